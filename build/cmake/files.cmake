@@ -406,6 +406,7 @@ set(BASE_CMN_SRC
     src/common/dynload.cpp
     src/common/encconv.cpp
     src/common/evtloopcmn.cpp
+    src/common/evtprofiler.cpp
     src/common/extended.c
     src/common/ffile.cpp
     src/common/file.cpp
@@ -527,6 +528,7 @@ set(BASE_CMN_HDR
     wx/eventfilter.h
     wx/evtloop.h
     wx/evtloopsrc.h
+    wx/evtprofiler.h
     wx/except.h
     wx/features.h
     wx/flags.h
@@ -876,6 +878,7 @@ set(GUI_CMN_SRC
     src/xrc/xmlreshandler.cpp
     src/common/bmpcboxcmn.cpp
     src/generic/grideditors.cpp
+    src/generic/gridasync.cpp
     src/generic/gridctrl.cpp
     src/generic/grid.cpp
     src/generic/hyperlinkg.cpp
@@ -1159,6 +1162,7 @@ set(GUI_CMN_HDR
     wx/hyperlink.h
     wx/bmpcbox.h
     wx/addremovectrl.h
+    wx/generic/gridasync.h
     wx/generic/gridctrl.h
     wx/generic/notifmsg.h
     wx/odcombo.h
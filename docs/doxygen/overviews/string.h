@@ -281,7 +281,14 @@ the entire string has to be parsed in order to find the character.
 Since iterating over a string by index is a common programming technique and
 was also possible and encouraged by wxString using the access operator[]()
 wxString implements caching of the last used index so that iterating over
-a string is a linear operation even in UTF-8 mode.
+a string is a linear operation even in UTF-8 mode. Additionally, since
+wxWidgets 3.1.6, the positions of every 64th character of long strings are
+indexed when they are accessed for the first time, so that accessing them in
+an arbitrary order, e.g. when using operator[]() with random indices, Mid() or
+Find(), doesn't require parsing the string from the beginning either. This
+index is built for the entire string at once and doesn't change until the
+string is modified, so it doesn't make reading the same string from multiple
+threads any less safe.
 
 It is nonetheless recommended to use @b iterators (instead of index based
 access) like this:
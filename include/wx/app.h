@@ -354,10 +354,11 @@ public:
     void ResumeProcessingOfPendingEvents();
 
     // called by ~wxEvtHandler to (eventually) remove the handler from the list of
-    // the handlers with pending events
-    void RemovePendingEventHandler(wxEvtHandler* toRemove);
+    // the handlers with pending events, returns true if it was in this list
+    bool RemovePendingEventHandler(wxEvtHandler* toRemove);
 
-    // adds an event handler to the list of the handlers with pending events
+    // adds an event handler to the list of the handlers with pending events,
+    // it must not be already present in it
     void AppendPendingEventHandler(wxEvtHandler* toAppend);
 
     // moves the event handler from the list of the handlers with pending events
@@ -65,6 +65,43 @@ inline int wxCMPFUNC_CONV wxNaturalStringSortDescending(const wxString& s1, cons
     return wxCmpNatural(s2, s1);
 }
 
+// Flags for wxGetStringSortKey() and the functions using it.
+enum wxStringSortKeyFlags
+{
+    // compare the strings as wxString::Cmp() does
+    wxSORTKEY_DEFAULT = 0,
+
+    // ignore case, as wxString::CmpNoCase() does
+    wxSORTKEY_NOCASE  = 1,
+
+    // use the collation order of the current locale, as wxStrcoll() does
+    wxSORTKEY_LOCALE  = 2,
+
+    // use natural order, as wxCmpNaturalGeneric() does: this already ignores
+    // case and uses the current locale, so the other flags are ignored
+    wxSORTKEY_NATURAL = 4
+};
+
+// Return the binary key which can be compared with wxCmpStringSortKeys()
+// instead of comparing the strings themselves: this is much faster than
+// wxCmpNaturalGeneric() or wxStrcoll() when the same string is compared many
+// times, e.g. when sorting.
+WXDLLIMPEXP_BASE
+wxCharBuffer wxGetStringSortKey(const wxString& str, int flags = wxSORTKEY_DEFAULT);
+
+WXDLLIMPEXP_BASE
+int wxCmpStringSortKeys(const wxCharBuffer& key1, const wxCharBuffer& key2);
+
+// Fill the order array, which must have count elements, with the indices of
+// the given strings in their sorted order. The keys are computed only once
+// for each string and, for big arrays, in several threads.
+WXDLLIMPEXP_BASE
+void wxGetStringSortOrder(const wxString* strings,
+                          size_t count,
+                          size_t* order,
+                          int flags = wxSORTKEY_DEFAULT,
+                          bool reverseOrder = false);
+
 
 #if wxUSE_STD_CONTAINERS
 
@@ -90,6 +127,9 @@ public:
     void Sort(CompareFunction function);
     void Sort(CMPFUNCwxString function) { wxArrayStringBase::Sort(function); }
 
+    // sort using the keys returned by wxGetStringSortKey()
+    void SortByKey(int flags, bool reverseOrder = false);
+
     size_t Add(const wxString& string, size_t copies = 1)
     {
         wxArrayStringBase::Add(string, copies);
@@ -122,14 +162,7 @@ class WXDLLIMPEXP_BASE wxSortedArrayString : public wxSortedArrayStringBase
 public:
     wxSortedArrayString() : wxSortedArrayStringBase(wxStringSortAscending)
         { }
-    wxSortedArrayString(const wxArrayString& src)
-        : wxSortedArrayStringBase(wxStringSortAscending)
-    {
-        reserve(src.size());
-
-        for ( size_t n = 0; n < src.size(); n++ )
-            Add(src[n]);
-    }
+    wxSortedArrayString(const wxArrayString& src);
     explicit wxSortedArrayString(wxArrayString::CompareFunction compareFunction)
         : wxSortedArrayStringBase(compareFunction)
         { }
@@ -256,6 +289,8 @@ public:
     // sort array elements using specified comparison function
   void Sort(CompareFunction compareFunction);
   void Sort(CompareFunction2 compareFunction);
+    // sort array elements using the keys returned by wxGetStringSortKey()
+  void SortByKey(int flags, bool reverseOrder = false);
 
   // comparison
     // compare two arrays case sensitively
@@ -398,6 +433,9 @@ private:
   // (if the old buffer is big enough, just return NULL).
   wxString *Grow(size_t nIncrement);
 
+  // Reorder the strings using wxGetStringSortOrder().
+  void DoSortByKey(int flags, bool reverseOrder);
+
   // Binary search in the sorted array: return the index of the string if it's
   // present, otherwise, if lowerBound is true, return the position at which
   // the string should be inserted and if it's false return wxNOT_FOUND.
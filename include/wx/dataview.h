@@ -277,6 +277,10 @@ public:
                          unsigned int column, bool ascending ) const;
     virtual bool HasDefaultCompare() const { return false; }
 
+    // return true if Compare() is not overridden, so that the values returned
+    // by GetValue() can be retrieved once and compared directly when sorting
+    virtual bool CanCacheSortKeys() const { return false; }
+
     // internal
     virtual bool IsListModel() const { return false; }
     virtual bool IsVirtualListModel() const { return false; }
@@ -1087,6 +1091,8 @@ public:
 
     virtual wxString GetColumnType( unsigned int col ) const wxOVERRIDE;
 
+    virtual bool CanCacheSortKeys() const wxOVERRIDE { return true; }
+
     virtual void GetValueByRow( wxVariant &value,
                            unsigned int row, unsigned int col ) const wxOVERRIDE;
 
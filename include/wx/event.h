@@ -3670,6 +3670,13 @@ public:
     // buffer as other wxString objects in this thread.
     virtual void QueueEvent(wxEvent *event);
 
+    // Schedule the given event to be processed later, just as QueueEvent()
+    // does, but replace any pending event queued with the same key by this
+    // function instead of adding a new one. If minInterval (in milliseconds)
+    // is non-zero, the events with this key are also not processed more often
+    // than once per this interval. This is safe to call from multiple threads.
+    void QueueCoalescedEvent(wxEvent *event, int key, int minInterval = 0);
+
     // Add an event to be processed later: notice that this function is not
     // safe to call from threads other than main, use QueueEvent()
     virtual void AddPendingEvent(const wxEvent& event)
@@ -3917,9 +3924,13 @@ public:
     //
     // return true if the event was processed, false otherwise (no match or the
     // handler decided to skip the event)
+    //
+    // isDynamic is only used by wxEventProfiler and indicates whether the
+    // entry comes from the dynamic or static event table
     static bool ProcessEventIfMatchesId(const wxEventTableEntryBase& tableEntry,
                                         wxEvtHandler *handler,
-                                        wxEvent& event);
+                                        wxEvent& event,
+                                        bool isDynamic = false);
 
     // Allow iterating over all connected dynamic event handlers: you must pass
     // the same "cookie" to GetFirst() and GetNext() and call them until null
@@ -4009,13 +4020,30 @@ protected:
     wxEvtHandler*       m_nextHandler;
     wxEvtHandler*       m_previousHandler;
 
-    typedef wxVector<wxDynamicEventTableEntry*> DynamicEvents;
+    // the dynamically bound event handlers, indexed by their event type
+    struct DynamicEvents;
     DynamicEvents* m_dynamicEvents;
 
-    wxList*             m_pendingEvents;
+    // the pending events are first pushed, without taking any locks, onto
+    // m_pendingEventsQueued stack by QueueEvent() and are then moved to the
+    // m_pendingEvents queue, in the correct order, by ProcessPendingEvents()
+    struct PendingEventNode;
+    PendingEventNode* volatile m_pendingEventsQueued;
+    PendingEventNode*   m_pendingEvents;
+    PendingEventNode*   m_pendingEventsLast;
+
+    // non-zero if this handler is in the list of the handlers with pending
+    // events of the application, only modified atomically
+    wxUint32 volatile   m_isPendingHandler;
+
+    // the data used by QueueCoalescedEvent(), allocated on first use and
+    // protected by m_pendingEventsLock
+    struct CoalescedEvents;
+    CoalescedEvents*    m_coalescedEvents;
 
 #if wxUSE_THREADS
-    // critical section protecting m_pendingEvents
+    // critical section protecting m_pendingEvents, it is not used by
+    // QueueEvent() and so is mostly taken by the thread processing them
     wxCriticalSection m_pendingEventsLock;
 #endif // wxUSE_THREADS
 
@@ -4054,6 +4082,25 @@ private:
     // try to process events in all handlers chained to this one
     bool DoTryChain(wxEvent& event);
 
+    // move the events pushed by QueueEvent() to m_pendingEvents queue, must be
+    // called with m_pendingEventsLock held, returns true if there were any
+    bool TakeQueuedEvents();
+
+    // remove this handler from the list of the handlers with pending events
+    // after processing or deleting all of them, also with the lock held
+    void UnregisterPendingHandler();
+
+    // unlink the given node, following the given one or NULL if it's the first
+    // one, from m_pendingEvents queue, also with the lock held
+    void UnlinkPendingEvent(PendingEventNode *prev, PendingEventNode *node);
+
+    // return true if the given pending event can't be processed yet because
+    // of its minimal interval, in which case it's postponed until then
+    bool DeferCoalescedEventIfNeeded(PendingEventNode *node);
+
+    // queue the postponed coalesced events which can be processed now
+    void QueueDueCoalescedEvents();
+
     // Head of the event filter linked list.
     static wxEventFilter* ms_filterList;
 
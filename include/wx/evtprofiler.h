@@ -0,0 +1,233 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/evtprofiler.h
+// Purpose:     wxEventProfiler class declaration.
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_EVTPROFILER_H_
+#define _WX_EVTPROFILER_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_STOPWATCH && wxUSE_LONGLONG
+
+#include "wx/event.h"
+#include "wx/hashmap.h"
+#include "wx/stopwatch.h"
+#include "wx/vector.h"
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif // wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// wxEventHandlerStats: statistics about calls to a single event handler
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxEventHandlerStats
+{
+public:
+    // Event type and the class of the events processed by this handler.
+    wxEventType GetEventType() const { return m_eventType; }
+    wxString GetEventClassName() const;
+
+    // The class of the object handling the events.
+    wxString GetHandlerClassName() const;
+
+    // True if the handler was connected using Bind() or Connect() and false
+    // if it comes from the static event table.
+    bool IsDynamic() const { return m_isDynamic; }
+
+    // Return the string combining all the information above.
+    wxString GetDescription() const;
+
+    // The number of calls and the time, in microseconds, taken by them.
+    unsigned long GetCount() const { return m_count; }
+    wxLongLong GetTotalTime() const { return m_totalTime; }
+    wxLongLong GetMaxTime() const { return m_maxTime; }
+    wxLongLong GetAverageTime() const;
+
+    // Return the approximate time not exceeded by the given percentage of
+    // calls, e.g. GetPercentile(50) returns the median time.
+    wxLongLong GetPercentile(double percentile) const;
+
+private:
+    wxEventHandlerStats(void *functor,
+                        wxEventType eventType,
+                        const wxClassInfo *eventClass,
+                        const wxClassInfo *handlerClass,
+                        bool isDynamic);
+
+    bool Matches(wxEventType eventType,
+                 const wxClassInfo *eventClass,
+                 const wxClassInfo *handlerClass,
+                 bool isDynamic) const
+    {
+        return m_eventType == eventType &&
+                m_eventClass == eventClass &&
+                    m_handlerClass == handlerClass &&
+                        m_isDynamic == isDynamic;
+    }
+
+    void AddCall(wxUint32 duration);
+
+    // The durations are stored in a histogram using 4 buckets for each power
+    // of 2, which is enough for computing the percentiles with 25% precision.
+    enum { NUM_BUCKETS = 128 };
+    static unsigned GetBucket(wxUint32 duration);
+    static wxUint32 GetBucketMax(unsigned bucket);
+
+    void *m_functor;
+    wxEventType m_eventType;
+    const wxClassInfo *m_eventClass;
+    const wxClassInfo *m_handlerClass;
+    bool m_isDynamic;
+
+    unsigned long m_count;
+    wxLongLong m_totalTime;
+    wxUint32 m_maxTime;
+    wxUint32 m_histogram[NUM_BUCKETS];
+
+    // index of the next stats object for a different handler using the same
+    // functor or (size_t)-1
+    size_t m_next;
+
+    friend class wxEventProfiler;
+};
+
+// ----------------------------------------------------------------------------
+// wxEventProfiler measures the time taken by all event handlers
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxEventProfiler
+{
+public:
+    wxEventProfiler();
+    ~wxEventProfiler();
+
+    // Start collecting statistics about all event handlers called from now
+    // on, only one profiler can be running at any time, so this returns false
+    // if another one is already running.
+    bool Start();
+
+    // Stop collecting statistics, this is done automatically on destruction.
+    void Stop();
+
+    bool IsRunning() const { return ms_running == this; }
+
+    // Forget all the collected statistics.
+    void Reset();
+
+    // Set the maximal number of individual handler calls stored for
+    // GetChromeTrace(), 0 disables storing them.
+    void SetMaxTraceEvents(size_t maxEvents) { m_maxTraceEvents = maxEvents; }
+    size_t GetMaxTraceEvents() const { return m_maxTraceEvents; }
+
+    // Return the statistics for all the handlers which were called, sorted in
+    // the order of decreasing total time.
+    wxVector<wxEventHandlerStats> GetStats() const;
+
+    // Return a human-readable table with the statistics.
+    wxString GetReport() const;
+
+    // Return the JSON object in Chrome trace events format, which can be
+    // loaded into chrome://tracing or other compatible viewers.
+    wxString GetChromeTrace() const;
+
+
+    // implementation only from now on
+
+    // Return the running profiler or NULL, this is called for every event
+    // handler invocation and so must be as fast as possible.
+    static wxEventProfiler *GetRunning() { return ms_running; }
+
+    // Helper measuring the time taken by a single handler call during its
+    // lifetime: it does nothing at all if no profiler is running.
+    class HandlerCall
+    {
+    public:
+        HandlerCall(const wxEventTableEntryBase& entry,
+                    wxEvtHandler *handler,
+                    const wxEvent& event,
+                    bool isDynamic)
+            : m_profiler(ms_running)
+        {
+            if ( m_profiler )
+                m_profiler->BeginCall(*this, entry, handler, event, isDynamic);
+        }
+
+        ~HandlerCall()
+        {
+            // check that the profiler is still running as it could have been
+            // stopped, or even destroyed, by the handler itself
+            if ( m_profiler && m_profiler == ms_running )
+                m_profiler->EndCall(*this);
+        }
+
+    private:
+        wxEventProfiler * const m_profiler;
+
+        void *m_functor;
+        wxEventType m_eventType;
+        const wxClassInfo *m_eventClass;
+        const wxClassInfo *m_handlerClass;
+        bool m_isDynamic;
+        wxLongLong m_start;
+
+        friend class wxEventProfiler;
+
+        wxDECLARE_NO_COPY_CLASS(HandlerCall);
+    };
+
+private:
+    void BeginCall(HandlerCall& call,
+                   const wxEventTableEntryBase& entry,
+                   wxEvtHandler *handler,
+                   const wxEvent& event,
+                   bool isDynamic);
+    void EndCall(const HandlerCall& call);
+
+    // Return the index of the stats for the handler being called.
+    size_t GetStatsIndex(const HandlerCall& call);
+
+    // A single handler call stored for the trace.
+    struct TraceEvent
+    {
+        size_t stats;
+        wxLongLong start;
+        wxUint32 duration;
+#if wxUSE_THREADS
+        wxThreadIdType thread;
+#endif // wxUSE_THREADS
+    };
+
+    // the running profiler, only modified atomically as profilers can be
+    // started and stopped from different threads
+    static wxEventProfiler * volatile ms_running;
+
+    // used for measuring time since the creation or the last Reset() call
+    wxStopWatch m_stopwatch;
+
+    wxVector<wxEventHandlerStats> m_stats;
+
+    WX_DECLARE_VOIDPTR_HASH_MAP(size_t, StatsIndexMap);
+    StatsIndexMap m_statsIndex;
+
+    wxVector<TraceEvent> m_trace;
+    size_t m_maxTraceEvents;
+
+#if wxUSE_THREADS
+    // the events can be processed by multiple threads, so the collected data
+    // must be protected
+    mutable wxCriticalSection m_critSect;
+#endif // wxUSE_THREADS
+
+    wxDECLARE_NO_COPY_CLASS(wxEventProfiler);
+};
+
+#endif // wxUSE_STOPWATCH && wxUSE_LONGLONG
+
+#endif // _WX_EVTPROFILER_H_
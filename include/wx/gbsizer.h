@@ -236,7 +236,8 @@ public:
 
     // Get/Set the size used for cells in the grid with no item.
     wxSize GetEmptyCellSize() const          { return m_emptyCellSize; }
-    void SetEmptyCellSize(const wxSize& sz)  { m_emptyCellSize = sz; }
+    void SetEmptyCellSize(const wxSize& sz)
+        { m_emptyCellSize = sz; InvalidateMinSize(); }
 
     // Get the size of the specified cell, including hgap and vgap.  Only
     // valid after a Layout.
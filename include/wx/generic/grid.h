@@ -94,6 +94,7 @@ enum wxGridRenderStyle
 
 class WXDLLIMPEXP_FWD_CORE wxGrid;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttr;
+class WXDLLIMPEXP_FWD_CORE wxGridBlockCoords;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttrProviderData;
 class WXDLLIMPEXP_FWD_CORE wxGridColLabelWindow;
 class WXDLLIMPEXP_FWD_CORE wxGridCornerLabelWindow;
@@ -115,6 +116,9 @@ class WXDLLIMPEXP_FWD_CORE wxDatePickerCtrl;
 #endif
 
 class wxGridFixedIndicesSet;
+class wxGridLineSizes;
+class wxGridBestSizeCache;
+class wxGridAsyncTableData;
 
 class wxGridOperations;
 class wxGridRowOperations;
@@ -901,6 +905,11 @@ public:
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
+    // set the attribute for all cells of the given block: this is much more
+    // efficient than setting it for each cell individually for big blocks
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
+
     // these functions must be called whenever some rows/cols are deleted
     // because the internal data must be updated then
     void UpdateAttrRows( size_t pos, int numRows );
@@ -1159,6 +1168,99 @@ private:
     friend class wxGrid;
 };
 
+// ----------------------------------------------------------------------------
+// wxGridLines: a range of grid rows or columns that can be iterated over
+// ----------------------------------------------------------------------------
+
+// The lines are stored as sorted non-overlapping ranges of consecutive lines,
+// so the memory used doesn't depend on the number of lines.
+class wxGridLines
+{
+public:
+    class iterator
+    {
+    public:
+#if wxUSE_STD_CONTAINERS_COMPATIBLY
+        typedef std::input_iterator_tag iterator_category;
+#endif
+        typedef ptrdiff_t difference_type;
+        typedef int value_type;
+        typedef int reference;
+        typedef const int* pointer;
+
+        iterator() : m_lines(NULL), m_range(0), m_line(0) { }
+
+        reference operator*() const { return m_line; }
+
+        iterator& operator++()
+            { Advance(); return *this; }
+        iterator operator++(int)
+            { iterator tmp = *this; Advance(); return tmp; }
+
+        bool operator==(const iterator& it) const
+            { return m_range == it.m_range && m_line == it.m_line; }
+        bool operator!=(const iterator& it) const
+            { return !(*this == it); }
+
+    private:
+        iterator(const wxGridLines* lines, size_t range)
+            : m_lines(lines),
+              m_range(range),
+              m_line(range < lines->GetRangesCount()
+                        ? lines->GetRangeFirst(range) : 0)
+        {
+        }
+
+        void Advance()
+        {
+            if ( m_line < m_lines->GetRangeLast(m_range) )
+            {
+                m_line++;
+            }
+            else if ( ++m_range < m_lines->GetRangesCount() )
+            {
+                m_line = m_lines->GetRangeFirst(m_range);
+            }
+            else
+            {
+                m_line = 0;
+            }
+        }
+
+        const wxGridLines* m_lines;
+        size_t m_range;
+        int m_line;
+
+        friend class wxGridLines;
+    };
+
+    wxGridLines() { }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, GetRangesCount()); }
+
+    bool empty() const { return m_bounds.empty(); }
+
+    // Return the total number of lines in all ranges.
+    size_t size() const
+    {
+        size_t count = 0;
+        for ( size_t n = 0; n < m_bounds.size(); n += 2 )
+            count += m_bounds[n + 1] - m_bounds[n] + 1;
+        return count;
+    }
+
+    size_t GetRangesCount() const { return m_bounds.size() / 2; }
+    int GetRangeFirst(size_t n) const { return m_bounds[2*n]; }
+    int GetRangeLast(size_t n) const { return m_bounds[2*n + 1]; }
+
+private:
+    // The first and last line of each range.
+    wxVector<int> m_bounds;
+
+    friend class wxGridSelection;
+};
+
 // For comparisons...
 //
 extern WXDLLIMPEXP_CORE wxGridCellCoords  wxGridNoCellCoords;
@@ -1212,6 +1314,13 @@ public:
     virtual wxString GetValue( int row, int col ) = 0;
     virtual void SetValue( int row, int col, const wxString& value ) = 0;
 
+    // Optionally retrieve the values of all cells of the given block at once,
+    // in row-major order: this is used by wxGrid when drawing and can be
+    // overridden to avoid calling GetValue() for each cell. The default
+    // implementation just returns false to indicate that it's not supported.
+    virtual bool GetValues( const wxGridBlockCoords& block,
+                            wxArrayString& values );
+
     // Data type determination and value access
     virtual wxString GetTypeName( int row, int col );
     virtual bool CanGetValueAs( int row, int col, const wxString& typeName );
@@ -1288,6 +1397,8 @@ public:
     virtual void SetAttr(wxGridCellAttr* attr, int row, int col);
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
 
 private:
     wxGrid * m_view;
@@ -1953,6 +2064,8 @@ public:
     void     SetAttr(int row, int col, wxGridCellAttr *attr);
     void     SetRowAttr(int row, wxGridCellAttr *attr);
     void     SetColAttr(int col, wxGridCellAttr *attr);
+    void     SetBlockAttr(int topRow, int leftCol, int bottomRow, int rightCol,
+                          wxGridCellAttr *attr);
 
     // the grid can cache attributes for the recently used cells (currently it
     // only caches one attribute for the most recently used one) and might
@@ -2046,8 +2159,7 @@ public:
 
     wxGridSizesInfo GetColSizes() const
         { return wxGridSizesInfo(GetDefaultColSize(), m_colWidths); }
-    wxGridSizesInfo GetRowSizes() const
-        { return wxGridSizesInfo(GetDefaultRowSize(), m_rowHeights); }
+    wxGridSizesInfo GetRowSizes() const;
 
     void SetColSizes(const wxGridSizesInfo& sizeInfo);
     void SetRowSizes(const wxGridSizesInfo& sizeInfo);
@@ -2112,6 +2224,12 @@ public:
     void     AutoSizeColumns( bool setAsMin = true );
     void     AutoSizeRows( bool setAsMin = true );
 
+    // only measure the visible, the first and last and the longest numLines
+    // cells when auto sizing columns or rows having more than that, or
+    // measure all of them if numLines is 0 (default)
+    void     SetAutoSizeSampleSize( int numLines );
+    int      GetAutoSizeSampleSize() const { return m_autoSizeSampleSize; }
+
     // auto size the grid, that is make the columns/rows of the "right" size
     // and also set the grid size to just fit its contents
     void     AutoSize();
@@ -2179,17 +2297,7 @@ public:
 
     // ------ cell value accessors
     //
-    wxString GetCellValue( int row, int col ) const
-    {
-        if ( m_table )
-        {
-            return m_table->GetValue( row, col );
-        }
-        else
-        {
-            return wxEmptyString;
-        }
-    }
+    wxString GetCellValue( int row, int col ) const;
 
     wxString GetCellValue( const wxGridCellCoords& coords ) const
         { return GetCellValue( coords.GetRow(), coords.GetCol() ); }
@@ -2241,6 +2349,10 @@ public:
     wxGridBlockCoordsVector GetSelectedRowBlocks() const;
     wxGridBlockCoordsVector GetSelectedColBlocks() const;
 
+    // Efficient methods returning the fully selected rows or columns.
+    wxGridLines GetSelectedRowLines() const;
+    wxGridLines GetSelectedColLines() const;
+
     // Less efficient (but maybe more convenient methods) returning all
     // selected cells, rows or columns -- there can be many and many of those.
     wxGridCellCoordsArray GetSelectedCells() const;
@@ -2552,6 +2664,12 @@ protected:
     wxGridTableBase          *m_table;
     bool                      m_ownTable;
 
+#if wxUSE_THREADS
+    // the worker thread and the cache used by m_table if it's a
+    // wxGridAsyncTableBase, NULL otherwise
+    wxGridAsyncTableData     *m_asyncTableData;
+#endif // wxUSE_THREADS
+
     int m_numRows;
     int m_numCols;
 
@@ -2583,13 +2701,21 @@ protected:
     // NB: *never* access m_row/col arrays directly because they are created
     //     on demand, *always* use accessor functions instead!
 
-    // init the m_rowHeights/Bottoms arrays with default values
+    // init m_rowSizes with default values
     void InitRowHeights();
 
     int        m_defaultRowHeight;
     int        m_minAcceptableRowHeight;
-    wxArrayInt m_rowHeights;
-    wxArrayInt m_rowBottoms;
+
+    // the sizes of all rows, NULL if they all have the default height
+    wxGridLineSizes *m_rowSizes;
+
+    // the number of lines measured when auto-sizing, 0 to measure all of them
+    int m_autoSizeSampleSize;
+
+    // the sizes of the cells measured when auto-sizing with sampling, only
+    // allocated when it's used
+    wxGridBestSizeCache *m_bestSizeCache;
 
     // init the m_colWidths/Rights arrays
     void InitColWidths();
@@ -2654,6 +2780,11 @@ protected:
     // common part of AutoSizeColumn/Row()
     void AutoSizeColOrRow(int n, bool setAsMin, wxGridDirection direction);
 
+    // fill the provided vector with the sorted indices of the lines to measure
+    // when auto-sizing the given column or row using sampling
+    void GetAutoSizeSample(int colOrRow, wxGridDirection direction,
+                           wxVector<int>& lines) const;
+
     // Calculate the minimum acceptable size for labels area
     wxCoord CalcColOrRowLabelAreaMinSize(wxGridDirection direction);
 
@@ -2677,6 +2808,11 @@ protected:
         wxGridCellAttr *attr;
     } m_attrCache;
 
+    // the values of the cells being drawn, if the table supports retrieving
+    // them all at once, or empty array otherwise
+    wxGridBlockCoords m_drawnValuesBlock;
+    wxArrayString m_drawnValues;
+
     // invalidates the attribute cache
     void ClearAttrCache();
 
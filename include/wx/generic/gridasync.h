@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/generic/gridasync.h
+// Purpose:     wxGridAsyncTableBase
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_GENERIC_GRIDASYNC_H_
+#define _WX_GENERIC_GRIDASYNC_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_GRID && wxUSE_THREADS
+
+#include "wx/grid.h"
+
+class wxGridAsyncTableData;
+
+// ----------------------------------------------------------------------------
+// wxGridAsyncTableBase
+// ----------------------------------------------------------------------------
+
+// Base class for the tables retrieving their data from a slow store: the rows
+// are loaded in chunks by a worker thread and the cells are shown using a
+// placeholder until their values become available.
+//
+// The worker thread and the cache of the loaded rows belong to the wxGrid
+// using this table: they're created when the table is associated with the
+// grid and destroyed, after stopping the thread, when the grid stops using
+// it, which must happen before the table itself is destroyed.
+class WXDLLIMPEXP_CORE wxGridAsyncTableBase : public wxGridTableBase
+{
+public:
+    wxGridAsyncTableBase();
+    virtual ~wxGridAsyncTableBase();
+
+    // Must be overridden to load the values of all numCols columns of the
+    // given rows in row-major order. This function is called from a worker
+    // thread and so must not use any GUI functions.
+    virtual bool LoadRows( int firstRow, int numRows, int numCols,
+                           wxArrayString& values ) = 0;
+
+    // Forget all the loaded values, e.g. because they changed in the store.
+    void InvalidateCache();
+
+    // Wait until all the rows requested so far are loaded and make them
+    // available immediately, without waiting for the next event loop
+    // iteration.
+    void WaitUntilLoaded();
+
+    // Return true if the values of the given row are already loaded.
+    bool IsRowAvailable( int row ) const;
+
+    // Number of rows loaded at once, 100 by default.
+    void SetChunkSize( int numRows );
+    int GetChunkSize() const { return m_chunkSize; }
+
+    // Maximal number of rows kept in memory, 10000 by default.
+    void SetCacheSize( int numRows );
+    int GetCacheSize() const { return m_cacheSize; }
+
+    // Value shown in the cells until their real value is loaded.
+    void SetPlaceholderValue( const wxString& value ) { m_placeholder = value; }
+    const wxString& GetPlaceholderValue() const { return m_placeholder; }
+
+    // overridden functions from wxGridTableBase
+    //
+    virtual wxString GetValue( int row, int col ) wxOVERRIDE;
+    virtual bool GetValues( const wxGridBlockCoords& block,
+                            wxArrayString& values ) wxOVERRIDE;
+
+private:
+    // the data owned by the grid using this table, if any
+    wxGridAsyncTableData *m_data;
+
+    int m_chunkSize;
+    int m_cacheSize;
+    wxString m_placeholder;
+
+    friend class wxGridAsyncTableData;
+
+    wxDECLARE_ABSTRACT_CLASS(wxGridAsyncTableBase);
+    wxDECLARE_NO_COPY_CLASS(wxGridAsyncTableBase);
+};
+
+#endif // wxUSE_GRID && wxUSE_THREADS
+
+#endif // _WX_GENERIC_GRIDASYNC_H_
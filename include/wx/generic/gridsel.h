@@ -21,6 +21,8 @@
 
 typedef wxVector<wxGridBlockCoords> wxVectorGridBlockCoords;
 
+class wxGridSelectionIndex;
+
 // Note: for all eventType arguments of the methods of this class wxEVT_NULL
 //       may be passed to forbid events generation completely.
 class WXDLLIMPEXP_CORE wxGridSelection
@@ -28,6 +30,7 @@ class WXDLLIMPEXP_CORE wxGridSelection
 public:
     wxGridSelection(wxGrid *grid,
                     wxGrid::wxGridSelectionModes sel = wxGrid::wxGridSelectCells);
+    ~wxGridSelection();
 
     bool IsSelection();
     bool IsInSelection(int row, int col) const;
@@ -109,7 +112,15 @@ public:
     wxArrayInt GetRowSelection() const;
     wxArrayInt GetColSelection() const;
 
-    wxVectorGridBlockCoords& GetBlocks() { return m_selection; }
+    // Return the fully selected rows or columns as ranges of consecutive
+    // lines, this is much more efficient than the functions above for big
+    // selections.
+    wxGridLines GetRowLines() const;
+    wxGridLines GetColLines() const;
+
+    // The blocks can't be modified directly, as this would make the index
+    // used by IsInSelection() stale, use the functions above instead.
+    const wxVectorGridBlockCoords& GetBlocks() const { return m_selection; }
 
     void EndSelecting();
 
@@ -138,6 +149,9 @@ private:
     void MergeOrAddBlock(wxVectorGridBlockCoords& blocks,
                          const wxGridBlockCoords& block);
 
+    // Common part of GetRowLines() and GetColLines().
+    wxGridLines DoGetLines(bool rows) const;
+
     // All currently selected blocks. We expect there to be a relatively small
     // amount of them, even for very large grids, as each block must be
     // selected by the user, so we store them unsorted.
@@ -147,6 +161,10 @@ private:
     // extending the current selection from keyboard.
     wxVectorGridBlockCoords             m_selection;
 
+    // The index of m_selection blocks allowing to check whether a cell is
+    // selected without iterating over all of them.
+    wxGridSelectionIndex                *m_index;
+
     wxGrid                              *m_grid;
     wxGrid::wxGridSelectionModes        m_selectionMode;
 
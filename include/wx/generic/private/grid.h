@@ -453,16 +453,264 @@ private:
     wxArrayAttrs m_attrs;
 };
 
-// NB: this is just a wrapper around 3 objects: one which stores cell
+// this class stores attributes set for rectangular blocks of cells
+//
+// The blocks are kept in a balanced binary search tree (a treap) ordered by
+// their top row, in which every node also stores the maximal bottom row of
+// all the blocks in its subtree. This allows to find the blocks containing a
+// cell in O((k+1) log n) time, where k is the number of blocks covering its
+// row, and to set or reset the attribute of a block in O(log n). Updating the
+// blocks when rows or columns are inserted or deleted is still O(n log n) as
+// all of them may need to be adjusted.
+//
+// When several blocks contain the same cell, the attribute of the most
+// recently set one is used.
+class WXDLLIMPEXP_ADV wxGridBlockAttrData
+{
+public:
+    wxGridBlockAttrData() : m_root(NULL), m_nextOrder(0), m_seed(1) { }
+    ~wxGridBlockAttrData();
+
+    void SetAttr(wxGridCellAttr *attr, const wxGridBlockCoords& block);
+    wxGridCellAttr *GetAttr(int row, int col) const;
+    void UpdateAttrRows( size_t pos, int numRows );
+    void UpdateAttrCols( size_t pos, int numCols );
+
+private:
+    struct Node
+    {
+        wxGridBlockCoords block;
+        wxGridCellAttr *attr;
+
+        // the order in which the attributes were set, used to give priority
+        // to the most recent one
+        unsigned long order;
+
+        // the heap priority of this node in the treap
+        unsigned priority;
+
+        // the maximal bottom row of all the blocks in this subtree
+        int maxBottom;
+
+        Node *left,
+             *right;
+    };
+
+    // the blocks are ordered by their top row and then by their other
+    // coordinates, so that each block appears in the tree at most once
+    static bool IsBefore(const wxGridBlockCoords& a, const wxGridBlockCoords& b);
+    static bool IsNodeBefore(const Node *a, const Node *b)
+        { return IsBefore(a->block, b->block); }
+
+    static void UpdateMaxBottom(Node *node);
+    static Node *Merge(Node *left, Node *right);
+    static void Split(Node *node, const wxGridBlockCoords& block,
+                      Node *&left, Node *&right);
+    static Node *DetachFirst(Node *&node);
+    static void Find(const Node *node, int row, int col, const Node *&found);
+    static void Collect(Node *node, wxVector<Node *>& nodes);
+
+    unsigned NextPriority();
+
+    // rebuild the tree from the nodes which must be already sorted
+    void Build(const wxVector<Node *>& nodes);
+
+    void UpdateAttrRowsOrCols(size_t pos, int num, bool rows);
+
+    Node *m_root;
+    unsigned long m_nextOrder;
+
+    // the state of the pseudo-random generator used for the priorities
+    unsigned m_seed;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridBlockAttrData);
+};
+
+// NB: this is just a wrapper around 4 objects: two which store cell and block
 //     attributes, and 2 others for row/col ones
 class WXDLLIMPEXP_ADV wxGridCellAttrProviderData
 {
 public:
     wxGridCellAttrData m_cellAttrs;
+    wxGridBlockAttrData m_blockAttrs;
     wxGridRowOrColAttrData m_rowAttrs,
                            m_colAttrs;
 };
 
+// ----------------------------------------------------------------------------
+// wxGridLineSizes: sizes and positions of the rows of a (possibly huge) grid
+// ----------------------------------------------------------------------------
+
+// This class stores the sizes of the lines as runs of consecutive lines having
+// the same size, so its memory usage only depends on the number of the lines
+// with non-default sizes and not on the total number of lines. The runs are
+// kept in a balanced tree (a treap using the line index as implicit key) with
+// the number of lines and their total size stored in each subtree, which
+// allows to find the position of a line, the line at a given position, and to
+// change, insert or remove lines in logarithmic time.
+//
+// As in wxGrid itself, a negative size indicates a hidden line, whose size is
+// the absolute value of the stored one when it's shown again.
+class wxGridLineSizes
+{
+public:
+    // Create the object for the given number of lines all of the same size.
+    wxGridLineSizes(int count, int size);
+    ~wxGridLineSizes();
+
+    int GetCount() const { return Count(m_root); }
+
+    // Get the total size of all the visible lines.
+    int GetTotal() const { return Extent(m_root); }
+
+    // Get the stored size of the line, i.e. negative if it's hidden.
+    int GetSize(int line) const;
+
+    // Change the stored size of the line.
+    void SetSize(int line, int size);
+
+    // Get the position of the end of the given line, i.e. the total size of
+    // all visible lines up to and including this one.
+    int GetEnd(int line) const;
+
+    // Return the first line whose end is greater than the given coordinate or
+    // GetCount() if there is none.
+    int FindLine(int coord) const;
+
+    // Insert the given number of lines of the given size before "pos".
+    void Insert(int pos, int count, int size);
+
+    // Remove "count" lines starting from "pos".
+    void Remove(int pos, int count);
+
+    // Multiply the sizes of all visible lines by num/den.
+    void Scale(int num, int den);
+
+    // Store the sizes of all lines with size different from the given default
+    // one in the provided map.
+    void GetCustomSizes(int sizeDefault, wxUnsignedToIntHashMap& sizes) const;
+
+private:
+    struct Node
+    {
+        Node *left,
+             *right;
+        unsigned priority;
+
+        // the number of lines in this run and their size
+        int count,
+            size;
+
+        // the total number of lines and their total visible size in the
+        // subtree rooted at this node
+        int subCount,
+            subExtent;
+    };
+
+    static int Count(const Node *node) { return node ? node->subCount : 0; }
+    static int Extent(const Node *node) { return node ? node->subExtent : 0; }
+    static void Update(Node *node);
+    static void Free(Node *node);
+    static void ScaleNodes(Node *node, int num, int den);
+    static void AddToLastRun(Node *node, int count);
+    static void CollectSizes(const Node *node,
+                             int& line,
+                             int sizeDefault,
+                             wxUnsignedToIntHashMap& sizes);
+
+    Node *NewNode(int count, int size);
+
+    // Split the tree into the first n lines and all the rest, cutting a run in
+    // two if necessary.
+    void Split(Node *node, int n, Node *& left, Node *& right);
+
+    // Concatenate two trees without coalescing the runs.
+    static Node *Merge(Node *left, Node *right);
+
+    // Concatenate two trees, merging the last run of the first one with the
+    // first run of the second one if they have the same size.
+    Node *Join(Node *left, Node *right);
+
+    Node *m_root;
+
+    // state of the pseudo-random generator used for node priorities
+    unsigned m_seed;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridLineSizes);
+};
+
+// ----------------------------------------------------------------------------
+// wxGridBestSizeCache: best sizes of the cells measured when auto-sizing
+// ----------------------------------------------------------------------------
+
+// This class is used when auto-sizing with sampling to avoid measuring the
+// same cells again. A cached size is only used if the cell value and font are
+// still the same and if it was computed for the same size of the cell in the
+// other direction, so that the cache doesn't need to be explicitly invalidated
+// when the cells change.
+//
+// The number of cached sizes is limited, the least recently used ones are
+// discarded when the limit is reached.
+class wxGridBestSizeCache
+{
+public:
+    wxGridBestSizeCache() { }
+    ~wxGridBestSizeCache() { Clear(); }
+
+    bool Lookup(wxGridDirection direction, int row, int col,
+                const wxString& value, const wxFont& font, int otherSize,
+                int *extent) const;
+
+    void Store(wxGridDirection direction, int row, int col,
+               const wxString& value, const wxFont& font, int otherSize,
+               int extent);
+
+    void Clear();
+
+private:
+    struct Entry
+    {
+        wxLongLong_t key;
+
+        wxString value;
+        wxFont font;
+        int otherSize;
+        int extent;
+
+        // the neighbours in the list of the entries ordered by their last use
+        Entry *prev,
+              *next;
+    };
+
+    WX_DECLARE_HASH_MAP(wxLongLong_t, Entry *,
+                        wxIntegerHash, wxIntegerEqual,
+                        EntriesMap);
+
+    // the entries for one direction: all of them are in both the map and the
+    // list, which starts with the most recently used one
+    struct Entries
+    {
+        Entries() : head(NULL), tail(NULL) { }
+
+        void Unlink(Entry *entry);
+        void PushFront(Entry *entry);
+
+        EntriesMap map;
+        Entry *head,
+              *tail;
+    };
+
+    static wxLongLong_t GetKey(int row, int col)
+    {
+        return (static_cast<wxLongLong_t>(row) << 32) + col;
+    }
+
+    // this is mutable because Lookup() updates the order of the entries
+    mutable Entries m_entries[2];
+
+    wxDECLARE_NO_COPY_CLASS(wxGridBestSizeCache);
+};
+
 // ----------------------------------------------------------------------------
 // operations classes abstracting the difference between operating on rows and
 // columns
@@ -551,8 +799,14 @@ public:
     // Get the height/width of the given row/column
     virtual int GetLineSize(const wxGrid *grid, int line) const = 0;
 
-    // Get wxGrid::m_rowBottoms/m_colRights array
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const = 0;
+    // Return true if any row or column has a non-default size
+    virtual bool HasCustomLineSizes(const wxGrid *grid) const = 0;
+
+    // Return the position of the row or column containing the given pixel
+    // coordinate, which must lie inside the lines between minPos and maxPos.
+    // This is only used if HasCustomLineSizes() returns true.
+    virtual int
+        FindLinePos(const wxGrid *grid, int coord, int minPos, int maxPos) const = 0;
 
     // Get default height row height or column width
     virtual int GetDefaultLineSize(const wxGrid *grid) const = 0;
@@ -649,8 +903,11 @@ public:
         { return grid->GetRowBottom(line); }
     virtual int GetLineSize(const wxGrid *grid, int line) const wxOVERRIDE
         { return grid->GetRowHeight(line); }
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const wxOVERRIDE
-        { return grid->m_rowBottoms; }
+    virtual bool HasCustomLineSizes(const wxGrid *grid) const wxOVERRIDE
+        { return grid->m_rowSizes != NULL; }
+    virtual int FindLinePos(const wxGrid *grid, int coord,
+                            int WXUNUSED(minPos), int WXUNUSED(maxPos)) const wxOVERRIDE
+        { return grid->m_rowSizes->FindLine(coord); }
     virtual int GetDefaultLineSize(const wxGrid *grid) const wxOVERRIDE
         { return grid->GetDefaultRowSize(); }
     virtual int GetMinimalAcceptableLineSize(const wxGrid *grid) const wxOVERRIDE
@@ -730,8 +987,10 @@ public:
         { return grid->GetColRight(line); }
     virtual int GetLineSize(const wxGrid *grid, int line) const wxOVERRIDE
         { return grid->GetColWidth(line); }
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const wxOVERRIDE
-        { return grid->m_colRights; }
+    virtual bool HasCustomLineSizes(const wxGrid *grid) const wxOVERRIDE
+        { return !grid->m_colRights.empty(); }
+    virtual int
+        FindLinePos(const wxGrid *grid, int coord, int minPos, int maxPos) const wxOVERRIDE;
     virtual int GetDefaultLineSize(const wxGrid *grid) const wxOVERRIDE
         { return grid->GetDefaultColSize(); }
     virtual int GetMinimalAcceptableLineSize(const wxGrid *grid) const wxOVERRIDE
@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/generic/private/gridasync.h
+// Purpose:     Private data of wxGridAsyncTableBase
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_GENERIC_PRIVATE_GRIDASYNC_H_
+#define _WX_GENERIC_PRIVATE_GRIDASYNC_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_GRID && wxUSE_THREADS
+
+#include "wx/generic/gridasync.h"
+#include "wx/thread.h"
+#include "wx/hashmap.h"
+#include "wx/vector.h"
+
+struct wxGridAsyncChunk
+{
+    // the values of all the cells of this chunk, in row-major order
+    wxArrayString values;
+    int numRows,
+        numCols;
+
+    // used to find the least recently used chunk when trimming the cache
+    unsigned long lastUse;
+};
+
+struct wxGridAsyncRequest
+{
+    int chunk,
+        firstRow,
+        numRows,
+        numCols;
+
+    // the generation of the cache at the time of the request, used to ignore
+    // the results of the requests made before InvalidateCache()
+    unsigned generation;
+};
+
+struct wxGridAsyncResult
+{
+    wxGridAsyncRequest request;
+    bool ok;
+    wxArrayString values;
+};
+
+WX_DECLARE_HASH_MAP(int, wxGridAsyncChunk *, wxIntegerHash, wxIntegerEqual,
+                    wxGridAsyncChunkMap);
+
+// This object contains the worker thread loading the rows of the table and
+// the cache of the loaded rows. It is created and destroyed by wxGrid when
+// it starts and stops using the table, so that the thread is always stopped
+// while the table is still alive.
+class wxGridAsyncTableData : public wxEvtHandler,
+                             public wxThreadHelper
+{
+public:
+    explicit wxGridAsyncTableData(wxGridAsyncTableBase *table);
+    virtual ~wxGridAsyncTableData();
+
+    // Forget all the loaded chunks and pending requests.
+    void Invalidate();
+
+    // Wait until the worker thread processes all the pending requests and
+    // store their results.
+    void WaitUntilLoaded();
+
+    // Get the value of the given cell if it's loaded.
+    bool GetValue(int row, int col, wxString& value);
+
+    bool HasRow(int row) const
+    {
+        return m_chunks.find(row / m_table->m_chunkSize) != m_chunks.end();
+    }
+
+    // Request loading all the chunks containing the given rows which are not
+    // loaded yet, and prefetch the next one in the scrolling direction.
+    void Request(int firstRow, int lastRow);
+
+    // Remove the least recently used chunks if the cache is too big.
+    void TrimCache();
+
+protected:
+    virtual void *Entry() wxOVERRIDE;
+
+private:
+    // Stop the worker thread if it's running.
+    void Stop();
+
+    void RequestChunk(int chunk, int numRows);
+    void StoreResult(wxGridAsyncResult *result);
+    void StoreResults();
+    void DeleteChunks();
+    void OnChunksLoaded(wxThreadEvent& event);
+
+    wxGridAsyncTableBase * const m_table;
+
+    // these fields are only used from the main thread
+    wxGridAsyncChunkMap m_chunks;
+    wxVector<int> m_pending;
+    unsigned long m_lastUse;
+    int m_lastFirstChunk;
+    unsigned m_generation;
+
+    // these fields are shared with the worker thread and protected by
+    // m_mutex
+    wxMutex m_mutex;
+    wxVector<wxGridAsyncRequest> m_requests;
+    wxVector<wxGridAsyncResult *> m_results;
+    bool m_busy;
+    bool m_stop;
+
+    // signalled by the worker thread when it has nothing more to do
+    wxCondition m_idle;
+
+    // posted once for each new request and to wake up the thread to stop it
+    wxSemaphore m_semaphore;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridAsyncTableData);
+};
+
+#endif // wxUSE_GRID && wxUSE_THREADS
+
+#endif // _WX_GENERIC_PRIVATE_GRIDASYNC_H_
@@ -18,6 +18,8 @@
 #include "wx/selstore.h"
 #include "wx/timer.h"
 #include "wx/settings.h"
+#include "wx/hashmap.h"
+#include "wx/vector.h"
 
 // ============================================================================
 // private classes
@@ -43,73 +45,103 @@ struct wxColWidthInfo
 WX_DEFINE_ARRAY_PTR(wxColWidthInfo *, ColWidthArray);
 
 //-----------------------------------------------------------------------------
-//  wxListItemData (internal)
+//  wxListItemStore (internal)
 //-----------------------------------------------------------------------------
 
-class wxListItemData
+WX_DECLARE_HASH_MAP(size_t, int, wxIntegerHash, wxIntegerEqual,
+                    wxListItemImageMap);
+WX_DECLARE_HASH_MAP(size_t, wxUIntPtr, wxIntegerHash, wxIntegerEqual,
+                    wxListItemDataMap);
+WX_DECLARE_HASH_MAP(size_t, wxItemAttr *, wxIntegerHash, wxIntegerEqual,
+                    wxListItemAttrMap);
+
+// This class stores the subitems of all lines of the control column by column
+// instead of allocating an object for each of them: every line only has an
+// index ("slot") in this store, the texts of all items in the same column are
+// kept in a single buffer and images, client data and attributes, which are
+// typically only used for some items, are kept in sparse maps.
+class wxListItemStore
 {
 public:
-    wxListItemData(wxListMainWindow *owner);
-    ~wxListItemData();
+    wxListItemStore() { m_slotCount = 0; }
+    ~wxListItemStore() { Clear(); }
+
+    // allocate a slot for a new line or free it when the line is deleted,
+    // deleting its attributes if deleteAttrs is true
+    size_t AllocSlot();
+    void FreeSlot(size_t slot, bool deleteAttrs);
+
+    // free all slots and columns, without deleting any attributes
+    void Clear();
+
+    // columns are only added when needed, so the number of columns here may
+    // be different from the number of columns in the control
+    size_t GetColumnCount() const { return m_columns.size(); }
+    void EnsureColumnCount(size_t count);
+    void InsertColumn(size_t col);
+    void DeleteColumn(size_t col, bool deleteAttrs);
+
+    wxString GetText(size_t slot, size_t col) const;
+    // this overload reuses the buffer of the given string, which is more
+    // efficient when getting many texts in a row, e.g. when painting
+    void GetText(size_t slot, size_t col, wxString& text) const;
+    bool HasText(size_t slot, size_t col) const
+        { return m_columns[col]->refs[slot].length != 0; }
+    void SetText(size_t slot, size_t col, const wxString& text);
+
+    int GetImage(size_t slot, size_t col) const;
+    void SetImage(size_t slot, size_t col, int image);
+
+    wxUIntPtr GetData(size_t slot, size_t col) const;
+    void SetData(size_t slot, size_t col, wxUIntPtr data);
+
+    // the store never takes ownership of the attributes, the caller is
+    // responsible for deleting the previously used one if necessary
+    wxItemAttr *GetAttr(size_t slot, size_t col) const;
+    void SetAttr(size_t slot, size_t col, wxItemAttr *attr);
 
-    void SetItem( const wxListItem &info );
-    void SetImage( int image ) { m_image = image; }
-    void SetData( wxUIntPtr data ) { m_data = data; }
-    void SetPosition( int x, int y );
-    void SetSize( int width, int height );
-
-    bool HasText() const { return !m_text.empty(); }
-    const wxString& GetText() const { return m_text; }
-    void SetText(const wxString& text) { m_text = text; }
-
-    // we can't use empty string for measuring the string width/height, so
-    // always return something
-    wxString GetTextForMeasuring() const
+private:
+    // location of the item text in the column buffer
+    struct TextRef
     {
-        wxString s = GetText();
-        if ( s.empty() )
-            s = wxT('H');
-
-        return s;
-    }
+        wxUint32 offset;
+        wxUint32 length;
+    };
 
-    bool IsHit( int x, int y ) const;
+    struct Column
+    {
+        Column() { unused = 0; }
 
-    int GetX() const;
-    int GetY() const;
-    int GetWidth() const;
-    int GetHeight() const;
+        // the texts of all items, one after another, without trailing NULs
+        wxVector<wxChar> chars;
 
-    int GetImage() const { return m_image; }
-    bool HasImage() const { return GetImage() != -1; }
+        // the number of characters in the buffer not used by any text
+        size_t unused;
 
-    void GetItem( wxListItem &info ) const;
+        // the text location for every slot
+        wxVector<TextRef> refs;
 
-    void SetAttr(wxItemAttr *attr) { m_attr = attr; }
-    wxItemAttr *GetAttr() const { return m_attr; }
+        // only the items with non-default values are stored in these maps
+        wxListItemImageMap images;
+        wxListItemDataMap data;
+        wxListItemAttrMap attrs;
+    };
 
-public:
-    // the item image or -1
-    int m_image;
+    // remove the texts which are not used any more from the column buffer
+    void Compact(Column& column);
 
-    // user data associated with the item
-    wxUIntPtr m_data;
+    void DeleteColumnAttrs(Column& column);
 
-    // the item coordinates are not used in report mode; instead this pointer is
-    // NULL and the owner window is used to retrieve the item position and size
-    wxRect *m_rect;
 
-    // the list ctrl we are in
-    wxListMainWindow *m_owner;
+    wxVector<Column *> m_columns;
 
-    // custom attributes or NULL
-    wxItemAttr *m_attr;
+    // the total number of slots, both used and free ones
+    size_t m_slotCount;
 
-protected:
-    // common part of all ctors
-    void Init();
+    // the slots which can be reused
+    wxVector<size_t> m_freeSlots;
 
-    wxString m_text;
+    wxDECLARE_NO_COPY_CLASS(wxListItemStore);
 };
 
 //-----------------------------------------------------------------------------
@@ -160,13 +192,11 @@ private:
 //  wxListLineData (internal)
 //-----------------------------------------------------------------------------
 
-WX_DECLARE_LIST(wxListItemData, wxListItemDataList);
-
 class wxListLineData
 {
 public:
-    // the list of subitems: only may have more than one item in report mode
-    wxListItemDataList m_items;
+    // the index of the subitems of this line in the owner item store
+    size_t m_slot;
 
     // this is not used in report view
     struct GeometryInfo
@@ -207,12 +237,7 @@ public:
 
 public:
     wxListLineData(wxListMainWindow *owner);
-
-    ~wxListLineData()
-    {
-        WX_CLEAR_LIST(wxListItemDataList, m_items);
-        delete m_gi;
-    }
+    ~wxListLineData();
 
     // called by the owner when it toggles report view
     void SetReportView(bool inReportView)
@@ -255,7 +280,8 @@ public:
     bool IsChecked() { return m_checked; }
 
     bool HasImage() const { return GetImage() != -1; }
-    bool HasText() const { return !GetText(0).empty(); }
+    bool HasText() const { return HasText(0); }
+    bool HasText(int index) const;
 
     void SetItem( int index, const wxListItem &info );
     void GetItem( int index, wxListItem &info ) const;
@@ -282,16 +308,18 @@ public:
     void Draw( wxDC *dc, bool current );
 
     // the same in report mode: it needs more parameters as we don't store
-    // everything in the item in report mode
+    // everything in the item in report mode, textBuf is just a scratch string
+    // which can be reused for drawing all lines to avoid allocating memory
     void DrawInReportMode( wxDC *dc,
                            const wxRect& rect,
                            const wxRect& rectHL,
                            bool highlighted,
-                           bool current );
+                           bool current,
+                           wxString& textBuf );
 
 private:
-    // set the line to contain num items (only can be > 1 in report mode)
-    void InitItems( int num );
+    // the store containing the data of our subitems
+    inline wxListItemStore& GetStore() const;
 
     // get the mode (i.e. style)  of the list control
     inline int GetMode() const;
@@ -305,8 +333,10 @@ private:
 
     // draw the text on the DC with the correct justification; also add an
     // ellipsis if the text is too large to fit in the current width
+    //
+    // notice that the text may be modified by this function
     void DrawTextFormatted(wxDC *dc,
-                           const wxString &text,
+                           wxString &text,
                            int col,
                            int x,
                            int yMid,    // this is middle, not top, of the text
@@ -508,6 +538,9 @@ public:
     // return true if the control is in report mode
     bool InReportView() const { return HasFlag(wxLC_REPORT); }
 
+    // return the store containing the subitems of all lines
+    wxListItemStore& GetItemStore() { return m_itemStore; }
+
     // return true if we are in single selection mode, false if multi sel
     bool IsSingleSel() const { return HasFlag(wxLC_SINGLE_SEL); }
 
@@ -786,6 +819,10 @@ public:
                                    int lineNumber );
 
 protected:
+    // the data of all items, it must be declared before m_lines as the lines
+    // use it in their dtor
+    wxListItemStore      m_itemStore;
+
     // the array of all line objects for a non virtual list control (for the
     // virtual list control we only ever use m_lines[0])
     wxListLineDataArray  m_lines;
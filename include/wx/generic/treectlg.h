@@ -248,6 +248,10 @@ protected:
                          m_hilightUnfocusedBrush;
     bool                 m_hasFocus;
     bool                 m_dirty;
+    // the cached layout of an item is valid only if it has this generation
+    unsigned             m_layoutGen;
+    // the maximal items extent used for the scrollbars the last time
+    int                  m_scrolledMaxRight;
     bool                 m_ownsImageListButtons;
     bool                 m_isDragging; // true between BEGIN/END drag events
     bool                 m_lastOnSame;  // last click on the same item as prev
@@ -322,11 +326,40 @@ protected:
     void CalculateLineHeight();
     int  GetLineHeight(wxGenericTreeItem *item) const;
     void PaintLevel( wxGenericTreeItem *item, wxDC& dc, int level, int &y );
+    void PaintChildren( wxGenericTreeItem *item, wxDC& dc, int level,
+                        int &y, int &yLast );
     void PaintItem( wxGenericTreeItem *item, wxDC& dc);
 
-    void CalculateLevel( wxGenericTreeItem *item, wxDC &dc, int level, int &y );
     void CalculatePositions();
 
+#if WXWIN_COMPATIBILITY_3_0
+    wxDEPRECATED_MSG("use CalculatePositions() instead")
+    void CalculateLevel( wxGenericTreeItem *item, wxDC &dc, int level, int &y );
+#endif // WXWIN_COMPATIBILITY_3_0
+
+    // invalidate the cached layout of the given item and all its parents, or
+    // of all items in the tree
+    void InvalidateLayout( wxGenericTreeItem *item );
+    void InvalidateAllLayouts();
+
+    // invalidate the layout of the children of the given item after adding,
+    // removing or reordering them
+    void InvalidateChildrenLayout( wxGenericTreeItem *item );
+
+    // update the cached layout of the item subtree, i.e. its total height and
+    // width and the offsets of its children, if necessary
+    void UpdateLayout( wxGenericTreeItem *item ) const;
+    void DoUpdateLayout( wxGenericTreeItem *item, wxDC *dc ) const;
+
+    // compute the position of the item and measure it if not done yet
+    void CalculateItemGeometry( wxGenericTreeItem *item ) const;
+
+    // return the item at the given (unscrolled) vertical position or NULL
+    wxGenericTreeItem *FindItemAtY( int y ) const;
+
+    // return the first visible item at or below the given vertical position
+    wxTreeItemId FindVisibleItemFrom( int y ) const;
+
     void RefreshSubtree( wxGenericTreeItem *item );
     void RefreshLine( wxGenericTreeItem *item );
 
@@ -18,6 +18,7 @@
 #include "wx/image.h"
 #include "wx/animdecod.h"
 #include "wx/dynarray.h"
+#include "wx/buffer.h"
 
 // internal utility used to store a frame in 8bit-per-pixel format
 class GIFImage;
@@ -53,6 +54,10 @@ public:
     ~wxGIFDecoder();
 
     // get data of current frame
+    //
+    // frames are decoded on demand and only the most recently used ones are
+    // kept, so the returned pointer is only valid until the data of another
+    // frame is requested
     unsigned char* GetData(unsigned int frame) const;
     unsigned char* GetPalette(unsigned int frame) const;
     unsigned int GetNcolours(unsigned int frame) const;
@@ -74,6 +79,11 @@ public:
     // free all internal frames
     void Destroy();
 
+    // set the maximal amount of memory used for the decoded frames, the
+    // compressed data of all frames is always kept
+    void SetCacheSize(size_t bytes);
+    size_t GetCacheSize() const { return m_cacheSize; }
+
     // implementation of wxAnimationDecoder's pure virtuals
     virtual bool Load( wxInputStream& stream ) wxOVERRIDE
         { return LoadGIF(stream) == wxGIF_OK; }
@@ -91,20 +101,35 @@ protected:
         // modifies current stream position (see wxAnimationDecoder::CanRead)
 
 private:
-    int getcode(wxInputStream& stream, int bits, int abfin);
+    int getcode(wxInputStream& stream, int bits, int abfin) const;
     wxGIFErrorCode dgif(wxInputStream& stream,
-                        GIFImage *img, int interl, int bits);
+                        GIFImage *img, int interl, int bits) const;
+
+    // decode the frame from its compressed data if it isn't cached already
+    bool DecodeFrame(unsigned int frame) const;
+
+    // mark the frame as the most recently used one and free the least
+    // recently used ones if the cache became too big
+    void CacheFrame(unsigned int frame) const;
 
 
     // array of all frames
     wxArrayPtrVoid m_frames;
 
+    // indices of the frames with decoded data, least recently used first
+    mutable wxArrayInt m_cachedFrames;
+    mutable size_t m_cacheUsed;
+    size_t m_cacheSize;
+
     // decoder state vars
-    int           m_restbits;       // remaining valid bits
-    unsigned int  m_restbyte;       // remaining bytes in this block
-    unsigned int  m_lastbyte;       // last byte read
-    unsigned char m_buffer[256];    // buffer for reading
-    unsigned char *m_bufp;          // pointer to next byte in buffer
+    mutable int           m_restbits;       // remaining valid bits
+    mutable unsigned int  m_restbyte;       // remaining bytes in this block
+    mutable unsigned int  m_lastbyte;       // last byte read
+    mutable unsigned char m_buffer[256];    // buffer for reading
+    mutable unsigned char *m_bufp;          // pointer to next byte in buffer
+
+    // if non-NULL, the compressed data read by getcode() is appended to it
+    wxMemoryBuffer *m_capture;
 
     wxDECLARE_NO_COPY_CLASS(wxGIFDecoder);
 };
@@ -18,4 +18,6 @@
 #include "wx/generic/grideditors.h"
 #include "wx/generic/gridctrl.h"
 
+#include "wx/generic/gridasync.h"
+
 #endif // _WX_GRID_H_BASE_
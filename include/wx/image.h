@@ -83,6 +83,18 @@ enum wxImageAlphaBlendMode
     wxIMAGE_ALPHA_BLEND_COMPOSE = 1
 };
 
+// Layouts of the interleaved pixel buffers used by wxImage::GetPackedPixels()
+// and SetPackedPixels().
+enum wxImagePackedFormat
+{
+    // R, G, B, A bytes, alpha not premultiplied.
+    wxIMAGE_PACKED_RGBA = 0,
+
+    // 32 bit native endian 0xAARRGGBB words with premultiplied alpha, i.e.
+    // B, G, R, A bytes on little endian machines, as used by Cairo and DIBs.
+    wxIMAGE_PACKED_ARGB32_PREMULTIPLIED = 1
+};
+
 // alpha channel values: fully transparent, default threshold separating
 // transparent pixels from opaque for a few functions dealing with alpha and
 // fully opaque
@@ -515,6 +527,15 @@ public:
     void InitAlpha();
     void ClearAlpha();
 
+    // copy (a part of) the image to or from a buffer with interleaved pixels
+    // and the given row stride in bytes (0 means no padding between rows)
+    bool GetPackedPixels(unsigned char *dst, int stride = 0,
+                         wxImagePackedFormat format = wxIMAGE_PACKED_RGBA,
+                         const wxRect& rect = wxRect()) const;
+    bool SetPackedPixels(const unsigned char *src, int stride = 0,
+                         wxImagePackedFormat format = wxIMAGE_PACKED_RGBA,
+                         const wxRect& rect = wxRect());
+
     // return true if this pixel is masked or has alpha less than specified
     // threshold
     bool IsTransparent(int x, int y,
@@ -50,6 +50,7 @@ protected:
     size_t OnSysRead(void *buffer, size_t nbytes) wxOVERRIDE;
     wxFileOffset OnSysSeek(wxFileOffset pos, wxSeekMode mode) wxOVERRIDE;
     wxFileOffset OnSysTell() const wxOVERRIDE;
+    const void *OnSysPeekContiguous(size_t *size) wxOVERRIDE;
 
 private:
     // common part of ctors taking wxInputStream
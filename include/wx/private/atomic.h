@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/atomic.h
+// Purpose:     wxAtomicCompareExchange() helper
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_ATOMIC_H_
+#define _WX_PRIVATE_ATOMIC_H_
+
+#include "wx/defs.h"
+
+// ----------------------------------------------------------------------------
+// Atomically replace a value with another one if it's still equal to the
+// expected old value, return true if the value was replaced.
+//
+// This function also acts as a full memory barrier. It can be used with
+// wxUint32 and pointer values.
+// ----------------------------------------------------------------------------
+
+#if !wxUSE_THREADS
+
+template <typename T>
+inline bool wxAtomicCompareExchange(T volatile& value, T oldValue, T newValue)
+{
+    if ( value != oldValue )
+        return false;
+
+    value = newValue;
+    return true;
+}
+
+#elif defined(HAVE_GCC_ATOMIC_BUILTINS)
+
+template <typename T>
+inline bool wxAtomicCompareExchange(T volatile& value, T oldValue, T newValue)
+{
+    return __sync_bool_compare_and_swap(&value, oldValue, newValue);
+}
+
+#elif defined(__WINDOWS__)
+
+#include "wx/msw/wrapwin.h"
+
+inline bool
+wxAtomicCompareExchange(wxUint32 volatile& value,
+                        wxUint32 oldValue,
+                        wxUint32 newValue)
+{
+    return static_cast<wxUint32>(::InterlockedCompareExchange
+                                   (
+                                    reinterpret_cast<LONG volatile*>(&value),
+                                    static_cast<LONG>(newValue),
+                                    static_cast<LONG>(oldValue)
+                                   )) == oldValue;
+}
+
+template <typename T>
+inline bool wxAtomicCompareExchange(T* volatile& value, T* oldValue, T* newValue)
+{
+    return ::InterlockedCompareExchangePointer
+             (
+                reinterpret_cast<PVOID volatile*>(&value),
+                newValue,
+                oldValue
+             ) == oldValue;
+}
+
+#else // no atomic operations, use a lock
+
+#include "wx/thread.h"
+
+inline wxCriticalSection& wxGetAtomicOpsCS()
+{
+    static wxCriticalSection s_csAtomicOps;
+    return s_csAtomicOps;
+}
+
+template <typename T>
+inline bool wxAtomicCompareExchange(T volatile& value, T oldValue, T newValue)
+{
+    wxCriticalSectionLocker lock(wxGetAtomicOpsCS());
+
+    if ( value != oldValue )
+        return false;
+
+    value = newValue;
+    return true;
+}
+
+#endif // atomic operations
+
+#endif // _WX_PRIVATE_ATOMIC_H_
@@ -13,6 +13,7 @@
 #include "wx/defs.h"
 
 class WXDLLIMPEXP_FWD_BASE wxLog;
+struct wxPrintfFormatCache;
 
 #if wxUSE_INTL
 #include "wx/hashset.h"
@@ -52,6 +53,12 @@ public:
     wxLocaleUntranslatedStrings untranslatedStrings;
 #endif
 
+    // the cache of the parsed printf format strings, allocated on demand in
+    // src/common/wxprintf.cpp
+    wxPrintfFormatCache *printfFormatCache;
+
+    ~wxThreadSpecificInfo();
+
 #if wxUSE_THREADS
     // Cleans up storage for the current thread. Should be called when a thread
     // is being destroyed. If it's not called, the only bad thing that happens
@@ -60,7 +67,12 @@ public:
 #endif
 
 private:
-    wxThreadSpecificInfo() : logger(NULL), loggingDisabled(false) {}
+    wxThreadSpecificInfo()
+        : logger(NULL),
+          loggingDisabled(false),
+          printfFormatCache(NULL)
+    {
+    }
 };
 
 #define wxThreadInfo wxThreadSpecificInfo::Get()
@@ -18,6 +18,7 @@
 #include "wx/crt.h"
 #include "wx/log.h"
 #include "wx/utils.h"
+#include "wx/vector.h"
 
 #include <limits.h>
 #include <string.h>
@@ -121,6 +122,85 @@ template<> struct wxPrintfStringHelper<wchar_t>
 };
 
 
+// the widest unsigned integer type used by wxPrintfConvSpec
+#ifdef wxLongLong_t
+    typedef wxULongLong_t wxPrintfUInt;
+#else
+    typedef unsigned long wxPrintfUInt;
+#endif
+
+// helper of wxPrintfConvSpec::Process(): returns the absolute value of the
+// argument, interpreting it as unsigned value of type UT if isSigned is false,
+// and sets negative to true if it's a negative signed value
+template<typename T, typename UT>
+inline wxPrintfUInt wxPrintfGetMagnitude(T value, bool isSigned, bool& negative)
+{
+    if ( isSigned && value < 0 )
+    {
+        negative = true;
+        return 0 - static_cast<wxPrintfUInt>(value);
+    }
+
+    negative = false;
+    return static_cast<UT>(value);
+}
+
+// another helper of wxPrintfConvSpec::Process(): formats the given integer
+// value using the specified conversion ('d', 'o', 'x', ...) directly in the
+// output buffer, returns the number of characters written or -1 if there is
+// not enough space
+template<typename CharType>
+int wxPrintfFormatInt(CharType *buf, size_t lenMax,
+                      wxPrintfUInt value, bool negative, CharType conv)
+{
+    unsigned base = 10;
+    const char *digits = "0123456789abcdef";
+    switch ( conv )
+    {
+        case wxT('o'):
+            base = 8;
+            break;
+
+        case wxT('X'):
+            digits = "0123456789ABCDEF";
+            wxFALLTHROUGH;
+
+        case wxT('x'):
+            base = 16;
+            break;
+    }
+
+    // count the characters first to be able to write the digits directly in
+    // their final positions, starting from the least significant one
+    size_t len = negative ? 2 : 1;
+    for ( wxPrintfUInt n = value / base; n; n /= base )
+        len++;
+
+    if ( len > lenMax )
+    {
+        // fill the output buffer with as much as fits into it for consistency
+        // with the other conversions and then return -1
+        CharType full[2 + sizeof(wxPrintfUInt)*3];
+        wxPrintfFormatInt(full, WXSIZEOF(full), value, negative, conv);
+        wxStrncpy(buf, full, lenMax);
+        return -1;
+    }
+
+    CharType *out = buf + len;
+    do
+    {
+        *--out = digits[value % base];
+        value /= base;
+    }
+    while ( value );
+
+    if ( negative )
+        *--out = wxT('-');
+
+    return len;
+}
+
+
 // Contains parsed data relative to a conversion specifier given to
 // wxCRT_VsnprintfW and parsed from the format string
 // NOTE: in C++ there is almost no difference between struct & classes thus
@@ -144,6 +224,10 @@ public:
     // does the argument need to the be aligned to left ?
     bool m_bAlignLeft;
 
+    // is this an integer conversion without any flags, width or precision
+    // which can be formatted directly, without using sprintf() ?
+    bool m_bPlainInt;
+
     // pointer to the '%' of this conversion specifier in the format string
     // NOTE: this points somewhere in the string given to the Parse() function -
     //       it's task of the caller ensure that memory is still valid !
@@ -192,6 +276,7 @@ void wxPrintfConvSpec<CharType>::Init()
     m_nMaxWidth = INT_MAX;
     m_pos = 0;
     m_bAlignLeft = false;
+    m_bPlainInt = false;
     m_pArgPos = m_pArgEnd = NULL;
     m_type = wxPAT_INVALID;
 
@@ -209,10 +294,11 @@ bool wxPrintfConvSpec<CharType>::Parse(const CharType *format)
     // temporary parse data
     size_t flagofs = 1;
     bool in_prec,       // true if we found the dot in some previous iteration
-         prec_dot;      // true if the dot has been already added to m_szFlags
+         prec_dot,      // true if the dot has been already added to m_szFlags
+         has_flags;     // true if we found anything but the length modifiers
     int ilen = 0;
 
-    m_bAlignLeft = in_prec = prec_dot = false;
+    m_bAlignLeft = in_prec = prec_dot = has_flags = false;
     m_pArgPos = m_pArgEnd = format;
     do
     {
@@ -239,11 +325,13 @@ bool wxPrintfConvSpec<CharType>::Parse(const CharType *format)
             case wxT('+'):
             case wxT('\''):
                 CHECK_PREC
+                has_flags = true;
                 m_szFlags[flagofs++] = char(ch);
                 break;
 
             case wxT('-'):
                 CHECK_PREC
+                has_flags = true;
                 m_bAlignLeft = true;
                 m_szFlags[flagofs++] = char(ch);
                 break;
@@ -256,6 +344,7 @@ bool wxPrintfConvSpec<CharType>::Parse(const CharType *format)
                     m_szFlags[flagofs++] = '.';
                 in_prec = true;
                 prec_dot = false;
+                has_flags = true;
                 m_nMaxWidth = 0;
                 // dot will be auto-added to m_szFlags if non-negative
                 // number follows
@@ -315,6 +404,7 @@ bool wxPrintfConvSpec<CharType>::Parse(const CharType *format)
                 break;
 
             case wxT('*'):
+                has_flags = true;
                 if (in_prec)
                 {
                     CHECK_PREC
@@ -341,6 +431,7 @@ bool wxPrintfConvSpec<CharType>::Parse(const CharType *format)
                 {
                     int len = 0;
                     CHECK_PREC
+                    has_flags = true;
                     while ( (*m_pArgEnd >= CharType('0')) &&
                             (*m_pArgEnd <= CharType('9')) )
                     {
@@ -376,6 +467,9 @@ bool wxPrintfConvSpec<CharType>::Parse(const CharType *format)
 
                     m_pos = m_nMinWidth;
                     m_nMinWidth = 0;
+
+                    // the digits were not really a width
+                    has_flags = false;
                 }
                 break;
 
@@ -404,6 +498,10 @@ bool wxPrintfConvSpec<CharType>::Parse(const CharType *format)
 #endif // wxLongLong_t/!wxLongLong_t
                 else if (ilen == 3)
                     m_type = wxPAT_SIZET;
+
+                // 'h' modifier requires truncating the value to short, don't
+                // bother with it and just let sprintf() handle it
+                m_bPlainInt = !has_flags && ilen != -1;
                 done = true;
                 break;
 
@@ -627,6 +725,48 @@ int wxPrintfConvSpec<CharType>::Process(CharType *buf, size_t lenMax, wxPrintfAr
     char szScratch[wxMAX_SVNPRINTF_SCRATCHBUFFER_LEN];
     size_t lenScratch = 0, lenCur = 0;
 
+    // integers without any flags are formatted directly in the output buffer
+    // as this is much faster than using sprintf() and copying its output and
+    // the result doesn't depend on the locale anyhow
+    if ( m_bPlainInt )
+    {
+        const CharType conv = *m_pArgEnd;
+        const bool isSigned = conv == wxT('d') || conv == wxT('i');
+
+        wxPrintfUInt value = 0;
+        bool negative = false;
+        switch ( m_type )
+        {
+            case wxPAT_INT:
+                value = wxPrintfGetMagnitude<int, unsigned int>
+                        (p->pad_int, isSigned, negative);
+                break;
+
+            case wxPAT_LONGINT:
+                value = wxPrintfGetMagnitude<long, unsigned long>
+                        (p->pad_longint, isSigned, negative);
+                break;
+
+#ifdef wxLongLong_t
+            case wxPAT_LONGLONGINT:
+                value = wxPrintfGetMagnitude<wxLongLong_t, wxULongLong_t>
+                        (p->pad_longlongint, isSigned, negative);
+                break;
+#endif // wxLongLong_t
+
+            case wxPAT_SIZET:
+                value = wxPrintfGetMagnitude<ssize_t, size_t>
+                        (static_cast<ssize_t>(p->pad_sizet), isSigned, negative);
+                break;
+
+            default:
+                wxFAIL_MSG( "unexpected plain integer conversion type" );
+                return -1;
+        }
+
+        return wxPrintfFormatInt(buf, lenMax, value, negative, conv);
+    }
+
 #define APPEND_CH(ch) \
                 { \
                     if ( lenCur == lenMax ) \
@@ -790,6 +930,65 @@ int wxPrintfConvSpec<CharType>::Process(CharType *buf, size_t lenMax, wxPrintfAr
 }
 
 
+template<typename CharType> struct wxPrintfConvSpecParser;
+
+// Parsing the format string is relatively expensive and the same format
+// strings are typically used again and again, so the results of parsing them
+// are cached in a per-thread cache, see wxThreadSpecificInfo.
+//
+// The cache is indexed by the address of the format string, as the format
+// strings are usually literals and so the same string always has the same
+// address. But as the same memory may be reused for a different string, we
+// also keep a copy of the format string to check that it didn't change.
+template<typename CharType>
+struct wxPrintfCacheEntry
+{
+    wxPrintfCacheEntry() : format(NULL) { }
+
+    // the cached format string address or NULL if the entry is unused
+    const CharType *format;
+
+    // copy of the format string, including the trailing NUL
+    wxVector<CharType> copy;
+
+    // wxPrintfConvSpecParser fields
+    wxVector< wxPrintfConvSpec<CharType> > specs;
+    wxVector<int> args; // index in specs for each argument or -1
+    bool posarg_present,
+         nonposarg_present;
+};
+
+// number of entries in the cache, must be a power of 2
+const size_t wxPRINTF_CACHE_SIZE = 64;
+
+template<typename CharType>
+struct wxPrintfCache
+{
+    wxPrintfCacheEntry<CharType> entries[wxPRINTF_CACHE_SIZE];
+};
+
+struct wxPrintfFormatCache
+{
+    wxPrintfCache<char> cacheChar;
+    wxPrintfCache<wchar_t> cacheWChar;
+};
+
+// These functions are implemented in src/common/wxprintf.cpp and are
+// thread-safe as they only use the cache of the current thread.
+
+// Fill the parser with the results of parsing the given format string if it
+// is in the cache and return true or just return false if it isn't.
+bool wxGetCachedPrintfFormat(const char *fmt,
+                             wxPrintfConvSpecParser<char>& parser);
+bool wxGetCachedPrintfFormat(const wchar_t *fmt,
+                             wxPrintfConvSpecParser<wchar_t>& parser);
+
+// Store the results of parsing the given format string in the cache.
+void wxCachePrintfFormat(const char *fmt,
+                         const wxPrintfConvSpecParser<char>& parser);
+void wxCachePrintfFormat(const wchar_t *fmt,
+                         const wxPrintfConvSpecParser<wchar_t>& parser);
+
 // helper that parses format string
 template<typename CharType>
 struct wxPrintfConvSpecParser
@@ -797,6 +996,21 @@ struct wxPrintfConvSpecParser
     typedef wxPrintfConvSpec<CharType> ConvSpec;
 
     wxPrintfConvSpecParser(const CharType *fmt)
+    {
+        if ( wxGetCachedPrintfFormat(fmt, *this) )
+            return;
+
+        Parse(fmt);
+
+        // don't cache the format strings using too many arguments, which is
+        // an error that should be reported every time
+        if ( nspecs < wxMAX_SVNPRINTF_ARGUMENTS )
+            wxCachePrintfFormat(fmt, *this);
+    }
+
+    // parse the format string, this is called by the ctor and shouldn't be
+    // called directly
+    void Parse(const CharType *fmt)
     {
         nspecs =
         nargs = 0;
@@ -331,7 +331,7 @@ public:
     virtual void DeleteWindows();
 
     // Enable deleting the SizerItem without destroying the contained sizer.
-    void DetachSizer() { m_sizer = NULL; }
+    void DetachSizer();
 
     // Enable deleting the SizerItem without resetting the sizer in the
     // contained window.
@@ -354,6 +354,7 @@ public:
         if ( IsWindow() )
             m_window->SetMinSize(size);
         m_minSize = size;
+        InvalidateContainingSizer();
     }
     void SetMinSize( int x, int y )
         { SetMinSize(wxSize(x, y)); }
@@ -363,11 +364,11 @@ public:
     // if either of dimensions is zero, ratio is assumed to be 1
     // to avoid "divide by zero" errors
     void SetRatio(int width, int height)
-        { m_ratio = (width && height) ? ((float) width / (float) height) : 1; }
+        { SetRatio((width && height) ? ((float) width / (float) height) : 1); }
     void SetRatio(const wxSize& size)
         { SetRatio(size.x, size.y); }
     void SetRatio(float ratio)
-        { m_ratio = ratio; }
+        { m_ratio = ratio; InvalidateContainingSizer(); }
     float GetRatio() const
         { return m_ratio; }
 
@@ -383,15 +384,15 @@ public:
     bool IsSpacer() const { return m_kind == Item_Spacer; }
 
     void SetProportion( int proportion )
-        { m_proportion = proportion; }
+        { m_proportion = proportion; InvalidateContainingSizer(); }
     int GetProportion() const
         { return m_proportion; }
     void SetFlag( int flag )
-        { m_flag = flag; }
+        { m_flag = flag; InvalidateContainingSizer(); }
     int GetFlag() const
         { return m_flag; }
     void SetBorder( int border )
-        { m_border = border; }
+        { m_border = border; InvalidateContainingSizer(); }
     int GetBorder() const
         { return m_border; }
 
@@ -401,6 +402,13 @@ public:
         { return m_kind == Item_Sizer ? m_sizer : NULL; }
     wxSize GetSpacer() const;
 
+    // get the sizer this item is in, if any
+    wxSizer *GetContainingSizer() const { return m_containingSizer; }
+
+    // for internal use only: this is called by wxSizer when the item is
+    // added to it
+    void SetContainingSizer(wxSizer *sizer) { m_containingSizer = sizer; }
+
     // This function behaves obviously for the windows and spacers but for the
     // sizers it returns true if any sizer element is shown and only returns
     // false if all of them are hidden. Also, it always returns true if
@@ -428,18 +436,21 @@ public:
     {
         Free();
         DoSetWindow(window);
+        InvalidateContainingSizer();
     }
 
     void AssignSizer(wxSizer *sizer)
     {
         Free();
         DoSetSizer(sizer);
+        InvalidateContainingSizer();
     }
 
     void AssignSpacer(const wxSize& size)
     {
         Free();
         DoSetSpacer(size);
+        InvalidateContainingSizer();
     }
 
     void AssignSpacer(int w, int h) { AssignSpacer(wxSize(w, h)); }
@@ -455,7 +466,7 @@ public:
 
 protected:
     // common part of several ctors
-    void Init() { m_userData = NULL; m_kind = Item_None; }
+    void Init() { m_userData = NULL; m_kind = Item_None; m_containingSizer = NULL; }
 
     // common part of ctors taking wxSizerFlags
     void Init(const wxSizerFlags& flags);
@@ -472,6 +483,10 @@ protected:
     // if it's != wxDefaultSize, just return wxDefaultSize otherwise.
     wxSize AddBorderToSize(const wxSize& size) const;
 
+    // must be called whenever anything affecting the layout of this item
+    // changes to let the sizer containing it know about it
+    void InvalidateContainingSizer();
+
     // discriminated union: depending on m_kind one of the fields is valid
     enum
     {
@@ -505,6 +520,9 @@ protected:
 
     wxObject    *m_userData;
 
+    // the sizer this item is in, may be NULL
+    wxSizer     *m_containingSizer;
+
 private:
     wxDECLARE_CLASS(wxSizerItem);
     wxDECLARE_NO_COPY_CLASS(wxSizerItem);
@@ -520,7 +538,13 @@ WX_DECLARE_EXPORTED_LIST( wxSizerItem, wxSizerItemList );
 class WXDLLIMPEXP_CORE wxSizer: public wxObject, public wxClientDataContainer
 {
 public:
-    wxSizer() { m_containingWindow = NULL; }
+    wxSizer()
+    {
+        m_containingWindow = NULL;
+        m_containingItem = NULL;
+        m_cachedMinSize = wxDefaultSize;
+        m_cachedMinSizePass = 0;
+    }
     virtual ~wxSizer();
 
     // methods for adding elements to the sizer: there are Add/Insert/Prepend
@@ -616,6 +640,9 @@ public:
     void SetContainingWindow(wxWindow *window);
     wxWindow *GetContainingWindow() const { return m_containingWindow; }
 
+    // get the sizer item containing this sizer if it's nested in another one
+    wxSizerItem *GetContainingItem() const { return m_containingItem; }
+
     virtual bool Remove( wxSizer *sizer );
     virtual bool Remove( int index );
 
@@ -669,6 +696,13 @@ public:
     // Calculate the minimal size or return m_minSize if bigger.
     wxSize GetMinSize();
 
+    // The minimal size is cached during Layout() and this function discards
+    // the cached value, which happens automatically whenever the sizer items
+    // or the windows in them change. This function also invalidates the
+    // minimal size of the sizers containing this one and of the window it is
+    // used in.
+    void InvalidateMinSize();
+
     // These virtual functions are used by the layout algorithm: first
     // CalcMin() is called to calculate the minimal size of the sizer and
     // prepare for laying it out and then RepositionChildren() is called with
@@ -718,7 +752,8 @@ public:
 
         // This call is required for wxWrapSizer to be able to calculate its
         // minimal size correctly.
-        InformFirstDirection(wxHORIZONTAL, size.x, size.y);
+        if ( InformFirstDirection(wxHORIZONTAL, size.x, size.y) )
+            InvalidateMinSize();
     }
     void SetDimension(int x, int y, int width, int height)
         { SetDimension(wxPoint(x, y), wxSize(width, height)); }
@@ -757,6 +792,11 @@ public:
     // items are shown.
     virtual bool AreAnyItemsShown() const;
 
+    // For internal use only: same as InvalidateMinSize() but doesn't
+    // invalidate the best size of the containing window, this is used by
+    // wxWindow::InvalidateBestSize() itself.
+    void WXInvalidateCachedMinSize() { DoInvalidateMinSize(); }
+
 protected:
     wxSize              m_size;
     wxSize              m_minSize;
@@ -780,6 +820,27 @@ protected:
     virtual wxSizerItem* DoInsert(size_t index, wxSizerItem *item);
 
 private:
+    // invalidate the cached minimal size of this sizer and all the sizers
+    // containing it and return the outermost one
+    wxSizer *DoInvalidateMinSize();
+
+    // return true if m_cachedMinSize can be used instead of calling CalcMin()
+    bool IsMinSizeCached() const;
+
+    // the item containing this sizer if it's nested in another one, or NULL
+    wxSizerItem *m_containingItem;
+
+    // the result of the last call to CalcMin() or wxDefaultSize if it needs
+    // to be called again
+    wxSize m_cachedMinSize;
+
+    // the layout pass during which m_cachedMinSize was computed: it is only
+    // used until the end of this pass, as CalcMin() of custom sizers may
+    // depend on anything and not call InvalidateMinSize() when it changes
+    unsigned m_cachedMinSizePass;
+
+    friend class wxSizerItem;
+
     wxDECLARE_CLASS(wxSizer);
 };
 
@@ -806,16 +867,18 @@ public:
     {
         wxASSERT_MSG( cols >= 0, "Number of columns must be non-negative");
         m_cols = cols;
+        InvalidateMinSize();
     }
 
     void SetRows( int rows )
     {
         wxASSERT_MSG( rows >= 0, "Number of rows must be non-negative");
         m_rows = rows;
+        InvalidateMinSize();
     }
 
-    void SetVGap( int gap )     { m_vgap = gap; }
-    void SetHGap( int gap )     { m_hgap = gap; }
+    void SetVGap( int gap )     { m_vgap = gap; InvalidateMinSize(); }
+    void SetHGap( int gap )     { m_hgap = gap; InvalidateMinSize(); }
     int GetCols() const         { return m_cols; }
     int GetRows() const         { return m_rows; }
     int GetVGap() const         { return m_vgap; }
@@ -917,12 +980,14 @@ public:
     // grow in one direction but not the other
 
     // the direction may be wxVERTICAL, wxHORIZONTAL or wxBOTH (default)
-    void SetFlexibleDirection(int direction) { m_flexDirection = direction; }
+    void SetFlexibleDirection(int direction)
+        { m_flexDirection = direction; InvalidateMinSize(); }
     int GetFlexibleDirection() const { return m_flexDirection; }
 
     // note that the grow mode only applies to the direction which is not
     // flexible
-    void SetNonFlexibleGrowMode(wxFlexSizerGrowMode mode) { m_growMode = mode; }
+    void SetNonFlexibleGrowMode(wxFlexSizerGrowMode mode)
+        { m_growMode = mode; InvalidateMinSize(); }
     wxFlexSizerGrowMode GetNonFlexibleGrowMode() const { return m_growMode; }
 
     // Read-only access to the row heights and col widths arrays
@@ -982,7 +1047,7 @@ public:
 
     bool IsVertical() const { return m_orient == wxVERTICAL; }
 
-    void SetOrientation(int orient) { m_orient = orient; }
+    void SetOrientation(int orient) { m_orient = orient; InvalidateMinSize(); }
 
     // implementation of our resizing logic
     virtual wxSize CalcMin() wxOVERRIDE;
@@ -32,6 +32,7 @@ public:
     // overridden base class virtuals
     virtual bool HasTransparentBackground() wxOVERRIDE { return true; }
     virtual bool Enable(bool enable = true) wxOVERRIDE;
+    virtual void SetLabel(const wxString& label) wxOVERRIDE;
 
     // implementation only: this is used by wxStaticBoxSizer to account for the
     // need for extra space taken by the static box
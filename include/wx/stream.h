@@ -136,6 +136,17 @@ public:
     // when EOF is reached or an error occurs
     wxInputStream& Read(wxOutputStream& streamOut);
 
+    // return a pointer to the data following the current position without
+    // copying it, and the number of bytes available there in size
+    //
+    // this only works for the streams keeping all their data in memory, such
+    // as wxMemoryInputStream or a mapped wxMappedFileInputStream, and returns
+    // NULL for all the others, which must be read using Read() as usual
+    //
+    // the data remains valid until the stream is destroyed and doesn't change
+    // the stream position, use SeekI(n, wxFromCurrent) to consume it
+    const void *PeekContiguous(size_t *size);
+
 
     // status functions
     // ----------------
@@ -200,6 +211,10 @@ protected:
     // read
     virtual size_t OnSysRead(void *buffer, size_t size) = 0;
 
+    // return the data at the current position if the stream has it in memory,
+    // the default implementation returns NULL
+    virtual const void *OnSysPeekContiguous(size_t *size);
+
     // write-back buffer support
     // -------------------------
 
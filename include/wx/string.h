@@ -73,6 +73,16 @@
     #endif
 #endif // wxUSE_STRING_POS_CACHE
 
+// in UTF-8 build we also maintain a sparse index of the byte offsets of every
+// wxString::PosIndex::STEP-th character of long strings: unlike the cache
+// above, which only helps with (mostly) sequential access, it makes the cost
+// of finding the offset of any character independent of the string length
+// and of the order in which the characters are accessed; it is built only
+// when needed, so predefine this symbol as 0 to disable it completely
+#ifndef wxUSE_STRING_POS_INDEX
+    #define wxUSE_STRING_POS_INDEX wxUSE_UNICODE_UTF8
+#endif
+
 class WXDLLIMPEXP_FWD_BASE wxString;
 
 // unless this symbol is predefined to disable the compatibility functions, do
@@ -436,6 +446,66 @@ private:
   static SubstrBufFromWC ImplStr(const wchar_t* str, size_t n)
     { return ConvertStr(str, n, wxMBConvUTF8()); }
 
+#if wxUSE_STRING_POS_INDEX
+  // this is the index of the offsets of every STEP-th character in m_impl,
+  // only used for the strings of at least MIN_LEN bytes: it is built for the
+  // entire string at once, the first time a position in it is looked up by a
+  // method not modifying the string, and never changes after this, so the
+  // same string can still be read by several threads concurrently; it is
+  // freed when the string is modified or destroyed
+  struct PosIndex
+  {
+      enum
+      {
+          STEP = 64,        // distance between the indexed characters
+          MIN_LEN = 256     // don't bother with the index for short strings
+      };
+
+      // the number of entries, which are allocated together with the struct
+      size_t count;
+
+      // the entry n contains the offset of the character n*STEP
+      size_t offsets[1];
+  };
+
+  // check if using the index is worth it for this string
+  bool ShouldUsePosIndex() const
+    { return m_impl.length() >= PosIndex::MIN_LEN; }
+
+  // return the index of this string if it already exists, otherwise build it
+  // if canBuild is true or return NULL
+  const PosIndex *GetPosIndex(bool canBuild) const
+  {
+      const PosIndex * const index = m_posIndex.ptr;
+      return index || !canBuild ? index : DoBuildPosIndex();
+  }
+
+  // build the index and store it unless another thread has already done it,
+  // return the stored index or NULL if there is not enough memory for it
+  const PosIndex *DoBuildPosIndex() const;
+
+  // return the offset of the given position using the index, fromPos must be
+  // less or equal to pos and fromImpl is its known offset
+  size_t DoPosToImplUsingIndex(const PosIndex *index,
+                               size_t pos,
+                               size_t fromPos = 0,
+                               size_t fromImpl = 0) const;
+
+  // return the position corresponding to the given offset
+  size_t DoPosFromImplUsingIndex(const PosIndex *index, size_t impl) const;
+
+  void InvalidatePosIndex()
+  {
+      if ( m_posIndex.ptr )
+      {
+          free(m_posIndex.ptr);
+          m_posIndex.ptr = NULL;
+      }
+  }
+#else // !wxUSE_STRING_POS_INDEX
+  void InvalidatePosIndex() { }
+#endif // wxUSE_STRING_POS_INDEX/!wxUSE_STRING_POS_INDEX
+
 #if wxUSE_STRING_POS_CACHE
   // this is an extremely simple cache used by PosToImpl(): each cache element
   // contains the string it applies to and the index corresponding to the last
@@ -623,7 +693,7 @@ private:
 #endif
   }
 
-  size_t DoPosToImpl(size_t pos) const
+  size_t DoPosToImpl(size_t pos, bool canBuildIndex) const
   {
       wxCACHE_PROFILE_FIELD_INC(postot);
 
@@ -659,6 +729,26 @@ private:
 
       wxCACHE_PROFILE_FIELD_ADD(sumofs, pos - cache->pos);
 
+#if wxUSE_STRING_POS_INDEX
+      // don't iterate over many characters if we can avoid it
+      if ( pos - cache->pos > PosIndex::STEP && ShouldUsePosIndex() )
+      {
+          const PosIndex * const index = GetPosIndex(canBuildIndex);
+          if ( index )
+          {
+              cache->impl = DoPosToImplUsingIndex(index, pos,
+                                                  cache->pos, cache->impl);
+              cache->pos = pos;
+
+              wxSTRING_CACHE_ASSERT(
+                  (int)cache->impl == (begin() + pos).impl() - m_impl.begin() );
+
+              return cache->impl;
+          }
+      }
+#else // !wxUSE_STRING_POS_INDEX
+      wxUnusedVar(canBuildIndex);
+#endif // wxUSE_STRING_POS_INDEX/!wxUSE_STRING_POS_INDEX
 
       wxStringImpl::const_iterator i(m_impl.begin() + cache->impl);
       for ( size_t n = cache->pos; n < pos; n++ )
@@ -675,6 +765,8 @@ private:
 
   void InvalidateCache()
   {
+      InvalidatePosIndex();
+
       Cache::Element * const cache = FindCacheElement();
       if ( cache )
           cache->Reset();
@@ -682,6 +774,8 @@ private:
 
   void InvalidateCachedLength()
   {
+      InvalidatePosIndex();
+
       Cache::Element * const cache = FindCacheElement();
       if ( cache )
           cache->len = npos;
@@ -689,6 +783,8 @@ private:
 
   void SetCachedLength(size_t len)
   {
+      InvalidatePosIndex();
+
       // we optimistically cache the length here even if the string wasn't
       // present in the cache before, this seems to do no harm and the
       // potential for avoiding length recomputation for long strings looks
@@ -698,6 +794,8 @@ private:
 
   void UpdateCachedLength(ptrdiff_t delta)
   {
+      InvalidatePosIndex();
+
       Cache::Element * const cache = FindCacheElement();
       if ( cache && cache->len != npos )
       {
@@ -712,23 +810,60 @@ private:
   #define wxSTRING_UPDATE_CACHED_LENGTH(n) UpdateCachedLength(n)
   #define wxSTRING_SET_CACHED_LENGTH(n) SetCachedLength(n)
 #else // !wxUSE_STRING_POS_CACHE
-  size_t DoPosToImpl(size_t pos) const
+  size_t DoPosToImpl(size_t pos, bool canBuildIndex) const
   {
+#if wxUSE_STRING_POS_INDEX
+      if ( pos > PosIndex::STEP && ShouldUsePosIndex() )
+      {
+          const PosIndex * const index = GetPosIndex(canBuildIndex);
+          if ( index )
+              return DoPosToImplUsingIndex(index, pos);
+      }
+#else // !wxUSE_STRING_POS_INDEX
+      wxUnusedVar(canBuildIndex);
+#endif // wxUSE_STRING_POS_INDEX/!wxUSE_STRING_POS_INDEX
+
       return (begin() + pos).impl() - m_impl.begin();
   }
 
-  #define wxSTRING_INVALIDATE_CACHE()
-  #define wxSTRING_INVALIDATE_CACHED_LENGTH()
-  #define wxSTRING_UPDATE_CACHED_LENGTH(n)
-  #define wxSTRING_SET_CACHED_LENGTH(n)
+  // there is no cache, but the index still needs to be invalidated whenever
+  // the string changes
+  void InvalidateCache() { InvalidatePosIndex(); }
+
+  #define wxSTRING_INVALIDATE_CACHE() InvalidateCache()
+  #define wxSTRING_INVALIDATE_CACHED_LENGTH() InvalidateCache()
+  #define wxSTRING_UPDATE_CACHED_LENGTH(n) InvalidateCache()
+  #define wxSTRING_SET_CACHED_LENGTH(n) InvalidateCache()
 #endif // wxUSE_STRING_POS_CACHE/!wxUSE_STRING_POS_CACHE
 
+  // the const overloads are used by the methods not modifying the string and
+  // may build the positions index, while the non-const ones are used by the
+  // modifying methods and only use the index if it already exists, as it's
+  // going to be freed by the modification anyhow
   size_t PosToImpl(size_t pos) const
   {
-      return pos == 0 || pos == npos ? pos : DoPosToImpl(pos);
+      return pos == 0 || pos == npos ? pos : DoPosToImpl(pos, true);
+  }
+
+  size_t PosToImpl(size_t pos)
+  {
+      return pos == 0 || pos == npos ? pos : DoPosToImpl(pos, false);
+  }
+
+  void PosLenToImpl(size_t pos, size_t len,
+                    size_t *implPos, size_t *implLen) const
+  {
+      DoPosLenToImpl(pos, len, implPos, implLen, true);
   }
 
-  void PosLenToImpl(size_t pos, size_t len, size_t *implPos, size_t *implLen) const;
+  void PosLenToImpl(size_t pos, size_t len, size_t *implPos, size_t *implLen)
+  {
+      DoPosLenToImpl(pos, len, implPos, implLen, false);
+  }
+
+  void DoPosLenToImpl(size_t pos, size_t len,
+                      size_t *implPos, size_t *implLen,
+                      bool canBuildIndex) const;
 
   size_t LenToImpl(size_t len) const
   {
@@ -741,8 +876,17 @@ private:
   {
       if ( pos == 0 || pos == npos )
           return pos;
-      else
-          return const_iterator(this, m_impl.begin() + pos) - begin();
+
+#if wxUSE_STRING_POS_INDEX
+      if ( pos > PosIndex::STEP && ShouldUsePosIndex() )
+      {
+          const PosIndex * const index = GetPosIndex(true);
+          if ( index )
+              return DoPosFromImplUsingIndex(index, pos);
+      }
+#endif // wxUSE_STRING_POS_INDEX
+
+      return const_iterator(this, m_impl.begin() + pos) - begin();
   }
 #endif // !wxUSE_UNICODE_UTF8/wxUSE_UNICODE_UTF8
 
@@ -960,7 +1104,12 @@ public:
   };
 
   iterator GetIterForNthChar(size_t n)
-    { return iterator(this, m_impl.begin() + PosToImpl(n)); }
+  {
+      // this is used for accessing the characters, so it doesn't prevent
+      // the index from being built, even if it's a non-const method
+      const wxString * const self = this;
+      return iterator(this, m_impl.begin() + self->PosToImpl(n));
+  }
   const_iterator GetIterForNthChar(size_t n) const
     { return const_iterator(this, m_impl.begin() + PosToImpl(n)); }
 #else // !wxUSE_UNICODE_UTF8
@@ -1250,15 +1399,16 @@ public:
     { assign(str, nLength); }
 
 
-#if wxUSE_STRING_POS_CACHE
+#if wxUSE_STRING_POS_CACHE || wxUSE_STRING_POS_INDEX
   ~wxString()
   {
       // we need to invalidate our cache entry as another string could be
       // recreated at the same address (unlikely, but still possible, with the
       // heap-allocated strings but perfectly common with stack-allocated ones)
+      // and free the index, if any
       InvalidateCache();
   }
-#endif // wxUSE_STRING_POS_CACHE
+#endif // wxUSE_STRING_POS_CACHE || wxUSE_STRING_POS_INDEX
 
   // even if we're not built with wxUSE_STD_STRING_CONV_IN_WXSTRING == 1 it is
   // very convenient to allow implicit conversions from std::string to wxString
@@ -2468,10 +2618,12 @@ public:
     // append elements str[pos], ..., str[pos+n]
   wxString& append(const wxString& str, size_t pos, size_t n)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(n);
-
       size_t from, len;
       str.PosLenToImpl(pos, n, &from, &len);
+
+      // as in insert() below, str may be the same string as this one
+      wxSTRING_UPDATE_CACHED_LENGTH(n);
+
       m_impl.append(str.m_impl, from, len);
       return *this;
   }
@@ -2682,6 +2834,8 @@ public:
 #endif // wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString& assign(const wxScopedCharBuffer& buf, const wxMBConv& conv)
   {
+      wxSTRING_INVALIDATE_CACHE();
+
       SubstrBufFromMB str(ImplStr(buf.data(), buf.length(), conv));
       m_impl.assign(str.data, str.len);
 
@@ -2769,15 +2923,23 @@ public:
 
     // insert another string
   wxString& insert(size_t nPos, const wxString& str)
-    { insert(GetIterForNthChar(nPos), str.begin(), str.end()); return *this; }
+  {
+      insert(iterator(this, m_impl.begin() + PosToImpl(nPos)),
+             str.begin(), str.end());
+      return *this;
+  }
     // insert n chars of str starting at nStart (in str)
   wxString& insert(size_t nPos, const wxString& str, size_t nStart, size_t n)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(n);
-
       size_t from, len;
       str.PosLenToImpl(nStart, n, &from, &len);
-      m_impl.insert(PosToImpl(nPos), str.m_impl, from, len);
+      const size_t pos = PosToImpl(nPos);
+
+      // do it only now, as str may be this string itself, and the lookups
+      // above could have cached the positions beyond the insertion point
+      wxSTRING_UPDATE_CACHED_LENGTH(n);
+
+      m_impl.insert(pos, str.m_impl, from, len);
 
       return *this;
   }
@@ -2969,14 +3131,15 @@ public:
   wxString& replace(size_t nStart, size_t nLen,
                     const wxString& str, size_t nStart2, size_t nLen2)
   {
-      wxSTRING_INVALIDATE_CACHE();
-
       size_t from, len;
       PosLenToImpl(nStart, nLen, &from, &len);
 
       size_t from2, len2;
       str.PosLenToImpl(nStart2, nLen2, &from2, &len2);
 
+      // as in insert() above, str may be the same string as this one
+      wxSTRING_INVALIDATE_CACHE();
+
       m_impl.replace(from, len, str.m_impl, from2, len2);
 
       return *this;
@@ -3113,13 +3276,13 @@ public:
   // swap two strings
   void swap(wxString& str)
   {
-#if wxUSE_STRING_POS_CACHE
+#if wxUSE_UNICODE_UTF8
       // we modify not only this string but also the other one directly so we
       // need to invalidate cache for both of them (we could also try to
       // exchange their cache entries but it seems unlikely to be worth it)
       InvalidateCache();
       str.InvalidateCache();
-#endif // wxUSE_STRING_POS_CACHE
+#endif // wxUSE_UNICODE_UTF8
 
       m_impl.swap(str.m_impl);
   }
@@ -3714,6 +3877,20 @@ private:
 
   wxStringIteratorNodeHead m_iterators;
 
+#if wxUSE_STRING_POS_INDEX
+  // the index is not copied together with the string, just as m_iterators,
+  // and is set atomically as it may be built by const methods
+  struct PosIndexPtr
+  {
+      PosIndexPtr() : ptr(NULL) {}
+      PosIndex * volatile ptr;
+
+      wxDECLARE_NO_COPY_CLASS(PosIndexPtr);
+  };
+
+  mutable PosIndexPtr m_posIndex;
+#endif // wxUSE_STRING_POS_INDEX
+
   friend class WXDLLIMPEXP_FWD_BASE wxStringIteratorNode;
   friend class WXDLLIMPEXP_FWD_BASE wxUniCharRef;
 #endif // wxUSE_UNICODE_UTF8
@@ -3989,7 +4166,12 @@ public:
     wxStringInternalBuffer(wxString& str, size_t lenWanted = 1024)
         : wxStringTypeBufferBase<wxStringCharType>(str, lenWanted) {}
     ~wxStringInternalBuffer()
-        { m_str.m_impl.assign(m_buf.data()); }
+    {
+        m_str.m_impl.assign(m_buf.data());
+#if wxUSE_UNICODE_UTF8
+        m_str.InvalidateCache();
+#endif // wxUSE_UNICODE_UTF8
+    }
 
     wxDECLARE_NO_COPY_CLASS(wxStringInternalBuffer);
 };
@@ -4004,6 +4186,9 @@ public:
     ~wxStringInternalBufferLength()
     {
         m_str.m_impl.assign(m_buf.data(), m_len);
+#if wxUSE_UNICODE_UTF8
+        m_str.InvalidateCache();
+#endif // wxUSE_UNICODE_UTF8
     }
 
     wxDECLARE_NO_COPY_CLASS(wxStringInternalBufferLength);
@@ -68,6 +68,9 @@ public:
 
     virtual bool HasTransparentBackground() wxOVERRIDE;
 
+    virtual bool BeginRepositioningChildren() wxOVERRIDE;
+    virtual void EndRepositioningChildren() wxOVERRIDE;
+
     wxNonOwnedWindow* GetTopLevelWindow();
 
     bool NeedsPaint() const { return m_childNeedsPaint; }
@@ -120,6 +123,11 @@ private:
     bool m_childNeedsPaint;
     bool m_selfNeedsPaint;
 
+    // true between BeginRepositioningChildren() and EndRepositioningChildren()
+    // calls and the area to refresh when the latter is called
+    bool m_repositioningChildren;
+    wxRect m_repositionedRect;
+
     wxDECLARE_DYNAMIC_CLASS(wxWindowWasm);
     wxDECLARE_NO_COPY_CLASS(wxWindowWasm);
 };
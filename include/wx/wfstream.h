@@ -175,6 +175,37 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxFileStream);
 };
 
+// ----------------------------------------------------------------------------
+// wxMappedFileInputStream: wxFileInputStream reading from a memory mapping
+// ----------------------------------------------------------------------------
+
+// Regular files are mapped into memory under Unix, so that PeekContiguous()
+// can return their contents without copying them. Other kinds of files, such
+// as pipes or sockets, and files under the other platforms are read normally.
+class WXDLLIMPEXP_BASE wxMappedFileInputStream : public wxFileInputStream
+{
+public:
+    wxMappedFileInputStream(const wxString& fileName);
+    virtual ~wxMappedFileInputStream();
+
+    bool IsMapped() const { return m_data != NULL; }
+
+    virtual wxFileOffset GetLength() const wxOVERRIDE;
+
+protected:
+    virtual size_t OnSysRead(void *buffer, size_t size) wxOVERRIDE;
+    virtual wxFileOffset OnSysSeek(wxFileOffset pos, wxSeekMode mode) wxOVERRIDE;
+    virtual wxFileOffset OnSysTell() const wxOVERRIDE;
+    virtual const void *OnSysPeekContiguous(size_t *size) wxOVERRIDE;
+
+private:
+    void *m_data;
+    size_t m_length;
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedFileInputStream);
+};
+
 #endif //wxUSE_FILE
 
 #if wxUSE_FFILE
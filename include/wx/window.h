@@ -1098,6 +1098,18 @@ public:
         // return true if window had been frozen and not unthawed yet
     bool IsFrozen() const { return m_freezeCount != 0; }
 
+        // start a layout transaction: Layout() calls for this window and all
+        // its children are deferred until the matching commit
+    void BeginLayoutTransaction();
+
+        // end a layout transaction, laying out all the windows whose layout
+        // was deferred if it was the outermost one
+    void CommitLayoutTransaction();
+
+        // return true if this window or any of its parents is inside a
+        // layout transaction
+    bool IsInLayoutTransaction() const;
+
         // adjust DC for drawing on this window
     virtual void PrepareDC( wxDC & WXUNUSED(dc) ) { }
 
@@ -1499,6 +1511,12 @@ public:
         // lay out the window and its children
     virtual bool Layout();
 
+        // implementation only: if the layout of this window is currently
+        // deferred, remember to do it later and return true, otherwise return
+        // false. Automatic layouts, i.e. those done in response to a size
+        // change, are also deferred while the window is frozen.
+    bool WXDeferLayout(bool automatic = false);
+
         // sizers
     void SetSizer(wxSizer *sizer, bool deleteOld = true );
     void SetSizerAndFit( wxSizer *sizer, bool deleteOld = true );
@@ -1974,10 +1992,28 @@ private:
     wxSize GetDlgUnitBase() const;
 
 
+    // perform all the layouts deferred by WXDeferLayout() which are not
+    // deferred any longer
+    static void LayoutDeferredWindows();
+
+    // check whether the layout deferred by WXDeferLayout() must still be
+    // postponed
+    bool IsLayoutStillDeferred() const;
+
+
     // number of Freeze() calls minus the number of Thaw() calls: we're frozen
     // (i.e. not being updated) if it is positive
     unsigned int m_freezeCount;
 
+    // number of BeginLayoutTransaction() calls minus the number of
+    // CommitLayoutTransaction() ones
+    unsigned int m_layoutTransactionCount;
+
+    // true if this window is in the list of windows with deferred layout and
+    // if its layout was deferred by an explicit Layout() call, respectively
+    bool m_layoutDeferred;
+    bool m_layoutDeferredExplicitly;
+
     wxDECLARE_ABSTRACT_CLASS(wxWindowBase);
     wxDECLARE_NO_COPY_CLASS(wxWindowBase);
     wxDECLARE_EVENT_TABLE();
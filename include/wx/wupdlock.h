@@ -49,5 +49,31 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxWindowUpdateLocker);
 };
 
+// ----------------------------------------------------------------------------
+// wxLayoutTransaction defers the window layout during its lifetime
+// ----------------------------------------------------------------------------
+
+class wxLayoutTransaction
+{
+public:
+    // create an object deferring the layout of the given window and all its
+    // children until it is destroyed, the window must outlive this object
+    explicit wxLayoutTransaction(wxWindow *win) : m_win(win)
+    {
+        win->BeginLayoutTransaction();
+    }
+
+    // dtor performs all the deferred layouts
+    ~wxLayoutTransaction()
+    {
+        m_win->CommitLayoutTransaction();
+    }
+
+private:
+    wxWindow * const m_win;
+
+    wxDECLARE_NO_COPY_CLASS(wxLayoutTransaction);
+};
+
 #endif // _WX_WUPDLOCK_H_
 
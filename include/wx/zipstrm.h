@@ -395,6 +395,20 @@ public:
     wxString WXZIPFIX GetComment();
     int WXZIPFIX GetTotalEntries();
 
+    // Reads the whole central directory of a seekable zip into an index of
+    // the entries keyed on their names, so that FindEntry() can look them up
+    // and OpenEntry() seek straight to them without a sequential scan.
+    bool WXZIPFIX LoadIndex();
+    bool HasIndex() const { return m_index != NULL; }
+
+    // The returned entry is owned by the index and must not be deleted.
+    wxZipEntry *WXZIPFIX FindEntry(const wxString& name,
+                                   wxPathFormat format = wxPATH_NATIVE) const;
+
+    // Reuses the index already loaded by another stream reading the same
+    // archive, skipping the search for the end record and central directory.
+    bool WXZIPFIX ShareIndex(const wxZipInputStream& other);
+
     virtual wxFileOffset GetLength() const wxOVERRIDE { return m_entry.GetSize(); }
 
 protected:
@@ -440,8 +454,11 @@ private:
     bool m_parentSeekable;
     class wxZipWeakLinks *m_weaklinks;
     class wxZipStreamLink *m_streamlink;
+    class wxZipIndex *m_index;
     wxFileOffset m_offsetAdjustment;
     wxFileOffset m_position;
+    wxFileOffset m_centralOffset;
+    wxFileOffset m_centralSize;
     wxUint32 m_signature;
     size_t m_TotalEntries;
     wxString m_Comment;
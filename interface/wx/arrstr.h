@@ -239,6 +239,38 @@ public:
     */
     void Sort(CompareFunction compareFunction);
 
+    /**
+        Sorts the array using the keys returned by wxGetStringSortKey().
+
+        The result is the same as when using Sort() with the comparison
+        function corresponding to the given @a flags, but the key is computed
+        only once for each string instead of doing it during each comparison,
+        which makes this function much faster for the natural or
+        locale-dependent sort order. Moreover, big arrays are sorted using
+        several threads, if available.
+
+        Example:
+        @code
+        wxArrayString files;
+        files.Add("file10.txt");
+        files.Add("File2.txt");
+        files.Add("file1.txt");
+
+        // Now files contains "file1.txt", "File2.txt" and "file10.txt".
+        files.SortByKey(wxSORTKEY_NATURAL);
+        @endcode
+
+        @param flags
+            Combination of wxStringSortKeyFlags elements.
+        @param reverseOrder
+            If @true, sort the array in the reverse order.
+
+        @note This function can't be used with wxSortedArrayString.
+
+        @since 3.1.6
+    */
+    void SortByKey(int flags, bool reverseOrder = false);
+
     /**
         Compares 2 arrays respecting the case. Returns @true if the arrays have
         different number of elements or if the elements don't match pairwise.
@@ -310,6 +342,9 @@ public:
 
         Constructs a sorted array with the same contents as the (possibly
         unsorted) @a array argument.
+
+        Since wxWidgets 3.1.6 all the strings are sorted at once, which is much
+        faster than adding them one by one to the array for big arrays.
     */
     wxSortedArrayString(const wxArrayString& array);
 
@@ -492,6 +527,106 @@ int wxCmpNatural(const wxString& s1, const wxString& s2);
 */
 int wxCmpNaturalGeneric(const wxString& s1, const wxString& s2);
 
+/**
+    Flags for wxGetStringSortKey() and the functions using it.
+
+    @since 3.1.6
+*/
+enum wxStringSortKeyFlags
+{
+    /// Order the strings as wxString::Cmp() does.
+    wxSORTKEY_DEFAULT = 0,
+
+    /// Ignore case, as wxString::CmpNoCase() does.
+    wxSORTKEY_NOCASE  = 1,
+
+    /**
+        Use the collation order of the current locale, as wxStrcoll() does.
+
+        May be combined with wxSORTKEY_NOCASE to ignore case as well.
+     */
+    wxSORTKEY_LOCALE  = 2,
+
+    /**
+        Use the natural order, as wxCmpNaturalGeneric() does.
+
+        This order already ignores case and uses the current locale, so any
+        other flags are ignored when this one is specified.
+     */
+    wxSORTKEY_NATURAL = 4
+};
+
+/**
+    Returns the binary sort key for the given string.
+
+    Comparing the keys of two strings using wxCmpStringSortKeys() gives the
+    same result as comparing the strings themselves with the comparison
+    function corresponding to the given @a flags. As computing the key is
+    roughly as expensive as a single comparison, but comparing the keys is
+    much cheaper than comparing the strings using wxCmpNaturalGeneric() or
+    wxStrcoll(), using the keys is beneficial when each string is compared
+    many times, e.g. when sorting or searching in a sorted container.
+
+    The keys are only valid as long as the current locale doesn't change and
+    their contents is unspecified and may change between wxWidgets versions,
+    so they shouldn't be stored persistently.
+
+    @param str
+        The string to compute the key for.
+    @param flags
+        Combination of wxStringSortKeyFlags elements.
+
+    @see wxGetStringSortOrder(), wxArrayString::SortByKey()
+
+    @since 3.1.6
+*/
+wxCharBuffer wxGetStringSortKey(const wxString& str, int flags = wxSORTKEY_DEFAULT);
+
+/**
+    Compares two keys returned by wxGetStringSortKey().
+
+    Returns a negative value, 0 or a positive value if the first key is,
+    respectively, less than, equal to or greater than the second one.
+
+    Both keys must have been computed using the same flags.
+
+    @since 3.1.6
+*/
+int wxCmpStringSortKeys(const wxCharBuffer& key1, const wxCharBuffer& key2);
+
+/**
+    Computes the order of the strings sorted using their sort keys.
+
+    This function doesn't modify the strings, but fills the @a order array with
+    the indices of the strings in their sorted order, i.e. @c strings[order[0]]
+    is the first string, @c strings[order[1]] the second one and so on. This
+    is useful for sorting the items of controls or any other containers
+    associated with a string, as the data can be reordered using the returned
+    indices.
+
+    The key of each string is computed only once and, if the number of
+    strings is big enough and more than one CPU is available, the keys are
+    computed and sorted using several threads.
+
+    @param strings
+        Pointer to the strings to sort.
+    @param count
+        The number of strings.
+    @param order
+        Array of @a count elements filled with the indices of the strings.
+    @param flags
+        Combination of wxStringSortKeyFlags elements.
+    @param reverseOrder
+        If @true, the order is reversed.
+
+    @since 3.1.6
+*/
+void wxGetStringSortOrder(const wxString* strings,
+                          size_t count,
+                          size_t* order,
+                          int flags = wxSORTKEY_DEFAULT,
+                          bool reverseOrder = false);
+
 
 // ============================================================================
 // Global functions/macros
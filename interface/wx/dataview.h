@@ -299,6 +299,29 @@ public:
     */
     virtual bool HasDefaultCompare() const;
 
+    /**
+        Override this function to return @true if the model doesn't override
+        Compare().
+
+        Sorting many items using Compare() may be slow, as it retrieves the
+        values of both items being compared on each call. If this function
+        returns @true, the generic wxDataViewCtrl implementation may retrieve
+        the value of each item in the sort column only once instead and
+        compare these values directly, in the same way as the default
+        Compare() implementation does, and may also sort big numbers of items
+        using several threads.
+
+        Note that this is only done for the columns containing strings,
+        numbers, dates, booleans or wxDataViewIconText values and the
+        default Compare() is still used for the other ones, so overriding
+        DoCompareValues() doesn't prevent returning @true from this function.
+
+        The default implementation returns @false.
+
+        @since 3.1.6
+    */
+    virtual bool CanCacheSortKeys() const;
+
     /**
         Return true if there is a value in the given column of this item.
 
@@ -3489,6 +3512,14 @@ public:
     */
     virtual wxString GetColumnType( unsigned int col ) const;
 
+    /**
+        Overridden from wxDataViewModel to return @true, as this class uses
+        the default Compare().
+
+        @since 3.1.6
+    */
+    virtual bool CanCacheSortKeys() const;
+
     /**
         Sets the client data associated with the item.
 
@@ -416,10 +416,12 @@ public:
         moment).
 
         QueueEvent() can be used for inter-thread communication from the worker
-        threads to the main thread, it is safe in the sense that it uses
-        locking internally and avoids the problem mentioned in AddPendingEvent()
-        documentation by ensuring that the @a event object is not used by the
-        calling thread any more. Care should still be taken to avoid that some
+        threads to the main thread, it is safe in the sense that it can be
+        called from multiple threads simultaneously and avoids the problem
+        mentioned in AddPendingEvent() documentation by ensuring that the @a
+        event object is not used by the calling thread any more. Since
+        wxWidgets 3.1.6 it also doesn't block the other threads queuing events
+        at the same time, nor the thread processing them. Care should still be taken to avoid that some
         fields of this object are used by it, notably any wxString members of
         the event object must not be shallow copies of another wxString object
         as this would result in them still using the same string buffer behind
@@ -462,6 +464,43 @@ public:
      */
     virtual void QueueEvent(wxEvent *event);
 
+    /**
+        Queue an event replacing the previously queued event with the same key.
+
+        This function is similar to QueueEvent() and can also be called from
+        any thread, but if an event queued using this function with the same
+        @a key is still pending, i.e. hasn't been processed yet, the new event
+        replaces it in the queue instead of being added to it. This is useful
+        for the events reporting the progress of some operation or any other
+        state of which only the latest value matters, as it avoids flooding
+        the main thread with the events which become outdated by the time they
+        are processed.
+
+        Optionally, the frequency of the events with the given key can also be
+        limited by specifying non-zero @a minInterval: in this case, an event
+        is not processed sooner than the given number of milliseconds after
+        the previous event with the same key was, but is kept in the queue
+        (where it can still be replaced by the newer events) until then.
+        Notice that such postponed events may be processed after the events
+        queued after them and that they are only processed when the event loop
+        is running, as wxTimer is used for waking it up when they become due.
+
+        The keys are specific to this event handler and the events with
+        different keys don't affect each other.
+
+        @since 3.1.6
+
+        @param event
+            A heap-allocated event to be queued, this function takes ownership
+            of it. This parameter shouldn't be @c NULL.
+        @param key
+            Arbitrary key identifying the events replacing each other.
+        @param minInterval
+            Minimal interval between processing the events with the same key
+            in milliseconds or 0 to process them as soon as possible.
+     */
+    void QueueCoalescedEvent(wxEvent *event, int key, int minInterval = 0);
+
     /**
         Post an event to be processed later.
 
@@ -0,0 +1,208 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        interface/wx/evtprofiler.h
+// Purpose:     wxEventProfiler class documentation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    Statistics about the calls to a single event handler.
+
+    Objects of this class are returned by wxEventProfiler::GetStats() and
+    can't be created directly.
+
+    A handler is identified by the event table entry or by the Bind() call
+    which connected it, the type of the events it handled and the class of the
+    object handling them, as returned by wxObject::GetClassInfo(). Notice that
+    this class is the most derived class using wxRTTI macros, so it may be
+    one of the base classes of the real class of the object.
+
+    All the times are in microseconds.
+
+    @library{wxbase}
+    @category{events}
+
+    @since 3.1.6
+ */
+class wxEventHandlerStats
+{
+public:
+    /// Return the type of the events processed by this handler.
+    wxEventType GetEventType() const;
+
+    /// Return the name of the class of the events processed by this handler.
+    wxString GetEventClassName() const;
+
+    /// Return the name of the class of the object handling the events.
+    wxString GetHandlerClassName() const;
+
+    /**
+        Return @true if this handler was connected using Bind() or Connect()
+        or @false if it was defined in the static event table.
+     */
+    bool IsDynamic() const;
+
+    /**
+        Return a human-readable string combining all the information
+        identifying this handler.
+     */
+    wxString GetDescription() const;
+
+    /// Return the number of times this handler was called.
+    unsigned long GetCount() const;
+
+    /**
+        Return the total time spent in this handler.
+
+        Notice that this time includes the time taken by any other event
+        handlers called from this one, e.g. when processing nested events.
+     */
+    wxLongLong GetTotalTime() const;
+
+    /// Return the longest time taken by a single call of this handler.
+    wxLongLong GetMaxTime() const;
+
+    /// Return the average time taken by a single call of this handler.
+    wxLongLong GetAverageTime() const;
+
+    /**
+        Return the time not exceeded by the given percentage of calls.
+
+        For example, @c GetPercentile(50) returns the median call time and
+        @c GetPercentile(99) the time exceeded by only 1% of calls.
+
+        The returned value is approximate, as only the distribution of the call
+        times is stored and not the individual times, but is never less than
+        the exact value and exceeds it by at most 25%.
+
+        @param percentile
+            The percentage of calls, between 0 and 100.
+     */
+    wxLongLong GetPercentile(double percentile) const;
+};
+
+/**
+    Collects statistics about the time spent in all event handlers.
+
+    This class can be used for finding the event handlers responsible for the
+    lack of responsiveness of the application without using any external
+    tools. When a profiler is running, the time taken by each call of every
+    event handler, defined in a static event table or connected using Bind(),
+    is measured and the number of calls and their total and maximal duration
+    are recorded for each handler.
+
+    The collected data can be retrieved using GetStats() or formatted as a
+    table using GetReport(). Additionally, the individual calls can be saved
+    in the trace events format of Chrome browser using GetChromeTrace() and
+    visualized by loading them into @c chrome://tracing or any compatible
+    viewer.
+
+    Only a single profiler can be running at any given moment and it is
+    started using Start() and stopped using Stop() or when the profiler is
+    destroyed. These functions must be called from the main thread only, but
+    the handlers called in all threads are profiled. When no profiler is
+    running, the overhead of this class is negligible.
+
+    Example of using this class:
+    @code
+    void MyFrame::OnStartProfiling(wxCommandEvent&)
+    {
+        m_profiler.Reset();
+        m_profiler.Start();
+    }
+
+    void MyFrame::OnStopProfiling(wxCommandEvent&)
+    {
+        m_profiler.Stop();
+
+        wxLogMessage("%s", m_profiler.GetReport());
+
+        wxFile file("events.json", wxFile::write);
+        file.Write(m_profiler.GetChromeTrace());
+    }
+    @endcode
+
+    @library{wxbase}
+    @category{events}
+
+    @since 3.1.6
+ */
+class wxEventProfiler
+{
+public:
+    /**
+        Create a profiler.
+
+        The profiler doesn't collect any data until Start() is called.
+     */
+    wxEventProfiler();
+
+    /**
+        Destroy the profiler, stopping it if it's running.
+     */
+    ~wxEventProfiler();
+
+    /**
+        Start profiling all the event handlers.
+
+        Does nothing if this profiler is already running.
+
+        @return @false if another profiler is already running.
+     */
+    bool Start();
+
+    /**
+        Stop profiling.
+
+        The collected data is preserved and profiling can be resumed later by
+        calling Start() again.
+     */
+    void Stop();
+
+    /// Return @true if this profiler is currently running.
+    bool IsRunning() const;
+
+    /// Discard all the collected data.
+    void Reset();
+
+    /**
+        Set the maximal number of the individual handler calls to store.
+
+        The individual calls are only needed for GetChromeTrace() and storing
+        them requires memory, so their number is limited. By default, up to
+        100000 calls are stored and the subsequent ones are only taken into
+        account for the statistics. Use 0 to disable storing them completely.
+     */
+    void SetMaxTraceEvents(size_t maxEvents);
+
+    /// Return the value set by SetMaxTraceEvents().
+    size_t GetMaxTraceEvents() const;
+
+    /**
+        Return the statistics for all the handlers called while profiling.
+
+        The returned vector is sorted in the order of decreasing total time
+        spent in the handlers.
+     */
+    wxVector<wxEventHandlerStats> GetStats() const;
+
+    /**
+        Return the report with the statistics for all handlers.
+
+        The report is a table with one line per handler, in the same order as
+        used by GetStats(), and is suitable for logging or showing it to the
+        developer, but its exact format is unspecified.
+     */
+    wxString GetReport() const;
+
+    /**
+        Return all the stored handler calls in Chrome trace events format.
+
+        The returned string is a JSON object containing a "complete" event for
+        each stored handler call, see SetMaxTraceEvents(). The timestamps are
+        relative to the creation of the profiler or the last call to Reset().
+     */
+    wxString GetChromeTrace() const;
+};
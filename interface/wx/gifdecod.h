@@ -11,6 +11,10 @@
    @class wxGIFDecoder
 
    An animation decoder supporting animated GIF files.
+
+   Only the compressed data of the frames is kept in memory after loading,
+   the frames are decoded when they are needed and the most recently used
+   decoded frames are cached, see SetCacheSize().
 */
 class  wxGIFDecoder : public wxAnimationDecoder
 {
@@ -28,6 +32,26 @@ public:
     virtual long GetDelay(unsigned int frame) const;
     virtual wxColour GetTransparentColour(unsigned int frame) const;
 
+    /**
+        Sets the maximal amount of memory, in bytes, used for caching the
+        decoded frames.
+
+        The most recently used frame is always kept, even if it is bigger than
+        the given size. The default cache size is 32MB.
+
+        @since 3.1.6
+    */
+    void SetCacheSize(size_t bytes);
+
+    /**
+        Returns the maximal amount of memory used for caching decoded frames.
+
+        @see SetCacheSize()
+
+        @since 3.1.6
+    */
+    size_t GetCacheSize() const;
+
 protected:
     virtual bool DoCanRead(wxInputStream& stream) const;    
 };
@@ -1732,9 +1732,10 @@ public:
         Get the attribute to use for the specified cell.
 
         If wxGridCellAttr::Any is used as @a kind value, this function combines
-        the attributes set for this cell using SetAttr() and those for its row
-        or column (set with SetRowAttr() or SetColAttr() respectively), with
-        the cell attribute having the highest precedence.
+        the attributes set for this cell using SetAttr(), for a block
+        containing it using SetBlockAttr() and those for its row or column
+        (set with SetRowAttr() or SetColAttr() respectively), with the cell
+        attribute having the highest precedence, followed by the block one.
 
         Notice that the caller must call DecRef() on the returned pointer if it
         is non-@NULL. GetAttrPtr() method can be used to do this automatically.
@@ -1782,6 +1783,26 @@ public:
     /// Set attribute for the specified column.
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
+    /**
+        Set attribute for all cells of the specified block.
+
+        The default implementation stores a single entry for the entire block,
+        independently of its size, and adjusts it when rows or columns are
+        inserted or deleted, so it is much more efficient than calling
+        SetAttr() for all cells of a big block. If several blocks containing
+        the same cell have attributes, the most recently set one is used.
+
+        Passing @NULL for @a attr removes the attribute previously set for
+        exactly the same block.
+
+        Notice that the attribute must not define the cell size, i.e. block
+        attributes can't be used to create multicells.
+
+        @since 3.1.6
+     */
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
+
     //@}
 
     /**
@@ -1939,6 +1960,149 @@ public:
     wxString GetCornerLabelValue() const;
 };
 
+/**
+    Base class for the tables retrieving their data from a slow store.
+
+    This class can be used for the tables whose data is too big to be loaded
+    into memory entirely or which takes too long to retrieve, e.g. because it
+    comes from a database or over the network. The data is loaded in chunks of
+    rows by a worker thread, without blocking the GUI, and the cells whose
+    values are not available yet show the placeholder value, see
+    SetPlaceholderValue(). When a chunk becomes available, the rows containing
+    it are refreshed.
+
+    Only the most recently used chunks are kept in memory, see SetCacheSize().
+    The chunk following the visible rows in the direction of scrolling is
+    loaded in advance.
+
+    The derived class must implement LoadRows(), which is called from the
+    worker thread, as well as GetNumberRows(), GetNumberCols() and SetValue().
+
+    The worker thread and the cache of the loaded rows belong to the wxGrid
+    using the table: they are created when the table is associated with the
+    grid and the thread is stopped, waiting for LoadRows() call in progress,
+    if any, to finish, when the grid is destroyed or starts using another
+    table. Hence a table not used by any grid doesn't load anything and only
+    returns the placeholder values, and a table not owned by the grid must
+    not be destroyed while the grid still uses it.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @since 3.1.6
+ */
+class wxGridAsyncTableBase : public wxGridTableBase
+{
+public:
+    /**
+        Default constructor.
+
+        The worker thread is only created when the values are needed for the
+        first time by the grid using this table.
+     */
+    wxGridAsyncTableBase();
+
+    /**
+        Destructor.
+
+        The table must not be used by any wxGrid any more when it is
+        destroyed.
+     */
+    virtual ~wxGridAsyncTableBase();
+
+    /**
+        Load the values of the given rows.
+
+        This function must fill @a values with @a numRows times @a numCols
+        values of the cells in the rows starting from @a firstRow in row-major
+        order.
+
+        Notice that it is called from a worker thread and so must not call any
+        GUI functions and must protect any data shared with the main thread.
+
+        @return @true if the values were loaded or @false on error, in which
+            case the placeholder value continues to be shown for these rows.
+     */
+    virtual bool LoadRows(int firstRow, int numRows, int numCols,
+                          wxArrayString& values) = 0;
+
+    /**
+        Forget all the already loaded values.
+
+        This function can be called when the data in the underlying store
+        changes. The grid using this table is refreshed and the values are
+        loaded again.
+     */
+    void InvalidateCache();
+
+    /**
+        Wait until all the rows requested so far are loaded.
+
+        This function blocks until the worker thread finishes loading all the
+        rows requested so far and makes their values available immediately,
+        without waiting for the next event loop iteration. It can be useful
+        when all the values are needed at once, e.g. for printing or
+        exporting them.
+     */
+    void WaitUntilLoaded();
+
+    /**
+        Return @true if the values of the given row are already available.
+     */
+    bool IsRowAvailable(int row) const;
+
+    /**
+        Set the number of rows loaded by a single LoadRows() call.
+
+        The default chunk size is 100 rows. Changing it invalidates the cache.
+     */
+    void SetChunkSize(int numRows);
+
+    /**
+        Get the number of rows loaded by a single LoadRows() call.
+     */
+    int GetChunkSize() const;
+
+    /**
+        Set the maximal number of rows kept in memory.
+
+        The default cache size is 10000 rows.
+     */
+    void SetCacheSize(int numRows);
+
+    /**
+        Get the maximal number of rows kept in memory.
+     */
+    int GetCacheSize() const;
+
+    /**
+        Set the value shown in the cells whose values are not loaded yet.
+
+        By default the placeholder is empty.
+     */
+    void SetPlaceholderValue(const wxString& value);
+
+    /**
+        Get the value shown in the cells whose values are not loaded yet.
+     */
+    const wxString& GetPlaceholderValue() const;
+
+    /**
+        Return the value of the cell if it's loaded or the placeholder value.
+
+        If the value is not available yet, loading it is started.
+     */
+    virtual wxString GetValue(int row, int col);
+
+    /**
+        Return the values of all cells in the block, using the placeholder
+        value for the cells which are not loaded yet.
+
+        Loading all the missing rows is started and @true is always returned.
+     */
+    virtual bool GetValues(const wxGridBlockCoords& block,
+                           wxArrayString& values);
+};
+
 /**
     Represents coordinates of a grid cell.
 
@@ -2257,6 +2421,78 @@ public:
     iterator end() const;
 };
 
+/**
+    Represents a collection of grid rows or columns that can be iterated over.
+
+    Objects of this class are returned by wxGrid::GetSelectedRowLines() and
+    wxGrid::GetSelectedColLines(). They store the lines as sorted ranges of
+    consecutive lines, so their size doesn't depend on the number of lines,
+    unlike the arrays returned by wxGrid::GetSelectedRows() and
+    wxGrid::GetSelectedCols().
+
+    Iterating over the object yields the line indices in increasing order:
+    @code
+        for ( const int row : grid->GetSelectedRowLines() ) {
+            ... do something with row ...
+        }
+    @endcode
+    Alternatively, the ranges can be examined directly:
+    @code
+        const wxGridLines lines = grid->GetSelectedRowLines();
+        for ( size_t n = 0; n < lines.GetRangesCount(); n++ ) {
+            ... use lines.GetRangeFirst(n) and lines.GetRangeLast(n) ...
+        }
+    @endcode
+
+    @since 3.1.6
+ */
+class wxGridLines
+{
+public:
+    /**
+        Read-only input iterator type.
+
+        This is an opaque type, which satisfies the input iterator
+        requirements and dereferences to the line index.
+     */
+    class iterator
+    {
+        iterator();
+
+        int operator*() const;
+
+        iterator& operator++();
+        iterator operator++(int);
+
+        bool operator==(const iterator& it) const;
+        bool operator!=(const iterator& it) const;
+    };
+
+    /// Default constructor creates an empty object.
+    wxGridLines();
+
+    /// Return iterator corresponding to the first line.
+    iterator begin() const;
+
+    /// Return iterator corresponding to the end of the lines.
+    iterator end() const;
+
+    /// Return true if there are no lines.
+    bool empty() const;
+
+    /// Return the total number of lines.
+    size_t size() const;
+
+    /// Return the number of ranges of consecutive lines.
+    size_t GetRangesCount() const;
+
+    /// Return the first line of the range with the given index.
+    int GetRangeFirst(size_t n) const;
+
+    /// Return the last line of the range with the given index.
+    int GetRangeLast(size_t n) const;
+};
+
 /**
     @class wxGridTableBase
 
@@ -2361,6 +2597,37 @@ public:
      */
     virtual void SetValue(int row, int col, const wxString& value) = 0;
 
+    /**
+        May be overridden to retrieve the values of all cells in a block at
+        once.
+
+        wxGrid calls this function before drawing the cells in the given
+        block. If it returns @true, the values stored in @a values are used
+        when drawing the cells instead of calling GetValue() for each of them.
+        This can be much more efficient for the tables retrieving their data
+        from an external store, e.g. a column-oriented one.
+
+        Notice that this function is only called if the cells being drawn
+        make up most of the block: if the area to redraw consists of several
+        disjoint parts, GetValue() may be used for them instead.
+
+        The default implementation simply returns @false.
+
+        @param block
+            The block of cells to retrieve the values of.
+        @param values
+            The array to fill with the values of all the cells of the block,
+            in row-major order, i.e. the value of the cell (row, col) must be
+            at the index @c (row-top)*width+(col-left).
+        @return
+            @true if the values were retrieved, @false if this is not
+            supported.
+
+        @since 3.1.6
+     */
+    virtual bool GetValues(const wxGridBlockCoords& block,
+                           wxArrayString& values);
+
     /**
         Returns the type of the value in the given cell.
 
@@ -2700,6 +2967,19 @@ public:
      */
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
+    /**
+        Set attribute of all cells of the specified block.
+
+        By default this function is simply forwarded to
+        wxGridCellAttrProvider::SetBlockAttr().
+
+        The table takes ownership of @a attr, i.e. will call DecRef() on it.
+
+        @since 3.1.6
+     */
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
+
     //@}
 
     /**
@@ -4069,6 +4349,40 @@ public:
     */
     void AutoSizeRows(bool setAsMin = true);
 
+    /**
+        Set the number of cells measured when auto-sizing a column or a row.
+
+        By default, all cells of the column or row are measured when
+        auto-sizing it, which can take a long time for columns of big grids.
+        If @a numLines is positive, only the columns or rows having more than
+        4 times this number of cells are measured approximately: only the
+        currently visible cells, the first and last @a numLines cells and the
+        @a numLines cells with the longest values among at most 16 times as
+        many cells evenly distributed over the column or row are used.
+
+        When sampling is used, the measured sizes of the cells are also cached
+        and reused when auto-sizing the same cells again, unless their value or
+        font changes. Only a limited number of the most recently used sizes is
+        kept in this cache.
+
+        @param numLines The number of cells to measure or 0 to measure all of
+            them, which is the default.
+
+        @see GetAutoSizeSampleSize()
+
+        @since 3.1.6
+     */
+    void SetAutoSizeSampleSize(int numLines);
+
+    /**
+        Return the number of cells measured when auto-sizing.
+
+        @see SetAutoSizeSampleSize()
+
+        @since 3.1.6
+     */
+    int GetAutoSizeSampleSize() const;
+
     /**
         Returns the cell fitting mode.
 
@@ -4964,6 +5278,27 @@ public:
      */
     wxGridBlockCoordsVector GetSelectedColBlocks() const;
 
+    /**
+        Returns all the fully selected rows.
+
+        This function returns the same rows as GetSelectedRows(), but as
+        ranges of consecutive rows, so it remains efficient even if a huge
+        number of rows is selected.
+
+        @since 3.1.6
+     */
+    wxGridLines GetSelectedRowLines() const;
+
+    /**
+        Returns all the fully selected columns.
+
+        This function returns the same columns as GetSelectedCols(), but as
+        ranges of consecutive columns.
+
+        @since 3.1.6
+     */
+    wxGridLines GetSelectedColLines() const;
+
     /**
         Returns an array of individually selected cells.
 
@@ -5788,6 +6123,20 @@ public:
     */
     void SetColAttr(int col, wxGridCellAttr* attr);
 
+    /**
+        Sets the cell attributes for all cells in the specified block.
+
+        This is much more efficient than calling SetAttr() for all the cells of
+        a big block, see wxGridCellAttrProvider::SetBlockAttr() for more
+        details.
+
+        The grid takes ownership of the attribute pointer.
+
+        @since 3.1.6
+    */
+    void SetBlockAttr(int topRow, int leftCol, int bottomRow, int rightCol,
+                      wxGridCellAttr *attr);
+
     /**
         Sets the extra margins used around the grid area.
 
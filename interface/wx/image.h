@@ -75,6 +75,29 @@ enum wxImageAlphaBlendMode
     wxIMAGE_ALPHA_BLEND_COMPOSE = 1
 };
 
+/**
+    Layouts of the interleaved pixel buffers used by
+    wxImage::GetPackedPixels() and wxImage::SetPackedPixels().
+
+    @since 3.1.6
+*/
+enum wxImagePackedFormat
+{
+    /// Four bytes per pixel in R, G, B, A order, alpha is not premultiplied.
+    wxIMAGE_PACKED_RGBA = 0,
+
+    /**
+        32 bit words in native byte order with the alpha, red, green and blue
+        components from the most to the least significant byte, and with the
+        colour components premultiplied by alpha.
+
+        This corresponds to B, G, R, A byte order on little endian machines
+        and is the format used by Cairo @c CAIRO_FORMAT_ARGB32 surfaces and
+        Windows 32bpp DIBs.
+     */
+    wxIMAGE_PACKED_ARGB32_PREMULTIPLIED = 1
+};
+
 /**
     Possible values for PNG image type option.
 
@@ -1122,6 +1145,42 @@ public:
     */
     unsigned char* GetAlpha() const;
 
+    /**
+        Copies the pixels of the image to a buffer using interleaved layout.
+
+        wxImage stores RGB and alpha values in separate arrays, while many
+        graphics libraries use interleaved pixels. This function converts
+        between them in a single pass over the image data, which is more
+        efficient than using GetRed(), GetAlpha() and similar functions for
+        every pixel.
+
+        If the image doesn't have alpha channel, all pixels are fully opaque.
+        The image mask, if any, is ignored.
+
+        @param dst
+            The buffer to fill, must be big enough to contain all the rows of
+            @a rect with the given @a stride.
+        @param stride
+            The offset between the starts of two consecutive rows in @a dst,
+            in bytes. If 0, the rows are not padded, i.e. the stride is 4
+            times the width of @a rect.
+        @param format
+            The layout of the pixels in @a dst.
+        @param rect
+            The part of the image to copy, the entire image if empty, which
+            is the default. Must be inside the image.
+
+        @return @true on success or @false if the image is invalid or the
+            rectangle doesn't fit into it.
+
+        @see SetPackedPixels()
+
+        @since 3.1.6
+    */
+    bool GetPackedPixels(unsigned char* dst, int stride = 0,
+                         wxImagePackedFormat format = wxIMAGE_PACKED_RGBA,
+                         const wxRect& rect = wxRect()) const;
+
     /**
         Returns the image data as an array.
 
@@ -1636,6 +1695,36 @@ public:
     */
     void ClearAlpha();
 
+    /**
+        Sets the pixels of the image from a buffer using interleaved layout.
+
+        This is the counterpart of GetPackedPixels(). The alpha values from
+        @a src are only used if the image has alpha channel, call InitAlpha()
+        or SetAlpha() before this function if necessary. For the premultiplied
+        format, the colour components are converted back to the
+        non-premultiplied values used by wxImage.
+
+        @param src
+            The buffer with the pixels of all rows of @a rect.
+        @param stride
+            The offset between the starts of two consecutive rows in @a src,
+            in bytes. If 0, the rows are not padded, i.e. the stride is 4
+            times the width of @a rect.
+        @param format
+            The layout of the pixels in @a src.
+        @param rect
+            The part of the image to set, the entire image if empty, which
+            is the default. Must be inside the image.
+
+        @return @true on success or @false if the image is invalid or the
+            rectangle doesn't fit into it.
+
+        @since 3.1.6
+    */
+    bool SetPackedPixels(const unsigned char* src, int stride = 0,
+                         wxImagePackedFormat format = wxIMAGE_PACKED_RGBA,
+                         const wxRect& rect = wxRect());
+
     /**
         Sets the image data without performing checks.
 
@@ -31,10 +31,15 @@ public:
         (@a in_rows contains @a w * 3 bytes per row, @a out_rows @a w bytes per row).
         Fills @a out_rows with indexes into palette (which is also stored into @a palette
         variable).
+
+        The only flag taken into account in @a flags is @c wxQUANTIZE_NO_DITHER
+        which disables Floyd-Steinberg dithering, see Quantize(). The @a flags
+        parameter is only available since wxWidgets 3.1.6.
     */
     static void DoQuantize(unsigned int w, unsigned int h,
                            unsigned char** in_rows, unsigned char** out_rows,
-                           unsigned char* palette, int desiredNoColours);
+                           unsigned char* palette, int desiredNoColours,
+                           int flags = 0);
 
     /**
         Reduce the colours in the source image and put the result into the destination image.
@@ -42,6 +47,13 @@ public:
 
         Specify an optional palette pointer to receive the resulting palette.
         This palette may be passed to ConvertImageToBitmap, for example.
+
+        By default, the pixels are mapped to the palette colours using
+        Floyd-Steinberg dithering. If @a flags contains @c wxQUANTIZE_NO_DITHER
+        (available since wxWidgets 3.1.6), each pixel is simply replaced with
+        the closest palette colour instead, which is significantly faster and
+        avoids dithering noise in images with large areas of uniform colour,
+        such as screenshots.
     */
     static bool Quantize(const wxImage& src, wxImage& dest,
                          wxPalette** pPalette, int desiredNoColours = 236,
@@ -333,6 +333,13 @@ public:
     /**
         This method is abstract and has to be overwritten by any derived class.
         Here, the sizer will do the actual calculation of its children's minimal sizes.
+
+        Notice that the value returned by this function is cached by
+        GetMinSize() during Layout(), so that it is called only once for each
+        sizer, including the nested ones, during the layout. It is called
+        again during the next layout, so it may depend on any parameters of
+        the derived class, but InvalidateMinSize() should still be called
+        when they change if the layout needs to be updated immediately.
     */
     virtual wxSize CalcMin() = 0;
 
@@ -461,6 +468,14 @@ public:
     */
     void SetContainingWindow(wxWindow *window);
 
+    /**
+        Returns the item containing this sizer if it was added to another
+        sizer or @NULL otherwise.
+
+        @since 3.1.6
+    */
+    wxSizerItem* GetContainingItem() const;
+
     /**
        Returns the number of items in the sizer.
 
@@ -512,9 +527,32 @@ public:
         In particular, if you use the value to set toplevel window's minimal or
         actual size, use wxWindow::SetMinClientSize() or wxWindow::SetClientSize(),
         not wxWindow::SetMinSize() or wxWindow::SetSize().
+
+        The combined minimal size of the children is computed by calling
+        CalcMin(), except when this function is called again during the same
+        Layout() and InvalidateMinSize() hadn't been called since the last
+        call, in which case the cached value is returned.
     */
     wxSize GetMinSize();
 
+    /**
+        Discards the cached minimal size of the sizer.
+
+        This function is called automatically when something affecting the
+        minimal size of the sizer changes, e.g. an item is added to or removed
+        from the sizer, one of its windows is shown or hidden or its best size
+        changes, see wxWindow::InvalidateBestSize(). Custom sizers may call it
+        when any of their parameters used in their CalcMin() implementation
+        changes, although this is not required as the cached minimal size is
+        only used during a single Layout() call anyhow.
+
+        Calling this function also invalidates the minimal sizes of all the
+        sizers containing this one and the best size of the window using them.
+
+        @since 3.1.6
+    */
+    void InvalidateMinSize();
+
     /**
         Returns the current position of the sizer.
     */
@@ -1222,6 +1260,14 @@ public:
     */
     wxSize GetSpacer() const;
 
+    /**
+        Returns the sizer this item is in or @NULL if it wasn't added to any
+        sizer yet.
+
+        @since 3.1.6
+    */
+    wxSizer* GetContainingSizer() const;
+
     /**
         Get the userData item attribute.
     */
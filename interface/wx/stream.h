@@ -642,6 +642,27 @@ public:
     */
     wxInputStream& Read(wxOutputStream& stream_out);
 
+    /**
+        Returns a pointer to the data following the current position without
+        copying it.
+
+        This is only possible for the streams keeping all of their data in
+        memory, such as wxMemoryInputStream or wxMappedFileInputStream, and
+        @NULL is returned for all the other ones, which need to be read with
+        Read() as usual. Notice that @NULL is also returned if some data was
+        put back into the stream with Ungetch().
+
+        The data remains valid as long as the stream exists. Peeking at it
+        doesn't change the current position, call
+        @c SeekI(n, wxFromCurrent) to consume @c n bytes of it.
+
+        @param size
+            Receives the number of bytes available at the returned address.
+
+        @since 3.1.6
+    */
+    const void* PeekContiguous(size_t* size);
+
     /**
         Reads exactly the specified number of bytes into the buffer.
 
@@ -718,6 +739,17 @@ protected:
         variable should be set accordingly as well).
     */
     size_t OnSysRead(void* buffer, size_t bufsize) = 0;
+
+    /**
+        Internal function called by PeekContiguous().
+
+        Streams keeping their data in memory can override it to return the
+        address of the data at the current position and store its size in
+        @a size. The default implementation returns @NULL.
+
+        @since 3.1.6
+    */
+    virtual const void* OnSysPeekContiguous(size_t* size);
 };
 
 
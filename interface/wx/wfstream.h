@@ -356,6 +356,52 @@ public:
 
 
 
+/**
+    @class wxMappedFileInputStream
+
+    This class is a wxFileInputStream reading the file through a memory
+    mapping when possible.
+
+    Under Unix regular files are mapped into memory, which allows
+    wxInputStream::PeekContiguous() to give access to their contents without
+    copying it. For the other kinds of files, e.g. pipes or sockets, or if
+    mapping the file fails, and under the other platforms it behaves exactly
+    as wxFileInputStream.
+
+    Notice that the file must not be truncated by another process while it's
+    mapped.
+
+    @library{wxbase}
+    @category{streams}
+
+    @see wxFileInputStream
+
+    @since 3.1.6
+*/
+class wxMappedFileInputStream : public wxFileInputStream
+{
+public:
+    /**
+        Opens the specified file and maps it into memory if possible.
+
+        @warning
+        You should use wxStreamBase::IsOk() to verify if the constructor succeeded.
+    */
+    wxMappedFileInputStream(const wxString& fileName);
+
+    /**
+        Unmaps and closes the file.
+    */
+    virtual ~wxMappedFileInputStream();
+
+    /**
+        Returns @true if the file is being read through a memory mapping.
+    */
+    bool IsMapped() const;
+};
+
+
+
 /**
     @class wxFileStream
 
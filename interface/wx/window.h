@@ -1477,6 +1477,10 @@ public:
         Resets the cached best size value so it will be recalculated the next time it
         is needed.
 
+        This also invalidates the cached minimal size of the sizer containing
+        this window, if any, see wxSizer::InvalidateMinSize(), and the best
+        size of the parent window.
+
         @see CacheBestSize()
     */
     void InvalidateBestSize();
@@ -2050,6 +2054,10 @@ public:
 
         If the window has any children, they are recursively thawed too.
 
+        Since wxWidgets 3.1.6, the window and its children are laid out when
+        they are thawed if their size had changed while they were frozen, as
+        their automatic layout is postponed until then.
+
         @see wxWindowUpdateLocker, Freeze(), IsFrozen()
     */
     void Thaw();
@@ -2061,6 +2069,52 @@ public:
     */
     bool IsFrozen() const;
 
+    /**
+        Starts a layout transaction for this window.
+
+        Until the matching CommitLayoutTransaction() call, the calls to
+        Layout() for this window or any of its non-top-level children don't lay
+        them out immediately but just remember that they need to be laid out.
+        This allows to perform many changes affecting the layout, e.g. adding,
+        removing, showing or hiding many controls, without laying out the
+        windows after each of them.
+
+        Calls to this function may be nested and must be matched by the same
+        number of calls to CommitLayoutTransaction(). Using wxLayoutTransaction
+        helper class ensures that this is always the case.
+
+        Notice that only the layout performed by the base class Layout()
+        implementation, i.e. by sizers or constraints, is deferred and the
+        classes overriding Layout() may still lay out their children
+        immediately.
+
+        @see IsInLayoutTransaction(), Freeze()
+
+        @since 3.1.6
+    */
+    void BeginLayoutTransaction();
+
+    /**
+        Ends a layout transaction started by BeginLayoutTransaction().
+
+        If this is the outermost transaction, all the windows whose layout was
+        deferred while it was active are laid out now, with each of them being
+        laid out only once and the parents laid out before their children.
+
+        @since 3.1.6
+    */
+    void CommitLayoutTransaction();
+
+    /**
+        Returns @true if this window or any of its parents, up to the top
+        level one, is inside a layout transaction.
+
+        @see BeginLayoutTransaction()
+
+        @since 3.1.6
+    */
+    bool IsInLayoutTransaction() const;
+
     /**
         Returns the background colour of the window.
 
@@ -3531,6 +3585,11 @@ public:
         @true argument had been explicitly called), ensuring that it is always
         laid out correctly.
 
+        If the window is inside a layout transaction (see
+        BeginLayoutTransaction()), the layout is postponed until the end of
+        the transaction. The automatic layout done when the window size changes
+        is also postponed while the window is frozen, see Freeze().
+
         @see @ref overview_windowsizing
 
         @returns Always returns @true, the return value is not useful.
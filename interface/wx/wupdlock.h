@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////////////
 // Name:        wupdlock.h
-// Purpose:     interface of wxWindowUpdateLocker
+// Purpose:     interface of wxWindowUpdateLocker and wxLayoutTransaction
 // Author:      wxWidgets team
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
@@ -71,3 +71,53 @@ public:
     ~wxWindowUpdateLocker();
 };
 
+
+/**
+    @class wxLayoutTransaction
+
+    This class defers the layout of a wxWindow and all its children during its
+    lifetime by using wxWindow::BeginLayoutTransaction() and
+    wxWindow::CommitLayoutTransaction() methods.
+
+    It is typically used when changing many windows at once, e.g. when
+    rebuilding the contents of a dynamic form, to lay out each window only once
+    instead of doing it after each change:
+
+    @code
+    void MyFrame::RebuildForm()
+    {
+        wxLayoutTransaction deferLayout(m_panel);
+
+        m_panel->DestroyChildren();
+        for ( size_t n = 0; n < m_fields.size(); n++ )
+        {
+            ... create the controls for the field and add them to a sizer ...
+            m_panel->Layout(); // Doesn't do anything yet.
+        }
+
+        // The panel is laid out just once here, when deferLayout is destroyed.
+    }
+    @endcode
+
+    @library{wxcore}
+    @category{misc}
+
+    @since 3.1.6
+*/
+class wxLayoutTransaction
+{
+public:
+    /**
+        Starts a layout transaction for the specified @e win.
+
+        The parameter must be non-@NULL and the window must exist for longer
+        than wxLayoutTransaction object itself.
+    */
+    explicit wxLayoutTransaction(wxWindow* win);
+
+    /**
+        Destructor commits the transaction, performing all the deferred layouts
+        if it was the outermost one.
+    */
+    ~wxLayoutTransaction();
+};
@@ -434,6 +434,51 @@ public:
         @see overview_archive_byname
     */
     bool OpenEntry(wxZipEntry& entry);
+
+    /**
+        Reads the whole central directory of a zip on a seekable stream and
+        builds an index of its entries keyed on their names.
+
+        Once the index is loaded FindEntry() looks entries up in constant
+        time, and OpenEntry() can then seek straight to the entry's data
+        without reading the entries before it.
+
+        Returns @false if the stream isn't seekable or the central directory
+        can't be read.
+
+        @since 3.1.6
+    */
+    bool LoadIndex();
+
+    /**
+        Returns @true if LoadIndex() or ShareIndex() was successfully called.
+
+        @since 3.1.6
+    */
+    bool HasIndex() const;
+
+    /**
+        Returns the entry with the given name from the index loaded by
+        LoadIndex(), or @NULL if there is no such entry or no index.
+
+        The entry remains owned by the index and must not be deleted, but it
+        can be passed to OpenEntry().
+
+        @since 3.1.6
+    */
+    wxZipEntry* FindEntry(const wxString& name,
+                          wxPathFormat format = wxPATH_NATIVE) const;
+
+    /**
+        Makes this stream use the index already loaded by @a other, which
+        must be reading the same zip file, instead of locating and reading
+        the central directory again.
+
+        This must be called before anything else is done with this stream.
+
+        @since 3.1.6
+    */
+    bool ShareIndex(const wxZipInputStream& other);
 };
 
 
@@ -481,39 +481,40 @@ void wxAppConsoleBase::DelayPendingEventHandler(wxEvtHandler* toDelay)
     wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
 }
 
-void wxAppConsoleBase::RemovePendingEventHandler(wxEvtHandler* toRemove)
+bool wxAppConsoleBase::RemovePendingEventHandler(wxEvtHandler* toRemove)
 {
     wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
 
-    if (m_handlersWithPendingEvents.Index(toRemove) != wxNOT_FOUND)
-    {
-        m_handlersWithPendingEvents.Remove(toRemove);
+    // notice that the handler can't occur more than once in these lists as
+    // it's only added to them when its "pending" flag is set, see QueueEvent()
+    bool removed = true;
 
-        // check that the handler was present only once in the list
-        wxASSERT_MSG( m_handlersWithPendingEvents.Index(toRemove) == wxNOT_FOUND,
-                        "Handler occurs twice in the m_handlersWithPendingEvents list!" );
+    int n = m_handlersWithPendingEvents.Index(toRemove);
+    if (n != wxNOT_FOUND)
+    {
+        m_handlersWithPendingEvents.RemoveAt(n);
     }
-    //else: it wasn't in this list at all, it's ok
-
-    if (m_handlersWithPendingDelayedEvents.Index(toRemove) != wxNOT_FOUND)
+    else
     {
-        m_handlersWithPendingDelayedEvents.Remove(toRemove);
-
-        // check that the handler was present only once in the list
-        wxASSERT_MSG( m_handlersWithPendingDelayedEvents.Index(toRemove) == wxNOT_FOUND,
-                        "Handler occurs twice in m_handlersWithPendingDelayedEvents list!" );
+        n = m_handlersWithPendingDelayedEvents.Index(toRemove);
+        if (n != wxNOT_FOUND)
+            m_handlersWithPendingDelayedEvents.RemoveAt(n);
+        else // it wasn't in these lists at all, it's ok
+            removed = false;
     }
-    //else: it wasn't in this list at all, it's ok
 
     wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
+
+    return removed;
 }
 
 void wxAppConsoleBase::AppendPendingEventHandler(wxEvtHandler* toAppend)
 {
     wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
 
-    if ( m_handlersWithPendingEvents.Index(toAppend) == wxNOT_FOUND )
-        m_handlersWithPendingEvents.Add(toAppend);
+    // no need to check if the handler is already in the list, the caller
+    // ensures that it isn't
+    m_handlersWithPendingEvents.Add(toAppend);
 
     wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
 }
@@ -587,10 +588,18 @@ void wxAppConsoleBase::DeletePendingEvents()
     wxCHECK_RET( m_handlersWithPendingDelayedEvents.IsEmpty(),
                  "this helper list should be empty" );
 
-    for (unsigned int i=0; i<m_handlersWithPendingEvents.GetCount(); i++)
-        m_handlersWithPendingEvents[i]->DeletePendingEvents();
+    // the handlers remove themselves from the list when their pending events
+    // are deleted
+    while (!m_handlersWithPendingEvents.IsEmpty())
+    {
+        wxEvtHandler* const handler = m_handlersWithPendingEvents[0];
+
+        wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
 
-    m_handlersWithPendingEvents.Clear();
+        handler->DeletePendingEvents();
+
+        wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
+    }
 
     wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
 }
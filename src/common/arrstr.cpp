@@ -18,8 +18,14 @@
 
 #include "wx/arrstr.h"
 #include "wx/scopedarray.h"
+#include "wx/utils.h"
+#include "wx/vector.h"
 #include "wx/wxcrt.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif // wxUSE_THREADS
+
 #include "wx/beforestd.h"
 #include <algorithm>
 #include <functional>
@@ -191,6 +197,39 @@ void wxArrayString::Sort(bool reverseOrder)
     }
 }
 
+void wxArrayString::SortByKey(int flags, bool reverseOrder)
+{
+    const size_t count = size();
+    if ( count < 2 )
+        return;
+
+    wxScopedArray<size_t> order(count);
+    wxGetStringSortOrder(&(*this)[0], count, order.get(), flags, reverseOrder);
+
+    wxArrayStringBase sorted(count);
+    for ( size_t n = 0; n < count; n++ )
+        sorted[n].swap((*this)[order[n]]);
+
+    swap(sorted);
+}
+
+wxSortedArrayString::wxSortedArrayString(const wxArrayString& src)
+    : wxSortedArrayStringBase(wxStringSortAscending)
+{
+    // sorting all strings at once is much faster than inserting them one by
+    // one into the already sorted array
+    const size_t count = src.size();
+    if ( !count )
+        return;
+
+    wxScopedArray<size_t> order(count);
+    wxGetStringSortOrder(&src[0], count, order.get());
+
+    reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+        wxSortedArrayStringBase::AddAt(src[order[n]], n);
+}
+
 int wxSortedArrayString::Index(const wxString& str,
                                bool WXUNUSED_UNLESS_DEBUG(bCase),
                                bool WXUNUSED_UNLESS_DEBUG(bFromEnd)) const
@@ -266,6 +305,20 @@ void wxArrayString::Copy(const wxArrayString& src)
   if ( src.m_nCount > ARRAY_DEFAULT_INITIAL_SIZE )
     Alloc(src.m_nCount);
 
+  // when copying an unsorted array into a sorted one using the default
+  // comparison function, sorting all strings at once is much faster than
+  // inserting them one by one
+  if ( m_autoSort && !m_compareFunction && !src.m_autoSort && !m_nCount )
+  {
+    m_autoSort = false;
+    for ( size_t n = 0; n < src.m_nCount; n++ )
+      Add(src[n]);
+    m_autoSort = true;
+
+    DoSortByKey(wxSORTKEY_DEFAULT, false);
+    return;
+  }
+
   for ( size_t n = 0; n < src.m_nCount; n++ )
     Add(src[n]);
 }
@@ -605,6 +658,29 @@ void wxArrayString::Sort(bool reverseOrder)
         std::sort(m_pItems, m_pItems + m_nCount);
 }
 
+void wxArrayString::SortByKey(int flags, bool reverseOrder)
+{
+    wxCHECK_RET( !m_autoSort, wxT("can't use this method with sorted arrays") );
+
+    DoSortByKey(flags, reverseOrder);
+}
+
+void wxArrayString::DoSortByKey(int flags, bool reverseOrder)
+{
+    if ( m_nCount < 2 )
+        return;
+
+    wxScopedArray<size_t> order(m_nCount);
+    wxGetStringSortOrder(m_pItems, m_nCount, order.get(), flags, reverseOrder);
+
+    wxScopedArray<wxString> sorted(m_nCount);
+    for ( size_t n = 0; n < m_nCount; n++ )
+        sorted[n].swap(m_pItems[order[n]]);
+
+    for ( size_t n = 0; n < m_nCount; n++ )
+        m_pItems[n].swap(sorted[n]);
+}
+
 bool wxArrayString::operator==(const wxArrayString& a) const
 {
     if ( m_nCount != a.m_nCount )
@@ -924,3 +1000,329 @@ int wxCMPFUNC_CONV wxCmpNatural(const wxString& s1, const wxString& s2)
 #endif // #if defined( __WINDOWS__ )
 }
 
+
+// ----------------------------------------------------------------------------
+// sort keys
+// ----------------------------------------------------------------------------
+
+namespace // helpers for wxGetStringSortKey() and wxGetStringSortOrder()
+{
+
+// The keys are stored as sequences of bytes compared with memcmp(), so all
+// the values are stored in big endian order.
+typedef wxVector<unsigned char> wxStringSortKeyData;
+
+inline unsigned char* StoreKeyValue(unsigned char* p, wxUint32 value)
+{
+    *p++ = static_cast<unsigned char>(value >> 24);
+    *p++ = static_cast<unsigned char>(value >> 16);
+    *p++ = static_cast<unsigned char>(value >> 8);
+    *p++ = static_cast<unsigned char>(value);
+
+    return p;
+}
+
+void AppendKeyValue(wxStringSortKeyData& key, wxUint32 value)
+{
+    const size_t offset = key.size();
+    key.resize(offset + 4);
+    StoreKeyValue(&key[offset], value);
+}
+
+void AppendKeyChars(wxStringSortKeyData& key, const wxString& str, bool lower)
+{
+    if ( str.empty() )
+        return;
+
+    const size_t offset = key.size();
+    key.resize(offset + 4*str.length());
+
+    unsigned char* p = &key[offset];
+    for ( wxString::const_iterator it = str.begin(); it != str.end(); ++it )
+    {
+        const wxUniChar ch = *it;
+        p = StoreKeyValue(p, lower ? wxUint32(wxTolower(ch)) : ch.GetValue());
+    }
+}
+
+// Append the key corresponding to wxStrcoll() comparison, terminated by 0 if
+// the key can be followed by something else.
+void AppendKeyCollated(wxStringSortKeyData& key,
+                       const wxString& str,
+                       bool terminate)
+{
+    const wxWX2WCbuf buf(str.wc_str());
+    const wchar_t* chars = buf;
+    size_t len = wxWcslen(chars);
+
+    wxWCharBuffer xfrm;
+    const size_t lenXfrm = wxStrxfrm(static_cast<wchar_t*>(NULL), chars, 0);
+    if ( lenXfrm != static_cast<size_t>(-1) )
+    {
+        xfrm = wxWCharBuffer(lenXfrm);
+        if ( wxStrxfrm(xfrm.data(), chars, lenXfrm + 1) == lenXfrm )
+        {
+            chars = xfrm.data();
+            len = lenXfrm;
+        }
+        //else: this is not supposed to happen, but if the string can't be
+        //      transformed for some reason, still use something reasonable
+    }
+
+    const size_t size = 4*(terminate ? len + 1 : len);
+    if ( !size )
+        return;
+
+    const size_t offset = key.size();
+    key.resize(offset + size);
+
+    unsigned char* p = &key[offset];
+    for ( size_t n = 0; n < len; n++ )
+        p = StoreKeyValue(p, static_cast<wxUint32>(chars[n]));
+
+    if ( terminate )
+        StoreKeyValue(p, 0);
+}
+
+// Append the key corresponding to wxCmpNaturalGeneric() comparison: each
+// fragment is represented by its type followed by its contents, and the end of
+// the string corresponds to the empty fragment sorting before all the others.
+void AppendKeyNatural(wxStringSortKeyData& key, const wxString& str)
+{
+    wxString text(str);
+    while ( !text.empty() )
+    {
+        const wxStringFragment fragment = GetFragment(text);
+
+        key.push_back(static_cast<unsigned char>(fragment.type));
+        switch ( fragment.type )
+        {
+            case wxStringFragment::Empty:
+                break;
+
+            case wxStringFragment::SpaceOrPunct:
+                AppendKeyCollated(key, fragment.text, true);
+                break;
+
+            case wxStringFragment::Digit:
+                AppendKeyValue(key, static_cast<wxUint32>(fragment.value >> 32));
+                AppendKeyValue(key, static_cast<wxUint32>(fragment.value));
+                break;
+
+            case wxStringFragment::LetterOrSymbol:
+                AppendKeyCollated(key, fragment.text.Lower(), true);
+                break;
+        }
+    }
+}
+
+void AppendKey(wxStringSortKeyData& key, const wxString& str, int flags)
+{
+    if ( flags & wxSORTKEY_NATURAL )
+        AppendKeyNatural(key, str);
+    else if ( flags & wxSORTKEY_LOCALE )
+        AppendKeyCollated(key, flags & wxSORTKEY_NOCASE ? str.Lower() : str,
+                          false);
+    else
+        AppendKeyChars(key, str, (flags & wxSORTKEY_NOCASE) != 0);
+}
+
+int CompareKeys(const unsigned char* key1, size_t len1,
+                const unsigned char* key2, size_t len2)
+{
+    const size_t len = wxMin(len1, len2);
+    if ( len )
+    {
+        const int rc = memcmp(key1, key2, len);
+        if ( rc )
+            return rc;
+    }
+
+    return len1 < len2 ? -1 : len1 > len2 ? 1 : 0;
+}
+
+// Element of the array sorted by wxGetStringSortOrder().
+struct wxStringSortItem
+{
+    const unsigned char* key;
+    size_t len;
+    size_t index;
+
+    bool operator<(const wxStringSortItem& other) const
+    {
+        return CompareKeys(key, len, other.key, other.len) < 0;
+    }
+};
+
+// Compute the keys for the strings in the given range and sort it.
+void SortStringRange(const wxString* strings,
+                     size_t first,
+                     size_t last,
+                     int flags,
+                     wxStringSortKeyData& keys,
+                     wxStringSortItem* items)
+{
+    for ( size_t n = first; n < last; n++ )
+    {
+        const size_t offset = keys.size();
+        AppendKey(keys, strings[n], flags);
+        items[n].len = keys.size() - offset;
+        items[n].index = n;
+    }
+
+    // only set the pointers now, as the buffer could have been reallocated
+    // while computing the keys
+    const unsigned char* key = keys.empty() ? NULL : &keys[0];
+    for ( size_t n = first; n < last; n++ )
+    {
+        items[n].key = key;
+        key += items[n].len;
+    }
+
+    std::sort(items + first, items + last);
+}
+
+#if wxUSE_THREADS
+
+// The minimal number of strings for which several threads are used.
+const size_t wxSORT_PARALLEL_THRESHOLD = 10000;
+
+class wxStringSortThread : public wxThread
+{
+public:
+    wxStringSortThread(const wxString* strings,
+                       size_t first,
+                       size_t last,
+                       int flags,
+                       wxStringSortKeyData& keys,
+                       wxStringSortItem* items)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_strings(strings),
+          m_first(first),
+          m_last(last),
+          m_flags(flags),
+          m_keys(keys),
+          m_items(items)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        SortStringRange(m_strings, m_first, m_last, m_flags, m_keys, m_items);
+
+        return 0;
+    }
+
+private:
+    const wxString* const m_strings;
+    const size_t m_first,
+                 m_last;
+    const int m_flags;
+    wxStringSortKeyData& m_keys;
+    wxStringSortItem* const m_items;
+
+    wxDECLARE_NO_COPY_CLASS(wxStringSortThread);
+};
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
+wxCharBuffer wxGetStringSortKey(const wxString& str, int flags)
+{
+    wxStringSortKeyData data;
+    AppendKey(data, str, flags);
+
+    wxCharBuffer key(data.size());
+    if ( !data.empty() )
+        memcpy(key.data(), &data[0], data.size());
+
+    return key;
+}
+
+int wxCmpStringSortKeys(const wxCharBuffer& key1, const wxCharBuffer& key2)
+{
+    return CompareKeys(reinterpret_cast<const unsigned char*>(key1.data()),
+                       key1.length(),
+                       reinterpret_cast<const unsigned char*>(key2.data()),
+                       key2.length());
+}
+
+void wxGetStringSortOrder(const wxString* strings,
+                          size_t count,
+                          size_t* order,
+                          int flags,
+                          bool reverseOrder)
+{
+    if ( !count )
+        return;
+
+    wxScopedArray<wxStringSortItem> items(count);
+
+    // Split the strings into chunks, each of which is sorted independently,
+    // possibly in its own thread, and then merge the sorted chunks.
+    size_t numChunks = 1;
+#if wxUSE_THREADS
+    if ( count >= wxSORT_PARALLEL_THRESHOLD )
+    {
+        const int numCPUs = wxThread::GetCPUCount();
+        if ( numCPUs > 1 )
+            numChunks = wxMin(static_cast<size_t>(numCPUs), size_t(16));
+    }
+#endif // wxUSE_THREADS
+
+    wxVector<wxStringSortKeyData> keys(numChunks);
+    wxVector<size_t> bounds(numChunks + 1);
+    for ( size_t n = 0; n <= numChunks; n++ )
+        bounds[n] = count / numChunks * n + wxMin(n, count % numChunks);
+
+#if wxUSE_THREADS
+    wxVector<wxStringSortThread*> threads;
+    for ( size_t n = 1; n < numChunks; n++ )
+    {
+        wxStringSortThread* const thread = new wxStringSortThread
+                                               (
+                                                strings,
+                                                bounds[n],
+                                                bounds[n + 1],
+                                                flags,
+                                                keys[n],
+                                                items.get()
+                                               );
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            // just do it in this thread then
+            delete thread;
+            SortStringRange(strings, bounds[n], bounds[n + 1], flags,
+                            keys[n], items.get());
+            continue;
+        }
+
+        threads.push_back(thread);
+    }
+#endif // wxUSE_THREADS
+
+    SortStringRange(strings, bounds[0], bounds[1], flags, keys[0], items.get());
+
+#if wxUSE_THREADS
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+#endif // wxUSE_THREADS
+
+    for ( size_t step = 1; step < numChunks; step *= 2 )
+    {
+        for ( size_t n = 0; n + step < numChunks; n += 2*step )
+        {
+            std::inplace_merge(items.get() + bounds[n],
+                               items.get() + bounds[n + step],
+                               items.get() + bounds[wxMin(n + 2*step, numChunks)]);
+        }
+    }
+
+    for ( size_t n = 0; n < count; n++ )
+        order[n] = items[reverseOrder ? count - 1 - n : n].index;
+}
@@ -43,9 +43,14 @@
 #endif
 
 #include "wx/thread.h"
+#include "wx/private/atomic.h"
 
 #if wxUSE_BASE
+    #include "wx/evtprofiler.h"
+    #include "wx/hashmap.h"
     #include "wx/scopedptr.h"
+    #include "wx/time.h"
+    #include "wx/timer.h"
 
     wxDECLARE_SCOPED_PTR(wxEvent, wxEventPtr)
     wxDEFINE_SCOPED_PTR(wxEvent, wxEventPtr)
@@ -1142,13 +1147,249 @@ void wxEventHashTable::GrowEventTypeTable()
 // wxEvtHandler
 // ----------------------------------------------------------------------------
 
+// the minimal interval between the coalesced events can only be respected if
+// we can use a timer to process them when it expires
+#if wxUSE_TIMER && wxUSE_LONGLONG
+    #define wxHAS_COALESCED_EVENTS_INTERVAL
+#endif
+
+// the node of the lists of the pending events
+struct wxEvtHandler::PendingEventNode
+{
+    wxEvent *event;
+    PendingEventNode *next;
+
+    // only used for the events queued by QueueCoalescedEvent()
+    bool coalesced;
+    int key;
+};
+
+struct wxEvtHandler::CoalescedEvents
+{
+    // information about the coalesced events with the given key
+    struct KeyInfo
+    {
+        KeyInfo() : node(NULL), minInterval(0) { }
+
+        // the pending event with this key, if any
+        PendingEventNode *node;
+
+        // minimal interval between the events with this key in milliseconds
+        int minInterval;
+
+#ifdef wxHAS_COALESCED_EVENTS_INTERVAL
+        // the time when the last event with this key was processed, if any
+        wxLongLong lastProcessed;
+#endif // wxHAS_COALESCED_EVENTS_INTERVAL
+    };
+
+    WX_DECLARE_HASH_MAP(int, KeyInfo, wxIntegerHash, wxIntegerEqual, KeyInfoMap);
+
+    KeyInfoMap keys;
+
+#ifdef wxHAS_COALESCED_EVENTS_INTERVAL
+    // the timer queuing the postponed events when their interval expires
+    class DueTimer : public wxTimer
+    {
+    public:
+        explicit DueTimer(wxEvtHandler *handler) : m_handler(handler) { }
+
+        virtual void Notify() wxOVERRIDE
+        {
+            m_handler->QueueDueCoalescedEvents();
+        }
+
+    private:
+        wxEvtHandler * const m_handler;
+
+        wxDECLARE_NO_COPY_CLASS(DueTimer);
+    };
+
+    CoalescedEvents() : timer(NULL) { }
+    ~CoalescedEvents() { delete timer; }
+
+    // the events postponed because their minimal interval hasn't expired yet
+    wxVector<PendingEventNode*> deferred;
+
+    // the timer is only created when it's needed for the first time, as this
+    // must be done in the main thread, and the time when it expires
+    DueTimer *timer;
+    wxLongLong timerDue;
+#endif // wxHAS_COALESCED_EVENTS_INTERVAL
+};
+
+// All the dynamically bound event handlers are stored in the order in which
+// they were bound, as needed by Get{First,Next}DynamicEntry(), and are also
+// indexed by their event type, which allows SearchDynamicEventTable() to only
+// look at the handlers which can process the event.
+//
+// In both cases, the handlers are unbound by replacing them with NULL and
+// only really removed later by SearchDynamicEventTable(), as they can be
+// unbound while we're iterating over them.
+struct wxEvtHandler::DynamicEvents
+{
+    typedef wxVector<wxDynamicEventTableEntry*> Entries;
+
+    DynamicEvents()
+        : numUnbound(0),
+          m_slots(NULL),
+          m_numSlots(0),
+          m_numTypes(0)
+    {
+    }
+
+    ~DynamicEvents()
+    {
+        for ( size_t n = 0; n < m_numSlots; n++ )
+            delete m_slots[n].entries;
+
+        delete [] m_slots;
+    }
+
+    // Return the entries for the given event type or NULL if there are none.
+    Entries* Find(wxEventType eventType) const
+    {
+        if ( !m_numSlots )
+            return NULL;
+
+        for ( size_t n = Hash(eventType); ; n = (n + 1) & (m_numSlots - 1) )
+        {
+            const Slot& slot = m_slots[n];
+            if ( !slot.entries )
+                return NULL;
+
+            if ( slot.eventType == eventType )
+                return slot.entries;
+        }
+    }
+
+    void Add(wxDynamicEventTableEntry* entry)
+    {
+        all.push_back(entry);
+
+        Entries* entries = Find(entry->m_eventType);
+        if ( !entries )
+        {
+            // keep the load factor under 1/2 to make the collisions rare
+            if ( 2*(m_numTypes + 1) > m_numSlots )
+                Grow();
+
+            entries = new Entries;
+            Insert(entry->m_eventType, entries);
+            m_numTypes++;
+        }
+
+        // Notice that the entries vector itself never moves in memory, so it
+        // is fine to append to it while it's being iterated over by index.
+        entries->push_back(entry);
+    }
+
+    // Unbind the entry at the given index in "all" vector.
+    void Remove(size_t index)
+    {
+        wxDynamicEventTableEntry* const entry = all[index];
+        all[index] = NULL;
+        numUnbound++;
+
+        Entries* const entries = Find(entry->m_eventType);
+        wxCHECK_RET( entries, "event handler not indexed by its type" );
+
+        // the most recently bound handlers are more likely to be unbound, so
+        // search from the end
+        for ( size_t n = entries->size(); n; n-- )
+        {
+            if ( (*entries)[n - 1] == entry )
+            {
+                (*entries)[n - 1] = NULL;
+                return;
+            }
+        }
+
+        wxFAIL_MSG( "event handler not found in the type index" );
+    }
+
+    // Remove the unbound entries from the given vector.
+    static void Prune(Entries& entries)
+    {
+        size_t nNew = 0;
+        for ( size_t n = 0; n != entries.size(); n++ )
+        {
+            if ( entries[n] )
+                entries[nNew++] = entries[n];
+        }
+
+        entries.resize(nNew);
+    }
+
+    // all the entries in the order of binding, with NULLs for unbound ones
+    Entries all;
+
+    // number of NULL entries in "all"
+    size_t numUnbound;
+
+private:
+    // the open-addressed hash table slot, it's empty if entries is NULL
+    struct Slot
+    {
+        wxEventType eventType;
+        Entries* entries;
+    };
+
+    size_t Hash(wxEventType eventType) const
+    {
+        // the event types are small consecutive integers, so mix them a bit
+        // (using Fibonacci hashing multiplier) to avoid long clusters
+        return (static_cast<wxUint32>(eventType) * 2654435761U) & (m_numSlots - 1);
+    }
+
+    void Insert(wxEventType eventType, Entries* entries)
+    {
+        size_t n = Hash(eventType);
+        while ( m_slots[n].entries )
+            n = (n + 1) & (m_numSlots - 1);
+
+        m_slots[n].eventType = eventType;
+        m_slots[n].entries = entries;
+    }
+
+    void Grow()
+    {
+        Slot* const slotsOld = m_slots;
+        const size_t numSlotsOld = m_numSlots;
+
+        // the number of slots must be a power of 2 for Hash() to work
+        m_numSlots = m_numSlots ? 2*m_numSlots : 8;
+        m_slots = new Slot[m_numSlots];
+        for ( size_t n = 0; n < m_numSlots; n++ )
+            m_slots[n].entries = NULL;
+
+        for ( size_t n = 0; n < numSlotsOld; n++ )
+        {
+            if ( slotsOld[n].entries )
+                Insert(slotsOld[n].eventType, slotsOld[n].entries);
+        }
+
+        delete [] slotsOld;
+    }
+
+    Slot* m_slots;
+    size_t m_numSlots;
+    size_t m_numTypes;
+
+    wxDECLARE_NO_COPY_CLASS(DynamicEvents);
+};
+
 wxEvtHandler::wxEvtHandler()
 {
     m_nextHandler = NULL;
     m_previousHandler = NULL;
     m_enabled = true;
     m_dynamicEvents = NULL;
-    m_pendingEvents = NULL;
+    m_pendingEventsQueued = NULL;
+    m_pendingEvents =
+    m_pendingEventsLast = NULL;
+    m_isPendingHandler = 0;
+    m_coalescedEvents = NULL;
 
     // no client data (yet)
     m_clientData = NULL;
@@ -1186,12 +1427,12 @@ wxEvtHandler::~wxEvtHandler()
         delete m_dynamicEvents;
     }
 
-    // Remove us from the list of the pending events if necessary.
-    if (wxTheApp)
-        wxTheApp->RemovePendingEventHandler(this);
-
+    // Delete our pending events, this also removes us from the list of the
+    // handlers with pending events if necessary.
     DeletePendingEvents();
 
+    delete m_coalescedEvents;
+
     // we only delete object data, not untyped
     if ( m_clientDataType == wxClientData_Object )
         delete m_clientObject;
@@ -1287,37 +1528,301 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
         return;
     }
 
-    // 1) Add this event to our list of pending events
+    // 1) Push this event on the stack of the queued events: this doesn't
+    //    block, so that multiple threads can queue events simultaneously
+    PendingEventNode * const node = new PendingEventNode;
+    node->event = event;
+    node->coalesced = false;
+    do
+    {
+        node->next = m_pendingEventsQueued;
+    }
+    while ( !wxAtomicCompareExchange(m_pendingEventsQueued, node->next, node) );
+
+    // 2) Add this event handler to list of event handlers that have pending
+    //    events unless it's already there: notice that the flag must only be
+    //    set after pushing the event as otherwise the event could be missed
+    //    by UnregisterPendingHandler() which resets it
+    if ( wxAtomicCompareExchange(m_isPendingHandler, 0u, 1u) )
+        wxTheApp->AppendPendingEventHandler(this);
+
+    // 3) Inform the system that new pending events are somewhere,
+    //    and that these should be processed in idle time.
+    wxWakeUpIdle();
+}
+
+bool wxEvtHandler::TakeQueuedEvents()
+{
+    // take all the events queued since the last call at once
+    PendingEventNode *node;
+    do
+    {
+        node = m_pendingEventsQueued;
+        if ( !node )
+            return false;
+    }
+    while ( !wxAtomicCompareExchange(m_pendingEventsQueued,
+                                   node,
+                                   static_cast<PendingEventNode*>(NULL)) );
+
+    // and append them to the queue in the order they were queued in, i.e. in
+    // the reverse order of the stack
+    PendingEventNode * const last = node;
+    PendingEventNode *first = NULL;
+    while ( node )
+    {
+        PendingEventNode * const next = node->next;
+        node->next = first;
+        first = node;
+        node = next;
+    }
+
+    if ( m_pendingEventsLast )
+        m_pendingEventsLast->next = first;
+    else
+        m_pendingEvents = first;
+
+    m_pendingEventsLast = last;
+
+    return true;
+}
+
+void wxEvtHandler::UnregisterPendingHandler()
+{
+    if ( !m_isPendingHandler )
+        return;
+
+    // if we're not in the list yet, the thread which has set the flag is
+    // going to add us to it soon and we'll be removed from it when we're
+    // called to process the events, so leave the flag set in this case
+    if ( !wxTheApp->RemovePendingEventHandler(this) )
+        return;
+
+    wxAtomicCompareExchange(m_isPendingHandler, 1u, 0u);
+
+    // an event could have been queued after we had checked that there were
+    // none left but before we reset the flag, in which case QueueEvent() did
+    // not add us to the list and we must do it ourselves now
+    if ( TakeQueuedEvents() && wxAtomicCompareExchange(m_isPendingHandler, 0u, 1u) )
+        wxTheApp->AppendPendingEventHandler(this);
+}
+
+void
+wxEvtHandler::UnlinkPendingEvent(PendingEventNode *prev, PendingEventNode *node)
+{
+    if ( prev )
+        prev->next = node->next;
+    else
+        m_pendingEvents = node->next;
+
+    if ( m_pendingEventsLast == node )
+        m_pendingEventsLast = prev;
+
+    node->next = NULL;
+}
+
+void
+wxEvtHandler::QueueCoalescedEvent(wxEvent *event, int key, int minInterval)
+{
+    wxCHECK_RET( event, "NULL event can't be posted" );
+
+    wxASSERT_MSG( minInterval >= 0, "invalid minimal interval" );
+
+    if (!wxTheApp)
+    {
+        wxLogDebug("No application object! Cannot queue this event!");
+
+        delete event;
+
+        return;
+    }
+
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
-    if ( !m_pendingEvents )
-        m_pendingEvents = new wxList;
+    if ( !m_coalescedEvents )
+        m_coalescedEvents = new CoalescedEvents;
 
-    m_pendingEvents->Append(event);
+    CoalescedEvents::KeyInfo& info = m_coalescedEvents->keys[key];
+    info.minInterval = wxMax(minInterval, 0);
+
+    if ( info.node )
+    {
+        // simply replace the event which hasn't been processed yet, without
+        // changing its position in the queue
+        delete info.node->event;
+        info.node->event = event;
+
+        wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+
+        return;
+    }
+
+    // ensure that the events queued by QueueEvent() before this one are
+    // processed before it
+    TakeQueuedEvents();
+
+    PendingEventNode * const node = new PendingEventNode;
+    node->event = event;
+    node->next = NULL;
+    node->coalesced = true;
+    node->key = key;
+
+    if ( m_pendingEventsLast )
+        m_pendingEventsLast->next = node;
+    else
+        m_pendingEvents = node;
 
-    // 2) Add this event handler to list of event handlers that
-    //    have pending events.
+    m_pendingEventsLast = node;
 
-    wxTheApp->AppendPendingEventHandler(this);
+    info.node = node;
+
+    if ( wxAtomicCompareExchange(m_isPendingHandler, 0u, 1u) )
+        wxTheApp->AppendPendingEventHandler(this);
 
-    // only release m_pendingEventsLock now because otherwise there is a race
-    // condition as described in the ticket #9093: we could process the event
-    // just added to m_pendingEvents in our ProcessPendingEvents() below before
-    // we had time to append this pointer to wxHandlersWithPendingEvents list; thus
-    // breaking the invariant that a handler should be in the list iff it has
-    // any pending events to process
     wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
-    // 3) Inform the system that new pending events are somewhere,
-    //    and that these should be processed in idle time.
     wxWakeUpIdle();
 }
 
+bool wxEvtHandler::DeferCoalescedEventIfNeeded(PendingEventNode *node)
+{
+#ifdef wxHAS_COALESCED_EVENTS_INTERVAL
+    const CoalescedEvents::KeyInfo& info = m_coalescedEvents->keys[node->key];
+    if ( !info.minInterval || info.lastProcessed == 0 )
+        return false;
+
+    const wxLongLong now = wxGetUTCTimeMillis();
+    const wxLongLong due = info.lastProcessed + info.minInterval;
+
+    // also check for the clock going backwards to avoid postponing the event
+    // for too long in this case
+    if ( now >= due || now < info.lastProcessed )
+        return false;
+
+    m_coalescedEvents->deferred.push_back(node);
+
+    CoalescedEvents::DueTimer*& timer = m_coalescedEvents->timer;
+    if ( !timer )
+        timer = new CoalescedEvents::DueTimer(this);
+
+    if ( !timer->IsRunning() || due < m_coalescedEvents->timerDue )
+    {
+        m_coalescedEvents->timerDue = due;
+        timer->StartOnce((due - now).ToLong());
+    }
+
+    return true;
+#else // !wxHAS_COALESCED_EVENTS_INTERVAL
+    wxUnusedVar(node);
+
+    return false;
+#endif // wxHAS_COALESCED_EVENTS_INTERVAL/!wxHAS_COALESCED_EVENTS_INTERVAL
+}
+
+void wxEvtHandler::QueueDueCoalescedEvents()
+{
+#ifdef wxHAS_COALESCED_EVENTS_INTERVAL
+    wxENTER_CRIT_SECT( m_pendingEventsLock );
+
+    // keep the order of the events queued by QueueEvent() before the ones we
+    // are going to add
+    TakeQueuedEvents();
+
+    const wxLongLong now = wxGetUTCTimeMillis();
+    wxLongLong nextDue;
+
+    bool queued = false;
+
+    wxVector<PendingEventNode*>& deferred = m_coalescedEvents->deferred;
+    for ( size_t n = 0; n < deferred.size(); )
+    {
+        PendingEventNode * const node = deferred[n];
+
+        const CoalescedEvents::KeyInfo& info = m_coalescedEvents->keys[node->key];
+        const wxLongLong due = info.lastProcessed + info.minInterval;
+        if ( now >= due || now < info.lastProcessed )
+        {
+            if ( m_pendingEventsLast )
+                m_pendingEventsLast->next = node;
+            else
+                m_pendingEvents = node;
+
+            m_pendingEventsLast = node;
+
+            deferred.erase(deferred.begin() + n);
+            queued = true;
+        }
+        else
+        {
+            if ( nextDue == 0 || due < nextDue )
+                nextDue = due;
+
+            n++;
+        }
+    }
+
+    if ( queued && wxAtomicCompareExchange(m_isPendingHandler, 0u, 1u) )
+        wxTheApp->AppendPendingEventHandler(this);
+
+    if ( nextDue != 0 )
+    {
+        m_coalescedEvents->timerDue = nextDue;
+        m_coalescedEvents->timer->StartOnce((nextDue - now).ToLong());
+    }
+
+    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+
+    if ( queued )
+        wxWakeUpIdle();
+#endif // wxHAS_COALESCED_EVENTS_INTERVAL
+}
+
 void wxEvtHandler::DeletePendingEvents()
 {
-    if (m_pendingEvents)
-        m_pendingEvents->DeleteContents(true);
-    wxDELETE(m_pendingEvents);
+    wxENTER_CRIT_SECT( m_pendingEventsLock );
+
+    for ( ;; )
+    {
+        TakeQueuedEvents();
+
+        if ( !m_pendingEvents )
+            break;
+
+        while ( m_pendingEvents )
+        {
+            PendingEventNode * const node = m_pendingEvents;
+            m_pendingEvents = node->next;
+
+            delete node->event;
+            delete node;
+        }
+
+        m_pendingEventsLast = NULL;
+    }
+
+    if ( m_coalescedEvents )
+    {
+#ifdef wxHAS_COALESCED_EVENTS_INTERVAL
+        wxVector<PendingEventNode*>& deferred = m_coalescedEvents->deferred;
+        for ( size_t n = 0; n < deferred.size(); n++ )
+        {
+            delete deferred[n]->event;
+            delete deferred[n];
+        }
+
+        deferred.clear();
+
+        if ( m_coalescedEvents->timer )
+            m_coalescedEvents->timer->Stop();
+#endif // wxHAS_COALESCED_EVENTS_INTERVAL
+
+        m_coalescedEvents->keys.clear();
+    }
+
+    if ( wxTheApp )
+        UnregisterPendingHandler();
+
+    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 }
 
 void wxEvtHandler::ProcessPendingEvents()
@@ -1336,50 +1841,100 @@ void wxEvtHandler::ProcessPendingEvents()
 
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
-    // this method is only called by wxApp if this handler does have
-    // pending events
-    wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
-                 "should have pending events if called" );
+    // this method is only called by wxApp if this handler has pending events
+    // but they could have been already processed if another thread queued a
+    // new event just when we were removing ourselves from the list, in which
+    // case it will have added us back to it
+    if ( !TakeQueuedEvents() && !m_pendingEvents )
+    {
+        UnregisterPendingHandler();
+
+        wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+
+        return;
+    }
 
-    wxList::compatibility_iterator node = m_pendingEvents->GetFirst();
-    wxEvent* pEvent = static_cast<wxEvent *>(node->GetData());
+    PendingEventNode *prev = NULL,
+                     *node = m_pendingEvents;
 
     // find the first event which can be processed now:
     wxEventLoopBase* evtLoop = wxEventLoopBase::GetActive();
-    if (evtLoop && evtLoop->IsYielding())
+    const bool yielding = evtLoop && evtLoop->IsYielding();
+    while ( node )
     {
-        while (node && pEvent && !evtLoop->IsEventAllowedInsideYield(pEvent->GetEventCategory()))
+        if ( node->coalesced && DeferCoalescedEventIfNeeded(node) )
         {
-            node = node->GetNext();
-            pEvent = node ? static_cast<wxEvent *>(node->GetData()) : NULL;
+            // this event will be queued again later, skip it for now
+            PendingEventNode * const next = node->next;
+            UnlinkPendingEvent(prev, node);
+            node = next;
         }
+        else if ( yielding &&
+                    !evtLoop->IsEventAllowedInsideYield(node->event->GetEventCategory()) )
+        {
+            prev = node;
+            node = node->next;
+        }
+        else // found it
+        {
+            break;
+        }
+    }
 
-        if (!node)
+    if (!node)
+    {
+        if ( m_pendingEvents )
         {
             // all our events are NOT processable now... signal this:
             wxTheApp->DelayPendingEventHandler(this);
 
             // see the comment at the beginning of evtloop.h header for the
             // logic behind YieldFor() and behind DelayPendingEventHandler()
+        }
+        else if ( !TakeQueuedEvents() )
+        {
+            // all our events were postponed, we'll be added back to the list
+            // when they can be processed
+            UnregisterPendingHandler();
+        }
 
-            wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+        wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
-            return;
-        }
+        return;
     }
 
-    wxEventPtr event(pEvent);
+    wxEventPtr event(node->event);
 
     // it's important we remove event from list before processing it, else a
     // nested event loop, for example from a modal dialog, might process the
     // same event again.
-    m_pendingEvents->Erase(node);
+    UnlinkPendingEvent(prev, node);
+
+    if ( node->coalesced )
+    {
+        // a new event with the same key must be queued from now on
+        CoalescedEvents::KeyInfoMap& keys = m_coalescedEvents->keys;
+        CoalescedEvents::KeyInfoMap::iterator it = keys.find(node->key);
+        if ( it->second.minInterval )
+        {
+            it->second.node = NULL;
+#ifdef wxHAS_COALESCED_EVENTS_INTERVAL
+            it->second.lastProcessed = wxGetUTCTimeMillis();
+#endif // wxHAS_COALESCED_EVENTS_INTERVAL
+        }
+        else // no need to remember anything about this key
+        {
+            keys.erase(it);
+        }
+    }
 
-    if ( m_pendingEvents->IsEmpty() )
+    delete node;
+
+    if ( !m_pendingEvents && !TakeQueuedEvents() )
     {
         // if there are no more pending events left, we don't need to
         // stay in this list
-        wxTheApp->RemovePendingEventHandler(this);
+        UnregisterPendingHandler();
     }
 
     wxLEAVE_CRIT_SECT( m_pendingEventsLock );
@@ -1394,7 +1949,8 @@ void wxEvtHandler::ProcessPendingEvents()
 /* static */
 bool wxEvtHandler::ProcessEventIfMatchesId(const wxEventTableEntryBase& entry,
                                            wxEvtHandler *handler,
-                                           wxEvent& event)
+                                           wxEvent& event,
+                                           bool isDynamic)
 {
     int tableId1 = entry.m_id,
         tableId2 = entry.m_lastId;
@@ -1411,6 +1967,13 @@ bool wxEvtHandler::ProcessEventIfMatchesId(const wxEventTableEntryBase& entry,
         event.Skip(false);
         event.m_callbackUserData = entry.m_callbackUserData;
 
+#if wxUSE_STOPWATCH && wxUSE_LONGLONG
+        // this does nothing unless wxEventProfiler is running
+        wxEventProfiler::HandlerCall profile(entry, handler, event, isDynamic);
+#else
+        wxUnusedVar(isDynamic);
+#endif // wxUSE_STOPWATCH && wxUSE_LONGLONG
+
 #if wxUSE_EXCEPTIONS
         if ( wxTheApp )
         {
@@ -1767,7 +2330,7 @@ void wxEvtHandler::DoBind(int id,
     // We prefer to push back the entry here and then iterate over the vector
     // in reverse direction in GetNextDynamicEntry() as it's more efficient
     // than inserting the element at the front.
-    m_dynamicEvents->push_back(entry);
+    m_dynamicEvents->Add(entry);
 
     // Make sure we get to know when a sink is destroyed
     wxEvtHandler *eventSink = func->GetEvtHandler();
@@ -1821,7 +2384,7 @@ wxEvtHandler::DoUnbind(int id,
             // Notice that we rely on "cookie" being just the index into the
             // vector, which is not guaranteed by our API, but here we can use
             // this implementation detail.
-            (*m_dynamicEvents)[cookie] = NULL;
+            m_dynamicEvents->Remove(cookie);
 
             delete entry;
             return true;
@@ -1837,7 +2400,7 @@ wxEvtHandler::GetFirstDynamicEntry(size_t& cookie) const
         return NULL;
 
     // The handlers are in LIFO order, so we must start at the end.
-    cookie = m_dynamicEvents->size();
+    cookie = m_dynamicEvents->all.size();
     return GetNextDynamicEntry(cookie);
 }
 
@@ -1850,7 +2413,7 @@ wxEvtHandler::GetNextDynamicEntry(size_t& cookie) const
     {
         // Otherwise return the element at the previous index, skipping any
         // null elements which indicate removed entries.
-        wxDynamicEventTableEntry* const entry = m_dynamicEvents->at(--cookie);
+        wxDynamicEventTableEntry* const entry = m_dynamicEvents->all.at(--cookie);
         if ( entry )
             return entry;
     }
@@ -1863,7 +2426,11 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     wxCHECK_MSG( m_dynamicEvents, false,
                  wxT("caller should check that we have dynamic events") );
 
-    DynamicEvents& dynamicEvents = *m_dynamicEvents;
+    // Only the handlers for this event type need to be considered, so if
+    // there are none, there is nothing to do, except pruning the handlers for
+    // the other types.
+    DynamicEvents::Entries* const
+        dynamicEvents = m_dynamicEvents->Find(event.GetEventType());
 
     bool needToPruneDeleted = false;
 
@@ -1871,9 +2438,9 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     // but not yet pruned entries from the caller, but here we do want to know
     // about them, so iterate directly. Remember to do it in the reverse order
     // to honour the order of handlers connection.
-    for ( size_t n = dynamicEvents.size(); n; n-- )
+    for ( size_t n = dynamicEvents ? dynamicEvents->size() : 0; n; n-- )
     {
-        wxDynamicEventTableEntry* const entry = dynamicEvents[n - 1];
+        wxDynamicEventTableEntry* const entry = (*dynamicEvents)[n - 1];
 
         if ( !entry )
         {
@@ -1884,42 +2451,35 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
             continue;
         }
 
-        if ( event.GetEventType() == entry->m_eventType )
+        wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
+        if ( !handler )
+           handler = this;
+        if ( ProcessEventIfMatchesId(*entry, handler, event, true) )
         {
-            wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
-            if ( !handler )
-               handler = this;
-            if ( ProcessEventIfMatchesId(*entry, handler, event) )
-            {
-                // It's important to skip pruning of the unbound event entries
-                // below because this object itself could have been deleted by
-                // the event handler making m_dynamicEvents a dangling pointer
-                // which can't be accessed any longer in the code below.
-                //
-                // In practice, it hopefully shouldn't be a problem to wait
-                // until we get an event that we don't handle before pruning
-                // because this should happen soon enough and even if it
-                // doesn't the worst possible outcome is slightly increased
-                // memory consumption while not skipping pruning can result in
-                // hard to reproduce (because they require the disconnection
-                // and deletion happen at the same time which is not always the
-                // case) crashes.
-                return true;
-            }
+            // It's important to skip pruning of the unbound event entries
+            // below because this object itself could have been deleted by
+            // the event handler making m_dynamicEvents a dangling pointer
+            // which can't be accessed any longer in the code below.
+            //
+            // In practice, it hopefully shouldn't be a problem to wait
+            // until we get an event that we don't handle before pruning
+            // because this should happen soon enough and even if it
+            // doesn't the worst possible outcome is slightly increased
+            // memory consumption while not skipping pruning can result in
+            // hard to reproduce (because they require the disconnection
+            // and deletion happen at the same time which is not always the
+            // case) crashes.
+            return true;
         }
     }
 
     if ( needToPruneDeleted )
-    {
-        size_t nNew = 0;
-        for ( size_t n = 0; n != dynamicEvents.size(); n++ )
-        {
-            if ( dynamicEvents[n] )
-                dynamicEvents[nNew++] = dynamicEvents[n];
-        }
+        DynamicEvents::Prune(*dynamicEvents);
 
-        wxASSERT( nNew != dynamicEvents.size() );
-        dynamicEvents.resize(nNew);
+    if ( m_dynamicEvents->numUnbound )
+    {
+        DynamicEvents::Prune(m_dynamicEvents->all);
+        m_dynamicEvents->numUnbound = 0;
     }
 
     return false;
@@ -1995,12 +2555,12 @@ void wxEvtHandler::OnSinkDestroyed( wxEvtHandler *sink )
     {
         if ( entry->m_fn->GetEvtHandler() == sink )
         {
-            delete entry->m_callbackUserData;
-            delete entry;
-
             // Just as in DoUnbind(), we use our knowledge of
             // GetNextDynamicEntry() implementation here.
-            (*m_dynamicEvents)[cookie] = NULL;
+            m_dynamicEvents->Remove(cookie);
+
+            delete entry->m_callbackUserData;
+            delete entry;
         }
     }
 }
@@ -0,0 +1,396 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/evtprofiler.cpp
+// Purpose:     wxEventProfiler implementation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_STOPWATCH && wxUSE_LONGLONG
+
+#include "wx/evtprofiler.h"
+#include "wx/private/atomic.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
+
+#include <algorithm>
+
+// ----------------------------------------------------------------------------
+// private functions
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+bool CompareByTotalTime(const wxEventHandlerStats& s1,
+                        const wxEventHandlerStats& s2)
+{
+    return s1.GetTotalTime() > s2.GetTotalTime();
+}
+
+// Quote the string for using it in JSON.
+wxString QuoteJSON(const wxString& s)
+{
+    wxString quoted;
+    quoted.reserve(s.length() + 2);
+
+    quoted += '"';
+    for ( wxString::const_iterator it = s.begin(); it != s.end(); ++it )
+    {
+        const wxUniChar ch = *it;
+        if ( ch == '"' || ch == '\\' )
+        {
+            quoted += '\\';
+            quoted += ch;
+        }
+        else if ( ch < 0x20 )
+        {
+            quoted += wxString::Format("\\u%04x", static_cast<int>(ch.GetValue()));
+        }
+        else
+        {
+            quoted += ch;
+        }
+    }
+    quoted += '"';
+
+    return quoted;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// wxEventHandlerStats implementation
+// ============================================================================
+
+wxEventHandlerStats::wxEventHandlerStats(void *functor,
+                                         wxEventType eventType,
+                                         const wxClassInfo *eventClass,
+                                         const wxClassInfo *handlerClass,
+                                         bool isDynamic)
+    : m_functor(functor),
+      m_eventType(eventType),
+      m_eventClass(eventClass),
+      m_handlerClass(handlerClass),
+      m_isDynamic(isDynamic),
+      m_count(0),
+      m_maxTime(0),
+      m_next((size_t)-1)
+{
+    for ( unsigned n = 0; n < NUM_BUCKETS; n++ )
+        m_histogram[n] = 0;
+}
+
+wxString wxEventHandlerStats::GetEventClassName() const
+{
+    return m_eventClass ? m_eventClass->GetClassName() : wxT("wxEvent");
+}
+
+wxString wxEventHandlerStats::GetHandlerClassName() const
+{
+    return m_handlerClass ? m_handlerClass->GetClassName() : wxT("wxEvtHandler");
+}
+
+wxString wxEventHandlerStats::GetDescription() const
+{
+    return wxString::Format("%s handling %s (type %d) %s",
+                            GetHandlerClassName(),
+                            GetEventClassName(),
+                            m_eventType,
+                            m_isDynamic ? "bound dynamically"
+                                        : "in event table");
+}
+
+wxLongLong wxEventHandlerStats::GetAverageTime() const
+{
+    return m_count ? m_totalTime / static_cast<long>(m_count) : wxLongLong(0);
+}
+
+wxLongLong wxEventHandlerStats::GetPercentile(double percentile) const
+{
+    if ( !m_count )
+        return 0;
+
+    // find the first bucket such that the given part of all calls is in it or
+    // in the preceding buckets
+    unsigned long countMax = static_cast<unsigned long>(m_count*percentile/100.);
+    if ( countMax < 1 )
+        countMax = 1;
+
+    unsigned long count = 0;
+    for ( unsigned n = 0; n < NUM_BUCKETS; n++ )
+    {
+        count += m_histogram[n];
+        if ( count >= countMax )
+            return wxMin(GetBucketMax(n), m_maxTime);
+    }
+
+    return m_maxTime;
+}
+
+/* static */
+unsigned wxEventHandlerStats::GetBucket(wxUint32 duration)
+{
+    // the first 4 buckets are for the exact values
+    if ( duration < 4 )
+        return duration;
+
+    // find the position of the highest bit
+    unsigned bit = 2;
+    while ( duration >> (bit + 1) )
+        bit++;
+
+    // and use the next 2 bits for selecting one of 4 buckets for this power
+    return 4*(bit - 1) + ((duration >> (bit - 2)) & 3);
+}
+
+/* static */
+wxUint32 wxEventHandlerStats::GetBucketMax(unsigned bucket)
+{
+    if ( bucket < 4 )
+        return bucket;
+
+    const unsigned bit = bucket/4 + 1;
+    const wxUint64 max = (static_cast<wxUint64>(4 + bucket % 4 + 1) << (bit - 2)) - 1;
+
+    return max > 0xffffffff ? 0xffffffff : static_cast<wxUint32>(max);
+}
+
+void wxEventHandlerStats::AddCall(wxUint32 duration)
+{
+    m_count++;
+    m_totalTime += wxLongLong(0, duration);
+    if ( duration > m_maxTime )
+        m_maxTime = duration;
+
+    m_histogram[GetBucket(duration)]++;
+}
+
+// ============================================================================
+// wxEventProfiler implementation
+// ============================================================================
+
+wxEventProfiler * volatile wxEventProfiler::ms_running = NULL;
+
+wxEventProfiler::wxEventProfiler()
+{
+    m_maxTraceEvents = 100000;
+}
+
+wxEventProfiler::~wxEventProfiler()
+{
+    Stop();
+}
+
+bool wxEventProfiler::Start()
+{
+    // only set ourselves as the running profiler if there is none, even if
+    // another thread is trying to start another one at the same time
+    return IsRunning() ||
+            wxAtomicCompareExchange(ms_running,
+                                    static_cast<wxEventProfiler*>(NULL),
+                                    this);
+}
+
+void wxEventProfiler::Stop()
+{
+    wxAtomicCompareExchange(ms_running,
+                            this,
+                            static_cast<wxEventProfiler*>(NULL));
+}
+
+void wxEventProfiler::Reset()
+{
+    wxCRIT_SECT_LOCKER(lock, m_critSect);
+
+    m_stats.clear();
+    m_statsIndex.clear();
+    m_trace.clear();
+
+    m_stopwatch.Start();
+}
+
+void wxEventProfiler::BeginCall(HandlerCall& call,
+                                const wxEventTableEntryBase& entry,
+                                wxEvtHandler *handler,
+                                const wxEvent& event,
+                                bool isDynamic)
+{
+    // remember everything we need now, as the handler may destroy the object
+    // handling the event or even unbind itself
+    call.m_functor = entry.m_fn;
+    call.m_eventType = event.GetEventType();
+    call.m_eventClass = event.GetClassInfo();
+    call.m_handlerClass = handler->GetClassInfo();
+    call.m_isDynamic = isDynamic;
+
+    call.m_start = m_stopwatch.TimeInMicro();
+}
+
+void wxEventProfiler::EndCall(const HandlerCall& call)
+{
+    const wxLongLong elapsed = m_stopwatch.TimeInMicro() - call.m_start;
+
+    wxUint32 duration;
+    if ( elapsed < 0 )
+        duration = 0;
+    else if ( elapsed.GetHi() )
+        duration = 0xffffffff;
+    else
+        duration = elapsed.GetLo();
+
+    wxCRIT_SECT_LOCKER(lock, m_critSect);
+
+    const size_t stats = GetStatsIndex(call);
+    m_stats[stats].AddCall(duration);
+
+    if ( m_trace.size() < m_maxTraceEvents )
+    {
+        TraceEvent traceEvent;
+        traceEvent.stats = stats;
+        traceEvent.start = call.m_start;
+        traceEvent.duration = duration;
+#if wxUSE_THREADS
+        traceEvent.thread = wxThread::GetCurrentId();
+#endif // wxUSE_THREADS
+
+        m_trace.push_back(traceEvent);
+    }
+}
+
+size_t wxEventProfiler::GetStatsIndex(const HandlerCall& call)
+{
+    // the functor identifies the handler, but the same functor may be used
+    // for different event types and even by different objects, so check for
+    // all the stats using it
+    size_t* const head = &m_statsIndex.insert(
+                            StatsIndexMap::value_type(call.m_functor, (size_t)-1)
+                         ).first->second;
+
+    size_t* next = head;
+    while ( *next != (size_t)-1 )
+    {
+        const wxEventHandlerStats& stats = m_stats[*next];
+        if ( stats.Matches(call.m_eventType,
+                           call.m_eventClass,
+                           call.m_handlerClass,
+                           call.m_isDynamic) )
+        {
+            return *next;
+        }
+
+        next = &m_stats[*next].m_next;
+    }
+
+    *next = m_stats.size();
+    m_stats.push_back(wxEventHandlerStats(call.m_functor,
+                                          call.m_eventType,
+                                          call.m_eventClass,
+                                          call.m_handlerClass,
+                                          call.m_isDynamic));
+
+    return *next;
+}
+
+wxVector<wxEventHandlerStats> wxEventProfiler::GetStats() const
+{
+    wxVector<wxEventHandlerStats> stats;
+    {
+        wxCRIT_SECT_LOCKER(lock, m_critSect);
+
+        stats = m_stats;
+    }
+
+    if ( !stats.empty() )
+        std::sort(&stats[0], &stats[0] + stats.size(), CompareByTotalTime);
+
+    return stats;
+}
+
+wxString wxEventProfiler::GetReport() const
+{
+    const wxVector<wxEventHandlerStats> stats = GetStats();
+
+    wxString report;
+    report.Printf("%10s %12s %10s %10s %10s %10s %10s  %s\n",
+                  "Calls", "Total (ms)", "Avg (us)",
+                  "p50 (us)", "p90 (us)", "p99 (us)", "Max (us)",
+                  "Handler");
+
+    for ( size_t n = 0; n < stats.size(); n++ )
+    {
+        const wxEventHandlerStats& s = stats[n];
+
+        report += wxString::Format("%10lu %12.3f %10s %10s %10s %10s %10s  %s\n",
+                                   s.GetCount(),
+                                   s.GetTotalTime().ToDouble()/1000.,
+                                   s.GetAverageTime().ToString(),
+                                   s.GetPercentile(50).ToString(),
+                                   s.GetPercentile(90).ToString(),
+                                   s.GetPercentile(99).ToString(),
+                                   s.GetMaxTime().ToString(),
+                                   s.GetDescription());
+    }
+
+    return report;
+}
+
+wxString wxEventProfiler::GetChromeTrace() const
+{
+    wxCRIT_SECT_LOCKER(lock, m_critSect);
+
+    // the descriptions are the same for all the calls of the same handler, so
+    // compute them only once
+    wxVector<wxString> names;
+    names.reserve(m_stats.size());
+    for ( size_t n = 0; n < m_stats.size(); n++ )
+        names.push_back(QuoteJSON(m_stats[n].GetDescription()));
+
+    const unsigned long pid = wxGetProcessId();
+
+    wxString trace("{\"traceEvents\":[");
+    for ( size_t n = 0; n < m_trace.size(); n++ )
+    {
+        const TraceEvent& traceEvent = m_trace[n];
+
+        unsigned long tid = 0;
+#if wxUSE_THREADS
+        tid = static_cast<unsigned long>(traceEvent.thread);
+#endif // wxUSE_THREADS
+
+        if ( n )
+            trace += ',';
+
+        trace += wxString::Format
+                 (
+                    "\n{\"name\":%s,\"cat\":\"event\",\"ph\":\"X\","
+                    "\"ts\":%s,\"dur\":%lu,\"pid\":%lu,\"tid\":%lu}",
+                    names[traceEvent.stats],
+                    traceEvent.start.ToString(),
+                    static_cast<unsigned long>(traceEvent.duration),
+                    pid,
+                    tid
+                 );
+    }
+
+    trace += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return trace;
+}
+
+#endif // wxUSE_STOPWATCH && wxUSE_LONGLONG
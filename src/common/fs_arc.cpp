@@ -20,12 +20,20 @@
 #include "wx/archive.h"
 #include "wx/private/fileback.h"
 
+#if wxUSE_ZIPSTREAM
+    #include "wx/zipstrm.h"
+#endif
+
 //---------------------------------------------------------------------------
 // wxArchiveFSCacheDataImpl
 //
 // Holds the catalog of an archive file, and if it is being read from a
 // non-seekable stream, a copy of its backing file.
 //
+// For seekable zips the catalog is the index of the central directory kept by
+// wxZipInputStream, so lookups don't need to scan the entries sequentially
+// and the streams opened for each entry can share the index.
+//
 // This class is actually the reference counted implementation for the
 // wxArchiveFSCacheData class below. It was done that way to allow sharing
 // between instances of wxFileSystem, though that's a feature not used in this
@@ -55,6 +63,7 @@ public:
 
     wxArchiveEntry *Get(const wxString& name);
     wxInputStream *NewStream() const;
+    void ShareIndex(wxArchiveInputStream& stream) const;
 
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse);
 
@@ -71,6 +80,9 @@ private:
     wxBackingFile m_backer;
     wxInputStream *m_stream;
     wxArchiveInputStream *m_archive;
+#if wxUSE_ZIPSTREAM
+    wxZipInputStream *m_zip;
+#endif
 };
 
 wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
@@ -83,6 +95,9 @@ wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
     m_stream(new wxBackedInputStream(backer)),
     m_archive(factory.NewStream(*m_stream))
 {
+#if wxUSE_ZIPSTREAM
+    m_zip = NULL;
+#endif
 }
 
 wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
@@ -94,6 +109,17 @@ wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
     m_stream(stream),
     m_archive(factory.NewStream(*m_stream))
 {
+#if wxUSE_ZIPSTREAM
+    m_zip = NULL;
+
+    // only the exact class is known to create wxZipInputStreams
+    if (m_archive && factory.GetClassInfo() == wxCLASSINFO(wxZipClassFactory))
+    {
+        wxZipInputStream *zip = static_cast<wxZipInputStream*>(m_archive);
+        if (zip->LoadIndex())
+            m_zip = zip;
+    }
+#endif
 }
 
 wxArchiveFSCacheDataImpl::~wxArchiveFSCacheDataImpl()
@@ -125,6 +151,9 @@ wxArchiveFSEntry *wxArchiveFSCacheDataImpl::AddToCache(wxArchiveEntry *entry)
 
 void wxArchiveFSCacheDataImpl::CloseStreams()
 {
+#if wxUSE_ZIPSTREAM
+    m_zip = NULL;
+#endif
     wxDELETE(m_archive);
     wxDELETE(m_stream);
 }
@@ -139,6 +168,19 @@ wxArchiveEntry *wxArchiveFSCacheDataImpl::Get(const wxString& name)
     if (!m_archive)
         return NULL;
 
+#if wxUSE_ZIPSTREAM
+    if (m_zip)
+    {
+        wxZipEntry *entry = m_zip->FindEntry(name, wxPATH_UNIX);
+
+        // the index ignores a trailing separator, but a lookup doesn't
+        if (entry && entry->GetName(wxPATH_UNIX) == name)
+            return entry;
+
+        return NULL;
+    }
+#endif
+
     wxArchiveEntry *entry;
 
     while ((entry = m_archive->GetNextEntry()) != NULL)
@@ -162,6 +204,16 @@ wxInputStream* wxArchiveFSCacheDataImpl::NewStream() const
         return NULL;
 }
 
+void wxArchiveFSCacheDataImpl::ShareIndex(wxArchiveInputStream& stream) const
+{
+#if wxUSE_ZIPSTREAM
+    if (m_zip)
+        static_cast<wxZipInputStream&>(stream).ShareIndex(*m_zip);
+#else
+    wxUnusedVar(stream);
+#endif
+}
+
 wxArchiveFSEntry *wxArchiveFSCacheDataImpl::GetNext(wxArchiveFSEntry *fse)
 {
     wxArchiveFSEntry *next = fse ? fse->next : m_begin;
@@ -203,6 +255,8 @@ public:
 
     wxArchiveEntry *Get(const wxString& name) { return m_impl->Get(name); }
     wxInputStream *NewStream() const { return m_impl->NewStream(); }
+    void ShareIndex(wxArchiveInputStream& stream) const
+        { m_impl->ShareIndex(stream); }
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse)
         { return m_impl->GetNext(fse); }
 
@@ -385,6 +439,7 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
     if ( !s )
         return NULL;
 
+    cached->ShareIndex(*s);
     s->OpenEntry(*entry);
 
     if (!s->IsOk())
@@ -100,6 +100,7 @@ bool wxGBSizerItem::SetPos( const wxGBPosition& pos )
                  wxT("An item is already at that position") );
     }
     m_pos = pos;
+    InvalidateContainingSizer();
     return true;
 }
 
@@ -111,6 +112,7 @@ bool wxGBSizerItem::SetSpan( const wxGBSpan& span )
                  wxT("An item is already at that position") );
     }
     m_span = span;
+    InvalidateContainingSizer();
     return true;
 }
 
@@ -214,9 +216,12 @@ wxSizerItem* wxGridBagSizer::Add( wxGBSizerItem *item )
                  wxT("An item is already at that position") );
     m_children.Append(item);
     item->SetGBSizer(this);
+    item->SetContainingSizer(this);
     if ( item->GetWindow() )
         item->GetWindow()->SetContainingSizer( this );
 
+    InvalidateMinSize();
+
     // extend the number of rows/columns of the underlying wxFlexGridSizer if
     // necessary
     int row, col;
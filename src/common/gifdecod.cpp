@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "wx/gifdecod.h"
+#include "wx/mstream.h"
 #include "wx/scopedarray.h"
 #include "wx/scopedptr.h"
 #include "wx/scopeguard.h"
@@ -39,6 +40,9 @@ enum
 
 #define GetFrame(n)     ((GIFImage*)m_frames[n])
 
+// default maximal size of the decoded frames cache
+static const size_t GIF_DEFAULT_CACHE_SIZE = 32*1024*1024;
+
 //---------------------------------------------------------------------------
 // GIFImage
 //---------------------------------------------------------------------------
@@ -57,11 +61,15 @@ public:
     int transparent;                // transparent color index (-1 = none)
     wxAnimationDisposal disposal;   // disposal method
     long delay;                     // delay in ms (-1 = unused)
-    unsigned char *p;               // bitmap
+    unsigned char *p;               // bitmap (NULL if not decoded)
     unsigned char *pal;             // palette
     unsigned int ncolours;          // number of colours
     wxString comment;
 
+    wxMemoryBuffer raster;          // compressed raster data sub-blocks
+    int interl;                     // interlaced image?
+    int bits;                       // initial code size
+
     wxDECLARE_NO_COPY_CLASS(GIFImage);
 };
 
@@ -84,6 +92,8 @@ GIFImage::GIFImage()
     p = (unsigned char *) NULL;
     pal = (unsigned char *) NULL;
     ncolours = 0;
+    interl = 0;
+    bits = 0;
 }
 
 //---------------------------------------------------------------------------
@@ -92,6 +102,9 @@ GIFImage::GIFImage()
 
 wxGIFDecoder::wxGIFDecoder()
 {
+    m_cacheUsed = 0;
+    m_cacheSize = GIF_DEFAULT_CACHE_SIZE;
+    m_capture = NULL;
 }
 
 wxGIFDecoder::~wxGIFDecoder()
@@ -112,6 +125,75 @@ void wxGIFDecoder::Destroy()
 
     m_frames.Clear();
     m_nFrames = 0;
+
+    m_cachedFrames.Clear();
+    m_cacheUsed = 0;
+}
+
+void wxGIFDecoder::SetCacheSize(size_t bytes)
+{
+    m_cacheSize = bytes;
+
+    // shrink the cache if necessary, keeping the most recently used frame
+    if ( !m_cachedFrames.empty() )
+        CacheFrame(m_cachedFrames.Last());
+}
+
+//---------------------------------------------------------------------------
+// Decoded frames cache
+//---------------------------------------------------------------------------
+
+void wxGIFDecoder::CacheFrame(unsigned int frame) const
+{
+    int index = m_cachedFrames.Index(frame);
+    if ( index != wxNOT_FOUND )
+    {
+        m_cachedFrames.RemoveAt(index);
+    }
+    else
+    {
+        m_cacheUsed += GetFrame(frame)->w * GetFrame(frame)->h;
+    }
+
+    m_cachedFrames.Add(frame);
+
+    // free the least recently used frames, but always keep this one
+    while ( m_cacheUsed > m_cacheSize && m_cachedFrames.size() > 1 )
+    {
+        GIFImage *f = GetFrame(m_cachedFrames[0]);
+        m_cachedFrames.RemoveAt(0);
+
+        m_cacheUsed -= f->w * f->h;
+        free(f->p);
+        f->p = NULL;
+    }
+}
+
+bool wxGIFDecoder::DecodeFrame(unsigned int frame) const
+{
+    GIFImage *f = GetFrame(frame);
+    if ( f->p )
+    {
+        CacheFrame(frame);
+        return true;
+    }
+
+    f->p = (unsigned char *) malloc(f->w * f->h);
+    if ( !f->p )
+        return false;
+
+    // the raster data was already successfully decoded when loading the
+    // frame, so this can only fail if we run out of memory
+    wxMemoryInputStream stream(f->raster.GetData(), f->raster.GetDataLen());
+    if ( dgif(stream, f, f->interl, f->bits) != wxGIF_OK )
+    {
+        free(f->p);
+        f->p = NULL;
+        return false;
+    }
+
+    CacheFrame(frame);
+    return true;
 }
 
 
@@ -142,6 +224,9 @@ bool wxGIFDecoder::ConvertToImage(unsigned int frame, wxImage *image) const
 
     pal = GetPalette(frame);
     src = GetData(frame);
+    if ( !src )
+        return false;
+
     dst = image->GetData();
     transparent = GetTransparentColourIndex(frame);
 
@@ -273,7 +358,14 @@ wxColour wxGIFDecoder::GetTransparentColour(unsigned int frame) const
                     pal[n*3 + 2]);
 }
 
-unsigned char* wxGIFDecoder::GetData(unsigned int frame) const    { return (GetFrame(frame)->p); }
+unsigned char* wxGIFDecoder::GetData(unsigned int frame) const
+{
+    if ( !DecodeFrame(frame) )
+        return NULL;
+
+    return GetFrame(frame)->p;
+}
+
 unsigned char* wxGIFDecoder::GetPalette(unsigned int frame) const { return (GetFrame(frame)->pal); }
 unsigned int wxGIFDecoder::GetNcolours(unsigned int frame) const  { return (GetFrame(frame)->ncolours); }
 int wxGIFDecoder::GetTransparentColourIndex(unsigned int frame) const  { return (GetFrame(frame)->transparent); }
@@ -287,7 +379,7 @@ int wxGIFDecoder::GetTransparentColourIndex(unsigned int frame) const  { return
 // getcode:
 //  Reads the next code from the file stream, with size 'bits'
 //
-int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin)
+int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin) const
 {
     unsigned int mask;          // bit mask
     unsigned int code;          // code (result)
@@ -303,6 +395,15 @@ int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin)
         if (m_restbyte == 0)
         {
             m_restbyte = stream.GetC();
+            if ( m_capture && stream.LastRead() )
+            {
+                // grow the buffer geometrically as it can become big
+                const size_t len = m_capture->GetDataLen();
+                if ( m_capture->GetBufSize() < len + 256 )
+                    m_capture->SetBufSize(2*len + 256);
+
+                m_capture->AppendByte((char)m_restbyte);
+            }
 
             /* Some encoders are a bit broken: instead of issuing
              * an end-of-image symbol (ab_fin) they come up with
@@ -317,6 +418,8 @@ int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin)
 
             // prefetch data
             stream.Read((void *) m_buffer, m_restbyte);
+            if ( m_capture )
+                m_capture->AppendData(m_buffer, stream.LastRead());
             if (stream.LastRead() != m_restbyte)
             {
                 code = ab_fin;
@@ -348,7 +451,7 @@ int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin)
 //  Returns wxGIF_OK (== 0) on success, or an error code if something
 // fails (see header file for details)
 wxGIFErrorCode
-wxGIFDecoder::dgif(wxInputStream& stream, GIFImage *img, int interl, int bits)
+wxGIFDecoder::dgif(wxInputStream& stream, GIFImage *img, int interl, int bits) const
 {
     static const int allocSize = 4096 + 1;
 
@@ -866,17 +969,29 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                 if (bits == 0)
                     return wxGIF_INVFORMAT;
 
-                // decode image
+                // decode image, keeping its compressed data to be able to
+                // decode it again after it is dropped from the cache
+                pimg->interl = interl;
+                pimg->bits = bits;
+
+                m_capture = &pimg->raster;
                 wxGIFErrorCode result = dgif(stream, pimg.get(), interl, bits);
+                m_capture = NULL;
                 if (result != wxGIF_OK)
                     return result;
 
+                // ensure that decoding the captured data stops at the same
+                // place even if dgif() didn't read the terminating block
+                pimg->raster.AppendByte(0);
+
                 guardDestroy.Dismiss();
 
                 // add the image to our frame array
                 m_frames.Add(pimg.release());
                 m_nFrames++;
 
+                CacheFrame(m_nFrames - 1);
+
                 // if this is not an animated GIF, exit after first image
                 if (!anim)
                     done = true;
@@ -2257,6 +2257,178 @@ void wxImage::ClearAlpha()
     M_IMGDATA->m_alpha = NULL;
 }
 
+// ----------------------------------------------------------------------------
+// packed pixels support
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// get the rectangle to use for GetPackedPixels() and SetPackedPixels(), return
+// false if it's invalid
+bool
+GetPackedRect(const wxImage& image, const wxRect& rectOrig, int& stride,
+              wxRect& rect)
+{
+    rect = rectOrig.IsEmpty() ? wxRect(image.GetSize()) : rectOrig;
+    wxCHECK_MSG( wxRect(image.GetSize()).Contains(rect), false,
+                 wxS("rectangle outside of the image") );
+
+    if ( !stride )
+        stride = 4*rect.width;
+
+    return true;
+}
+
+inline unsigned char Premultiply(unsigned char alpha, unsigned char data)
+{
+    return static_cast<unsigned char>((alpha * data) / 255);
+}
+
+inline unsigned char Unpremultiply(unsigned char alpha, unsigned char data)
+{
+    return alpha ? static_cast<unsigned char>((data * 255) / alpha) : data;
+}
+
+} // anonymous namespace
+
+bool wxImage::GetPackedPixels(unsigned char *dst,
+                              int stride,
+                              wxImagePackedFormat format,
+                              const wxRect& rectOrig) const
+{
+    wxCHECK_MSG( IsOk(), false, wxS("invalid image") );
+
+    wxRect rect;
+    if ( !GetPackedRect(*this, rectOrig, stride, rect) )
+        return false;
+
+    const int width = M_IMGDATA->m_width;
+    for ( int y = rect.y; y < rect.GetBottom() + 1; y++, dst += stride )
+    {
+        const long offset = static_cast<long>(y) * width + rect.x;
+        const unsigned char *src = M_IMGDATA->m_data + 3*offset;
+        const unsigned char *alpha = M_IMGDATA->m_alpha
+                                        ? M_IMGDATA->m_alpha + offset
+                                        : NULL;
+
+        // test for the format and the alpha presence outside of the inner
+        // loops to keep them as simple as possible
+        switch ( format )
+        {
+            case wxIMAGE_PACKED_RGBA:
+            {
+                unsigned char *d = dst;
+                for ( int x = 0; x < rect.width; x++, src += 3, d += 4 )
+                {
+                    d[0] = src[0];
+                    d[1] = src[1];
+                    d[2] = src[2];
+                    d[3] = alpha ? *alpha++ : wxIMAGE_ALPHA_OPAQUE;
+                }
+                break;
+            }
+
+            case wxIMAGE_PACKED_ARGB32_PREMULTIPLIED:
+            {
+                wxUint32 *d = reinterpret_cast<wxUint32 *>(dst);
+                if ( alpha )
+                {
+                    for ( int x = 0; x < rect.width; x++, src += 3 )
+                    {
+                        const unsigned char a = *alpha++;
+                        *d++ = static_cast<wxUint32>(a) << 24 |
+                               Premultiply(a, src[0]) << 16 |
+                               Premultiply(a, src[1]) <<  8 |
+                               Premultiply(a, src[2]);
+                    }
+                }
+                else
+                {
+                    for ( int x = 0; x < rect.width; x++, src += 3 )
+                    {
+                        *d++ = 0xff000000u |
+                               src[0] << 16 |
+                               src[1] <<  8 |
+                               src[2];
+                    }
+                }
+                break;
+            }
+
+            default:
+                wxFAIL_MSG( wxS("unknown packed pixel format") );
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool wxImage::SetPackedPixels(const unsigned char *src,
+                              int stride,
+                              wxImagePackedFormat format,
+                              const wxRect& rectOrig)
+{
+    wxCHECK_MSG( IsOk(), false, wxS("invalid image") );
+
+    wxRect rect;
+    if ( !GetPackedRect(*this, rectOrig, stride, rect) )
+        return false;
+
+    AllocExclusive();
+
+    const int width = M_IMGDATA->m_width;
+    for ( int y = rect.y; y < rect.GetBottom() + 1; y++, src += stride )
+    {
+        const long offset = static_cast<long>(y) * width + rect.x;
+        unsigned char *dst = M_IMGDATA->m_data + 3*offset;
+        unsigned char *alpha = M_IMGDATA->m_alpha
+                                ? M_IMGDATA->m_alpha + offset
+                                : NULL;
+
+        switch ( format )
+        {
+            case wxIMAGE_PACKED_RGBA:
+            {
+                const unsigned char *s = src;
+                for ( int x = 0; x < rect.width; x++, dst += 3, s += 4 )
+                {
+                    dst[0] = s[0];
+                    dst[1] = s[1];
+                    dst[2] = s[2];
+                    if ( alpha )
+                        *alpha++ = s[3];
+                }
+                break;
+            }
+
+            case wxIMAGE_PACKED_ARGB32_PREMULTIPLIED:
+            {
+                const wxUint32 *s = reinterpret_cast<const wxUint32 *>(src);
+                for ( int x = 0; x < rect.width; x++, dst += 3 )
+                {
+                    const wxUint32 argb = *s++;
+                    const unsigned char a = argb >> 24;
+
+                    dst[0] = Unpremultiply(a, argb >> 16);
+                    dst[1] = Unpremultiply(a, argb >>  8);
+                    dst[2] = Unpremultiply(a, argb);
+                    if ( alpha )
+                        *alpha++ = a;
+                }
+                break;
+            }
+
+            default:
+                wxFAIL_MSG( wxS("unknown packed pixel format") );
+                return false;
+        }
+    }
+
+    return true;
+}
+
 
 // ----------------------------------------------------------------------------
 // mask support
@@ -3472,6 +3644,67 @@ wxImageHandler::GetResolutionFromOptions(const wxImage& image, int *x, int *y)
 // image histogram stuff
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+// Dense set of all the 2^24 RGB colours using a single bit per colour.
+//
+// This takes 2MB of memory, independently of the image size, but is much
+// faster than using a hash map for big images as there is no hashing nor
+// allocation per colour. Notice that the memory is allocated with calloc() so
+// that the OS may provide the pages filled with zeroes lazily.
+//
+// For small images, clearing the set costs more than using a hash map, so it
+// is not allocated at all for them and IsOk() returns false, just as when the
+// allocation fails, and the callers must fall back to using the hash map.
+class wxImageColourSet
+{
+public:
+    explicit wxImageColourSet(unsigned long numPixels)
+    {
+        m_bits = numPixels < MIN_PIXELS
+                    ? NULL
+                    : static_cast<wxUint32 *>(calloc(WORDS, sizeof(wxUint32)));
+    }
+
+    ~wxImageColourSet()
+    {
+        free(m_bits);
+    }
+
+    bool IsOk() const { return m_bits != NULL; }
+
+    // add the colour to the set, return true if it wasn't there yet
+    bool Add(unsigned long key)
+    {
+        wxUint32& word = m_bits[key >> 5];
+        const wxUint32 bit = 1u << (key & 31);
+        if ( word & bit )
+            return false;
+
+        word |= bit;
+        return true;
+    }
+
+    bool Has(unsigned long key) const
+    {
+        return (m_bits[key >> 5] & (1u << (key & 31))) != 0;
+    }
+
+private:
+    enum
+    {
+        WORDS = (1 << 24) / 32,
+        MIN_PIXELS = 256*256
+    };
+
+    wxUint32 *m_bits;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageColourSet);
+};
+
+} // anonymous namespace
+
 bool
 wxImage::FindFirstUnusedColour(unsigned char *r,
                                unsigned char *g,
@@ -3480,11 +3713,52 @@ wxImage::FindFirstUnusedColour(unsigned char *r,
                                unsigned char g2,
                                unsigned char b2) const
 {
-    wxImageHistogram histogram;
+    const unsigned long size = static_cast<unsigned long>(GetWidth()) * GetHeight();
+
+    wxImageColourSet colours(size);
+    if ( !colours.IsOk() )
+    {
+        // use the histogram for small images or if we couldn't allocate the set
+        wxImageHistogram histogram;
+
+        ComputeHistogram(histogram);
 
-    ComputeHistogram(histogram);
+        return histogram.FindFirstUnusedColour(r, g, b, r2, g2, b2);
+    }
+
+    const unsigned char *p = GetData();
+    for ( unsigned long n = 0; n < size; n++, p += 3 )
+        colours.Add(wxImageHistogram::MakeKey(p[0], p[1], p[2]));
 
-    return histogram.FindFirstUnusedColour(r, g, b, r2, g2, b2);
+    // this loop must be kept in sync with wxImageHistogram one
+    while ( colours.Has(wxImageHistogram::MakeKey(r2, g2, b2)) )
+    {
+        // color already used
+        r2++;
+        if ( r2 >= 255 )
+        {
+            r2 = 0;
+            g2++;
+            if ( g2 >= 255 )
+            {
+                g2 = 0;
+                b2++;
+                if ( b2 >= 255 )
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    if ( r )
+        *r = r2;
+    if ( g )
+        *g = g2;
+    if ( b )
+        *b = b2;
+
+    return true;
 }
 
 
@@ -3498,6 +3772,23 @@ wxImage::FindFirstUnusedColour(unsigned char *r,
 //
 unsigned long wxImage::CountColours( unsigned long stopafter ) const
 {
+    wxImageColourSet colours(static_cast<unsigned long>(GetWidth()) * GetHeight());
+    if ( colours.IsOk() )
+    {
+        const unsigned char *p = GetData();
+        const unsigned long size = static_cast<unsigned long>(GetWidth()) * GetHeight();
+        unsigned long nentries = 0;
+
+        for ( unsigned long j = 0; (j < size) && (nentries <= stopafter); j++, p += 3 )
+        {
+            if ( colours.Add(wxImageHistogram::MakeKey(p[0], p[1], p[2])) )
+                nentries++;
+        }
+
+        return nentries;
+    }
+
+    // use a hash table for small images or if we couldn't allocate the set
     wxHashTable h;
     wxObject dummy;
     unsigned char *p;
@@ -3535,20 +3826,37 @@ unsigned long wxImage::ComputeHistogram( wxImageHistogram &h ) const
     h.clear();
 
     const unsigned long size = static_cast<unsigned long>(GetWidth()) * GetHeight();
+    if ( !size )
+        return 0;
+
+    // Images typically contain long runs of pixels of the same colour, so
+    // count them without looking up the hash map for each of them: the
+    // entries don't move in memory when new ones are added, so it's safe to
+    // keep the pointer to the current one.
+    unsigned long key = wxImageHistogram::MakeKey(p[0], p[1], p[2]);
+    wxImageHistogramEntry *entry = &h[key];
+    entry->index = nentries++;
 
-    for ( unsigned long n = 0; n < size; n++ )
+    unsigned long count = 0;
+    for ( unsigned long n = 0; n < size; n++, p += 3 )
     {
-        unsigned char r, g, b;
-        r = *p++;
-        g = *p++;
-        b = *p++;
+        const unsigned long keyNew = wxImageHistogram::MakeKey(p[0], p[1], p[2]);
+        if ( keyNew != key )
+        {
+            entry->value += count;
+            count = 0;
 
-        wxImageHistogramEntry& entry = h[wxImageHistogram::MakeKey(r, g, b)];
+            key = keyNew;
+            entry = &h[key];
+            if ( entry->value == 0 )
+                entry->index = nentries++;
+        }
 
-        if ( entry.value++ == 0 )
-            entry.index = nentries++;
+        count++;
     }
 
+    entry->value += count;
+
     return nentries;
 }
 
@@ -752,8 +752,23 @@ bool wxPNGHandler::SaveFile( wxImage *image, wxOutputStream& stream, bool verbos
 
     const unsigned char *pColors = image->GetData();
 
+    // the most common case of 8 bit RGBA output without mask doesn't need any
+    // per-pixel processing and can just use the interleaved image data
+    const bool bPacked = iColorType == wxPNG_TYPE_COLOUR && iBitDepth == 8 &&
+                            bHasAlpha && bUseAlpha && !bHasMask;
+
     for (int y = 0; y != iHeight; ++y)
     {
+        if ( bPacked )
+        {
+            image->GetPackedPixels(data, 0, wxIMAGE_PACKED_RGBA,
+                                   wxRect(0, y, iWidth, 1));
+
+            png_bytep row_ptr = data;
+            png_write_rows( png_ptr, &row_ptr, 1 );
+            continue;
+        }
+
         unsigned char *pData = data;
         for (int x = 0; x != iWidth; x++)
         {
@@ -145,6 +145,13 @@ wxFileOffset wxMemoryInputStream::OnSysTell() const
     return m_i_streambuf->Tell();
 }
 
+const void *wxMemoryInputStream::OnSysPeekContiguous(size_t *size)
+{
+    *size = m_i_streambuf->GetBytesLeft();
+
+    return m_i_streambuf->GetBufferPos();
+}
+
 // ----------------------------------------------------------------------------
 // wxMemoryOutputStream
 // ----------------------------------------------------------------------------
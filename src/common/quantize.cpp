@@ -278,6 +278,8 @@ typedef struct {
 
   bool needs_zeroed;        /* true if next pass must zero histogram */
 
+  bool dither;          /* use Floyd-Steinberg dithering in pass 2? */
+
   /* Variables for Floyd-Steinberg dithering */
   FSERRPTR fserrors;        /* accumulated errors */
   bool on_odd_row;      /* flag to remember which row we are on */
@@ -310,18 +312,21 @@ prescan_quantize (j_decompress_ptr cinfo, JSAMPARRAY input_buf,
 
   for (row = 0; row < num_rows; row++) {
     ptr = input_buf[row];
+    histp = NULL;
     for (col = width; col > 0; col--) {
 
-      {
+      /* runs of identical pixels are common, so only look up the histogram */
+      /* cell when the pixel differs from the previous one */
+      if (!histp || ptr[0] != ptr[-3] || ptr[1] != ptr[-2] || ptr[2] != ptr[-1]) {
 
           /* get pixel value and index into the histogram */
           histp = & histogram[GETJSAMPLE(ptr[0]) >> C0_SHIFT]
                  [GETJSAMPLE(ptr[1]) >> C1_SHIFT]
                  [GETJSAMPLE(ptr[2]) >> C2_SHIFT];
-          /* increment, check for overflow and undo increment if so. */
-          if (++(*histp) <= 0)
-            (*histp)--;
       }
+      /* increment, check for overflow and undo increment if so. */
+      if (++(*histp) <= 0)
+        (*histp)--;
       ptr += 3;
     }
   }
@@ -991,7 +996,6 @@ fill_inverse_cmap (j_decompress_ptr cinfo, int c0, int c1, int c2)
  * Map some rows of pixels to the output colormapped representation.
  */
 
-#if 0
 void
 pass2_no_dither (j_decompress_ptr cinfo,
          JSAMPARRAY input_buf, JSAMPARRAY output_buf, int num_rows)
@@ -1024,7 +1028,6 @@ pass2_no_dither (j_decompress_ptr cinfo,
     }
   }
 }
-#endif
 
 void
 pass2_fs_dither (j_decompress_ptr cinfo,
@@ -1276,10 +1279,11 @@ start_pass_2_quant (j_decompress_ptr cinfo, bool is_pre_scan)
     cquantize->needs_zeroed = true; /* Always zero histogram */
   } else {
     /* Set up method pointers */
-    cquantize->pub.color_quantize = pass2_fs_dither;
+    cquantize->pub.color_quantize = cquantize->dither ? pass2_fs_dither
+                                                      : pass2_no_dither;
     cquantize->pub.finish_pass = finish_pass2;
 
-    {
+    if (cquantize->dither) {
       size_t arraysize = (size_t) ((cinfo->output_width + 2) *
                    (3 * sizeof(FSERROR)));
       /* Allocate Floyd-Steinberg workspace if we didn't already. */
@@ -1335,6 +1339,7 @@ jinit_2pass_quantizer (j_decompress_ptr cinfo)
   cquantize->pub.new_color_map = new_color_map_2_quant;
   cquantize->fserrors = NULL;   /* flag optional arrays not allocated */
   cquantize->error_limiter = NULL;
+  cquantize->dither = true;
 
 
   /* Allocate the histogram/inverse colormap storage */
@@ -1419,7 +1424,7 @@ prepare_range_limit_table (j_decompress_ptr cinfo)
 wxIMPLEMENT_DYNAMIC_CLASS(wxQuantize, wxObject);
 
 void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows,
-    unsigned char *palette, int desiredNoColours)
+    unsigned char *palette, int desiredNoColours, int flags)
 {
     j_decompress dec;
     my_cquantize_ptr cquantize;
@@ -1430,7 +1435,7 @@ void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, uns
     prepare_range_limit_table(&dec);
     jinit_2pass_quantizer(&dec);
     cquantize = (my_cquantize_ptr) dec.cquantize;
-
+    cquantize->dither = !(flags & wxQUANTIZE_NO_DITHER);
 
     cquantize->pub.start_pass(&dec, true);
     cquantize->pub.color_quantize(&dec, in_rows, out_rows, h);
@@ -1506,7 +1511,7 @@ bool wxQuantize::Quantize(const wxImage& src, wxImage& dest,
         outrows[i] = data8bit + w * i;
 
     //RGB->palette
-    DoQuantize(w, h, rows, outrows, palette, desiredNoColours);
+    DoQuantize(w, h, rows, outrows, palette, desiredNoColours, flags);
 
     delete[] rows;
     delete[] outrows;
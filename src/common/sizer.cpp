@@ -208,7 +208,8 @@ wxSizerItem::wxSizerItem(wxWindow *window,
              m_border(border),
              m_flag(flag),
              m_id(wxID_NONE),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
@@ -220,6 +221,17 @@ void wxSizerItem::DoSetSizer(wxSizer *sizer)
 {
     m_kind = Item_Sizer;
     m_sizer = sizer;
+
+    if ( sizer )
+        sizer->m_containingItem = this;
+}
+
+void wxSizerItem::DetachSizer()
+{
+    if ( m_sizer )
+        m_sizer->m_containingItem = NULL;
+
+    m_sizer = NULL;
 }
 
 wxSizerItem::wxSizerItem(wxSizer *sizer,
@@ -234,7 +246,8 @@ wxSizerItem::wxSizerItem(wxSizer *sizer,
              m_flag(flag),
              m_id(wxID_NONE),
              m_ratio(0),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
@@ -292,7 +305,8 @@ wxSizerItem::wxSizerItem(int width,
              m_border(border),
              m_flag(flag),
              m_id(wxID_NONE),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
@@ -332,6 +346,12 @@ void wxSizerItem::Free()
     m_kind = Item_None;
 }
 
+void wxSizerItem::InvalidateContainingSizer()
+{
+    if ( m_containingSizer )
+        m_containingSizer->InvalidateMinSize();
+}
+
 wxSize wxSizerItem::GetSpacer() const
 {
     wxSize size;
@@ -443,6 +463,17 @@ bool wxSizerItem::InformFirstDirection(int direction, int size, int availableOth
         }
     }
 
+    // The minimal size changed, so the cached minimal sizes of the containing
+    // sizers must be recomputed (and if this item is a sizer, its own cached
+    // size is not valid any longer neither).
+    if ( didUse )
+    {
+        if ( IsSizer() )
+            GetSizer()->InvalidateMinSize();
+        else
+            InvalidateContainingSizer();
+    }
+
     return didUse;
 }
 
@@ -629,6 +660,8 @@ void wxSizerItem::Show( bool show )
         default:
             wxFAIL_MSG( wxT("unexpected wxSizerItem::m_kind") );
     }
+
+    InvalidateContainingSizer();
 }
 
 bool wxSizerItem::IsShown() const
@@ -667,6 +700,37 @@ bool wxSizerItem::IsShown() const
 // wxSizer
 //---------------------------------------------------------------------------
 
+// The minimal sizes computed by CalcMin() are only reused during the same
+// layout pass, i.e. until the outermost Layout() call returns: this avoids
+// computing them more than once for the nested sizers, while still taking
+// into account any changes not signalled by InvalidateMinSize() during the
+// next layout.
+static unsigned gs_layoutPass = 0;
+static int gs_layoutDepth = 0;
+
+class wxSizerLayoutPass
+{
+public:
+    wxSizerLayoutPass()
+    {
+        if ( !gs_layoutDepth++ )
+        {
+            // 0 is used as "no pass" value for the newly created sizers, so
+            // skip it when wrapping around
+            if ( !++gs_layoutPass )
+                ++gs_layoutPass;
+        }
+    }
+
+    ~wxSizerLayoutPass()
+    {
+        --gs_layoutDepth;
+    }
+
+private:
+    wxDECLARE_NO_COPY_CLASS(wxSizerLayoutPass);
+};
+
 wxSizer::~wxSizer()
 {
     WX_CLEAR_LIST(wxSizerItemList, m_children);
@@ -710,8 +774,12 @@ wxSizerItem* wxSizer::DoInsert( size_t index, wxSizerItem *item )
     if ( item->GetSizer() )
         item->GetSizer()->SetContainingWindow( m_containingWindow );
 
+    item->SetContainingSizer( this );
+
     m_children.Insert( index, item );
 
+    InvalidateMinSize();
+
     return guard.Release();
 }
 
@@ -751,6 +819,7 @@ bool wxSizer::Remove( wxSizer *sizer )
         {
             delete item;
             m_children.Erase( node );
+            InvalidateMinSize();
             return true;
         }
 
@@ -773,6 +842,8 @@ bool wxSizer::Remove( int index )
     delete node->GetData();
     m_children.Erase( node );
 
+    InvalidateMinSize();
+
     return true;
 }
 
@@ -790,6 +861,7 @@ bool wxSizer::Detach( wxSizer *sizer )
             item->DetachSizer();
             delete item;
             m_children.Erase( node );
+            InvalidateMinSize();
             return true;
         }
         node = node->GetNext();
@@ -811,6 +883,7 @@ bool wxSizer::Detach( wxWindow *window )
         {
             delete item;
             m_children.Erase( node );
+            InvalidateMinSize();
             return true;
         }
         node = node->GetNext();
@@ -836,6 +909,9 @@ bool wxSizer::Detach( int index )
 
     delete item;
     m_children.Erase( node );
+
+    InvalidateMinSize();
+
     return true;
 }
 
@@ -914,6 +990,10 @@ bool wxSizer::Replace( size_t old, wxSizerItem *newitem )
     if (wxWindow* const w = newitem->GetWindow())
         w->SetContainingSizer(this);
 
+    newitem->SetContainingSizer(this);
+
+    InvalidateMinSize();
+
     return true;
 }
 
@@ -936,6 +1016,8 @@ void wxSizer::Clear( bool delete_windows )
 
     // Now empty the list
     WX_CLEAR_LIST(wxSizerItemList, m_children);
+
+    InvalidateMinSize();
 }
 
 void wxSizer::DeleteWindows()
@@ -1030,9 +1112,24 @@ void wxSizer::RecalcSizes()
 
 void wxSizer::Layout()
 {
+    wxSizerLayoutPass layoutPass;
+
     // (re)calculates minimums needed for each item and other preparations
-    // for layout
-    const wxSize minSize = CalcMin();
+    // for layout, unless this was already done during the current pass, as
+    // happens for the nested sizers whose CalcMin() was called by the
+    // CalcMin() of their parent
+    wxSize minSize;
+    if ( IsMinSizeCached() )
+    {
+        minSize = m_cachedMinSize;
+    }
+    else
+    {
+        minSize = CalcMin();
+
+        m_cachedMinSize = minSize;
+        m_cachedMinSizePass = gs_layoutPass;
+    }
 
     // Applies the layout and repositions/resizes the items
     wxWindow::ChildrenRepositioningGuard repositionGuard(m_containingWindow);
@@ -1082,18 +1179,68 @@ wxSize wxSizer::VirtualFitSize( wxWindow *window )
     return size;
 }
 
+bool wxSizer::IsMinSizeCached() const
+{
+    return gs_layoutDepth > 0 &&
+            m_cachedMinSizePass == gs_layoutPass &&
+                m_cachedMinSize != wxDefaultSize;
+}
+
 wxSize wxSizer::GetMinSize()
 {
-    wxSize ret( CalcMin() );
+    // CalcMin() is expensive for the sizers containing many items, directly
+    // or in the nested sizers, so avoid calling it more than once for the
+    // same sizer during a single layout pass.
+    if ( !IsMinSizeCached() )
+    {
+        m_cachedMinSize = CalcMin();
+        m_cachedMinSizePass = gs_layoutPass;
+    }
+
+    wxSize ret( m_cachedMinSize );
     if (ret.x < m_minSize.x) ret.x = m_minSize.x;
     if (ret.y < m_minSize.y) ret.y = m_minSize.y;
     return ret;
 }
 
+void wxSizer::InvalidateMinSize()
+{
+    wxSizer * const outermost = DoInvalidateMinSize();
+
+    // The best size of the window using the outermost sizer depends on its
+    // minimal size and this will take care of invalidating the sizers
+    // containing this window, if any, as well.
+    wxWindow * const win = outermost->m_containingWindow;
+    if ( win && win->GetSizer() == outermost )
+        win->InvalidateBestSize();
+}
+
+wxSizer *wxSizer::DoInvalidateMinSize()
+{
+    // Notice that we can't stop at the first sizer with already invalidated
+    // minimal size as its parent one might have been computed without it if
+    // it was hidden, so we always need to go up to the outermost sizer.
+    wxSizer *sizer = this;
+    for ( ;; )
+    {
+        sizer->m_cachedMinSize = wxDefaultSize;
+
+        wxSizer * const parent = sizer->m_containingItem
+                                    ? sizer->m_containingItem->GetContainingSizer()
+                                    : NULL;
+        if ( !parent )
+            return sizer;
+
+        sizer = parent;
+    }
+}
+
 void wxSizer::DoSetMinSize( int width, int height )
 {
     m_minSize.x = width;
     m_minSize.y = height;
+
+    InvalidateMinSize();
 }
 
 bool wxSizer::DoSetItemMinSize( wxWindow *window, int width, int height )
@@ -2031,6 +2178,8 @@ void wxFlexGridSizer::AddGrowableRow( size_t idx, int proportion )
 
     m_growableRows.Add( idx );
     m_growableRowsProportions.Add( proportion );
+
+    InvalidateMinSize();
 }
 
 void wxFlexGridSizer::AddGrowableCol( size_t idx, int proportion )
@@ -2044,6 +2193,8 @@ void wxFlexGridSizer::AddGrowableCol( size_t idx, int proportion )
 
     m_growableCols.Add( idx );
     m_growableColsProportions.Add( proportion );
+
+    InvalidateMinSize();
 }
 
 // helper function for RemoveGrowableCol/Row()
@@ -2067,11 +2218,15 @@ DoRemoveFromArrays(size_t idx, wxArrayInt& items, wxArrayInt& proportions)
 void wxFlexGridSizer::RemoveGrowableCol( size_t idx )
 {
     DoRemoveFromArrays(idx, m_growableCols, m_growableColsProportions);
+
+    InvalidateMinSize();
 }
 
 void wxFlexGridSizer::RemoveGrowableRow( size_t idx )
 {
     DoRemoveFromArrays(idx, m_growableRows, m_growableRowsProportions);
+
+    InvalidateMinSize();
 }
 
 //---------------------------------------------------------------------------
@@ -76,6 +76,14 @@ void wxStaticBoxBase::WXDestroyWithoutChildren()
     delete this;
 }
 
+void wxStaticBoxBase::SetLabel(const wxString& label)
+{
+    wxNavigationEnabled<wxControl>::SetLabel(label);
+
+    // the best size of the box, used by wxStaticBoxSizer, depends on its label
+    InvalidateBestSize();
+}
+
 bool wxStaticBoxBase::Enable(bool enable)
 {
 #ifdef wxHAS_WINDOW_LABEL_IN_STATIC_BOX
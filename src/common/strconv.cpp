@@ -952,6 +952,70 @@ extern const unsigned char tableUtf8Lengths[256] = {
                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F5..FF
 };
 
+// Return the number of ASCII characters at the start of the given string,
+// which is either NUL-terminated, if len is wxNO_LEN, or has the given length.
+//
+// Most of the text is ASCII, so this is used to process the runs of such
+// characters in bulk, which is much faster than decoding them one by one.
+static size_t wxGetASCIILength(const char *src, size_t len)
+{
+    size_t n = 0;
+
+    if ( len == wxNO_LEN )
+    {
+        // We can't read beyond the terminating NUL, so check one byte at a
+        // time in this case.
+        while ( src[n] && !(src[n] & 0x80) )
+            n++;
+
+        return n;
+    }
+
+    // Check as many bytes as fit into a machine word at once: they're all
+    // ASCII if none of them has the high bit set.
+    static const size_t highBits = ~static_cast<size_t>(0) / 0xff * 0x80;
+    for ( ; len - n >= sizeof(size_t); n += sizeof(size_t) )
+    {
+        size_t word;
+        memcpy(&word, src + n, sizeof(word));
+        if ( word & highBits )
+            break;
+    }
+
+    while ( n < len && !(src[n] & 0x80) )
+        n++;
+
+    return n;
+}
+
+// Same as above but for wide strings, with end being NULL for NUL-terminated
+// strings.
+static size_t wxGetASCIILength(const wchar_t *src, const wchar_t *end)
+{
+    const wchar_t *p = src;
+    if ( end )
+    {
+        while ( p != end && static_cast<wxUint32>(*p) < 0x80 )
+            p++;
+    }
+    else
+    {
+        while ( *p && static_cast<wxUint32>(*p) < 0x80 )
+            p++;
+    }
+
+    return p - src;
+}
+
+// Copy the ASCII characters, which must have been checked to be such by the
+// caller, to the output buffer of a different character type.
+template <typename TDst, typename TSrc>
+static inline void wxCopyASCII(TDst *dst, const TSrc *src, size_t len)
+{
+    for ( size_t n = 0; n < len; n++ )
+        dst[n] = static_cast<TDst>(src[n]);
+}
+
 size_t
 wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
                             const char *src, size_t srcLen) const
@@ -964,6 +1028,26 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
 
     for ( const char *p = src; ; p++ )
     {
+        // Convert all ASCII characters starting at the current position at
+        // once, the loop below only needs to decode the other ones.
+        size_t numASCII = wxGetASCIILength(p, srcLen);
+        if ( numASCII )
+        {
+            if ( out )
+            {
+                if ( numASCII > dstLen )
+                    numASCII = dstLen;
+
+                wxCopyASCII(out, p, numASCII);
+                out += numASCII;
+                dstLen -= numASCII;
+            }
+
+            p += numASCII;
+            srcLen -= numASCII;
+            written += numASCII;
+        }
+
         if ( (srcLen == wxNO_LEN ? !*p : !srcLen) )
         {
             // all done successfully, just add the trailing NULL if we are not
@@ -1077,6 +1161,24 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     const wchar_t* const end = srcLen == wxNO_LEN ? NULL : src + srcLen;
     for ( const wchar_t *wp = src; ; )
     {
+        // Convert all ASCII characters at once, as in ToWChar() above.
+        size_t numASCII = wxGetASCIILength(wp, end);
+        if ( numASCII )
+        {
+            if ( out )
+            {
+                if ( numASCII > dstLen )
+                    numASCII = dstLen;
+
+                wxCopyASCII(out, wp, numASCII);
+                out += numASCII;
+                dstLen -= numASCII;
+            }
+
+            wp += numASCII;
+            written += numASCII;
+        }
+
         if ( end ? wp == end : !*wp )
         {
             // all done successfully, just add the trailing NULL if we are not
@@ -1204,13 +1306,36 @@ size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
                 *buf++ = cc;
             len++;
 
-            // escape the escape character for octal escapes
-            if ((m_options & MAP_INVALID_UTF8_TO_OCTAL)
-                    && cc == '\\' && (!buf || len < n))
+            if (m_options & MAP_INVALID_UTF8_TO_OCTAL)
+            {
+                // escape the escape character for octal escapes
+                if (cc == '\\' && (!buf || len < n))
+                {
+                    if (buf)
+                        *buf++ = cc;
+                    len++;
+                }
+            }
+            else
             {
+                // ASCII characters usually come in runs, so convert all the
+                // following ones at once
+                size_t numASCII = wxGetASCIILength(psz, isNulTerminated
+                                                            ? wxNO_LEN
+                                                            : srcLen);
                 if (buf)
-                    *buf++ = cc;
-                len++;
+                {
+                    if (numASCII > n - len)
+                        numASCII = n - len;
+
+                    wxCopyASCII(buf, psz, numASCII);
+                    buf += numASCII;
+                }
+
+                psz += numASCII;
+                if (!isNulTerminated)
+                    srcLen -= numASCII;
+                len += numASCII;
             }
         }
         else
@@ -1416,6 +1541,24 @@ size_t wxMBConvUTF8::FromWChar(char *buf, size_t n,
                 if (buf)
                     *buf++ = (char) cc;
                 len++;
+
+                // and all the following ones, unless we need to check them
+                // for the octal escapes
+                if ( !(m_options & MAP_INVALID_UTF8_TO_OCTAL) )
+                {
+                    size_t numASCII = wxGetASCIILength(psz, end);
+                    if ( buf )
+                    {
+                        if ( numASCII > n - len )
+                            numASCII = n - len;
+
+                        wxCopyASCII(buf, psz, numASCII);
+                        buf += numASCII;
+                    }
+
+                    psz += numASCII;
+                    len += numASCII;
+                }
             }
             else
             {
@@ -890,6 +890,22 @@ char wxInputStream::Peek()
 wxInputStream& wxInputStream::Read(wxOutputStream& stream_out)
 {
     size_t lastcount = 0;
+
+    // if all our data is in memory, write it directly from there
+    size_t size;
+    const void *data = PeekContiguous(&size);
+    if ( data && size )
+    {
+        lastcount = stream_out.Write(data, size).LastWrite();
+        SeekI(lastcount, wxFromCurrent);
+
+        if ( lastcount != size )
+        {
+            m_lastcount = lastcount;
+            return *this;
+        }
+    }
+
     char buf[BUF_TEMP_SIZE];
 
     for ( ;; )
@@ -909,6 +925,25 @@ wxInputStream& wxInputStream::Read(wxOutputStream& stream_out)
     return *this;
 }
 
+const void *wxInputStream::PeekContiguous(size_t *size)
+{
+    wxCHECK_MSG( size, NULL, wxT("NULL size pointer") );
+
+    *size = 0;
+
+    // the data written back by Ungetch() comes before the data of the stream
+    // itself and isn't contiguous with it
+    if ( m_wback && m_wbackcur < m_wbacksize )
+        return NULL;
+
+    return OnSysPeekContiguous(size);
+}
+
+const void *wxInputStream::OnSysPeekContiguous(size_t *WXUNUSED(size))
+{
+    return NULL;
+}
+
 bool wxInputStream::ReadAll(void *buffer_, size_t size)
 {
     char* buffer = static_cast<char*>(buffer_);
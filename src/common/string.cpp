@@ -34,6 +34,7 @@
 #include "wx/hashmap.h"
 #include "wx/vector.h"
 #include "wx/xlocale.h"
+#include "wx/private/atomic.h"
 
 #ifdef __WINDOWS__
     #include "wx/msw/wrapwin.h"
@@ -240,8 +241,9 @@ wxSTD wostream& operator<<(wxSTD wostream& wos, const wxScopedWCharBuffer& str)
 
 #if wxUSE_UNICODE_UTF8
 
-void wxString::PosLenToImpl(size_t pos, size_t len,
-                            size_t *implPos, size_t *implLen) const
+void wxString::DoPosLenToImpl(size_t pos, size_t len,
+                              size_t *implPos, size_t *implLen,
+                              bool canBuildIndex) const
 {
     if ( pos == npos )
     {
@@ -249,7 +251,8 @@ void wxString::PosLenToImpl(size_t pos, size_t len,
     }
     else // have valid start position
     {
-        const const_iterator b = GetIterForNthChar(pos);
+        const const_iterator
+            b(this, m_impl.begin() + (pos ? DoPosToImpl(pos, canBuildIndex) : 0));
         *implPos = wxStringImpl::const_iterator(b.impl()) - m_impl.begin();
         if ( len == npos )
         {
@@ -272,6 +275,103 @@ void wxString::PosLenToImpl(size_t pos, size_t len,
     }
 }
 
+#if wxUSE_STRING_POS_INDEX
+
+const wxString::PosIndex *wxString::DoBuildPosIndex() const
+{
+    // there can't be more characters than bytes, so allocate enough entries
+    // for the worst case, which is also the most common one, as most of the
+    // characters are usually ASCII
+    const size_t maxCount = m_impl.length() / PosIndex::STEP + 1;
+    PosIndex * const
+        index = (PosIndex *)malloc(sizeof(PosIndex) +
+                                   (maxCount - 1)*sizeof(size_t));
+    if ( !index )
+        return NULL;
+
+    size_t count = 0;
+    size_t n = 0;
+    const wxStringImpl::const_iterator b(m_impl.begin());
+    const wxStringImpl::const_iterator e(m_impl.end());
+    for ( wxStringImpl::const_iterator i(b); ; n++ )
+    {
+        if ( n % PosIndex::STEP == 0 )
+            index->offsets[count++] = i - b;
+
+        if ( i == e )
+            break;
+
+        wxStringOperations::IncIter(i);
+    }
+
+    index->count = count;
+
+    // another thread may have built the index for this string concurrently,
+    // in which case use its index and not ours, as it may be already used
+    if ( !wxAtomicCompareExchange(m_posIndex.ptr,
+                                  static_cast<PosIndex *>(NULL),
+                                  index) )
+    {
+        free(index);
+    }
+
+    return m_posIndex.ptr;
+}
+
+size_t wxString::DoPosToImplUsingIndex(const PosIndex *index,
+                                       size_t pos,
+                                       size_t fromPos,
+                                       size_t fromImpl) const
+{
+    // start from the closest indexed character, unless the known position is
+    // even closer
+    size_t n = pos / PosIndex::STEP;
+    if ( n >= index->count )
+        n = index->count - 1;
+
+    size_t curPos = n*PosIndex::STEP;
+    size_t curImpl = index->offsets[n];
+    if ( fromPos > curPos )
+    {
+        curPos = fromPos;
+        curImpl = fromImpl;
+    }
+
+    wxStringImpl::const_iterator i(m_impl.begin() + curImpl);
+    const wxStringImpl::const_iterator e(m_impl.end());
+    for ( ; curPos < pos && i != e; curPos++ )
+        wxStringOperations::IncIter(i);
+
+    return i - m_impl.begin();
+}
+
+size_t
+wxString::DoPosFromImplUsingIndex(const PosIndex *index, size_t impl) const
+{
+    // find the last indexed character not after the given offset
+    const size_t * const offsets = index->offsets;
+    size_t lo = 0,
+           hi = index->count;
+    while ( hi - lo > 1 )
+    {
+        const size_t mid = lo + (hi - lo) / 2;
+        if ( offsets[mid] <= impl )
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    size_t pos = lo*PosIndex::STEP;
+    wxStringImpl::const_iterator i(m_impl.begin() + offsets[lo]);
+    const wxStringImpl::const_iterator target(m_impl.begin() + impl);
+    for ( ; i < target; pos++ )
+        wxStringOperations::IncIter(i);
+
+    return pos;
+}
+
+#endif // wxUSE_STRING_POS_INDEX
+
 #endif // wxUSE_UNICODE_UTF8
 
 // ----------------------------------------------------------------------------
@@ -12,6 +12,12 @@
 
 
 #include "wx/private/threadinfo.h"
+#include "wx/private/wxprintf.h"
+
+wxThreadSpecificInfo::~wxThreadSpecificInfo()
+{
+    delete printfFormatCache;
+}
 
 #if wxUSE_THREADS
 
@@ -153,9 +153,7 @@ wxUniCharRef& wxUniCharRef::operator=(const wxUniChar& c)
         // update the string:
         strimpl.replace(m_pos, m_pos + lenOld, utf, lenNew);
 
-#if wxUSE_STRING_POS_CACHE
         m_str.InvalidateCache();
-#endif // wxUSE_STRING_POS_CACHE
 
         // finally, set the iterators to valid values again (note that this
         // updates m_pos as well):
@@ -22,6 +22,10 @@
 
 #include <stdio.h>
 
+#ifdef __UNIX__
+    #include <sys/mman.h>
+#endif
+
 #if wxUSE_FILE
 
 // ----------------------------------------------------------------------------
@@ -108,6 +112,131 @@ bool wxFileInputStream::IsOk() const
     return wxInputStream::IsOk() && m_file->IsOpened();
 }
 
+// ----------------------------------------------------------------------------
+// wxMappedFileInputStream
+// ----------------------------------------------------------------------------
+
+wxMappedFileInputStream::wxMappedFileInputStream(const wxString& fileName)
+  : wxFileInputStream(fileName)
+{
+    m_data = NULL;
+    m_length = 0;
+    m_pos = 0;
+
+#ifdef __UNIX__
+    if ( !m_file->IsOpened() || m_file->GetKind() != wxFILE_KIND_DISK )
+        return;
+
+    // empty files can't be mapped and neither can those not fitting in the
+    // address space, just read them normally
+    const wxFileOffset length = m_file->Length();
+    if ( length <= 0 || wxFileOffset(size_t(length)) != length )
+        return;
+
+    void * const data = mmap(NULL, size_t(length), PROT_READ, MAP_PRIVATE,
+                             m_file->fd(), 0);
+    if ( data == MAP_FAILED )
+        return;
+
+    // start at the same position as the file itself
+    const wxFileOffset pos = m_file->Tell();
+    if ( pos == wxInvalidOffset )
+    {
+        munmap(data, size_t(length));
+        return;
+    }
+
+    m_data = data;
+    m_length = size_t(length);
+    m_pos = pos;
+#endif // __UNIX__
+}
+
+wxMappedFileInputStream::~wxMappedFileInputStream()
+{
+#ifdef __UNIX__
+    if ( m_data )
+        munmap(m_data, m_length);
+#endif // __UNIX__
+}
+
+wxFileOffset wxMappedFileInputStream::GetLength() const
+{
+    return m_data ? wxFileOffset(m_length) : wxFileInputStream::GetLength();
+}
+
+size_t wxMappedFileInputStream::OnSysRead(void *buffer, size_t size)
+{
+    if ( !m_data )
+        return wxFileInputStream::OnSysRead(buffer, size);
+
+    if ( m_pos >= wxFileOffset(m_length) )
+    {
+        m_lasterror = wxSTREAM_EOF;
+        return 0;
+    }
+
+    size_t count = m_length - size_t(m_pos);
+    if ( size < count )
+        count = size;
+
+    memcpy(buffer, static_cast<const char *>(m_data) + m_pos, count);
+    m_pos += count;
+
+    m_lasterror = wxSTREAM_NO_ERROR;
+
+    return count;
+}
+
+wxFileOffset wxMappedFileInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
+{
+    if ( !m_data )
+        return wxFileInputStream::OnSysSeek(pos, mode);
+
+    switch ( mode )
+    {
+        case wxFromStart:
+            break;
+
+        case wxFromCurrent:
+            pos += m_pos;
+            break;
+
+        case wxFromEnd:
+            pos += m_length;
+            break;
+
+        default:
+            wxFAIL_MSG( wxT("invalid seek mode") );
+            return wxInvalidOffset;
+    }
+
+    // as with the files, seeking beyond the end is allowed but reading there
+    // just returns EOF
+    if ( pos < 0 )
+        return wxInvalidOffset;
+
+    m_pos = pos;
+
+    return m_pos;
+}
+
+wxFileOffset wxMappedFileInputStream::OnSysTell() const
+{
+    return m_data ? m_pos : wxFileInputStream::OnSysTell();
+}
+
+const void *wxMappedFileInputStream::OnSysPeekContiguous(size_t *size)
+{
+    if ( !m_data )
+        return NULL;
+
+    const size_t pos = m_pos < wxFileOffset(m_length) ? size_t(m_pos) : m_length;
+    *size = m_length - pos;
+
+    return static_cast<const char *>(m_data) + pos;
+}
+
 // ----------------------------------------------------------------------------
 // wxFileOutputStream
 // ----------------------------------------------------------------------------
@@ -80,6 +80,8 @@
     #include "wx/msw/wrapwin.h"
 #endif
 
+#include <algorithm>
+
 // Windows List
 WXDLLIMPEXP_DATA_CORE(wxWindowList) wxTopLevelWindows;
 
@@ -98,6 +100,34 @@ bool IsInCaptureStack(wxWindowBase* win);
 
 } // wxMouseCapture
 
+namespace
+{
+
+// windows whose layout was deferred by wxWindowBase::WXDeferLayout(), entries
+// for the windows destroyed while the deferred layouts are being done are
+// reset to NULL
+wxVector<wxWindowBase*> gs_deferredLayouts;
+
+// number of wxWindowBase::Thaw() calls currently thawing the children of a
+// window
+int gs_thawingChildren = 0;
+
+int GetWindowDepth(const wxWindowBase* win)
+{
+    int depth = 0;
+    while ( !win->IsTopLevel() && (win = win->GetParent()) != NULL )
+        depth++;
+
+    return depth;
+}
+
+bool CompareWindowDepth(const wxWindowBase* win1, const wxWindowBase* win2)
+{
+    return GetWindowDepth(win1) < GetWindowDepth(win2);
+}
+
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 // static data
 // ----------------------------------------------------------------------------
@@ -354,6 +384,10 @@ wxWindowBase::wxWindowBase()
     m_isBeingDeleted = false;
 
     m_freezeCount = 0;
+
+    m_layoutTransactionCount = 0;
+    m_layoutDeferred =
+    m_layoutDeferredExplicitly = false;
 }
 
 // common part of window creation process
@@ -463,6 +497,19 @@ wxWindowBase::~wxWindowBase()
     // we weren't a dialog class
     wxTopLevelWindows.DeleteObject((wxWindow*)this);
 
+    // Don't try to lay out this window later neither.
+    if ( m_layoutDeferred )
+    {
+        wxVector<wxWindowBase*>::iterator it = std::find
+                                               (
+                                                gs_deferredLayouts.begin(),
+                                                gs_deferredLayouts.end(),
+                                                this
+                                               );
+        if ( it != gs_deferredLayouts.end() )
+            *it = NULL;
+    }
+
     // Any additional event handlers should be popped before the window is
     // deleted as otherwise the last handler will be left with a dangling
     // pointer to this window result in a difficult to diagnose crash later on.
@@ -657,6 +704,12 @@ void wxWindowBase::InvalidateBestSize()
 {
     m_bestSizeCache = wxDefaultSize;
 
+    // the minimal size of the sizers containing this window depends on its
+    // best size, but notice that we must not invalidate the best size of
+    // our parent from here as we do it below anyhow
+    if ( m_containingSizer )
+        m_containingSizer->WXInvalidateCachedMinSize();
+
     // parent's best size calculation may depend on its children's
     // as long as child window we are in is not top level window itself
     // (because the TLW size is never resized automatically)
@@ -1169,6 +1222,10 @@ bool wxWindowBase::Show(bool show)
     {
         m_isShown = show;
 
+        // hidden windows are not taken into account by the sizers
+        if ( m_containingSizer )
+            m_containingSizer->InvalidateMinSize();
+
         return true;
     }
     else
@@ -1289,6 +1346,7 @@ void wxWindowBase::Thaw()
     if ( !--m_freezeCount )
     {
         // recursively thaw all children:
+        gs_thawingChildren++;
         for ( wxWindowList::iterator i = GetChildren().begin();
               i != GetChildren().end(); ++i )
         {
@@ -1298,10 +1356,119 @@ void wxWindowBase::Thaw()
 
             child->Thaw();
         }
+        gs_thawingChildren--;
 
         // physically thaw this window:
         DoThaw();
+
+        // and perform the layouts deferred while it was frozen, but only once,
+        // after all its children have been thawed too
+        if ( !gs_thawingChildren && !gs_deferredLayouts.empty() )
+            LayoutDeferredWindows();
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Layout transactions
+// ----------------------------------------------------------------------------
+
+void wxWindowBase::BeginLayoutTransaction()
+{
+    m_layoutTransactionCount++;
+}
+
+void wxWindowBase::CommitLayoutTransaction()
+{
+    wxASSERT_MSG( m_layoutTransactionCount,
+                  "CommitLayoutTransaction() without matching "
+                  "BeginLayoutTransaction()" );
+
+    if ( !--m_layoutTransactionCount && !gs_deferredLayouts.empty() )
+        LayoutDeferredWindows();
+}
+
+bool wxWindowBase::IsInLayoutTransaction() const
+{
+    for ( const wxWindowBase* win = this; win; win = win->GetParent() )
+    {
+        if ( win->m_layoutTransactionCount )
+            return true;
+
+        // transactions of the parent window don't affect top level windows
+        if ( win->IsTopLevel() )
+            break;
+    }
+
+    return false;
+}
+
+bool wxWindowBase::WXDeferLayout(bool automatic)
+{
+    // Explicit layout requests are only deferred inside a transaction and not
+    // merely because the window is frozen, as the code calling Layout() may
+    // rely on the children being positioned when it returns.
+    if ( !IsInLayoutTransaction() && !(automatic && IsFrozen()) )
+        return false;
+
+    if ( !automatic )
+        m_layoutDeferredExplicitly = true;
+
+    if ( !m_layoutDeferred )
+    {
+        m_layoutDeferred = true;
+        gs_deferredLayouts.push_back(this);
+    }
+
+    return true;
+}
+
+bool wxWindowBase::IsLayoutStillDeferred() const
+{
+    if ( IsInLayoutTransaction() )
+        return true;
+
+    return IsFrozen() && !m_layoutDeferredExplicitly;
+}
+
+/* static */
+void wxWindowBase::LayoutDeferredWindows()
+{
+    // Laying out a window may end another transaction, don't do anything in
+    // this case as the loop below will process any newly added windows.
+    static wxRecursionGuardFlag s_flagReentrancy;
+    wxRecursionGuard guard(s_flagReentrancy);
+    if ( guard.IsInside() )
+        return;
+
+    // Remove the entries for the already destroyed windows and sort the others
+    // to lay out the parents before their children: doing it for the parent
+    // usually lays out the children too and then they don't need it any more.
+    gs_deferredLayouts.erase(std::remove(gs_deferredLayouts.begin(),
+                                         gs_deferredLayouts.end(),
+                                         static_cast<wxWindowBase*>(NULL)),
+                             gs_deferredLayouts.end());
+    std::stable_sort(gs_deferredLayouts.begin(), gs_deferredLayouts.end(),
+                     CompareWindowDepth);
+
+    // Notice that the vector can grow while we iterate over it and that its
+    // elements can be reset to NULL if the corresponding windows are destroyed.
+    for ( size_t n = 0; n < gs_deferredLayouts.size(); n++ )
+    {
+        wxWindowBase* const win = gs_deferredLayouts[n];
+        if ( !win || win->IsLayoutStillDeferred() )
+            continue;
+
+        gs_deferredLayouts[n] = NULL;
+        win->m_layoutDeferred =
+        win->m_layoutDeferredExplicitly = false;
+
+        win->Layout();
     }
+
+    gs_deferredLayouts.erase(std::remove(gs_deferredLayouts.begin(),
+                                         gs_deferredLayouts.end(),
+                                         static_cast<wxWindowBase*>(NULL)),
+                             gs_deferredLayouts.end());
 }
 
 // ----------------------------------------------------------------------------
@@ -2464,6 +2631,9 @@ void wxWindowBase::SetSizer(wxSizer *sizer, bool deleteOld)
     }
 
     SetAutoLayout(m_windowSizer != NULL);
+
+    // our best size is determined by the sizer, if we have one
+    InvalidateBestSize();
 }
 
 void wxWindowBase::SetSizerAndFit(wxSizer *sizer, bool deleteOld)
@@ -2523,6 +2693,10 @@ void wxWindowBase::SatisfyConstraints()
 
 bool wxWindowBase::Layout()
 {
+    // Postpone the layout if we're inside a layout transaction.
+    if ( WXDeferLayout() )
+        return true;
+
     // If there is a sizer, use it instead of the constraints
     if ( GetSizer() )
     {
@@ -2543,7 +2717,9 @@ bool wxWindowBase::Layout()
 
 void wxWindowBase::InternalOnSize(wxSizeEvent& event)
 {
-    if ( GetAutoLayout() )
+    // Don't lay out the window whenever its size changes while it's frozen, but
+    // do it once it's thawed.
+    if ( GetAutoLayout() && !WXDeferLayout(true) )
         Layout();
 
     event.Skip();
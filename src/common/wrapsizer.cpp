@@ -564,6 +564,7 @@ void wxWrapSizer::RepositionChildren(const wxSize& WXUNUSED(minSize))
                 // another real item to the same row we need to add the spacer
                 // between them two.
                 sizer->Add(itemSpace);
+                itemSpace->SetContainingSizer(this);
             }
 
             // We must pretend that any window item is not part of this sizer,
@@ -579,13 +580,16 @@ void wxWrapSizer::RepositionChildren(const wxSize& WXUNUSED(minSize))
             sizer->Add(item);
 
             // If item is a window, it now has a pointer to the child sizer,
-            // which is wrong. Set it to point to us.
+            // which is wrong. Set it to point to us. The same applies to the
+            // item itself.
             if ( win )
             {
                 win->SetContainingSizer(NULL);
                 win->SetContainingSizer(this);
             }
 
+            item->SetContainingSizer(this);
+
             itemLast = item;
             itemSpace = NULL;
         }
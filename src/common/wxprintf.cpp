@@ -24,9 +24,123 @@
 #endif
 
 #include "wx/private/wxprintf.h"
+#include "wx/private/threadinfo.h"
 
 #include <errno.h>
 
+// ============================================================================
+// cache of the parsed format strings
+// ============================================================================
+
+namespace
+{
+
+// The cache is thread-specific, so that it can be used without locking.
+inline wxPrintfFormatCache& GetPrintfFormatCache()
+{
+    wxPrintfFormatCache*& cache = wxThreadInfo.printfFormatCache;
+    if ( !cache )
+        cache = new wxPrintfFormatCache;
+
+    return *cache;
+}
+
+inline wxPrintfCache<char>& GetPrintfCache(const char *)
+{
+    return GetPrintfFormatCache().cacheChar;
+}
+
+inline wxPrintfCache<wchar_t>& GetPrintfCache(const wchar_t *)
+{
+    return GetPrintfFormatCache().cacheWChar;
+}
+
+template<typename CharType>
+wxPrintfCacheEntry<CharType>& GetPrintfCacheEntry(const CharType *fmt)
+{
+    // the low bits of the address are often the same because of alignment,
+    // so mix in the higher ones too
+    const wxUIntPtr addr = wxPtrToUInt(fmt);
+    const size_t n = (addr ^ (addr >> 6) ^ (addr >> 12)) & (wxPRINTF_CACHE_SIZE - 1);
+
+    return GetPrintfCache(fmt).entries[n];
+}
+
+template<typename CharType>
+bool DoGetCachedPrintfFormat(const CharType *fmt,
+                             wxPrintfConvSpecParser<CharType>& parser)
+{
+    const wxPrintfCacheEntry<CharType>& entry = GetPrintfCacheEntry(fmt);
+    if ( entry.format != fmt || wxStrcmp(&entry.copy[0], fmt) != 0 )
+        return false;
+
+    // the cached specs point into the format string, but this is fine as the
+    // string at this address is the same one
+    parser.nspecs = entry.specs.size();
+    for ( unsigned n = 0; n < parser.nspecs; n++ )
+        parser.specs[n] = entry.specs[n];
+
+    parser.nargs = entry.args.size();
+    for ( unsigned n = 0; n < parser.nargs; n++ )
+    {
+        const int spec = entry.args[n];
+        parser.pspec[n] = spec == -1 ? NULL : &parser.specs[spec];
+    }
+
+    parser.posarg_present = entry.posarg_present;
+    parser.nonposarg_present = entry.nonposarg_present;
+
+    return true;
+}
+
+template<typename CharType>
+void DoCachePrintfFormat(const CharType *fmt,
+                         const wxPrintfConvSpecParser<CharType>& parser)
+{
+    wxPrintfCacheEntry<CharType>& entry = GetPrintfCacheEntry(fmt);
+
+    entry.format = fmt;
+    entry.copy.assign(fmt, fmt + wxStrlen(fmt) + 1);
+
+    entry.specs.assign(parser.specs, parser.specs + parser.nspecs);
+
+    entry.args.clear();
+    for ( unsigned n = 0; n < parser.nargs; n++ )
+    {
+        const wxPrintfConvSpec<CharType>* const spec = parser.pspec[n];
+        entry.args.push_back(spec ? spec - parser.specs : -1);
+    }
+
+    entry.posarg_present = parser.posarg_present;
+    entry.nonposarg_present = parser.nonposarg_present;
+}
+
+} // anonymous namespace
+
+bool wxGetCachedPrintfFormat(const char *fmt,
+                             wxPrintfConvSpecParser<char>& parser)
+{
+    return DoGetCachedPrintfFormat(fmt, parser);
+}
+
+bool wxGetCachedPrintfFormat(const wchar_t *fmt,
+                             wxPrintfConvSpecParser<wchar_t>& parser)
+{
+    return DoGetCachedPrintfFormat(fmt, parser);
+}
+
+void wxCachePrintfFormat(const char *fmt,
+                         const wxPrintfConvSpecParser<char>& parser)
+{
+    DoCachePrintfFormat(fmt, parser);
+}
+
+void wxCachePrintfFormat(const wchar_t *fmt,
+                         const wxPrintfConvSpecParser<wchar_t>& parser)
+{
+    DoCachePrintfFormat(fmt, parser);
+}
+
 // ============================================================================
 // printf() implementation
 // ============================================================================
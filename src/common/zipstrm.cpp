@@ -25,6 +25,7 @@
 #include "wx/zstream.h"
 #include "wx/mstream.h"
 #include "wx/scopedptr.h"
+#include "wx/vector.h"
 #include "wx/wfstream.h"
 #include "zlib.h"
 
@@ -728,6 +729,76 @@ wxZipEntry *wxZipWeakLinks::GetEntry(wxFileOffset key) const
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Index of the entries in the central directory, keyed on their internal
+// names. It's reference counted so that several input streams reading the
+// same archive can share it.
+
+WX_DECLARE_STRING_HASH_MAP(wxZipEntry*, wxNameZipEntryMap_);
+
+class wxZipIndex
+{
+public:
+    wxZipIndex(wxFileOffset centralOffset,
+               wxFileOffset offsetAdjustment,
+               size_t totalEntries,
+               const wxString& comment)
+      : m_ref(1),
+        m_centralOffset(centralOffset),
+        m_offsetAdjustment(offsetAdjustment),
+        m_totalEntries(totalEntries),
+        m_comment(comment)
+    { }
+
+    wxZipIndex *AddRef() { m_ref++; return this; }
+    void Release() { if (--m_ref == 0) delete this; }
+
+    void Add(wxZipEntry *entry);
+    wxZipEntry *Find(const wxString& internalName) const;
+
+    wxFileOffset GetCentralOffset() const   { return m_centralOffset; }
+    wxFileOffset GetOffsetAdjustment() const { return m_offsetAdjustment; }
+    size_t GetTotalEntries() const          { return m_totalEntries; }
+    const wxString& GetComment() const      { return m_comment; }
+
+private:
+    ~wxZipIndex();
+
+    int m_ref;
+    wxVector<wxZipEntry*> m_entries;
+    wxNameZipEntryMap_ m_names;
+    wxFileOffset m_centralOffset;
+    wxFileOffset m_offsetAdjustment;
+    size_t m_totalEntries;
+    wxString m_comment;
+
+    wxSUPPRESS_GCC_PRIVATE_DTOR_WARNING(wxZipIndex)
+};
+
+wxZipIndex::~wxZipIndex()
+{
+    for (size_t i = 0; i < m_entries.size(); i++)
+        delete m_entries[i];
+}
+
+void wxZipIndex::Add(wxZipEntry *entry)
+{
+    m_entries.push_back(entry);
+
+    // if a name appears more than once the first entry wins, which is what
+    // a sequential search of the central directory would have found
+    wxNameZipEntryMap_::iterator it = m_names.find(entry->GetInternalName());
+    if (it == m_names.end())
+        m_names[entry->GetInternalName()] = entry;
+}
+
+wxZipEntry *wxZipIndex::Find(const wxString& internalName) const
+{
+    wxNameZipEntryMap_::const_iterator it = m_names.find(internalName);
+    return it != m_names.end() ? it->second : NULL;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // ZipEntry
 
@@ -1616,8 +1687,11 @@ void wxZipInputStream::Init()
     m_parentSeekable = false;
     m_weaklinks = new wxZipWeakLinks;
     m_streamlink = NULL;
+    m_index = NULL;
     m_offsetAdjustment = 0;
     m_position = wxInvalidOffset;
+    m_centralOffset = wxInvalidOffset;
+    m_centralSize = 0;
     m_signature = 0;
     m_TotalEntries = 0;
     m_lasterror = m_parent_i_stream->GetLastError();
@@ -1635,6 +1709,9 @@ wxZipInputStream::~wxZipInputStream()
 
     if (m_streamlink)
         m_streamlink->Release(this);
+
+    if (m_index)
+        m_index->Release();
 }
 
 wxString wxZipInputStream::GetComment()
@@ -1715,6 +1792,7 @@ bool wxZipInputStream::LoadEndRecord()
 
     m_TotalEntries = endrec.GetTotalEntries();
     m_Comment = endrec.GetComment();
+    m_centralSize = endrec.GetSize();
 
     wxUint32 magic = m_TotalEntries ? CENTRAL_MAGIC : END_MAGIC;
 
@@ -1723,7 +1801,7 @@ bool wxZipInputStream::LoadEndRecord()
     if (m_parent_i_stream->SeekI(endrec.GetOffset()) != wxInvalidOffset &&
             ReadSignature() == magic) {
         m_signature = magic;
-        m_position = endrec.GetOffset();
+        m_position = m_centralOffset = endrec.GetOffset();
         m_offsetAdjustment = 0;
         return true;
     }
@@ -1736,7 +1814,7 @@ bool wxZipInputStream::LoadEndRecord()
             m_parent_i_stream->SeekI(endPos - recSize) != wxInvalidOffset &&
                 ReadSignature() == magic) {
         m_signature = magic;
-        m_position = endPos - recSize;
+        m_position = m_centralOffset = endPos - recSize;
         if ( endrec.GetOffset() >= 0 && endrec.GetOffset() < m_position )
         {
             m_offsetAdjustment = m_position - endrec.GetOffset();
@@ -1749,6 +1827,114 @@ bool wxZipInputStream::LoadEndRecord()
     return false;
 }
 
+// Read the whole central directory in one go and index its entries by name
+//
+bool wxZipInputStream::LoadIndex()
+{
+    if (m_index)
+        return true;
+    if (m_position == wxInvalidOffset)
+        if (!LoadEndRecord())
+            return false;
+    if (!m_parentSeekable || m_centralOffset == wxInvalidOffset)
+        return false;
+    if (!AtHeader())
+        CloseEntry();
+
+    // the central directory is small compared to the archive, so reading it
+    // with a single read avoids a seek and a refill of the parent's buffer
+    // per entry, or if the parent has it in memory it's used directly
+    size_t size = wx_truncate_cast(size_t, m_centralSize);
+    if (size == 0 && m_TotalEntries != 0)
+        return false;
+
+    wxCharBuffer buf;
+    const void *data = NULL;
+    if (size) {
+        if (QuietSeek(*m_parent_i_stream, m_centralOffset) == wxInvalidOffset) {
+            m_lasterror = wxSTREAM_READ_ERROR;
+            return false;
+        }
+
+        size_t avail;
+        data = m_parent_i_stream->PeekContiguous(&avail);
+        if (!data || avail < size) {
+            buf = wxCharBuffer(size);
+            if (m_parent_i_stream->Read(buf.data(), size).LastRead() != size) {
+                m_lasterror = wxSTREAM_READ_ERROR;
+                return false;
+            }
+            data = buf.data();
+        }
+    }
+
+    wxMemoryInputStream central(data, size);
+    wxZipIndex *index = new wxZipIndex(m_centralOffset, m_offsetAdjustment,
+                                       m_TotalEntries, m_Comment);
+
+    char magic[4];
+    while (central.Read(magic, 4).LastRead() == 4 &&
+            CrackUint32(magic) == CENTRAL_MAGIC) {
+        wxZipEntryPtr_ entry(new wxZipEntry);
+        if (!entry->ReadCentral(central, GetConv())) {
+            index->Release();
+            wxLogError(_("error reading zip central directory"));
+            m_lasterror = wxSTREAM_READ_ERROR;
+            return false;
+        }
+
+        if (m_offsetAdjustment) {
+            // see the comment in ReadCentral()
+            wxFileOffset ofs = wxUint32(entry->GetOffset());
+            ofs += m_offsetAdjustment;
+            if (ofs > wxUINT32_MAX) {
+                index->Release();
+                m_lasterror = wxSTREAM_READ_ERROR;
+                return false;
+            }
+            entry->SetOffset(ofs);
+        }
+
+        entry->SetKey(entry->GetOffset());
+        index->Add(entry.release());
+    }
+
+    m_index = index;
+    return true;
+}
+
+bool wxZipInputStream::ShareIndex(const wxZipInputStream& other)
+{
+    wxCHECK(other.m_index, false);
+    wxCHECK(m_position == wxInvalidOffset || m_index == other.m_index, false);
+
+    if (m_index != other.m_index) {
+        if (!IsOk() || !m_parent_i_stream->IsSeekable())
+            return false;
+
+        // leave the stream as LoadEndRecord() would have done, positioned
+        // at the start of the central directory
+        m_index = other.m_index->AddRef();
+        m_parentSeekable = true;
+        m_centralOffset = m_position = m_index->GetCentralOffset();
+        m_offsetAdjustment = m_index->GetOffsetAdjustment();
+        m_TotalEntries = m_index->GetTotalEntries();
+        m_Comment = m_index->GetComment();
+        m_signature = m_TotalEntries ? CENTRAL_MAGIC : END_MAGIC;
+    }
+
+    return true;
+}
+
+wxZipEntry *wxZipInputStream::FindEntry(const wxString& name,
+                                        wxPathFormat format) const
+{
+    if (!m_index)
+        return NULL;
+
+    return m_index->Find(wxZipEntry::GetInternalName(name, format));
+}
+
 // Find the end-of-central-directory record.
 // If found the stream will be positioned just past the 4 signature bytes.
 //
@@ -56,6 +56,10 @@
 #include "wx/private/markupparser.h"
 #endif // wxUSE_ACCESSIBILITY
 
+#if wxUSE_THREADS
+#include "wx/thread.h"
+#endif // wxUSE_THREADS
+
 //-----------------------------------------------------------------------------
 // classes
 //-----------------------------------------------------------------------------
@@ -489,12 +493,15 @@ public:
     wxDataViewTreeNode(wxDataViewTreeNode *parent, const wxDataViewItem& item)
         : m_parent(parent),
           m_item(item),
-          m_branchData(NULL)
+          m_branchData(NULL),
+          m_indexInParent(0)
     {
     }
 
     ~wxDataViewTreeNode()
     {
+        ms_generation++;
+
         if ( m_branchData )
         {
             wxDataViewTreeNodes& nodes = m_branchData->children;
@@ -621,6 +628,8 @@ public:
         {
             m_branchData = new BranchNodeData;
         }
+
+        m_parent->m_branchData->OnChildrenChanged();
     }
 
     int GetSubTreeCount() const
@@ -632,6 +641,8 @@ public:
     {
         wxASSERT( m_branchData != NULL );
 
+        ms_generation++;
+
         if( !m_branchData->open )
             return;
 
@@ -639,9 +650,25 @@ public:
         wxASSERT( m_branchData->subTreeCount >= 0 );
 
         if( m_parent )
+        {
+            // Only the rows of this node and its following siblings change
+            // in the parent, the rows of our own children are either not
+            // affected or were already invalidated by OnChildrenChanged().
+            m_parent->m_branchData->OnChildRowsChanged(this, num);
             m_parent->ChangeSubTreeCount(num);
+        }
     }
 
+    // Return the index of the child containing the given row in its subtree,
+    // with the row counted from the first child of this node, and fill
+    // rowChild with the row of this child itself. Return wxNOT_FOUND if the
+    // row is beyond the end of this subtree.
+    int FindChildByRow(int row, int *rowChild) const;
+
+    // Return the number which changes whenever the structure of any tree
+    // changes, this can be used to check if a cached node is still valid.
+    static unsigned GetGeneration() { return ms_generation; }
+
     void Resort(wxDataViewMainWindow* window);
 
     // Should be called after changing the item value to update its position in
@@ -672,18 +699,81 @@ private:
     {
         BranchNodeData()
             : open(false),
-              subTreeCount(0)
+              subTreeCount(0),
+              rowTreeValid(false)
         {
         }
 
         void InsertChild(wxDataViewTreeNode* node, unsigned index)
         {
             children.insert(children.begin() + index, node);
+            OnChildrenChanged();
         }
 
         void RemoveChild(unsigned index)
         {
             children.erase(children.begin() + index);
+            OnChildrenChanged();
+        }
+
+        void OnChildrenChanged()
+        {
+            ms_generation++;
+            rowTreeValid = false;
+        }
+
+        // Update the rows following the given child after the number of rows
+        // in its subtree changed by num.
+        void OnChildRowsChanged(const wxDataViewTreeNode* node, int num)
+        {
+            // Nothing to do if the tree will be rebuilt anyhow.
+            if ( !rowTreeValid )
+                return;
+
+            wxASSERT( children[node->m_indexInParent] == node );
+
+            const int count = children.size();
+            for ( int i = node->m_indexInParent + 1; i <= count; i += i & -i )
+                rowTree[i] += num;
+        }
+
+        // Return the index of the given child, which must be one of ours.
+        int IndexOf(const wxDataViewTreeNode* node)
+        {
+            const int count = children.size();
+            if ( node->m_indexInParent >= count ||
+                    children[node->m_indexInParent] != node )
+            {
+                // The cached indices are out of date after the children list
+                // changed, recompute all of them at once.
+                for ( int i = 0; i < count; i++ )
+                    children[i]->m_indexInParent = i;
+            }
+
+            wxASSERT( children[node->m_indexInParent] == node );
+
+            return node->m_indexInParent;
+        }
+
+        // (Re)compute rowTree from scratch, this is done lazily after the
+        // children change as it takes linear time.
+        void BuildRowTree()
+        {
+            const int count = children.size();
+            rowTree.assign(count + 1, 0);
+            for ( int i = 1; i <= count; i++ )
+            {
+                wxDataViewTreeNode* const node = children[i - 1];
+                node->m_indexInParent = i - 1;
+
+                rowTree[i] += 1 + node->GetSubTreeCount();
+
+                const int next = i + (i & -i);
+                if ( next <= count )
+                    rowTree[next] += rowTree[i];
+            }
+
+            rowTreeValid = true;
         }
 
         // Child nodes. Note that this may be empty even if m_hasChildren in
@@ -701,11 +791,29 @@ private:
         // 0 for leaves and is the number of rows the subtree occupies for
         // branch nodes.
         int                  subTreeCount;
+
+        // Fenwick (binary indexed) tree of the number of rows taken by each
+        // child, i.e. 1 + GetSubTreeCount(), allowing to find the child
+        // containing the given row and to update the rows of the children
+        // when one of them changes in logarithmic time. It is only built when
+        // needed, if rowTreeValid is false, and its element i, starting from
+        // 1, corresponds to the child i - 1.
+        wxVector<int>        rowTree;
+        bool                 rowTreeValid;
     };
 
     BranchNodeData *m_branchData;
+
+    // Index of this node in the parent children list, which may be out of date
+    // if it changed unless the parent rowTreeValid is true, use the parent
+    // BranchNodeData::IndexOf() to get the real index.
+    int m_indexInParent;
+
+    static unsigned ms_generation;
 };
 
+unsigned wxDataViewTreeNode::ms_generation = 0;
+
 
 
 //-----------------------------------------------------------------------------
@@ -1049,6 +1157,25 @@ private:
     wxDataViewTreeNode * m_root;
     int m_count;
 
+    // The path from the root to the node last returned by GetTreeNodeByRow(),
+    // used to find the node of the next row without searching for it. It is
+    // only valid if the tree generation didn't change since it was found.
+    struct RowNodePathEntry
+    {
+        const wxDataViewTreeNode *parent;
+        unsigned index;
+    };
+
+    wxDataViewTreeNode *GetRowNodePathLast() const
+    {
+        const RowNodePathEntry& entry = m_rowNodePath.back();
+        return entry.parent->GetChildNodes()[entry.index];
+    }
+
+    mutable wxVector<RowNodePathEntry> m_rowNodePath;
+    mutable unsigned m_rowNodePathRow;
+    mutable unsigned m_rowNodePathGeneration;
+
     // This is the tree node under the cursor
     wxDataViewTreeNode * m_underMouse;
 
@@ -1801,6 +1928,238 @@ private:
     const SortOrder m_sortOrder;
 };
 
+// The value of the sort column of a node, retrieved once before sorting the
+// nodes when the model allows it, see wxDataViewModel::CanCacheSortKeys().
+struct wxDataViewSortKey
+{
+    wxDataViewTreeNode* node;
+    wxUIntPtr id;
+
+    // Only one of these fields is used, depending on the key kind.
+    wxString str;
+    wxLongLong_t integer;
+    double number;
+};
+
+enum wxDataViewSortKeyKind
+{
+    SortKey_String,     // strings and wxDataViewIconText
+    SortKey_Integer,    // long, bool and wxDateTime values
+    SortKey_Double,
+    SortKey_Unsupported
+};
+
+wxDataViewSortKeyKind
+GetSortKey(const wxVariant& value, wxDataViewSortKey& key)
+{
+    const wxString type = value.GetType();
+    if ( type == wxS("string") )
+    {
+        key.str = value.GetString();
+        return SortKey_String;
+    }
+
+    if ( type == wxS("long") )
+    {
+        key.integer = value.GetLong();
+        return SortKey_Integer;
+    }
+
+    if ( type == wxS("double") )
+    {
+        key.number = value.GetDouble();
+        return SortKey_Double;
+    }
+
+#if wxUSE_DATETIME
+    if ( type == wxS("datetime") )
+    {
+        key.integer = value.GetDateTime().GetValue().GetValue();
+        return SortKey_Integer;
+    }
+#endif // wxUSE_DATETIME
+
+    if ( type == wxS("bool") )
+    {
+        key.integer = value.GetBool();
+        return SortKey_Integer;
+    }
+
+    if ( type == wxS("wxDataViewIconText") )
+    {
+        wxDataViewIconText iconText;
+        iconText << value;
+        key.str = iconText.GetText();
+        return SortKey_String;
+    }
+
+    return SortKey_Unsupported;
+}
+
+// Comparator for the sort keys giving the same order as the default
+// wxDataViewModel::Compare().
+class wxDataViewSortKeyCmp
+{
+public:
+    wxDataViewSortKeyCmp(wxDataViewSortKeyKind kind, bool ascending)
+        : m_kind(kind),
+          m_ascending(ascending)
+    {
+    }
+
+    bool operator()(const wxDataViewSortKey& key1,
+                    const wxDataViewSortKey& key2) const
+    {
+        return m_ascending ? IsLess(key1, key2) : IsLess(key2, key1);
+    }
+
+private:
+    bool IsLess(const wxDataViewSortKey& key1,
+                const wxDataViewSortKey& key2) const
+    {
+        switch ( m_kind )
+        {
+            case SortKey_String:
+                {
+                    const int res = key1.str.Cmp(key2.str);
+                    if ( res )
+                        return res < 0;
+                }
+                break;
+
+            case SortKey_Integer:
+                if ( key1.integer != key2.integer )
+                    return key1.integer < key2.integer;
+                break;
+
+            case SortKey_Double:
+                if ( key1.number != key2.number )
+                    return key1.number < key2.number;
+                break;
+
+            case SortKey_Unsupported:
+                wxFAIL_MSG( "unreachable" );
+                break;
+        }
+
+        // Items with the same value are ordered by their IDs.
+        return key1.id < key2.id;
+    }
+
+    const wxDataViewSortKeyKind m_kind;
+    const bool m_ascending;
+};
+
+#if wxUSE_THREADS
+
+// Thread used to sort a part of the keys when there are many of them.
+class wxDataViewSortThread : public wxThread
+{
+public:
+    wxDataViewSortThread(wxDataViewSortKey* first,
+                         wxDataViewSortKey* last,
+                         const wxDataViewSortKeyCmp& cmp)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_first(first),
+          m_last(last),
+          m_cmp(cmp)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        std::sort(m_first, m_last, m_cmp);
+        return NULL;
+    }
+
+private:
+    wxDataViewSortKey* const m_first;
+    wxDataViewSortKey* const m_last;
+    const wxDataViewSortKeyCmp m_cmp;
+};
+
+#endif // wxUSE_THREADS
+
+// Sort the nodes using the sort keys if the model allows it, return false if
+// they couldn't be used and the nodes were not sorted.
+bool
+SortNodesUsingKeys(wxDataViewMainWindow* window,
+                   const SortOrder& sortOrder,
+                   wxDataViewTreeNodes& nodes)
+{
+    const wxDataViewModel* const model = window->GetModel();
+    if ( !sortOrder.UsesColumn() || !model->CanCacheSortKeys() )
+        return false;
+
+    const unsigned column = sortOrder.GetColumn();
+    const size_t count = nodes.size();
+    if ( !count )
+        return true;
+
+    wxVector<wxDataViewSortKey> keys(count);
+    wxDataViewSortKeyKind kind = SortKey_Unsupported;
+
+    wxVariant value;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        wxDataViewSortKey& key = keys[n];
+        key.node = nodes[n];
+        key.id = wxPtrToUInt(key.node->GetItem().GetID());
+
+        const wxDataViewItem& item = key.node->GetItem();
+        if ( !model->HasValue(item, column) )
+            return false;
+
+        model->GetValue(value, item, column);
+
+        // All values must be of the same supported type, the default Compare()
+        // would call DoCompareValues() for the others anyhow.
+        const wxDataViewSortKeyKind kindThis = GetSortKey(value, key);
+        if ( kindThis == SortKey_Unsupported ||
+                (n && kindThis != kind) )
+            return false;
+
+        kind = kindThis;
+    }
+
+    const wxDataViewSortKeyCmp cmp(kind, sortOrder.IsAscending());
+
+    wxDataViewSortKey* const first = &keys[0];
+    wxDataViewSortKey* const last = first + count;
+
+    bool sorted = false;
+
+#if wxUSE_THREADS
+    // Sort the first half of big arrays in another thread while sorting the
+    // second one in this one and merge them at the end.
+    if ( count >= 50000 && wxThread::GetCPUCount() > 1 )
+    {
+        wxDataViewSortKey* const middle = first + count / 2;
+
+        wxDataViewSortThread thread(first, middle, cmp);
+        if ( thread.Create() == wxTHREAD_NO_ERROR &&
+                thread.Run() == wxTHREAD_NO_ERROR )
+        {
+            std::sort(middle, last, cmp);
+            thread.Wait();
+
+            std::inplace_merge(first, middle, last, cmp);
+
+            sorted = true;
+        }
+    }
+#endif // wxUSE_THREADS
+
+    if ( !sorted )
+        std::sort(first, last, cmp);
+
+    for ( size_t n = 0; n < count; n++ )
+        nodes[n] = keys[n].node;
+
+    return true;
+}
+
 } // anonymous namespace
 
 void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
@@ -1889,6 +2248,54 @@ void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
 }
 
 
+int wxDataViewTreeNode::FindChildByRow(int row, int *rowChild) const
+{
+    if ( !m_branchData )
+        return wxNOT_FOUND;
+
+    const int count = m_branchData->children.size();
+
+    // If none of the children is expanded, as is always the case for the list
+    // models, each of them takes exactly one row.
+    if ( m_branchData->open && m_branchData->subTreeCount == count )
+    {
+        if ( row >= count )
+            return wxNOT_FOUND;
+
+        *rowChild = row;
+        return row;
+    }
+
+    if ( !m_branchData->rowTreeValid )
+        m_branchData->BuildRowTree();
+
+    const wxVector<int>& tree = m_branchData->rowTree;
+
+    // Find the number of the children whose subtrees end before or at the
+    // given row, which is also the index of the child containing it.
+    int step = 1;
+    while ( 2*step <= count )
+        step *= 2;
+
+    int pos = 0,
+        rest = row;
+    for ( ; step; step /= 2 )
+    {
+        if ( pos + step <= count && tree[pos + step] <= rest )
+        {
+            pos += step;
+            rest -= tree[pos];
+        }
+    }
+
+    if ( pos == count )
+        return wxNOT_FOUND;
+
+    *rowChild = row - rest;
+
+    return pos;
+}
+
 void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
 {
     if (!m_branchData)
@@ -1908,9 +2315,13 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         // using model-specific sort order, which can change at any time.
         if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
         {
-            std::sort(m_branchData->children.begin(),
-                      m_branchData->children.end(),
-                      wxGenericTreeModelNodeCmp(window, sortOrder));
+            if ( !SortNodesUsingKeys(window, sortOrder, nodes) )
+            {
+                std::sort(nodes.begin(), nodes.end(),
+                          wxGenericTreeModelNodeCmp(window, sortOrder));
+            }
+
+            m_branchData->OnChildrenChanged();
 
             m_branchData->sortOrder = sortOrder;
         }
@@ -1950,44 +2361,29 @@ wxDataViewTreeNode::PutChildInSortOrder(wxDataViewMainWindow* window,
     // We should already be sorted in the right order.
     wxASSERT(m_branchData->sortOrder == window->GetSortOrder());
 
+    wxCHECK_RET( childNode->m_parent == this, "not our child?" );
+
     // First find the node in the current child list
-    int hi = nodes.size();
-    int oldLocation = wxNOT_FOUND;
-    for ( int index = 0; index < hi; ++index )
-    {
-        if ( nodes[index] == childNode )
-        {
-            oldLocation = index;
-            break;
-        }
-    }
-    wxCHECK_RET( oldLocation >= 0, "not our child?" );
+    const int oldLocation = m_branchData->IndexOf(childNode);
 
     wxGenericTreeModelNodeCmp cmp(window, m_branchData->sortOrder);
 
-    // Check if we actually need to move the node.
+    // Check if we actually need to move the node, i.e. if it is now out of
+    // order with respect to either of its neighbours.
     bool locationChanged = false;
 
-    if ( oldLocation == 0 )
-    {
-        // Compare with the next item (as we return early in the case of only a
-        // single child, we know that there is one) to check if the item is now
-        // out of order.
-        if ( !cmp(childNode, nodes[1]) )
-            locationChanged = true;
-    }
-    else // Compare with the previous item.
-    {
-        if ( !cmp(nodes[oldLocation - 1], childNode) )
-            locationChanged = true;
-    }
+    if ( oldLocation > 0 && !cmp(nodes[oldLocation - 1], childNode) )
+        locationChanged = true;
+    else if ( oldLocation + 1 < (int)nodes.size() &&
+                !cmp(childNode, nodes[oldLocation + 1]) )
+        locationChanged = true;
 
     if ( !locationChanged )
         return;
 
     // Remove and reinsert the node in the child list
     m_branchData->RemoveChild(oldLocation);
-    hi = nodes.size();
+    int hi = nodes.size();
     int lo = 0;
     while ( lo < hi )
     {
@@ -2061,6 +2457,8 @@ wxDataViewMainWindow::wxDataViewMainWindow( wxDataViewCtrl *parent, wxWindowID i
     m_currentColSetByKeyboard = false;
     m_useCellFocus = false;
     m_currentRow = (unsigned)-1;
+    m_rowNodePathRow = (unsigned)-1;
+    m_rowNodePathGeneration = 0;
     m_lineHeight = GetDefaultRowHeight();
     if (GetOwner()->HasFlag(wxDV_VARIABLE_LINE_HEIGHT))
     {
@@ -3801,68 +4199,86 @@ int wxDataViewMainWindow::QueryAndCacheLineHeight(unsigned int row, wxDataViewIt
 }
 
 
-class RowToTreeNodeJob: public DoJob
+wxDataViewTreeNode * wxDataViewMainWindow::GetTreeNodeByRow(unsigned int row) const
 {
-public:
-    // Note that we initialize m_current to -1 because the first node passed to
-    // our operator() will be the root node, which doesn't appear in the window
-    // and so doesn't count as a real row.
-    explicit RowToTreeNodeJob(int row)
-        : m_row(row), m_current(-1), m_ret(NULL)
-    {
-    }
+    wxASSERT( !IsVirtualList() );
 
-    virtual int operator() ( wxDataViewTreeNode * node ) wxOVERRIDE
+    if ( row == (unsigned)-1 )
+        return NULL;
+
+    // Rows are often requested one after another, e.g. when painting, so
+    // check if we can just advance from the previously found node.
+    if ( !m_rowNodePath.empty() &&
+            m_rowNodePathGeneration == wxDataViewTreeNode::GetGeneration() )
     {
-        if( m_current == m_row)
-        {
-            m_ret = node;
-            return DoJob::DONE;
-        }
+        if ( row == m_rowNodePathRow )
+            return GetRowNodePathLast();
 
-        if( node->GetSubTreeCount() + m_current < m_row )
+        if ( row == m_rowNodePathRow + 1 )
         {
-            m_current += node->GetSubTreeCount() + 1;
-            return  DoJob::SKIP_SUBTREE;
-        }
-        else
-        {
-            // If the current node has only leaf children, we can find the
-            // desired node directly. This can speed up finding the node
-            // in some cases, and will have a very good effect for list views.
-            if ( node->HasChildren() &&
-                 (int)node->GetChildNodes().size() == node->GetSubTreeCount() )
+            const wxDataViewTreeNode* const last = GetRowNodePathLast();
+            if ( last->IsOpen() && !last->GetChildNodes().empty() )
             {
-                const int index = m_row - m_current - 1;
-                m_ret = node->GetChildNodes()[index];
-                return DoJob::DONE;
+                // The next row is the first child of this node.
+                RowNodePathEntry entry;
+                entry.parent = last;
+                entry.index = 0;
+                m_rowNodePath.push_back(entry);
             }
+            else
+            {
+                // The next row is the next sibling of this node or of its
+                // closest parent having one.
+                for ( ;; )
+                {
+                    RowNodePathEntry& entry = m_rowNodePath.back();
+                    if ( entry.index + 1 < entry.parent->GetChildNodes().size() )
+                    {
+                        entry.index++;
+                        break;
+                    }
 
-            m_current++;
+                    m_rowNodePath.pop_back();
+                    if ( m_rowNodePath.empty() )
+                        return NULL;
+                }
+            }
 
-            return DoJob::CONTINUE;
+            m_rowNodePathRow = row;
+            return GetRowNodePathLast();
         }
     }
 
-    wxDataViewTreeNode * GetResult() const
-        { return m_ret; }
+    // Otherwise find the node by descending from the root: at each level we
+    // find the child containing the row using binary search.
+    m_rowNodePath.clear();
+    m_rowNodePathGeneration = wxDataViewTreeNode::GetGeneration();
+    m_rowNodePathRow = row;
 
-private:
-    const int m_row;
-    int m_current;
-    wxDataViewTreeNode* m_ret;
-};
+    const wxDataViewTreeNode* node = m_root;
+    int rowInNode = static_cast<int>(row);
+    for ( ;; )
+    {
+        int rowChild;
+        const int index = node->FindChildByRow(rowInNode, &rowChild);
+        if ( index == wxNOT_FOUND )
+        {
+            m_rowNodePath.clear();
+            return NULL;
+        }
 
-wxDataViewTreeNode * wxDataViewMainWindow::GetTreeNodeByRow(unsigned int row) const
-{
-    wxASSERT( !IsVirtualList() );
+        RowNodePathEntry entry;
+        entry.parent = node;
+        entry.index = index;
+        m_rowNodePath.push_back(entry);
 
-    if ( row == (unsigned)-1 )
-        return NULL;
+        if ( rowInNode == rowChild )
+            return GetRowNodePathLast();
 
-    RowToTreeNodeJob job(static_cast<int>(row));
-    Walker( m_root , job );
-    return job.GetResult();
+        // The row is inside the subtree of this child, skip the child itself.
+        node = node->GetChildNodes()[index];
+        rowInNode -= rowChild + 1;
+    }
 }
 
 wxDataViewItem wxDataViewMainWindow::GetItemByRow(unsigned int row) const
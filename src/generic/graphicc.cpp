@@ -1729,54 +1729,11 @@ wxCairoBitmapData::wxCairoBitmapData(wxGraphicsRenderer* renderer,
 
     int stride = InitBuffer(image.GetWidth(), image.GetHeight(), bufferFormat);
 
-    // Copy wxImage data into the buffer. Notice that we work with wxUint32
-    // values and not bytes becase Cairo always works with buffers in native
-    // endianness.
-    wxUint32* dst = reinterpret_cast<wxUint32*>(m_buffer);
-    const unsigned char* src = image.GetData();
-
-    if ( bufferFormat == CAIRO_FORMAT_ARGB32 )
-    {
-        const unsigned char* alpha = image.GetAlpha();
-
-        for ( int y = 0; y < m_height; y++ )
-        {
-            wxUint32* const rowStartDst = dst;
-
-            for ( int x = 0; x < m_width; x++ )
-            {
-                const unsigned char a = alpha ? *alpha : wxALPHA_OPAQUE;
-
-                *dst++ = a                    << 24 |
-                         ((a * src[0]) / 255) << 16 |
-                         ((a * src[1]) / 255) <<  8 |
-                         ((a * src[2]) / 255);
-                src += 3;
-
-                if ( alpha )
-                    alpha++;
-            }
-
-            dst = rowStartDst + stride / 4;
-        }
-    }
-    else // RGB
-    {
-        for ( int y = 0; y < m_height; y++ )
-        {
-            wxUint32* const rowStartDst = dst;
-
-            for ( int x = 0; x < m_width; x++ )
-            {
-                *dst++ = src[0] << 16 |
-                         src[1] <<  8 |
-                         src[2];
-                src += 3;
-            }
-
-            dst = rowStartDst + stride / 4;
-        }
-    }
+    // Copy wxImage data into the buffer: Cairo uses premultiplied 32 bit
+    // pixels in native endianness for both formats, with the alpha byte
+    // being simply ignored for CAIRO_FORMAT_RGB24.
+    image.GetPackedPixels(m_buffer, stride,
+                          wxIMAGE_PACKED_ARGB32_PREMULTIPLIED);
 
     // if there is a mask, set the alpha bytes in the target buffer to
     // fully transparent or retain original value
@@ -1786,8 +1743,8 @@ wxCairoBitmapData::wxCairoBitmapData(wxGraphicsRenderer* renderer,
         unsigned char mg = image.GetMaskGreen();
         unsigned char mb = image.GetMaskBlue();
 
-        dst = reinterpret_cast<wxUint32*>(m_buffer);
-        src = image.GetData();
+        wxUint32* dst = reinterpret_cast<wxUint32*>(m_buffer);
+        const unsigned char* src = image.GetData();
 
         if ( bufferFormat == CAIRO_FORMAT_ARGB32 )
         {
@@ -1856,33 +1813,18 @@ wxImage wxCairoBitmapData::ConvertToImage() const
     wxASSERT_MSG( !(stride % sizeof(wxUint32)), wxS("Unexpected stride.") );
     stride /= sizeof(wxUint32);
 
-    unsigned char* dst = image.GetData();
-    unsigned char *alpha = image.GetAlpha();
-    if ( alpha )
+    if ( image.HasAlpha() )
     {
         // We need to also copy alpha and undo the pre-multiplication as Cairo
         // stores pre-multiplied values in this format while wxImage does not.
-        for ( int y = 0; y < m_height; y++ )
-        {
-            const wxUint32* const rowStart = src;
-            for ( int x = 0; x < m_width; x++ )
-            {
-                const wxUint32 argb = *src++;
-
-                const unsigned char a = argb >> 24;
-                *alpha++ = a;
-
-                // Copy the RGB data undoing the pre-multiplication.
-                *dst++ = Unpremultiply(a, argb >> 16);
-                *dst++ = Unpremultiply(a, argb >>  8);
-                *dst++ = Unpremultiply(a, argb);
-            }
-
-            src = rowStart + stride;
-        }
+        image.SetPackedPixels(reinterpret_cast<const unsigned char*>(src),
+                              stride * sizeof(wxUint32),
+                              wxIMAGE_PACKED_ARGB32_PREMULTIPLIED);
     }
     else // RGB
     {
+        unsigned char* dst = image.GetData();
+
         // Things are pretty simple in this case, just copy RGB bytes.
         for ( int y = 0; y < m_height; y++ )
         {
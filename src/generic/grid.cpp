@@ -54,12 +54,16 @@
 #include "wx/generic/gridctrl.h"
 #include "wx/generic/grideditors.h"
 #include "wx/generic/private/grid.h"
+#include "wx/generic/private/gridasync.h"
 
 const char wxGridNameStr[] = "grid";
 
 // Required for wxIs... functions
 #include <ctype.h>
 
+#include <algorithm>
+#include <functional>
+
 WX_DECLARE_HASH_SET_WITH_DECL_PTR(int, wxIntegerHash, wxIntegerEqual,
                                   wxGridFixedIndicesSet, class WXDLLIMPEXP_ADV);
 
@@ -248,6 +252,490 @@ int wxGridColumnOperations::GetFirstLine(const wxGrid *grid, wxGridWindow *gridW
     return grid->GetNumberFrozenCols();
 }
 
+int wxGridColumnOperations::FindLinePos(const wxGrid *grid,
+                                        int coord,
+                                        int minPos,
+                                        int maxPos) const
+{
+    // columns can be reordered, so we can't use a simple cumulative structure
+    // for them as for the rows, but a binary search on the column right
+    // positions is still efficient enough for the typical number of columns
+    const wxArrayInt& lineEnds = grid->m_colRights;
+
+    while ( minPos < maxPos )
+    {
+        wxCHECK_MSG( lineEnds[GetLineAt(grid, minPos)] <= coord &&
+                        coord < lineEnds[GetLineAt(grid, maxPos)],
+                     -1,
+                     "wxGrid: internal error in PosToLinePos()" );
+
+        if ( coord >= lineEnds[GetLineAt(grid, maxPos - 1)] )
+            return maxPos;
+        else
+            maxPos--;
+
+        const int median = minPos + (maxPos - minPos + 1) / 2;
+        if ( coord < lineEnds[GetLineAt(grid, median)] )
+            maxPos = median;
+        else
+            minPos = median;
+    }
+
+    return maxPos;
+}
+
+// ----------------------------------------------------------------------------
+// wxGridLineSizes
+// ----------------------------------------------------------------------------
+
+wxGridLineSizes::wxGridLineSizes(int count, int size)
+{
+    m_seed = 2463534242u;
+    m_root = count > 0 ? NewNode(count, size) : NULL;
+}
+
+wxGridLineSizes::~wxGridLineSizes()
+{
+    Free(m_root);
+}
+
+wxGridLineSizes::Node *wxGridLineSizes::NewNode(int count, int size)
+{
+    // xorshift is more than good enough for the treap priorities
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    Node * const node = new Node;
+    node->left =
+    node->right = NULL;
+    node->priority = m_seed;
+    node->count = count;
+    node->size = size;
+    Update(node);
+
+    return node;
+}
+
+/* static */
+void wxGridLineSizes::Update(Node *node)
+{
+    node->subCount = Count(node->left) + node->count + Count(node->right);
+    node->subExtent = Extent(node->left) + Extent(node->right);
+    if ( node->size > 0 )
+        node->subExtent += node->count * node->size;
+}
+
+/* static */
+void wxGridLineSizes::Free(Node *node)
+{
+    if ( !node )
+        return;
+
+    Free(node->left);
+    Free(node->right);
+    delete node;
+}
+
+void wxGridLineSizes::Split(Node *node, int n, Node *& left, Node *& right)
+{
+    if ( !node )
+    {
+        left =
+        right = NULL;
+        return;
+    }
+
+    const int countLeft = Count(node->left);
+    if ( n <= countLeft )
+    {
+        Split(node->left, n, left, node->left);
+        Update(node);
+        right = node;
+    }
+    else if ( n >= countLeft + node->count )
+    {
+        Split(node->right, n - countLeft - node->count, node->right, right);
+        Update(node);
+        left = node;
+    }
+    else // the split point is inside this run
+    {
+        // cut it in two and put the second part in front of the right subtree
+        const int countBefore = n - countLeft;
+        Node * const rest = NewNode(node->count - countBefore, node->size);
+        right = Merge(rest, node->right);
+
+        node->count = countBefore;
+        node->right = NULL;
+        Update(node);
+        left = node;
+    }
+}
+
+/* static */
+wxGridLineSizes::Node *wxGridLineSizes::Merge(Node *left, Node *right)
+{
+    if ( !left )
+        return right;
+    if ( !right )
+        return left;
+
+    if ( left->priority > right->priority )
+    {
+        left->right = Merge(left->right, right);
+        Update(left);
+        return left;
+    }
+
+    right->left = Merge(left, right->left);
+    Update(right);
+    return right;
+}
+
+/* static */
+void wxGridLineSizes::AddToLastRun(Node *node, int count)
+{
+    if ( node->right )
+        AddToLastRun(node->right, count);
+    else
+        node->count += count;
+
+    Update(node);
+}
+
+wxGridLineSizes::Node *wxGridLineSizes::Join(Node *left, Node *right)
+{
+    if ( !left )
+        return right;
+    if ( !right )
+        return left;
+
+    const Node *last = left;
+    while ( last->right )
+        last = last->right;
+
+    const Node *first = right;
+    while ( first->left )
+        first = first->left;
+
+    if ( last->size == first->size )
+    {
+        // coalesce the adjacent runs to avoid accumulating the nodes when the
+        // lines are resized back to their previous size
+        const int count = first->count;
+
+        Node *firstRun;
+        Split(right, count, firstRun, right);
+        Free(firstRun);
+
+        AddToLastRun(left, count);
+    }
+
+    return Merge(left, right);
+}
+
+int wxGridLineSizes::GetSize(int line) const
+{
+    const Node *node = m_root;
+    while ( node )
+    {
+        const int countLeft = Count(node->left);
+        if ( line < countLeft )
+        {
+            node = node->left;
+        }
+        else if ( line < countLeft + node->count )
+        {
+            return node->size;
+        }
+        else
+        {
+            line -= countLeft + node->count;
+            node = node->right;
+        }
+    }
+
+    wxFAIL_MSG( "invalid line index" );
+
+    return 0;
+}
+
+int wxGridLineSizes::GetEnd(int line) const
+{
+    int end = 0;
+
+    const Node *node = m_root;
+    while ( node )
+    {
+        const int countLeft = Count(node->left);
+        const int size = node->size > 0 ? node->size : 0;
+        if ( line < countLeft )
+        {
+            node = node->left;
+        }
+        else if ( line < countLeft + node->count )
+        {
+            return end + Extent(node->left) + (line - countLeft + 1)*size;
+        }
+        else
+        {
+            end += Extent(node->left) + node->count*size;
+            line -= countLeft + node->count;
+            node = node->right;
+        }
+    }
+
+    wxFAIL_MSG( "invalid line index" );
+
+    return end;
+}
+
+int wxGridLineSizes::FindLine(int coord) const
+{
+    int line = 0;
+
+    const Node *node = m_root;
+    while ( node )
+    {
+        const int extentLeft = Extent(node->left);
+        if ( coord < extentLeft )
+        {
+            node = node->left;
+            continue;
+        }
+
+        coord -= extentLeft;
+        line += Count(node->left);
+
+        // hidden runs have 0 extent and so are never selected here
+        const int extent = node->size > 0 ? node->count*node->size : 0;
+        if ( coord < extent )
+            return line + coord / node->size;
+
+        coord -= extent;
+        line += node->count;
+        node = node->right;
+    }
+
+    return line;
+}
+
+void wxGridLineSizes::SetSize(int line, int size)
+{
+    wxCHECK_RET( line >= 0 && line < GetCount(), "invalid line index" );
+
+    if ( GetSize(line) == size )
+        return;
+
+    Node *left, *mid, *right;
+    Split(m_root, line, left, mid);
+    Split(mid, 1, mid, right);
+
+    mid->size = size;
+    Update(mid);
+
+    m_root = Join(Join(left, mid), right);
+}
+
+void wxGridLineSizes::Insert(int pos, int count, int size)
+{
+    wxCHECK_RET( pos >= 0 && pos <= GetCount(), "invalid line index" );
+
+    if ( count <= 0 )
+        return;
+
+    Node *left, *right;
+    Split(m_root, pos, left, right);
+
+    m_root = Join(Join(left, NewNode(count, size)), right);
+}
+
+void wxGridLineSizes::Remove(int pos, int count)
+{
+    wxCHECK_RET( pos >= 0 && pos + count <= GetCount(), "invalid line index" );
+
+    Node *left, *mid, *right;
+    Split(m_root, pos, left, mid);
+    Split(mid, count, mid, right);
+    Free(mid);
+
+    m_root = Join(left, right);
+}
+
+/* static */
+void wxGridLineSizes::ScaleNodes(Node *node, int num, int den)
+{
+    if ( !node )
+        return;
+
+    ScaleNodes(node->left, num, den);
+    ScaleNodes(node->right, num, den);
+
+    // don't change the hidden lines sizes
+    if ( node->size > 0 )
+        node->size = node->size * num / den;
+
+    Update(node);
+}
+
+void wxGridLineSizes::Scale(int num, int den)
+{
+    ScaleNodes(m_root, num, den);
+}
+
+/* static */
+void wxGridLineSizes::CollectSizes(const Node *node,
+                                   int& line,
+                                   int sizeDefault,
+                                   wxUnsignedToIntHashMap& sizes)
+{
+    if ( !node )
+        return;
+
+    CollectSizes(node->left, line, sizeDefault, sizes);
+
+    if ( node->size != sizeDefault )
+    {
+        for ( int n = 0; n < node->count; n++ )
+            sizes[line + n] = node->size;
+    }
+
+    line += node->count;
+
+    CollectSizes(node->right, line, sizeDefault, sizes);
+}
+
+void
+wxGridLineSizes::GetCustomSizes(int sizeDefault,
+                                wxUnsignedToIntHashMap& sizes) const
+{
+    int line = 0;
+    CollectSizes(m_root, line, sizeDefault, sizes);
+}
+
+// ----------------------------------------------------------------------------
+// wxGridBestSizeCache
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// maximal number of cached sizes in each direction
+const size_t wxGRID_BEST_SIZE_CACHE_MAX = 100000;
+
+} // anonymous namespace
+
+void wxGridBestSizeCache::Entries::Unlink(Entry *entry)
+{
+    if ( entry->prev )
+        entry->prev->next = entry->next;
+    else
+        head = entry->next;
+
+    if ( entry->next )
+        entry->next->prev = entry->prev;
+    else
+        tail = entry->prev;
+}
+
+void wxGridBestSizeCache::Entries::PushFront(Entry *entry)
+{
+    entry->prev = NULL;
+    entry->next = head;
+
+    if ( head )
+        head->prev = entry;
+    else
+        tail = entry;
+
+    head = entry;
+}
+
+bool wxGridBestSizeCache::Lookup(wxGridDirection direction, int row, int col,
+                                 const wxString& value, const wxFont& font,
+                                 int otherSize, int *extent) const
+{
+    Entries& entries = m_entries[direction];
+    EntriesMap::const_iterator it = entries.map.find(GetKey(row, col));
+    if ( it == entries.map.end() )
+        return false;
+
+    Entry * const entry = it->second;
+    if ( entry->otherSize != otherSize ||
+            entry->value != value ||
+                entry->font != font )
+        return false;
+
+    // this entry is now the most recently used one
+    if ( entry != entries.head )
+    {
+        entries.Unlink(entry);
+        entries.PushFront(entry);
+    }
+
+    *extent = entry->extent;
+
+    return true;
+}
+
+void wxGridBestSizeCache::Store(wxGridDirection direction, int row, int col,
+                                const wxString& value, const wxFont& font,
+                                int otherSize, int extent)
+{
+    Entries& entries = m_entries[direction];
+
+    const wxLongLong_t key = GetKey(row, col);
+
+    Entry *& entry = entries.map[key];
+    if ( entry )
+    {
+        entries.Unlink(entry);
+    }
+    else if ( entries.map.size() > wxGRID_BEST_SIZE_CACHE_MAX )
+    {
+        // Don't let the cache grow indefinitely when different cells are
+        // sampled as the grid is scrolled: reuse the least recently used
+        // entry for the new one.
+        Entry * const oldest = entries.tail;
+        entries.Unlink(oldest);
+        entries.map.erase(oldest->key);
+
+        entry = oldest;
+    }
+    else
+    {
+        entry = new Entry;
+    }
+
+    entry->key = key;
+    entry->value = value;
+    entry->font = font;
+    entry->otherSize = otherSize;
+    entry->extent = extent;
+
+    entries.PushFront(entry);
+}
+
+void wxGridBestSizeCache::Clear()
+{
+    for ( size_t n = 0; n < WXSIZEOF(m_entries); n++ )
+    {
+        Entries& entries = m_entries[n];
+
+        for ( Entry *entry = entries.head; entry; )
+        {
+            Entry * const next = entry->next;
+            delete entry;
+            entry = next;
+        }
+
+        entries.map.clear();
+        entries.head =
+        entries.tail = NULL;
+    }
+}
+
 // ----------------------------------------------------------------------------
 // wxGridCellWorker is an (almost) empty common base class for
 // wxGridCellRenderer and wxGridCellEditor managing ref counting
@@ -851,6 +1339,35 @@ void UpdateCellAttrRowsOrCols(wxGridCoordsToAttrMap& attrs, int editPos,
     const bool isEditingRows = (editRowCount != 0);
     const int editCount = (isEditingRows ? editRowCount : editColCount);
 
+    // Rows or columns are often appended or removed at the end of the grid,
+    // after all the cells having attributes, so check if any of them is
+    // affected at all before copying the entire map below.
+    bool affected = false;
+    for ( wxGridCoordsToAttrMap::const_iterator it = attrs.begin();
+          it != attrs.end();
+          ++it )
+    {
+        int cellRow, cellCol;
+        KeyToCoords(it->first, &cellRow, &cellCol);
+
+        int cellRows, cellCols;
+        it->second->GetSize(&cellRows, &cellCols);
+
+        const int cellPos = isEditingRows ? cellRow : cellCol;
+
+        // Note that the size of an inside cell is negative, so this check
+        // works for all cells, including multicells.
+        const int cellSize = isEditingRows ? cellRows : cellCols;
+        if ( cellPos >= editPos || cellPos + cellSize > editPos )
+        {
+            affected = true;
+            break;
+        }
+    }
+
+    if ( !affected )
+        return;
+
     // Copy updated attributes to a new map instead of attempting to edit attrs
     // map in-place. This requires more memory but greatly simplifies the code
     // and any attempt with in-place editing would likely also require a lot
@@ -1103,37 +1620,391 @@ void wxGridRowOrColAttrData::SetAttr(wxGridCellAttr *attr, int rowOrCol)
             m_attrs.RemoveAt(n);
         }
     }
-}
+}
+
+void wxGridRowOrColAttrData::UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols )
+{
+    size_t count = m_attrs.GetCount();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        int & rowOrCol = m_rowsOrCols[n];
+        if ( (size_t)rowOrCol >= pos )
+        {
+            if ( numRowsOrCols > 0 )
+            {
+                // If rows or cols inserted, increment row/col counter where necessary
+                rowOrCol += numRowsOrCols;
+            }
+            else if ( numRowsOrCols < 0)
+            {
+                // If rows/cols deleted, either decrement row/col counter (if row/col still exists)
+                if ((size_t)rowOrCol >= pos - numRowsOrCols)
+                    rowOrCol += numRowsOrCols;
+                else
+                {
+                    m_rowsOrCols.RemoveAt(n);
+                    m_attrs[n]->DecRef();
+                    m_attrs.RemoveAt(n);
+                    n--;
+                    count--;
+                }
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// wxGridBlockAttrData
+// ----------------------------------------------------------------------------
+
+wxGridBlockAttrData::~wxGridBlockAttrData()
+{
+    wxVector<Node *> nodes;
+    Collect(m_root, nodes);
+
+    for ( size_t n = 0; n < nodes.size(); n++ )
+    {
+        nodes[n]->attr->DecRef();
+        delete nodes[n];
+    }
+}
+
+/* static */
+bool wxGridBlockAttrData::IsBefore(const wxGridBlockCoords& a,
+                                   const wxGridBlockCoords& b)
+{
+    if ( a.GetTopRow() != b.GetTopRow() )
+        return a.GetTopRow() < b.GetTopRow();
+    if ( a.GetBottomRow() != b.GetBottomRow() )
+        return a.GetBottomRow() < b.GetBottomRow();
+    if ( a.GetLeftCol() != b.GetLeftCol() )
+        return a.GetLeftCol() < b.GetLeftCol();
+
+    return a.GetRightCol() < b.GetRightCol();
+}
+
+/* static */
+void wxGridBlockAttrData::UpdateMaxBottom(Node *node)
+{
+    int maxBottom = node->block.GetBottomRow();
+    if ( node->left && node->left->maxBottom > maxBottom )
+        maxBottom = node->left->maxBottom;
+    if ( node->right && node->right->maxBottom > maxBottom )
+        maxBottom = node->right->maxBottom;
+
+    node->maxBottom = maxBottom;
+}
+
+/* static */
+wxGridBlockAttrData::Node *
+wxGridBlockAttrData::Merge(Node *left, Node *right)
+{
+    // all the blocks in the left tree come before those in the right one
+    if ( !left )
+        return right;
+    if ( !right )
+        return left;
+
+    if ( left->priority > right->priority )
+    {
+        left->right = Merge(left->right, right);
+        UpdateMaxBottom(left);
+        return left;
+    }
+
+    right->left = Merge(left, right->left);
+    UpdateMaxBottom(right);
+    return right;
+}
+
+/* static */
+void wxGridBlockAttrData::Split(Node *node, const wxGridBlockCoords& block,
+                                Node *&left, Node *&right)
+{
+    // split the tree into the blocks coming before the given one and all the
+    // others
+    if ( !node )
+    {
+        left =
+        right = NULL;
+        return;
+    }
+
+    if ( IsBefore(node->block, block) )
+    {
+        Split(node->right, block, node->right, right);
+        left = node;
+    }
+    else
+    {
+        Split(node->left, block, left, node->left);
+        right = node;
+    }
+
+    UpdateMaxBottom(node);
+}
+
+/* static */
+wxGridBlockAttrData::Node *wxGridBlockAttrData::DetachFirst(Node *&node)
+{
+    if ( !node->left )
+    {
+        Node * const first = node;
+        node = node->right;
+        return first;
+    }
+
+    Node * const first = DetachFirst(node->left);
+    UpdateMaxBottom(node);
+    return first;
+}
+
+/* static */
+void wxGridBlockAttrData::Find(const Node *node, int row, int col,
+                               const Node *&found)
+{
+    // none of the blocks in this subtree reaches this row
+    if ( !node || node->maxBottom < row )
+        return;
+
+    Find(node->left, row, col, found);
+
+    // all the blocks to the right start below this one, so if this one
+    // starts below the given row, none of them can contain it
+    if ( node->block.GetTopRow() > row )
+        return;
+
+    if ( node->block.Contains(wxGridCellCoords(row, col)) &&
+            (!found || node->order > found->order) )
+    {
+        found = node;
+    }
+
+    Find(node->right, row, col, found);
+}
+
+/* static */
+void wxGridBlockAttrData::Collect(Node *node, wxVector<Node *>& nodes)
+{
+    if ( !node )
+        return;
+
+    Collect(node->left, nodes);
+    nodes.push_back(node);
+    Collect(node->right, nodes);
+}
+
+unsigned wxGridBlockAttrData::NextPriority()
+{
+    // xorshift generator: we don't need good random numbers here, just
+    // something to keep the tree balanced for any insertion order
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    return m_seed;
+}
+
+void wxGridBlockAttrData::Build(const wxVector<Node *>& nodes)
+{
+    // build the Cartesian tree of the sorted nodes in linear time by keeping
+    // the rightmost path of the tree built so far
+    wxVector<Node *> path;
+    for ( size_t n = 0; n < nodes.size(); n++ )
+    {
+        Node * const node = nodes[n];
+        node->priority = NextPriority();
+        node->left =
+        node->right = NULL;
+
+        // the nodes removed from the path won't get any new children, so
+        // their subtrees are complete and we can compute their maximal
+        // bottoms: notice that they're removed from the bottom up
+        Node *last = NULL;
+        while ( !path.empty() && path.back()->priority < node->priority )
+        {
+            last = path.back();
+            path.pop_back();
+            UpdateMaxBottom(last);
+        }
+
+        node->left = last;
+        if ( !path.empty() )
+            path.back()->right = node;
+
+        path.push_back(node);
+    }
+
+    m_root = path.empty() ? NULL : path[0];
+
+    while ( !path.empty() )
+    {
+        UpdateMaxBottom(path.back());
+        path.pop_back();
+    }
+}
+
+void wxGridBlockAttrData::SetAttr(wxGridCellAttr *attr,
+                                  const wxGridBlockCoords& block)
+{
+    // extract the node for exactly this block, if any, from the tree: if it
+    // exists, it's the leftmost one of the nodes not coming before it
+    Node *before,
+         *rest;
+    Split(m_root, block, before, rest);
+
+    Node *node = NULL;
+    if ( rest )
+    {
+        const Node *first = rest;
+        while ( first->left )
+            first = first->left;
+
+        if ( first->block == block )
+            node = DetachFirst(rest);
+    }
+
+    if ( node )
+    {
+        node->attr->DecRef();
+
+        if ( !attr )
+        {
+            // the attribute for this block was reset
+            delete node;
+            m_root = Merge(before, rest);
+            return;
+        }
+    }
+    else // no attribute for this block yet
+    {
+        if ( !attr )
+        {
+            m_root = Merge(before, rest);
+            return;
+        }
+
+        node = new Node;
+        node->block = block;
+        node->priority = NextPriority();
+    }
+
+    // (re)insert the node, making it the most recently set one
+    node->attr = attr;
+    node->order = m_nextOrder++;
+    node->left =
+    node->right = NULL;
+    UpdateMaxBottom(node);
+
+    m_root = Merge(Merge(before, node), rest);
+}
+wxGridCellAttr *wxGridBlockAttrData::GetAttr(int row, int col) const
+{
+    const Node *found = NULL;
+    Find(m_root, row, col, found);
+
+    if ( !found )
+        return NULL;
+
+    found->attr->IncRef();
+
+    return found->attr;
+}
+
+void wxGridBlockAttrData::UpdateAttrRowsOrCols(size_t pos, int num, bool rows)
+{
+    wxVector<Node *> nodes;
+    Collect(m_root, nodes);
+    m_root = NULL;
+
+    const int first = static_cast<int>(pos);
+    const int firstAfter = first - num;
+
+    size_t numKept = 0;
+    for ( size_t n = 0; n < nodes.size(); n++ )
+    {
+        Node * const node = nodes[n];
+        const wxGridBlockCoords& block = node->block;
+
+        int start = rows ? block.GetTopRow() : block.GetLeftCol(),
+            end = rows ? block.GetBottomRow() : block.GetRightCol();
+
+        if ( num > 0 )
+        {
+            // lines inserted inside the block extend it
+            if ( start >= first )
+                start += num;
+            if ( end >= first )
+                end += num;
+        }
+        else // lines deleted
+        {
+            if ( start >= firstAfter )
+                start += num;
+            else if ( start >= first )
+                start = first;
+
+            if ( end >= firstAfter )
+                end += num;
+            else if ( end >= first )
+                end = first - 1;
+
+            if ( end < start )
+            {
+                // the entire block was deleted
+                node->attr->DecRef();
+                delete node;
+                continue;
+            }
+        }
+
+        node->block = rows
+            ? wxGridBlockCoords(start, block.GetLeftCol(),
+                                end, block.GetRightCol())
+            : wxGridBlockCoords(block.GetTopRow(), start,
+                                block.GetBottomRow(), end);
+
+        nodes[numKept++] = node;
+    }
 
-void wxGridRowOrColAttrData::UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols )
-{
-    size_t count = m_attrs.GetCount();
-    for ( size_t n = 0; n < count; n++ )
+    nodes.erase(nodes.begin() + numKept, nodes.end());
+
+    // deleting lines may have changed the relative order of the blocks and
+    // even made some of them identical, in which case only the most recently
+    // set one is kept
+    std::sort(nodes.begin(), nodes.end(), IsNodeBefore);
+
+    numKept = 0;
+    for ( size_t n = 0; n < nodes.size(); n++ )
     {
-        int & rowOrCol = m_rowsOrCols[n];
-        if ( (size_t)rowOrCol >= pos )
+        Node *node = nodes[n];
+        if ( numKept && nodes[numKept - 1]->block == node->block )
         {
-            if ( numRowsOrCols > 0 )
-            {
-                // If rows or cols inserted, increment row/col counter where necessary
-                rowOrCol += numRowsOrCols;
-            }
-            else if ( numRowsOrCols < 0)
-            {
-                // If rows/cols deleted, either decrement row/col counter (if row/col still exists)
-                if ((size_t)rowOrCol >= pos - numRowsOrCols)
-                    rowOrCol += numRowsOrCols;
-                else
-                {
-                    m_rowsOrCols.RemoveAt(n);
-                    m_attrs[n]->DecRef();
-                    m_attrs.RemoveAt(n);
-                    n--;
-                    count--;
-                }
-            }
+            Node *& last = nodes[numKept - 1];
+            if ( node->order > last->order )
+                wxSwap(node, last);
+
+            node->attr->DecRef();
+            delete node;
+            continue;
         }
+
+        nodes[numKept++] = node;
     }
+
+    nodes.erase(nodes.begin() + numKept, nodes.end());
+
+    Build(nodes);
+}
+
+void wxGridBlockAttrData::UpdateAttrRows( size_t pos, int numRows )
+{
+    UpdateAttrRowsOrCols(pos, numRows, true);
+}
+
+void wxGridBlockAttrData::UpdateAttrCols( size_t pos, int numCols )
+{
+    UpdateAttrRowsOrCols(pos, numCols, false);
 }
 
 // ----------------------------------------------------------------------------
@@ -1171,55 +2042,67 @@ wxGridCellAttr *wxGridCellAttrProvider::GetAttr(int row, int col,
                 {
                     // Basically implement old version.
                     // Also check merge cache, so we don't have to re-merge every time..
-                    wxGridCellAttr *attrcell = m_data->m_cellAttrs.GetAttr(row, col);
-                    wxGridCellAttr *attrrow = m_data->m_rowAttrs.GetAttr(row);
-                    wxGridCellAttr *attrcol = m_data->m_colAttrs.GetAttr(col);
 
-                    if ((attrcell != attrrow) && (attrrow != attrcol) && (attrcell != attrcol))
+                    // Order is important: the attributes coming first take
+                    // precedence over the later ones.
+                    wxGridCellAttr *attrs[] =
+                    {
+                        m_data->m_cellAttrs.GetAttr(row, col),
+                        m_data->m_blockAttrs.GetAttr(row, col),
+                        m_data->m_colAttrs.GetAttr(col),
+                        m_data->m_rowAttrs.GetAttr(row),
+                    };
+
+                    int numAttrs = 0;
+                    for ( size_t n = 0; n < WXSIZEOF(attrs); n++ )
+                    {
+                        if ( attrs[n] )
+                        {
+                            // The same attribute object may be used at
+                            // several levels, don't merge it more than once.
+                            bool duplicate = false;
+                            for ( size_t m = 0; m < n; m++ )
+                            {
+                                if ( attrs[m] == attrs[n] )
+                                {
+                                    duplicate = true;
+                                    break;
+                                }
+                            }
+
+                            if ( duplicate )
+                            {
+                                attrs[n]->DecRef();
+                                attrs[n] = NULL;
+                                continue;
+                            }
+
+                            numAttrs++;
+                            if ( !attr )
+                                attr = attrs[n];
+                        }
+                    }
+
+                    if ( numAttrs > 1 )
                     {
-                        // Two or more are non NULL
+                        // Two or more are non NULL, merge them.
                         attr = new wxGridCellAttr;
                         attr->SetKind(wxGridCellAttr::Merged);
 
-                        // Order is important..
-                        if (attrcell)
-                        {
-                            attr->MergeWith(attrcell);
-                            attrcell->DecRef();
-                        }
-                        if (attrcol)
+                        for ( size_t n = 0; n < WXSIZEOF(attrs); n++ )
                         {
-                            attr->MergeWith(attrcol);
-                            attrcol->DecRef();
-                        }
-                        if (attrrow)
-                        {
-                            attr->MergeWith(attrrow);
-                            attrrow->DecRef();
+                            if ( attrs[n] )
+                            {
+                                attr->MergeWith(attrs[n]);
+                                attrs[n]->DecRef();
+                            }
                         }
 
                         // store merge attr if cache implemented
                         //attr->IncRef();
                         //m_data->m_mergeAttr.SetAttr(attr, row, col);
                     }
-                    else
-                    {
-                        // one or none is non null return it or null.
-                        if (attrrow)
-                            attr = attrrow;
-                        if (attrcol)
-                        {
-                            if (attr)
-                                attr->DecRef();
-                            attr = attrcol;
-                        }
-                        if (attrcell)
-                        {
-                            if (attr)
-                                attr->DecRef();
-                            attr = attrcell;
-                        }
-                    }
+                    //else: one or none is non null, just return it or null
                 }
                 break;
 
@@ -1255,6 +2138,23 @@ void wxGridCellAttrProvider::SetAttr(wxGridCellAttr *attr,
     m_data->m_cellAttrs.SetAttr(attr, row, col);
 }
 
+void wxGridCellAttrProvider::SetBlockAttr(wxGridCellAttr *attr,
+                                          const wxGridBlockCoords& block)
+{
+    if ( attr )
+    {
+        int rows, cols;
+        attr->GetSize(&rows, &cols);
+        wxASSERT_MSG( rows == 1 && cols == 1,
+                      "block attributes can't define the cell size" );
+    }
+
+    if ( !m_data )
+        InitData();
+
+    m_data->m_blockAttrs.SetAttr(attr, block.Canonicalize());
+}
+
 void wxGridCellAttrProvider::SetRowAttr(wxGridCellAttr *attr, int row)
 {
     if ( !m_data )
@@ -1276,6 +2176,7 @@ void wxGridCellAttrProvider::UpdateAttrRows( size_t pos, int numRows )
     if ( m_data )
     {
         m_data->m_cellAttrs.UpdateAttrRows( pos, numRows );
+        m_data->m_blockAttrs.UpdateAttrRows( pos, numRows );
 
         m_data->m_rowAttrs.UpdateAttrRowsOrCols( pos, numRows );
     }
@@ -1286,6 +2187,7 @@ void wxGridCellAttrProvider::UpdateAttrCols( size_t pos, int numCols )
     if ( m_data )
     {
         m_data->m_cellAttrs.UpdateAttrCols( pos, numCols );
+        m_data->m_blockAttrs.UpdateAttrCols( pos, numCols );
 
         m_data->m_colAttrs.UpdateAttrRowsOrCols( pos, numCols );
     }
@@ -1581,6 +2483,23 @@ void wxGridTableBase::SetRowAttr(wxGridCellAttr *attr, int row)
     }
 }
 
+void wxGridTableBase::SetBlockAttr(wxGridCellAttr *attr,
+                                   const wxGridBlockCoords& block)
+{
+    if ( m_attrProvider )
+    {
+        if ( attr )
+            attr->SetKind(wxGridCellAttr::Cell);
+        m_attrProvider->SetBlockAttr(attr, block);
+    }
+    else
+    {
+        // as we take ownership of the pointer and don't store it, we must
+        // free it now
+        wxSafeDecRef(attr);
+    }
+}
+
 void wxGridTableBase::SetColAttr(wxGridCellAttr *attr, int col)
 {
     if ( m_attrProvider )
@@ -1686,6 +2605,12 @@ wxString wxGridTableBase::GetCornerLabelValue() const
     return wxString();
 }
 
+bool wxGridTableBase::GetValues( const wxGridBlockCoords& WXUNUSED(block),
+                                 wxArrayString& WXUNUSED(values) )
+{
+    return false;
+}
+
 wxString wxGridTableBase::GetTypeName( int WXUNUSED(row), int WXUNUSED(col) )
 {
     return wxGRID_VALUE_STRING;
@@ -2730,6 +3655,11 @@ wxGrid::~wxGrid()
              total ? (gs_nAttrCacheHits*100) / total : 0);
 #endif
 
+#if wxUSE_THREADS
+    // stop loading the data before the table can be deleted
+    wxDELETE(m_asyncTableData);
+#endif // wxUSE_THREADS
+
     // if we own the table, just delete it, otherwise at least don't leave it
     // with dangling view pointer
     if ( m_ownTable )
@@ -2742,6 +3672,9 @@ wxGrid::~wxGrid()
 
     delete m_setFixedRows;
     delete m_setFixedCols;
+
+    delete m_rowSizes;
+    delete m_bestSizeCache;
 }
 
 //
@@ -2907,6 +3840,10 @@ wxGrid::SetTable(wxGridTableBase *table,
             HideCellEditControl();
             m_cellEditCtrlEnabled = false;
 
+#if wxUSE_THREADS
+            wxDELETE(m_asyncTableData);
+#endif // wxUSE_THREADS
+
             m_table->SetView(0);
             if( m_ownTable )
                 delete m_table;
@@ -2924,8 +3861,10 @@ wxGrid::SetTable(wxGridTableBase *table,
         // kill row and column size arrays
         m_colWidths.Empty();
         m_colRights.Empty();
-        m_rowHeights.Empty();
-        m_rowBottoms.Empty();
+        wxDELETE(m_rowSizes);
+
+        if ( m_bestSizeCache )
+            m_bestSizeCache->Clear();
     }
 
     if (table)
@@ -2937,6 +3876,15 @@ wxGrid::SetTable(wxGridTableBase *table,
         m_table->SetView( this );
         m_ownTable = takeOwnership;
 
+#if wxUSE_THREADS
+        // the data of the asynchronous tables belongs to the grid, so that
+        // their worker thread can be stopped before the table is destroyed
+        wxGridAsyncTableBase * const
+            asyncTable = wxDynamicCast(table, wxGridAsyncTableBase);
+        if ( asyncTable )
+            m_asyncTableData = new wxGridAsyncTableData(asyncTable);
+#endif // wxUSE_THREADS
+
         // Notice that this must be called after setting m_table as it uses it
         // indirectly, via wxGrid::GetColLabelValue().
         if ( m_useNativeHeader )
@@ -2977,8 +3925,14 @@ void wxGrid::Init()
 
     m_table = NULL;
     m_ownTable = false;
+#if wxUSE_THREADS
+    m_asyncTableData = NULL;
+#endif // wxUSE_THREADS
 
     m_selection = NULL;
+    m_rowSizes = NULL;
+    m_autoSizeSampleSize = 0;
+    m_bestSizeCache = NULL;
     m_defaultCellAttr = NULL;
     m_typeRegistry = NULL;
 
@@ -3076,32 +4030,19 @@ void wxGrid::Init()
 }
 
 // ----------------------------------------------------------------------------
-// the idea is to call these functions only when necessary because they create
-// quite big arrays which eat memory mostly unnecessary - in particular, if
-// default widths/heights are used for all rows/columns, we may not use these
-// arrays at all
+// the idea is to call these functions only when necessary because if default
+// widths/heights are used for all rows/columns, we don't need to store them at
+// all
 //
-// with some extra code, it should be possible to only store the widths/heights
-// different from default ones (resulting in space savings for huge grids) but
-// this is not done currently
+// notice that the row heights are stored as runs of rows of the same height,
+// so only the heights different from default ones really take space, but the
+// column widths are still stored in quite big arrays
 // ----------------------------------------------------------------------------
 
 void wxGrid::InitRowHeights()
 {
-    m_rowHeights.Empty();
-    m_rowBottoms.Empty();
-
-    m_rowHeights.Alloc( m_numRows );
-    m_rowBottoms.Alloc( m_numRows );
-
-    m_rowHeights.Add( m_defaultRowHeight, m_numRows );
-
-    int rowBottom = 0;
-    for ( int i = 0; i < m_numRows; i++ )
-    {
-        rowBottom += m_defaultRowHeight;
-        m_rowBottoms.Add( rowBottom );
-    }
+    delete m_rowSizes;
+    m_rowSizes = new wxGridLineSizes(m_numRows, m_defaultRowHeight);
 }
 
 void wxGrid::InitColWidths()
@@ -3147,25 +4088,26 @@ int wxGrid::GetColRight(int col) const
 int wxGrid::GetRowHeight(int row) const
 {
     // no custom heights / hidden rows
-    if ( m_rowHeights.IsEmpty() )
+    if ( !m_rowSizes )
         return m_defaultRowHeight;
 
     // a negative height indicates a hidden row
-    return m_rowHeights[row] > 0 ? m_rowHeights[row] : 0;
+    const int height = m_rowSizes->GetSize(row);
+    return height > 0 ? height : 0;
 }
 
 int wxGrid::GetRowTop(int row) const
 {
-    if ( m_rowBottoms.IsEmpty() )
+    if ( !m_rowSizes )
         return row * m_defaultRowHeight;
 
-    return m_rowBottoms[row] - GetRowHeight(row);
+    return m_rowSizes->GetEnd(row) - GetRowHeight(row);
 }
 
 int wxGrid::GetRowBottom(int row) const
 {
-    return m_rowBottoms.IsEmpty() ? (row + 1) * m_defaultRowHeight
-                                  : m_rowBottoms[row];
+    return m_rowSizes ? m_rowSizes->GetEnd(row)
+                      : (row + 1) * m_defaultRowHeight;
 }
 
 void wxGrid::CalcDimensions()
@@ -3309,21 +4251,8 @@ bool wxGrid::Redimension( wxGridTableMessage& msg )
 
             m_numRows += numRows;
 
-            if ( !m_rowHeights.IsEmpty() )
-            {
-                m_rowHeights.Insert( m_defaultRowHeight, pos, numRows );
-                m_rowBottoms.Insert( 0, pos, numRows );
-
-                int bottom = 0;
-                if ( pos > 0 )
-                    bottom = m_rowBottoms[pos - 1];
-
-                for ( i = pos; i < m_numRows; i++ )
-                {
-                    bottom += GetRowHeight(i);
-                    m_rowBottoms[i] = bottom;
-                }
-            }
+            if ( m_rowSizes )
+                m_rowSizes->Insert( pos, numRows, m_defaultRowHeight );
 
             UpdateCurrentCellOnRedim();
 
@@ -3347,21 +4276,8 @@ bool wxGrid::Redimension( wxGridTableMessage& msg )
             int oldNumRows = m_numRows;
             m_numRows += numRows;
 
-            if ( !m_rowHeights.IsEmpty() )
-            {
-                m_rowHeights.Add( m_defaultRowHeight, numRows );
-                m_rowBottoms.Add( 0, numRows );
-
-                int bottom = 0;
-                if ( oldNumRows > 0 )
-                    bottom = m_rowBottoms[oldNumRows - 1];
-
-                for ( i = oldNumRows; i < m_numRows; i++ )
-                {
-                    bottom += GetRowHeight(i);
-                    m_rowBottoms[i] = bottom;
-                }
-            }
+            if ( m_rowSizes )
+                m_rowSizes->Insert( oldNumRows, numRows, m_defaultRowHeight );
 
             UpdateCurrentCellOnRedim();
 
@@ -3379,18 +4295,8 @@ bool wxGrid::Redimension( wxGridTableMessage& msg )
             int numRows = msg.GetCommandInt2();
             m_numRows -= numRows;
 
-            if ( !m_rowHeights.IsEmpty() )
-            {
-                m_rowHeights.RemoveAt( pos, numRows );
-                m_rowBottoms.RemoveAt( pos, numRows );
-
-                int h = 0;
-                for ( i = 0; i < m_numRows; i++ )
-                {
-                    h += GetRowHeight(i);
-                    m_rowBottoms[i] = h;
-                }
-            }
+            if ( m_rowSizes )
+                m_rowSizes->Remove( pos, numRows );
 
             UpdateCurrentCellOnRedim();
 
@@ -5770,24 +6676,8 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
     // If we have any non-default row sizes, we need to scale them (default
     // ones will be scaled due to the reinitialization of m_defaultRowHeight
     // inside InitPixelFields() above).
-    if ( !m_rowHeights.empty() )
-    {
-        int total = 0;
-        for ( unsigned i = 0; i < m_rowHeights.size(); ++i )
-        {
-            int height = m_rowHeights[i];
-
-            // Skip hidden rows.
-            if ( height <= 0 )
-                continue;
-
-            height = height * event.GetNewDPI().x / event.GetOldDPI().x;
-            total += height;
-
-            m_rowHeights[i] = height;
-            m_rowBottoms[i] = total;
-        }
-    }
+    if ( m_rowSizes )
+        m_rowSizes->Scale(event.GetNewDPI().x, event.GetOldDPI().x);
 
     // Similarly for columns, except that here we need to update the native
     // control even if none of the widths had been changed, as it's not going
@@ -6326,6 +7216,44 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
     int i, numCells = cells.GetCount();
     wxGridCellCoordsArray redrawCells;
 
+    // give the table a chance to retrieve the values of all the cells we are
+    // going to draw at once instead of doing it for each of them
+    if ( m_table && numCells > 1 )
+    {
+        int topRow = m_numRows,
+            leftCol = m_numCols,
+            bottomRow = -1,
+            rightCol = -1;
+        for ( i = 0; i < numCells; i++ )
+        {
+            const wxGridCellCoords& cell = cells[i];
+            topRow = wxMin(topRow, cell.GetRow());
+            leftCol = wxMin(leftCol, cell.GetCol());
+            bottomRow = wxMax(bottomRow, cell.GetRow());
+            rightCol = wxMax(rightCol, cell.GetCol());
+        }
+
+        // the update region may consist of several disjoint rectangles (and
+        // the columns may be reordered too), so their bounding box could be
+        // much bigger than the area being drawn: don't retrieve the values
+        // in this case, as it would cost more than getting the drawn ones
+        // individually
+        const wxGridBlockCoords block(topRow, leftCol, bottomRow, rightCol);
+        const wxLongLong_t
+            area = static_cast<wxLongLong_t>(bottomRow - topRow + 1)*
+                        (rightCol - leftCol + 1);
+        if ( area <= 2*static_cast<wxLongLong_t>(numCells) &&
+                m_table->GetValues(block, m_drawnValues) &&
+                m_drawnValues.size() == static_cast<size_t>(area) )
+        {
+            m_drawnValuesBlock = block;
+        }
+        else
+        {
+            m_drawnValues.clear();
+        }
+    }
+
     for ( i = numCells - 1; i >= 0; i-- )
     {
         int row, col, cell_rows, cell_cols;
@@ -6439,6 +7367,8 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
     {
         DrawCell( dc, redrawCells[i] );
     }
+
+    m_drawnValues.clear();
 }
 
 void wxGrid::DrawGridSpace( wxDC& dc, wxGridWindow *gridWindow )
@@ -7767,8 +8697,8 @@ wxGridCellCoords wxGrid::XYToCell(int x, int y, wxGridWindow *gridWindow) const
 }
 
 // compute row or column from some (unscrolled) coordinate value, using either
-// m_defaultRowHeight/m_defaultColWidth or binary search on array of
-// m_rowBottoms/m_colRights to do it quickly in O(log n) time.
+// m_defaultRowHeight/m_defaultColWidth or searching m_rowSizes/m_colRights to
+// do it quickly in O(log n) time.
 // NOTE: This may not work correctly for reordered columns.
 int wxGrid::PosToLinePos(int coord,
                          bool clipToMinMax,
@@ -7788,8 +8718,7 @@ int wxGrid::PosToLinePos(int coord,
 
     // check for the simplest case: if we have no explicit line sizes
     // configured, then we already know the line this position falls in
-    const wxArrayInt& lineEnds = oper.GetLineEnds(this);
-    if ( lineEnds.empty() )
+    if ( !oper.HasCustomLineSizes(this) )
     {
         if ( maxPos < (numLines + minPos) )
             return maxPos;
@@ -7797,45 +8726,24 @@ int wxGrid::PosToLinePos(int coord,
         return clipToMinMax ? numLines + minPos - 1 : -1;
     }
 
-    // binary search is quite efficient and we can't really make any assumptions
-    // on where to start here since row and columns could be of size 0 if they are
-    // hidden. While this could be made more efficient, some profiling will be
-    // necessary to determine if it really is a performance bottleneck
+    // we can't really make any assumptions on where to start here since rows
+    // and columns could be of size 0 if they are hidden, so search for the
+    // line in the structure storing their sizes
     maxPos = numLines + minPos - 1;
 
     // check if the position is beyond the last column
     const int lineAtMaxPos = oper.GetLineAt(this, maxPos);
-    if ( coord >= lineEnds[lineAtMaxPos] )
+    if ( coord >= oper.GetLineEndPos(this, lineAtMaxPos) )
         return clipToMinMax ? maxPos : wxNOT_FOUND;
 
     // or before the first one
     const int lineAt0 = oper.GetLineAt(this, minPos);
     if ( coord < oper.GetLineStartPos(this, lineAt0) )
         return clipToMinMax ? minPos : wxNOT_FOUND;
-    else if ( coord < lineEnds[lineAt0] )
+    else if ( coord < oper.GetLineEndPos(this, lineAt0) )
         return minPos;
 
-    // finally do perform the binary search
-    while ( minPos < maxPos )
-    {
-        wxCHECK_MSG( lineEnds[oper.GetLineAt(this, minPos)] <= coord &&
-                        coord < lineEnds[oper.GetLineAt(this, maxPos)],
-                     -1,
-                     "wxGrid: internal error in PosToLinePos()" );
-
-        if ( coord >= lineEnds[oper.GetLineAt(this, maxPos - 1)] )
-            return maxPos;
-        else
-            maxPos--;
-
-        const int median = minPos + (maxPos - minPos + 1) / 2;
-        if ( coord < lineEnds[oper.GetLineAt(this, median)] )
-            maxPos = median;
-        else
-            minPos = median;
-    }
-
-    return maxPos;
+    return oper.FindLinePos(this, coord, minPos, maxPos);
 }
 
 int
@@ -9321,6 +10229,24 @@ bool wxGrid::IsReadOnly(int row, int col) const
 // attribute support: cache, automatic provider creation, ...
 // ----------------------------------------------------------------------------
 
+wxString wxGrid::GetCellValue( int row, int col ) const
+{
+    if ( !m_table )
+        return wxString();
+
+    // use the values retrieved by DrawGridCellArea() if we're drawing
+    if ( !m_drawnValues.empty() &&
+            m_drawnValuesBlock.Contains(wxGridCellCoords(row, col)) )
+    {
+        const int width = m_drawnValuesBlock.GetRightCol() -
+                            m_drawnValuesBlock.GetLeftCol() + 1;
+        return m_drawnValues[(row - m_drawnValuesBlock.GetTopRow())*width +
+                                col - m_drawnValuesBlock.GetLeftCol()];
+    }
+
+    return m_table->GetValue( row, col );
+}
+
 bool wxGrid::CanHaveAttributes() const
 {
     if ( !m_table )
@@ -9505,6 +10431,22 @@ void wxGrid::SetAttr(int row, int col, wxGridCellAttr *attr)
     }
 }
 
+void wxGrid::SetBlockAttr(int topRow, int leftCol, int bottomRow, int rightCol,
+                          wxGridCellAttr *attr)
+{
+    if ( CanHaveAttributes() )
+    {
+        m_table->SetBlockAttr(attr,
+                              wxGridBlockCoords(topRow, leftCol,
+                                                bottomRow, rightCol));
+        ClearAttrCache();
+    }
+    else
+    {
+        wxSafeDecRef(attr);
+    }
+}
+
 void wxGrid::SetRowAttr(int row, wxGridCellAttr *attr)
 {
     if ( CanHaveAttributes() )
@@ -9752,11 +10694,9 @@ void wxGrid::SetDefaultRowSize( int height, bool resizeExistingRows )
     if ( resizeExistingRows )
     {
         // since we are resizing all rows to the default row size,
-        // we can simply clear the row heights and row bottoms
-        // arrays (which also allows us to take advantage of
-        // some speed optimisations)
-        m_rowHeights.Empty();
-        m_rowBottoms.Empty();
+        // we can simply forget the row sizes (which also allows us
+        // to take advantage of some speed optimisations)
+        wxDELETE(m_rowSizes);
         CalcDimensions();
     }
 }
@@ -9847,20 +10787,18 @@ void wxGrid::DoSetRowSize( int row, int height )
 {
     wxCHECK_RET( row >= 0 && row < m_numRows, wxT("invalid row index") );
 
-    if ( m_rowHeights.IsEmpty() )
+    if ( !m_rowSizes )
     {
-        // need to really create the array
+        // need to really create the row sizes
         InitRowHeights();
     }
 
-    const int diff = UpdateRowOrColSize(m_rowHeights[row], height);
+    int heightCurrent = m_rowSizes->GetSize(row);
+    const int diff = UpdateRowOrColSize(heightCurrent, height);
     if ( !diff )
         return;
 
-    for ( int i = row; i < m_numRows; i++ )
-    {
-        m_rowBottoms[i] += diff;
-    }
+    m_rowSizes->SetSize(row, heightCurrent);
 
     InvalidateBestSize();
 
@@ -10266,10 +11204,26 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
     wxGridCellAttrPtr attr;
     wxGridCellRendererPtr renderer;
 
-    wxCoord extent, extentMax = 0;
+    // Only measure some of the cells if sampling is enabled and there are
+    // many of them.
+    wxVector<int> sample;
     int max = column ? m_numRows : m_numCols;
-    for ( int rowOrCol = 0; rowOrCol < max; rowOrCol++ )
+    const bool useSample = m_autoSizeSampleSize > 0 &&
+                            max > 4*m_autoSizeSampleSize;
+    if ( useSample )
+    {
+        GetAutoSizeSample(colOrRow, direction, sample);
+        max = sample.size();
+
+        if ( !m_bestSizeCache )
+            m_bestSizeCache = new wxGridBestSizeCache;
+    }
+
+    wxCoord extent, extentMax = 0;
+    for ( int n = 0; n < max; n++ )
     {
+        const int rowOrCol = useSample ? sample[n] : n;
+
         if ( column )
         {
             if ( !IsRowShown(rowOrCol) )
@@ -10327,11 +11281,32 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
 
         if ( renderer )
         {
-            extent = column
-                        ? renderer->GetBestWidth(*this, *attr, dc, row, col,
-                                                 GetRowHeight(row))
-                        : renderer->GetBestHeight(*this, *attr, dc, row, col,
-                                                  GetColWidth(col));
+            const int otherSize = column ? GetRowHeight(row) : GetColWidth(col);
+
+            // When sampling, reuse the previously measured size if the cell
+            // didn't change since then.
+            wxString value;
+            if ( useSample )
+                value = GetCellValue(row, col);
+
+            if ( !useSample ||
+                    !m_bestSizeCache->Lookup(direction, row, col, value,
+                                             attr->GetFont(), otherSize,
+                                             &extent) )
+            {
+                extent = column
+                            ? renderer->GetBestWidth(*this, *attr, dc,
+                                                     row, col, otherSize)
+                            : renderer->GetBestHeight(*this, *attr, dc,
+                                                      row, col, otherSize);
+
+                if ( useSample )
+                {
+                    m_bestSizeCache->Store(direction, row, col, value,
+                                           attr->GetFont(), otherSize,
+                                           extent);
+                }
+            }
 
             if ( span != CellSpan_None )
             {
@@ -10524,6 +11499,100 @@ wxCoord wxGrid::CalcColOrRowLabelAreaMinSize(wxGridDirection direction)
     return extentMax;
 }
 
+void
+wxGrid::GetAutoSizeSample(int colOrRow,
+                          wxGridDirection direction,
+                          wxVector<int>& lines) const
+{
+    const bool column = direction == wxGRID_COLUMN;
+    const int count = column ? m_numRows : m_numCols;
+    const int numSample = wxMin(m_autoSizeSampleSize, count);
+
+    // Always measure the first and the last lines.
+    for ( int n = 0; n < numSample; n++ )
+    {
+        lines.push_back(n);
+        lines.push_back(count - 1 - n);
+    }
+
+    // And the currently visible ones.
+    if ( m_gridWin )
+    {
+        int x, y;
+        CalcGridWindowUnscrolledPosition(0, 0, &x, &y, m_gridWin);
+
+        const wxSize size = m_gridWin->GetClientSize();
+        if ( column )
+        {
+            const int first = internalYToRow(y, m_gridWin);
+            const int last = internalYToRow(y + size.y, m_gridWin);
+            for ( int row = first; row <= last; row++ )
+                lines.push_back(row);
+        }
+        else
+        {
+            const int first = XToPos(x, m_gridWin);
+            const int last = XToPos(x + size.x, m_gridWin);
+            for ( int pos = first; pos <= last; pos++ )
+                lines.push_back(GetColAt(pos));
+        }
+    }
+
+    // Finally use the length of the cell values as a cheap approximation of
+    // their size and also measure the cells with the longest ones: keep the
+    // numSample longest values seen so far in a min-heap of their lengths
+    // combined with the line index.
+    //
+    // Retrieving the values of all cells may be expensive too, so only look
+    // at a bounded number of lines evenly distributed over all of them.
+    const int numScan = count / 16 > numSample ? 16*numSample : count;
+
+    wxVector<wxLongLong_t> longest;
+    longest.reserve(numSample);
+    for ( int i = 0; i < numScan; i++ )
+    {
+        const int n = static_cast<int>(static_cast<wxLongLong_t>(i)*count /
+                                            numScan);
+
+        const wxString& value = column ? GetCellValue(n, colOrRow)
+                                       : GetCellValue(colOrRow, n);
+
+        const wxLongLong_t
+            key = (static_cast<wxLongLong_t>(value.length()) << 32) + n;
+        if ( longest.size() < static_cast<size_t>(numSample) )
+        {
+            longest.push_back(key);
+            std::push_heap(longest.begin(), longest.end(),
+                           std::greater<wxLongLong_t>());
+        }
+        else if ( key > longest.front() )
+        {
+            std::pop_heap(longest.begin(), longest.end(),
+                          std::greater<wxLongLong_t>());
+            longest.back() = key;
+            std::push_heap(longest.begin(), longest.end(),
+                           std::greater<wxLongLong_t>());
+        }
+    }
+
+    for ( size_t n = 0; n < longest.size(); n++ )
+        lines.push_back(static_cast<int>(longest[n] & 0xffffffff));
+
+    // Sort the lines and remove the duplicates.
+    std::sort(lines.begin(), lines.end());
+    lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+}
+
+void wxGrid::SetAutoSizeSampleSize(int numLines)
+{
+    wxCHECK_RET( numLines >= 0, "invalid auto-size sample size" );
+
+    m_autoSizeSampleSize = numLines;
+
+    if ( !numLines )
+        wxDELETE(m_bestSizeCache);
+}
+
 void wxGrid::AutoSizeColumns(bool setAsMin)
 {
     wxGridUpdateLocker locker(this);
@@ -10595,14 +11664,13 @@ wxSize wxGrid::DoGetBestSize() const
             size.x += GetColWidth(col);
     }
 
-    if ( m_rowHeights.empty() )
+    if ( !m_rowSizes )
     {
         size.y += m_defaultRowHeight*m_numRows;
     }
     else
     {
-        for ( int row = 0; row < m_numRows; row++ )
-            size.y += GetRowHeight(row);
+        size.y += m_rowSizes->GetTotal();
     }
 
     return size + GetWindowBorderSize();
@@ -10946,6 +12014,22 @@ wxArrayInt wxGrid::GetSelectedCols() const
     return m_selection->GetColSelection();
 }
 
+wxGridLines wxGrid::GetSelectedRowLines() const
+{
+    if ( !m_selection )
+        return wxGridLines();
+
+    return m_selection->GetRowLines();
+}
+
+wxGridLines wxGrid::GetSelectedColLines() const
+{
+    if ( !m_selection )
+        return wxGridLines();
+
+    return m_selection->GetColLines();
+}
+
 void wxGrid::ClearSelection()
 {
     if ( m_selection )
@@ -11091,12 +12175,20 @@ void wxGrid::DoSetSizes(const wxGridSizesInfo& sizeInfo,
 {
     BeginBatch();
     oper.SetDefaultLineSize(this, sizeInfo.m_sizeDefault, true);
-    const int numLines = oper.GetNumberOfLines(this, NULL);
-    for ( int i = 0; i < numLines; i++ )
+
+    // only the lines with non-default sizes need to be updated, which avoids
+    // iterating over all the lines of a huge grid
+    const unsigned numLines = oper.GetNumberOfLines(this, NULL);
+    for ( wxUnsignedToIntHashMap::const_iterator it = sizeInfo.m_customSizes.begin();
+          it != sizeInfo.m_customSizes.end();
+          ++it )
     {
-        int size = sizeInfo.GetSize(i);
+        if ( it->first >= numLines )
+            continue;
+
+        int size = sizeInfo.GetSize(it->first);
         if ( size != sizeInfo.m_sizeDefault)
-            oper.SetLineSize(this, i, size);
+            oper.SetLineSize(this, it->first, size);
     }
     EndBatch();
 }
@@ -11111,6 +12203,16 @@ void wxGrid::SetRowSizes(const wxGridSizesInfo& sizeInfo)
     DoSetSizes(sizeInfo, wxGridRowOperations());
 }
 
+wxGridSizesInfo wxGrid::GetRowSizes() const
+{
+    wxGridSizesInfo sizeInfo;
+    sizeInfo.m_sizeDefault = GetDefaultRowSize();
+    if ( m_rowSizes )
+        m_rowSizes->GetCustomSizes(sizeInfo.m_sizeDefault, sizeInfo.m_customSizes);
+
+    return sizeInfo;
+}
+
 wxGridSizesInfo::wxGridSizesInfo(int defSize, const wxArrayInt& allSizes)
 {
     m_sizeDefault = defSize;
@@ -0,0 +1,472 @@
+///////////////////////////////////////////////////////////////////////////
+// Name:        src/generic/gridasync.cpp
+// Purpose:     wxGridAsyncTableBase
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+// For compilers that support precompilation, includes "wx/wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_GRID && wxUSE_THREADS
+
+#ifndef WX_PRECOMP
+    #include "wx/utils.h"
+#endif
+
+#include "wx/generic/private/gridasync.h"
+
+// ============================================================================
+// wxGridAsyncTableData implementation
+// ============================================================================
+
+wxGridAsyncTableData::wxGridAsyncTableData(wxGridAsyncTableBase *table)
+    : m_table(table),
+      m_idle(m_mutex)
+{
+    wxASSERT_MSG( !table->m_data, "table already used by another grid" );
+
+    m_lastUse = 0;
+    m_lastFirstChunk = -1;
+    m_generation = 0;
+    m_busy = false;
+    m_stop = false;
+
+    Bind(wxEVT_THREAD, &wxGridAsyncTableData::OnChunksLoaded, this);
+
+    m_table->m_data = this;
+}
+
+wxGridAsyncTableData::~wxGridAsyncTableData()
+{
+    // This is the only place where the thread is stopped: as it's done by
+    // the grid before it deletes the table (or stops using it), the table
+    // is still fully constructed and can't be used by LoadRows() after
+    // being destroyed.
+    Stop();
+
+    m_table->m_data = NULL;
+
+    for ( size_t n = 0; n < m_results.size(); n++ )
+        delete m_results[n];
+
+    DeleteChunks();
+}
+
+void wxGridAsyncTableData::Stop()
+{
+    wxThread * const thread = GetThread();
+    if ( !thread || !thread->IsRunning() )
+        return;
+
+    {
+        wxMutexLocker lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_semaphore.Post();
+    thread->Wait();
+}
+
+void wxGridAsyncTableData::DeleteChunks()
+{
+    for ( wxGridAsyncChunkMap::iterator it = m_chunks.begin();
+          it != m_chunks.end();
+          ++it )
+    {
+        delete it->second;
+    }
+
+    m_chunks.clear();
+}
+
+void wxGridAsyncTableData::Invalidate()
+{
+    DeleteChunks();
+
+    // the results of the requests already being processed will be ignored
+    m_generation++;
+    m_pending.clear();
+
+    wxMutexLocker lock(m_mutex);
+    m_requests.clear();
+}
+
+void wxGridAsyncTableData::WaitUntilLoaded()
+{
+    if ( GetThread() )
+    {
+        wxMutexLocker lock(m_mutex);
+
+        while ( !m_stop && (m_busy || !m_requests.empty()) )
+            m_idle.Wait();
+    }
+
+    // The event sent by the worker thread may still be pending, but we don't
+    // need to wait for it, it will just find no results to store.
+    StoreResults();
+}
+
+bool wxGridAsyncTableData::GetValue(int row, int col, wxString& value)
+{
+    const int chunkSize = m_table->m_chunkSize;
+
+    wxGridAsyncChunkMap::iterator it = m_chunks.find(row / chunkSize);
+    if ( it == m_chunks.end() )
+        return false;
+
+    wxGridAsyncChunk * const chunk = it->second;
+    chunk->lastUse = ++m_lastUse;
+
+    const int rowInChunk = row % chunkSize;
+    if ( rowInChunk >= chunk->numRows || col < 0 || col >= chunk->numCols )
+        return false;
+
+    value = chunk->values[rowInChunk*chunk->numCols + col];
+
+    return true;
+}
+
+void wxGridAsyncTableData::Request(int firstRow, int lastRow)
+{
+    const int numRows = m_table->GetNumberRows();
+    if ( firstRow < 0 || firstRow > lastRow || firstRow >= numRows )
+        return;
+
+    const int chunkSize = m_table->m_chunkSize;
+    const int firstChunk = firstRow / chunkSize;
+    const int lastChunk = wxMin(lastRow, numRows - 1) / chunkSize;
+
+    // Prefetch the chunk following the requested ones in the direction of
+    // scrolling. Do it first because the requests are processed in LIFO
+    // order, so that the visible rows are loaded before it.
+    if ( m_lastFirstChunk != -1 )
+    {
+        if ( firstChunk > m_lastFirstChunk )
+            RequestChunk(lastChunk + 1, numRows);
+        else if ( firstChunk < m_lastFirstChunk && firstChunk > 0 )
+            RequestChunk(firstChunk - 1, numRows);
+    }
+
+    m_lastFirstChunk = firstChunk;
+
+    for ( int chunk = lastChunk; chunk >= firstChunk; chunk-- )
+        RequestChunk(chunk, numRows);
+}
+
+void wxGridAsyncTableData::RequestChunk(int chunk, int numRows)
+{
+    const int chunkSize = m_table->m_chunkSize;
+
+    wxGridAsyncRequest request;
+    request.chunk = chunk;
+    request.firstRow = chunk*chunkSize;
+    if ( request.firstRow >= numRows )
+        return;
+
+    if ( m_chunks.find(chunk) != m_chunks.end() )
+        return;
+
+    for ( size_t n = 0; n < m_pending.size(); n++ )
+    {
+        if ( m_pending[n] == chunk )
+            return;
+    }
+
+    request.numRows = wxMin(chunkSize, numRows - request.firstRow);
+    request.numCols = m_table->GetNumberCols();
+    request.generation = m_generation;
+
+    if ( !GetThread() )
+    {
+        if ( CreateThread(wxTHREAD_JOINABLE) != wxTHREAD_NO_ERROR ||
+                GetThread()->Run() != wxTHREAD_NO_ERROR )
+        {
+            // Fall back to loading the data synchronously, this is still
+            // better than not showing it at all.
+            wxGridAsyncResult * const result = new wxGridAsyncResult;
+            result->request = request;
+            result->ok = m_table->LoadRows(request.firstRow, request.numRows,
+                                           request.numCols, result->values);
+            StoreResult(result);
+            return;
+        }
+    }
+
+    m_pending.push_back(chunk);
+
+    {
+        wxMutexLocker lock(m_mutex);
+
+        if ( m_stop )
+            return;
+
+        m_requests.push_back(request);
+
+        // There is no point in loading more chunks than the cache can hold,
+        // so forget the oldest requests, which are probably not needed any
+        // more anyhow after scrolling.
+        const size_t maxRequests = wxMax(m_table->m_cacheSize / chunkSize, 1);
+        if ( m_requests.size() > maxRequests )
+        {
+            const int dropped = m_requests.front().chunk;
+            m_requests.erase(m_requests.begin());
+
+            for ( size_t n = 0; n < m_pending.size(); n++ )
+            {
+                if ( m_pending[n] == dropped )
+                {
+                    m_pending.erase(m_pending.begin() + n);
+                    break;
+                }
+            }
+        }
+    }
+
+    m_semaphore.Post();
+}
+
+void *wxGridAsyncTableData::Entry()
+{
+    for ( ;; )
+    {
+        m_semaphore.Wait();
+
+        wxGridAsyncRequest request;
+        {
+            wxMutexLocker lock(m_mutex);
+
+            if ( m_stop )
+                break;
+
+            // this may happen if the request was dropped
+            if ( m_requests.empty() )
+                continue;
+
+            request = m_requests.back();
+            m_requests.pop_back();
+
+            m_busy = true;
+        }
+
+        wxGridAsyncResult * const result = new wxGridAsyncResult;
+        result->request = request;
+        result->ok = m_table->LoadRows(request.firstRow, request.numRows,
+                                       request.numCols, result->values);
+
+        {
+            wxMutexLocker lock(m_mutex);
+            m_results.push_back(result);
+
+            m_busy = false;
+            if ( m_requests.empty() )
+                m_idle.Broadcast();
+        }
+
+        QueueEvent(new wxThreadEvent());
+    }
+
+    // wake up WaitUntilLoaded() if it's waiting for us
+    wxMutexLocker lock(m_mutex);
+    m_idle.Broadcast();
+
+    return NULL;
+}
+
+void wxGridAsyncTableData::StoreResult(wxGridAsyncResult *result)
+{
+    const wxGridAsyncRequest& request = result->request;
+
+    for ( size_t n = 0; n < m_pending.size(); n++ )
+    {
+        if ( m_pending[n] == request.chunk )
+        {
+            m_pending.erase(m_pending.begin() + n);
+            break;
+        }
+    }
+
+    if ( request.generation != m_generation || !result->ok ||
+            result->values.size() !=
+                static_cast<size_t>(request.numRows*request.numCols) )
+    {
+        delete result;
+        return;
+    }
+
+    wxGridAsyncChunk *& chunk = m_chunks[request.chunk];
+    if ( !chunk )
+        chunk = new wxGridAsyncChunk;
+
+    chunk->values.swap(result->values);
+    chunk->numRows = request.numRows;
+    chunk->numCols = request.numCols;
+    chunk->lastUse = ++m_lastUse;
+
+    delete result;
+
+    // only repaint the rows which were filled in
+    wxGrid * const grid = m_table->GetView();
+    if ( grid && grid->GetNumberCols() > 0 && request.numCols > 0 )
+    {
+        const int lastRow = wxMin(request.firstRow + request.numRows,
+                                  grid->GetNumberRows()) - 1;
+        if ( lastRow >= request.firstRow )
+        {
+            grid->RefreshBlock(request.firstRow, 0,
+                               lastRow, grid->GetNumberCols() - 1);
+        }
+    }
+}
+
+void wxGridAsyncTableData::StoreResults()
+{
+    wxVector<wxGridAsyncResult *> results;
+    {
+        wxMutexLocker lock(m_mutex);
+        results.swap(m_results);
+    }
+
+    for ( size_t n = 0; n < results.size(); n++ )
+        StoreResult(results[n]);
+
+    TrimCache();
+}
+
+void wxGridAsyncTableData::OnChunksLoaded(wxThreadEvent& WXUNUSED(event))
+{
+    StoreResults();
+}
+
+void wxGridAsyncTableData::TrimCache()
+{
+    const size_t maxChunks = wxMax(m_table->m_cacheSize / m_table->m_chunkSize, 1);
+
+    while ( m_chunks.size() > maxChunks )
+    {
+        wxGridAsyncChunkMap::iterator oldest = m_chunks.begin();
+        for ( wxGridAsyncChunkMap::iterator it = m_chunks.begin();
+              it != m_chunks.end();
+              ++it )
+        {
+            if ( it->second->lastUse < oldest->second->lastUse )
+                oldest = it;
+        }
+
+        delete oldest->second;
+        m_chunks.erase(oldest);
+    }
+}
+
+// ============================================================================
+// wxGridAsyncTableBase implementation
+// ============================================================================
+
+wxIMPLEMENT_ABSTRACT_CLASS(wxGridAsyncTableBase, wxGridTableBase);
+
+wxGridAsyncTableBase::wxGridAsyncTableBase()
+{
+    m_data = NULL;
+    m_chunkSize = 100;
+    m_cacheSize = 10000;
+}
+
+wxGridAsyncTableBase::~wxGridAsyncTableBase()
+{
+    // By now the derived class part of this object is already destroyed, so
+    // it's too late to stop the worker thread which could be using it.
+    wxASSERT_MSG( !m_data,
+                  "wxGridAsyncTableBase must not be deleted while used by wxGrid" );
+}
+
+void wxGridAsyncTableBase::InvalidateCache()
+{
+    if ( !m_data )
+        return;
+
+    m_data->Invalidate();
+
+    if ( GetView() )
+        GetView()->ForceRefresh();
+}
+
+void wxGridAsyncTableBase::WaitUntilLoaded()
+{
+    if ( m_data )
+        m_data->WaitUntilLoaded();
+}
+
+bool wxGridAsyncTableBase::IsRowAvailable( int row ) const
+{
+    return m_data && m_data->HasRow(row);
+}
+
+void wxGridAsyncTableBase::SetChunkSize( int numRows )
+{
+    wxCHECK_RET( numRows > 0, "chunk size must be positive" );
+
+    if ( numRows == m_chunkSize )
+        return;
+
+    // the existing chunks can't be used with the new size
+    if ( m_data )
+        m_data->Invalidate();
+
+    m_chunkSize = numRows;
+}
+
+void wxGridAsyncTableBase::SetCacheSize( int numRows )
+{
+    m_cacheSize = numRows;
+
+    if ( m_data )
+        m_data->TrimCache();
+}
+
+wxString wxGridAsyncTableBase::GetValue( int row, int col )
+{
+    // without the grid there is nothing to load the values and nothing to
+    // show them in anyhow
+    if ( !m_data )
+        return m_placeholder;
+
+    wxString value;
+    if ( !m_data->GetValue(row, col, value) )
+    {
+        m_data->Request(row, row);
+        return m_placeholder;
+    }
+
+    return value;
+}
+
+bool wxGridAsyncTableBase::GetValues( const wxGridBlockCoords& block,
+                                      wxArrayString& values )
+{
+    // request all the missing rows at once
+    if ( m_data )
+        m_data->Request(block.GetTopRow(), block.GetBottomRow());
+
+    values.clear();
+    values.reserve((block.GetBottomRow() - block.GetTopRow() + 1)*
+                   (block.GetRightCol() - block.GetLeftCol() + 1));
+
+    wxString value;
+    for ( int row = block.GetTopRow(); row <= block.GetBottomRow(); row++ )
+    {
+        for ( int col = block.GetLeftCol(); col <= block.GetRightCol(); col++ )
+        {
+            if ( !m_data || !m_data->GetValue(row, col, value) )
+                value = m_placeholder;
+
+            values.push_back(value);
+        }
+    }
+
+    return true;
+}
+
+#endif // wxUSE_GRID && wxUSE_THREADS
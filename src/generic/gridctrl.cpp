@@ -31,6 +31,54 @@
 #include "wx/generic/private/grid.h"
 #include "wx/private/window.h"
 
+// ----------------------------------------------------------------------------
+// private functions
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// The functions below only change the DC state if it's different from the
+// wanted one: as the adjacent cells usually share the same attributes, this
+// ensures that the brushes, pens and fonts are set only once for a group of
+// such cells when drawing them, which is important because doing it may be
+// expensive, e.g. for the DCs using wxGraphicsContext.
+
+void SetDCSolidBrush(wxDC& dc, const wxColour& colour)
+{
+    const wxBrush& brush = dc.GetBrush();
+    if ( !brush.IsOk() ||
+            brush.GetStyle() != wxBRUSHSTYLE_SOLID ||
+                brush.GetColour() != colour )
+    {
+        dc.SetBrush(colour);
+    }
+}
+
+void SetDCTransparentPen(wxDC& dc)
+{
+    const wxPen& pen = dc.GetPen();
+    if ( !pen.IsOk() || pen.GetStyle() != wxPENSTYLE_TRANSPARENT )
+        dc.SetPen(*wxTRANSPARENT_PEN);
+}
+
+void SetDCTextColours(wxDC& dc, const wxColour& bg, const wxColour& fg)
+{
+    if ( dc.GetTextBackground() != bg )
+        dc.SetTextBackground(bg);
+
+    if ( dc.GetTextForeground() != fg )
+        dc.SetTextForeground(fg);
+}
+
+void SetDCFont(wxDC& dc, const wxFont& font)
+{
+    if ( dc.GetFont() != font )
+        dc.SetFont(font);
+}
+
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 // wxGridCellRenderer
 // ----------------------------------------------------------------------------
@@ -64,8 +112,8 @@ void wxGridCellRenderer::Draw(wxGrid& grid,
         clr = wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE);
     }
 
-    dc.SetBrush(clr);
-    dc.SetPen( *wxTRANSPARENT_PEN );
+    SetDCSolidBrush(dc, clr);
+    SetDCTransparentPen(dc);
     dc.DrawRectangle(rect);
 }
 
@@ -88,22 +136,21 @@ void wxGridCellRenderer::SetTextColoursAndFont(const wxGrid& grid,
                 clr = grid.GetSelectionBackground();
             else
                 clr = wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHT);
-            dc.SetTextBackground( clr );
-            dc.SetTextForeground( grid.GetSelectionForeground() );
+            SetDCTextColours(dc, clr, grid.GetSelectionForeground());
         }
         else
         {
-            dc.SetTextBackground( attr.GetBackgroundColour() );
-            dc.SetTextForeground( attr.GetTextColour() );
+            SetDCTextColours(dc, attr.GetBackgroundColour(), attr.GetTextColour());
         }
     }
     else
     {
-        dc.SetTextBackground(wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE));
-        dc.SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT));
+        SetDCTextColours(dc,
+                         wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE),
+                         wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT));
     }
 
-    dc.SetFont( attr.GetFont() );
+    SetDCFont(dc, attr.GetFont());
 }
 
 // ----------------------------------------------------------------------------
@@ -404,7 +451,7 @@ wxGridCellAutoWrapStringRenderer::GetTextLines(wxGrid& grid,
                                                const wxRect& rect,
                                                int row, int col)
 {
-    dc.SetFont(attr.GetFont());
+    SetDCFont(dc, attr.GetFont());
     const wxCoord maxWidth = rect.GetWidth();
 
     // Transform logical lines into physical ones, wrapping the longer ones.
@@ -613,7 +660,7 @@ wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGridCellAttr& attr,
                                                wxDC& dc,
                                                const wxString& text)
 {
-    dc.SetFont(attr.GetFont());
+    SetDCFont(dc, attr.GetFont());
     return dc.GetMultiLineTextExtent(text);
 }
 
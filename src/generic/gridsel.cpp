@@ -23,28 +23,305 @@
 #if wxUSE_GRID
 
 #include "wx/generic/gridsel.h"
-#include "wx/dynarray.h"
+
+#include <algorithm>
 
 
 namespace
 {
 
-// The helper function to compare wxIntSortedArray elements.
-int CompareInts(int n1, int n2)
+bool CompareBlocksByTop(const wxGridBlockCoords& block1,
+                        const wxGridBlockCoords& block2)
+{
+    return block1.GetTopRow() < block2.GetTopRow();
+}
+
+// A range of consecutive rows or columns used by DoGetLines().
+struct wxGridLineRange
+{
+    int first,
+        last;
+
+    bool operator<(const wxGridLineRange& other) const
+    {
+        return first < other.first;
+    }
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxGridSelectionIndex
+// ----------------------------------------------------------------------------
+
+// This class allows to check whether a cell, or a block, is contained in one
+// of the selected blocks without iterating over all of them.
+//
+// It keeps a copy of the blocks sorted by their top row and a static interval
+// tree over them: each node of the binary tree stores the maximal bottom row
+// of the blocks in its subtree, so that only the subtrees which may contain a
+// block covering the given row need to be visited.
+//
+// The sorted blocks are rebuilt lazily after arbitrary changes to the
+// selection, but adding and removing a single block, which are the most
+// common operations when selecting with the mouse, don't require rebuilding
+// them: removed blocks are just cleared from the tree, while added ones are
+// kept in a small list of pending blocks, which are merged into the sorted
+// ones only when there are too many of them to check them all individually.
+class wxGridSelectionIndex
+{
+public:
+    explicit wxGridSelectionIndex(const wxVectorGridBlockCoords& selection)
+        : m_selection(selection)
+    {
+        m_valid = false;
+        m_leaves = 0;
+        m_removed = 0;
+    }
+
+    // Must be called after any change to the selection other than those
+    // reported by Add() and Remove().
+    void Invalidate() { m_valid = false; }
+
+    void Add(const wxGridBlockCoords& block);
+    void Remove(const wxGridBlockCoords& block);
+
+    // Return true if the given block is entirely contained in one of the
+    // selected blocks.
+    bool IsContained(const wxGridBlockCoords& block) const;
+
+private:
+    // The minimal number of the pending blocks which need to be merged.
+    enum { MIN_PENDING_TO_MERGE = 16 };
+
+    // Return the index of the first block with the top row after the given
+    // one.
+    size_t FindFirstAfter(int row) const;
+
+    // Return true if the block with the given index had been removed.
+    bool IsRemoved(size_t n) const { return m_maxBottoms[m_leaves + n] < 0; }
+
+    // Bring m_blocks and m_maxBottoms up to date.
+    void Update() const;
+
+    // Build the tree over the current m_blocks.
+    void BuildTree() const;
+
+    // Check for a block containing the given one in the subtree of the given
+    // node, covering m_blocks[lo..hi), among the first count blocks.
+    bool DoFind(size_t node, size_t lo, size_t hi, size_t count,
+                const wxGridBlockCoords& block) const;
+
+    const wxVectorGridBlockCoords& m_selection;
+
+    mutable wxVector<wxGridBlockCoords> m_blocks;
+
+    // The tree is stored in the usual way, with the children of the node n
+    // having indices 2n and 2n+1 and the leaves starting at m_leaves. The
+    // leaves of the removed blocks contain -1.
+    mutable wxVector<int> m_maxBottoms;
+    mutable size_t m_leaves;
+
+    // The number of removed blocks still present in m_blocks.
+    mutable size_t m_removed;
+
+    // The blocks added since the tree was built, in no particular order.
+    mutable wxVector<wxGridBlockCoords> m_pending;
+
+    // False if the selection has changed since m_blocks were built.
+    mutable bool m_valid;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridSelectionIndex);
+};
+
+size_t wxGridSelectionIndex::FindFirstAfter(int row) const
+{
+    size_t lo = 0,
+           hi = m_blocks.size();
+    while ( lo < hi )
+    {
+        const size_t mid = (lo + hi) / 2;
+        if ( m_blocks[mid].GetTopRow() <= row )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+void wxGridSelectionIndex::Add(const wxGridBlockCoords& block)
+{
+    // Nothing to do if the blocks will be rebuilt anyhow.
+    if ( !m_valid )
+        return;
+
+    m_pending.push_back(block);
+}
+
+void wxGridSelectionIndex::Remove(const wxGridBlockCoords& block)
+{
+    if ( !m_valid )
+        return;
+
+    // The block being removed is typically the last added one.
+    for ( size_t n = m_pending.size(); n > 0; n-- )
+    {
+        if ( m_pending[n - 1] == block )
+        {
+            m_pending.erase(m_pending.begin() + n - 1);
+            return;
+        }
+    }
+
+    for ( size_t n = FindFirstAfter(block.GetTopRow()); n > 0; n-- )
+    {
+        const wxGridBlockCoords& current = m_blocks[n - 1];
+        if ( current.GetTopRow() != block.GetTopRow() )
+            break;
+
+        if ( current == block && !IsRemoved(n - 1) )
+        {
+            // Update the tree in place: the maximal bottom rows of the nodes
+            // containing the removed block can only become smaller.
+            size_t node = m_leaves + n - 1;
+            m_maxBottoms[node] = -1;
+            for ( node /= 2; node > 0; node /= 2 )
+            {
+                m_maxBottoms[node] = wxMax(m_maxBottoms[2*node],
+                                           m_maxBottoms[2*node + 1]);
+            }
+
+            m_removed++;
+            return;
+        }
+    }
+
+    wxFAIL_MSG( "removing a block not in the selection" );
+
+    m_valid = false;
+}
+
+void wxGridSelectionIndex::Update() const
+{
+    if ( !m_valid )
+    {
+        m_blocks = m_selection;
+        std::sort(m_blocks.begin(), m_blocks.end(), CompareBlocksByTop);
+
+        m_pending.clear();
+        BuildTree();
+
+        m_valid = true;
+        return;
+    }
+
+    // Checking the pending blocks is linear in their number, so merge them
+    // into the tree if there are too many of them, but not too often, as
+    // this is linear in the total number of blocks: this makes the cost of
+    // adding a block and of checking the pending ones both proportional to
+    // the square root of the number of blocks.
+    const size_t pending = m_pending.size();
+    if ( pending < MIN_PENDING_TO_MERGE || pending*pending < m_blocks.size() )
+        return;
+
+    // Drop the removed blocks, preserving the order of the remaining ones.
+    if ( m_removed )
+    {
+        size_t count = 0;
+        for ( size_t n = 0; n < m_blocks.size(); n++ )
+        {
+            if ( !IsRemoved(n) )
+                m_blocks[count++] = m_blocks[n];
+        }
+
+        m_blocks.erase(m_blocks.begin() + count, m_blocks.end());
+    }
+
+    std::sort(m_pending.begin(), m_pending.end(), CompareBlocksByTop);
+
+    const size_t count = m_blocks.size();
+    for ( size_t n = 0; n < pending; n++ )
+        m_blocks.push_back(m_pending[n]);
+    std::inplace_merge(m_blocks.begin(),
+                       m_blocks.begin() + count,
+                       m_blocks.end(),
+                       CompareBlocksByTop);
+
+    m_pending.clear();
+    BuildTree();
+}
+
+void wxGridSelectionIndex::BuildTree() const
 {
-    return n1 - n2;
+    const size_t count = m_blocks.size();
+
+    m_leaves = 1;
+    while ( m_leaves < count )
+        m_leaves *= 2;
+
+    m_maxBottoms.assign(2*m_leaves, -1);
+    for ( size_t n = 0; n < count; n++ )
+        m_maxBottoms[m_leaves + n] = m_blocks[n].GetBottomRow();
+
+    for ( size_t node = m_leaves - 1; node > 0; node-- )
+    {
+        m_maxBottoms[node] = wxMax(m_maxBottoms[2*node],
+                                   m_maxBottoms[2*node + 1]);
+    }
+
+    m_removed = 0;
 }
 
+bool
+wxGridSelectionIndex::DoFind(size_t node, size_t lo, size_t hi, size_t count,
+                             const wxGridBlockCoords& block) const
+{
+    if ( lo >= count || m_maxBottoms[node] < block.GetBottomRow() )
+        return false;
+
+    if ( node >= m_leaves )
+        return m_blocks[lo].Contains(block);
+
+    const size_t mid = (lo + hi) / 2;
+    return DoFind(2*node, lo, mid, count, block) ||
+            DoFind(2*node + 1, mid, hi, count, block);
 }
 
-WX_DEFINE_SORTED_ARRAY_CMP_INT(int, CompareInts, wxIntSortedArray);
+bool wxGridSelectionIndex::IsContained(const wxGridBlockCoords& block) const
+{
+    Update();
 
+    // Only the blocks starting at or above the top row of the given block can
+    // contain it.
+    if ( !m_blocks.empty() &&
+            DoFind(1, 0, m_leaves, FindFirstAfter(block.GetTopRow()), block) )
+        return true;
+
+    for ( size_t n = 0; n < m_pending.size(); n++ )
+    {
+        if ( m_pending[n].Contains(block) )
+            return true;
+    }
+
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// wxGridSelection
+// ----------------------------------------------------------------------------
 
 wxGridSelection::wxGridSelection( wxGrid * grid,
                                   wxGrid::wxGridSelectionModes sel )
 {
     m_grid = grid;
     m_selectionMode = sel;
+    m_index = new wxGridSelectionIndex(m_selection);
+}
+
+wxGridSelection::~wxGridSelection()
+{
+    delete m_index;
 }
 
 bool wxGridSelection::IsSelection()
@@ -74,21 +351,9 @@ void wxGridSelection::EndSelecting()
 
 bool wxGridSelection::IsInSelection( int row, int col ) const
 {
-    // Check whether the given cell is contained in one of the selected blocks.
-    //
-    // Note that this algorithm is O(N) in number of selected blocks, not in
-    // number of cells in the grid, so it should be reasonably efficient even
-    // for very large grids, as the user shouldn't be able to select too many
-    // blocks. If we still run into problems with this, we should find a more
-    // efficient way of storing the selection, e.g. using k-d trees.
-    const size_t count = m_selection.size();
-    for ( size_t n = 0; n < count; n++ )
-    {
-        if ( m_selection[n].Contains(wxGridCellCoords(row, col)) )
-            return true;
-    }
-
-    return false;
+    // Check whether the given cell is contained in one of the selected blocks
+    // using the index, which only examines the blocks covering this row.
+    return m_index->IsContained(wxGridBlockCoords(row, col, row, col));
 }
 
 // Change the selection mode
@@ -159,6 +424,7 @@ void wxGridSelection::SetSelectionMode( wxGrid::wxGridSelectionModes selmode )
                     m_grid->RefreshBlock(block.GetTopLeft(), block.GetBottomRight());
                 }
                 m_selection.erase(m_selection.begin() + n);
+                m_index->Invalidate();
             }
         }
 
@@ -244,6 +510,7 @@ wxGridSelection::SelectAll()
     // There is no need to refresh anything, as Select() will do it anyhow, and
     // no need to generate any events, so do not call ClearSelection() here.
     m_selection.clear();
+    m_index->Invalidate();
 
     const int numRows = m_grid->GetNumberRows();
     const int numCols = m_grid->GetNumberCols();
@@ -344,6 +611,7 @@ wxGridSelection::DeselectBlock(const wxGridBlockCoords& block,
         // remove the block (note that selBlock, being a reference, is
         // invalidated here and can't be used any more below)
         m_selection.erase(m_selection.begin() + n);
+        m_index->Invalidate();
         n--;
         count--;
 
@@ -408,6 +676,7 @@ void wxGridSelection::ClearSelection()
         coords1 = block.GetTopLeft();
         coords2 = block.GetBottomRight();
         m_selection.erase(m_selection.begin() + n);
+        m_index->Invalidate();
         if ( !m_grid->GetBatchCount() )
         {
             m_grid->RefreshBlock(coords1, coords2);
@@ -436,6 +705,8 @@ void wxGridSelection::ClearSelection()
 
 void wxGridSelection::UpdateRows( size_t pos, int numRows )
 {
+    m_index->Invalidate();
+
     size_t count = m_selection.size();
     size_t n;
 
@@ -485,6 +756,8 @@ void wxGridSelection::UpdateRows( size_t pos, int numRows )
 
 void wxGridSelection::UpdateCols( size_t pos, int numCols )
 {
+    m_index->Invalidate();
+
     size_t count = m_selection.size();
     size_t n;
 
@@ -685,7 +958,9 @@ bool wxGridSelection::ExtendCurrentBlock(const wxGridCellCoords& blockStart,
     }
 
     // Update the current block in place.
+    m_index->Remove(*m_selection.rbegin());
     *m_selection.rbegin() = newBlock;
+    m_index->Add(newBlock);
 
     // Send Event.
     wxGridRangeSelectEvent gridEvt(m_grid->GetId(),
@@ -784,65 +1059,101 @@ wxGridCellCoordsArray wxGridSelection::GetBlockSelectionBottomRight() const
 // is, anyhow, the best we can do.
 wxArrayInt wxGridSelection::GetRowSelection() const
 {
-    if ( m_selectionMode == wxGrid::wxGridSelectColumns ||
-            m_selectionMode == wxGrid::wxGridSelectNone )
-        return wxArrayInt();
-
-    wxIntSortedArray uniqueRows;
-    const size_t count = m_selection.size();
-    for ( size_t n = 0; n < count; ++n )
-    {
-        const wxGridBlockCoords& block = m_selection[n];
-        if ( block.GetLeftCol() == 0 &&
-             block.GetRightCol() == m_grid->GetNumberCols() - 1 )
-        {
-            for ( int r = block.GetTopRow(); r <= block.GetBottomRow(); ++r )
-            {
-                if ( uniqueRows.Index(r) == wxNOT_FOUND )
-                    uniqueRows.Add(r);
-            }
-        }
-    }
+    const wxGridLines lines = GetRowLines();
 
     wxArrayInt result;
-    result.reserve(uniqueRows.size());
-    for( size_t i = 0; i < uniqueRows.size(); ++i )
-    {
-        result.push_back(uniqueRows[i]);
-    }
+    result.reserve(lines.size());
+    for ( wxGridLines::iterator it = lines.begin(); it != lines.end(); ++it )
+        result.push_back(*it);
+
     return result;
 }
 
 // See comments for GetRowSelection().
 wxArrayInt wxGridSelection::GetColSelection() const
+{
+    const wxGridLines lines = GetColLines();
+
+    wxArrayInt result;
+    result.reserve(lines.size());
+    for ( wxGridLines::iterator it = lines.begin(); it != lines.end(); ++it )
+        result.push_back(*it);
+
+    return result;
+}
+
+wxGridLines wxGridSelection::GetRowLines() const
+{
+    if ( m_selectionMode == wxGrid::wxGridSelectColumns ||
+            m_selectionMode == wxGrid::wxGridSelectNone )
+        return wxGridLines();
+
+    return DoGetLines(true);
+}
+
+wxGridLines wxGridSelection::GetColLines() const
 {
     if ( m_selectionMode == wxGrid::wxGridSelectRows ||
             m_selectionMode == wxGrid::wxGridSelectNone )
-        return wxArrayInt();
+        return wxGridLines();
 
-    wxIntSortedArray uniqueCols;
+    return DoGetLines(false);
+}
+
+wxGridLines wxGridSelection::DoGetLines(bool rows) const
+{
+    const int lastCol = m_grid->GetNumberCols() - 1;
+    const int lastRow = m_grid->GetNumberRows() - 1;
+
+    // Collect the ranges of the lines selected entirely.
+    wxVector<wxGridLineRange> ranges;
     const size_t count = m_selection.size();
     for ( size_t n = 0; n < count; ++n )
     {
         const wxGridBlockCoords& block = m_selection[n];
-        if ( block.GetTopRow() == 0 &&
-             block.GetBottomRow() == m_grid->GetNumberRows() - 1 )
+
+        wxGridLineRange range;
+        if ( rows )
         {
-            for ( int c = block.GetLeftCol(); c <= block.GetRightCol(); ++c )
-            {
-                if ( uniqueCols.Index(c) == wxNOT_FOUND )
-                    uniqueCols.Add(c);
-            }
+            if ( block.GetLeftCol() != 0 || block.GetRightCol() != lastCol )
+                continue;
+
+            range.first = block.GetTopRow();
+            range.last = block.GetBottomRow();
+        }
+        else
+        {
+            if ( block.GetTopRow() != 0 || block.GetBottomRow() != lastRow )
+                continue;
+
+            range.first = block.GetLeftCol();
+            range.last = block.GetRightCol();
         }
+
+        ranges.push_back(range);
     }
 
-    wxArrayInt result;
-    result.reserve(uniqueCols.size());
-    for( size_t i = 0; i < uniqueCols.size(); ++i )
+    wxVectorSort(ranges);
+
+    // And combine the overlapping or adjacent ones.
+    wxGridLines lines;
+    for ( size_t n = 0; n < ranges.size(); ++n )
     {
-        result.push_back(uniqueCols[i]);
+        const wxGridLineRange& range = ranges[n];
+        if ( !lines.m_bounds.empty() &&
+                range.first <= lines.m_bounds.back() + 1 )
+        {
+            if ( range.last > lines.m_bounds.back() )
+                lines.m_bounds.back() = range.last;
+        }
+        else
+        {
+            lines.m_bounds.push_back(range.first);
+            lines.m_bounds.push_back(range.last);
+        }
     }
-    return result;
+
+    return lines;
 }
 
 void
@@ -854,6 +1165,7 @@ wxGridSelection::Select(const wxGridBlockCoords& block,
         return;
 
     m_selection.push_back(block);
+    m_index->Add(block);
 
     // Update View:
     if ( !m_grid->GetBatchCount() )
@@ -113,166 +113,274 @@ static const int MARGIN_AROUND_CHECKBOX = 5;
 // arrays/list implementations
 // ----------------------------------------------------------------------------
 
-#include "wx/listimpl.cpp"
-WX_DEFINE_LIST(wxListItemDataList)
-
 #include "wx/listimpl.cpp"
 WX_DEFINE_LIST(wxListHeaderDataList)
 
 
 // ----------------------------------------------------------------------------
-// wxListItemData
+// wxListItemStore
 // ----------------------------------------------------------------------------
 
-wxListItemData::~wxListItemData()
+namespace
 {
-    // in the virtual list control the attributes are managed by the main
-    // program, so don't delete them
-    if ( !m_owner->IsVirtual() )
-        delete m_attr;
 
-    delete m_rect;
-}
+// the minimal number of unused characters in the column buffer before we
+// consider compacting it
+const size_t MIN_UNUSED_TO_COMPACT = 4096;
+
+} // anonymous namespace
 
-void wxListItemData::Init()
+size_t wxListItemStore::AllocSlot()
 {
-    m_image = -1;
-    m_data = 0;
+    if ( !m_freeSlots.empty() )
+    {
+        const size_t slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
 
-    m_attr = NULL;
+    const TextRef ref = { 0, 0 };
+    for ( size_t col = 0; col < m_columns.size(); col++ )
+        m_columns[col]->refs.push_back(ref);
+
+    return m_slotCount++;
 }
 
-wxListItemData::wxListItemData(wxListMainWindow *owner)
+void wxListItemStore::FreeSlot(size_t slot, bool deleteAttrs)
 {
-    Init();
+    for ( size_t col = 0; col < m_columns.size(); col++ )
+    {
+        Column& column = *m_columns[col];
 
-    m_owner = owner;
+        TextRef& ref = column.refs[slot];
+        column.unused += ref.length;
+        ref.length = 0;
+
+        column.images.erase(slot);
+        column.data.erase(slot);
+
+        wxListItemAttrMap::iterator it = column.attrs.find(slot);
+        if ( it != column.attrs.end() )
+        {
+            if ( deleteAttrs )
+                delete it->second;
+            column.attrs.erase(it);
+        }
+    }
+
+    m_freeSlots.push_back(slot);
+
+    if ( m_freeSlots.size() == m_slotCount )
+    {
+        // all lines were deleted, so we can release all the memory used by
+        // them while keeping the columns
+        for ( size_t col = 0; col < m_columns.size(); col++ )
+        {
+            Column& column = *m_columns[col];
+            wxVector<wxChar>().swap(column.chars);
+            wxVector<TextRef>().swap(column.refs);
+            column.unused = 0;
+        }
 
-    if ( owner->InReportView() )
-        m_rect = NULL;
+        m_freeSlots.clear();
+        m_slotCount = 0;
+    }
     else
-        m_rect = new wxRect;
+    {
+        for ( size_t col = 0; col < m_columns.size(); col++ )
+            Compact(*m_columns[col]);
+    }
 }
 
-// Check if the item is visible
-bool wxGenericListCtrl::IsVisible(long item) const
+void wxListItemStore::Clear()
 {
-    wxRect itemRect;
-    GetItemRect( item, itemRect );
-    const wxRect clientRect = GetClientRect();
-    bool visible = clientRect.Intersects( itemRect );
-    if ( visible && m_headerWin )
-    {
-        wxRect headerRect = m_headerWin->GetClientRect();
-        // take into account the +1 added in GetSubItemRect()
-        headerRect.height++;
-        visible = itemRect.GetBottom() > headerRect.GetBottom();
-    }
-    return visible;
+    for ( size_t col = 0; col < m_columns.size(); col++ )
+        delete m_columns[col];
+
+    m_columns.clear();
+    m_freeSlots.clear();
+    m_slotCount = 0;
 }
 
-void wxListItemData::SetItem( const wxListItem &info )
+void wxListItemStore::EnsureColumnCount(size_t count)
 {
-    if ( info.m_mask & wxLIST_MASK_TEXT )
-        SetText(info.m_text);
-    if ( info.m_mask & wxLIST_MASK_IMAGE )
-        m_image = info.m_image;
-    if ( info.m_mask & wxLIST_MASK_DATA )
-        m_data = info.m_data;
+    while ( m_columns.size() < count )
+        InsertColumn(m_columns.size());
+}
 
-    if ( info.HasAttributes() )
-    {
-        if ( m_attr )
-            m_attr->AssignFrom(*info.GetAttributes());
-        else
-            m_attr = new wxItemAttr(*info.GetAttributes());
-    }
+void wxListItemStore::InsertColumn(size_t col)
+{
+    wxCHECK_RET( col <= m_columns.size(), "invalid column index" );
 
-    if ( m_rect )
-    {
-        m_rect->x =
-        m_rect->y =
-        m_rect->height = 0;
-        m_rect->width = info.m_width;
-    }
+    Column* const column = new Column;
+
+    const TextRef ref = { 0, 0 };
+    column->refs.resize(m_slotCount, ref);
+
+    m_columns.insert(m_columns.begin() + col, column);
 }
 
-void wxListItemData::SetPosition( int x, int y )
+void wxListItemStore::DeleteColumn(size_t col, bool deleteAttrs)
 {
-    wxCHECK_RET( m_rect, wxT("unexpected SetPosition() call") );
+    wxCHECK_RET( col < m_columns.size(), "invalid column index" );
+
+    if ( deleteAttrs )
+        DeleteColumnAttrs(*m_columns[col]);
 
-    m_rect->x = x;
-    m_rect->y = y;
+    delete m_columns[col];
+    m_columns.erase(m_columns.begin() + col);
 }
 
-void wxListItemData::SetSize( int width, int height )
+void wxListItemStore::DeleteColumnAttrs(Column& column)
 {
-    wxCHECK_RET( m_rect, wxT("unexpected SetSize() call") );
+    for ( wxListItemAttrMap::iterator it = column.attrs.begin();
+          it != column.attrs.end();
+          ++it )
+    {
+        delete it->second;
+    }
 
-    if ( width != -1 )
-        m_rect->width = width;
-    if ( height != -1 )
-        m_rect->height = height;
+    column.attrs.clear();
 }
 
-bool wxListItemData::IsHit( int x, int y ) const
+wxString wxListItemStore::GetText(size_t slot, size_t col) const
 {
-    wxCHECK_MSG( m_rect, false, wxT("can't be called in this mode") );
+    const Column& column = *m_columns[col];
+    const TextRef& ref = column.refs[slot];
+    if ( !ref.length )
+        return wxString();
 
-    return wxRect(GetX(), GetY(), GetWidth(), GetHeight()).Contains(x, y);
+    return wxString(&column.chars[ref.offset], ref.length);
 }
 
-int wxListItemData::GetX() const
+void wxListItemStore::GetText(size_t slot, size_t col, wxString& text) const
 {
-    wxCHECK_MSG( m_rect, 0, wxT("can't be called in this mode") );
+    const Column& column = *m_columns[col];
+    const TextRef& ref = column.refs[slot];
+    if ( ref.length )
+        text.assign(&column.chars[ref.offset], ref.length);
+    else
+        text.clear();
+}
+
+void wxListItemStore::SetText(size_t slot, size_t col, const wxString& text)
+{
+    Column& column = *m_columns[col];
+    TextRef& ref = column.refs[slot];
 
-    return m_rect->x;
+    const size_t length = text.length();
+    if ( length <= ref.length )
+    {
+        // the new text fits into the space used by the old one
+        column.unused += ref.length - length;
+    }
+    else // append the new text to the end of the buffer
+    {
+        column.unused += ref.length;
+        ref.offset = static_cast<wxUint32>(column.chars.size());
+        column.chars.resize(column.chars.size() + length);
+    }
+
+    ref.length = static_cast<wxUint32>(length);
+
+    wxChar* p = length ? &column.chars[ref.offset] : NULL;
+    for ( wxString::const_iterator i = text.begin(); i != text.end(); ++i )
+        *p++ = *i;
+
+    Compact(column);
 }
 
-int wxListItemData::GetY() const
+void wxListItemStore::Compact(Column& column)
 {
-    wxCHECK_MSG( m_rect, 0, wxT("can't be called in this mode") );
+    // only do it if at least half of the buffer is wasted, this ensures that
+    // the amortized cost of changing the texts remains constant
+    if ( column.unused < MIN_UNUSED_TO_COMPACT ||
+            column.unused < column.chars.size() / 2 )
+        return;
 
-    return m_rect->y;
+    wxVector<wxChar> chars;
+    chars.resize(column.chars.size() - column.unused);
+
+    size_t offset = 0;
+    for ( size_t slot = 0; slot < column.refs.size(); slot++ )
+    {
+        TextRef& ref = column.refs[slot];
+        if ( !ref.length )
+            continue;
+
+        memcpy(&chars[offset], &column.chars[ref.offset],
+               ref.length*sizeof(wxChar));
+        ref.offset = static_cast<wxUint32>(offset);
+        offset += ref.length;
+    }
+
+    column.chars.swap(chars);
+    column.unused = 0;
 }
 
-int wxListItemData::GetWidth() const
+int wxListItemStore::GetImage(size_t slot, size_t col) const
 {
-    wxCHECK_MSG( m_rect, 0, wxT("can't be called in this mode") );
+    const wxListItemImageMap& images = m_columns[col]->images;
+    wxListItemImageMap::const_iterator it = images.find(slot);
+    return it == images.end() ? -1 : it->second;
+}
 
-    return m_rect->width;
+void wxListItemStore::SetImage(size_t slot, size_t col, int image)
+{
+    wxListItemImageMap& images = m_columns[col]->images;
+    if ( image == -1 )
+        images.erase(slot);
+    else
+        images[slot] = image;
 }
 
-int wxListItemData::GetHeight() const
+wxUIntPtr wxListItemStore::GetData(size_t slot, size_t col) const
 {
-    wxCHECK_MSG( m_rect, 0, wxT("can't be called in this mode") );
+    const wxListItemDataMap& data = m_columns[col]->data;
+    wxListItemDataMap::const_iterator it = data.find(slot);
+    return it == data.end() ? 0 : it->second;
+}
 
-    return m_rect->height;
+void wxListItemStore::SetData(size_t slot, size_t col, wxUIntPtr data)
+{
+    wxListItemDataMap& map = m_columns[col]->data;
+    if ( !data )
+        map.erase(slot);
+    else
+        map[slot] = data;
 }
 
-void wxListItemData::GetItem( wxListItem &info ) const
+wxItemAttr *wxListItemStore::GetAttr(size_t slot, size_t col) const
 {
-    long mask = info.m_mask;
-    if ( !mask )
-        // by default, get everything for backwards compatibility
-        mask = -1;
+    const wxListItemAttrMap& attrs = m_columns[col]->attrs;
+    wxListItemAttrMap::const_iterator it = attrs.find(slot);
+    return it == attrs.end() ? NULL : it->second;
+}
 
-    if ( mask & wxLIST_MASK_TEXT )
-        info.m_text = m_text;
-    if ( mask & wxLIST_MASK_IMAGE )
-        info.m_image = m_image;
-    if ( mask & wxLIST_MASK_DATA )
-        info.m_data = m_data;
+void wxListItemStore::SetAttr(size_t slot, size_t col, wxItemAttr *attr)
+{
+    wxListItemAttrMap& attrs = m_columns[col]->attrs;
+    if ( !attr )
+        attrs.erase(slot);
+    else
+        attrs[slot] = attr;
+}
 
-    if ( m_attr )
+// Check if the item is visible
+bool wxGenericListCtrl::IsVisible(long item) const
+{
+    wxRect itemRect;
+    GetItemRect( item, itemRect );
+    const wxRect clientRect = GetClientRect();
+    bool visible = clientRect.Intersects( itemRect );
+    if ( visible && m_headerWin )
     {
-        if ( m_attr->HasTextColour() )
-            info.SetTextColour(m_attr->GetTextColour());
-        if ( m_attr->HasBackgroundColour() )
-            info.SetBackgroundColour(m_attr->GetBackgroundColour());
-        if ( m_attr->HasFont() )
-            info.SetFont(m_attr->GetFont());
+        wxRect headerRect = m_headerWin->GetClientRect();
+        // take into account the +1 added in GetSubItemRect()
+        headerRect.height++;
+        visible = itemRect.GetBottom() > headerRect.GetBottom();
     }
+    return visible;
 }
 
 //-----------------------------------------------------------------------------
@@ -419,6 +527,11 @@ inline bool wxListLineData::IsVirtual() const
     return m_owner->IsVirtual();
 }
 
+inline wxListItemStore& wxListLineData::GetStore() const
+{
+    return m_owner->GetItemStore();
+}
+
 wxListLineData::wxListLineData( wxListMainWindow *owner )
 {
     m_owner = owner;
@@ -431,15 +544,26 @@ wxListLineData::wxListLineData( wxListMainWindow *owner )
     m_highlighted = false;
     m_checked = false;
 
-    InitItems( GetMode() == wxLC_REPORT ? m_owner->GetColumnCount() : 1 );
+    // we may have more than one subitem only in report mode
+    GetStore().EnsureColumnCount
+               (
+                GetMode() == wxLC_REPORT ? m_owner->GetColumnCount() : 1
+               );
+    m_slot = GetStore().AllocSlot();
 }
 
-void wxListLineData::CalculateSize( wxDC *dc, int spacing )
+wxListLineData::~wxListLineData()
 {
-    wxListItemDataList::compatibility_iterator node = m_items.GetFirst();
-    wxCHECK_RET( node, wxT("no subitems at all??") );
+    // in the virtual list control the attributes are managed by the main
+    // program, so don't delete them
+    GetStore().FreeSlot(m_slot, !IsVirtual());
 
-    wxListItemData *item = node->GetData();
+    delete m_gi;
+}
+
+void wxListLineData::CalculateSize( wxDC *dc, int spacing )
+{
+    wxCHECK_RET( GetStore().GetColumnCount(), wxT("no subitems at all??") );
 
     wxString s;
     wxCoord lw, lh;
@@ -450,7 +574,7 @@ void wxListLineData::CalculateSize( wxDC *dc, int spacing )
         case wxLC_SMALL_ICON:
             m_gi->m_rectAll.width = spacing;
 
-            s = item->GetText();
+            s = GetText(0);
 
             if ( s.empty() )
             {
@@ -472,10 +596,10 @@ void wxListLineData::CalculateSize( wxDC *dc, int spacing )
                 m_gi->m_rectLabel.height = lh;
             }
 
-            if (item->HasImage())
+            if (HasImage())
             {
                 int w, h;
-                m_owner->GetImageSize( item->GetImage(), w, h );
+                m_owner->GetImageSize( GetImage(), w, h );
                 m_gi->m_rectIcon.width = w + 8;
                 m_gi->m_rectIcon.height = h + 8;
 
@@ -485,7 +609,7 @@ void wxListLineData::CalculateSize( wxDC *dc, int spacing )
                     m_gi->m_rectAll.height = m_gi->m_rectIcon.height + lh + 4;
             }
 
-            if ( item->HasText() )
+            if ( HasText() )
             {
                 m_gi->m_rectHighlight.width = m_gi->m_rectLabel.width;
                 m_gi->m_rectHighlight.height = m_gi->m_rectLabel.height;
@@ -498,7 +622,11 @@ void wxListLineData::CalculateSize( wxDC *dc, int spacing )
             break;
 
         case wxLC_LIST:
-            s = item->GetTextForMeasuring();
+            // we can't use empty string for measuring the string
+            // width/height, so always use something
+            s = GetText(0);
+            if ( s.empty() )
+                s = wxT('H');
 
             dc->GetTextExtent( s, &lw, &lh );
             lw += EXTRA_WIDTH;
@@ -510,10 +638,10 @@ void wxListLineData::CalculateSize( wxDC *dc, int spacing )
             m_gi->m_rectAll.width = lw;
             m_gi->m_rectAll.height = lh;
 
-            if (item->HasImage())
+            if (HasImage())
             {
                 int w, h;
-                m_owner->GetImageSize( item->GetImage(), w, h );
+                m_owner->GetImageSize( GetImage(), w, h );
                 m_gi->m_rectIcon.width = w;
                 m_gi->m_rectIcon.height = h;
 
@@ -538,10 +666,7 @@ void wxListLineData::CalculateSize( wxDC *dc, int spacing )
 
 void wxListLineData::SetPosition( int x, int y, int spacing )
 {
-    wxListItemDataList::compatibility_iterator node = m_items.GetFirst();
-    wxCHECK_RET( node, wxT("no subitems at all??") );
-
-    wxListItemData *item = node->GetData();
+    wxCHECK_RET( GetStore().GetColumnCount(), wxT("no subitems at all??") );
 
     switch ( GetMode() )
     {
@@ -550,14 +675,14 @@ void wxListLineData::SetPosition( int x, int y, int spacing )
             m_gi->m_rectAll.x = x;
             m_gi->m_rectAll.y = y;
 
-            if ( item->HasImage() )
+            if ( HasImage() )
             {
                 m_gi->m_rectIcon.x = m_gi->m_rectAll.x + 4 +
                     (m_gi->m_rectAll.width - m_gi->m_rectIcon.width) / 2;
                 m_gi->m_rectIcon.y = m_gi->m_rectAll.y + 4;
             }
 
-            if ( item->HasText() )
+            if ( HasText() )
             {
                 if (m_gi->m_rectAll.width > spacing)
                     m_gi->m_rectLabel.x = m_gi->m_rectAll.x + (EXTRA_WIDTH/2);
@@ -582,7 +707,7 @@ void wxListLineData::SetPosition( int x, int y, int spacing )
             m_gi->m_rectHighlight.y = m_gi->m_rectAll.y;
             m_gi->m_rectLabel.y = m_gi->m_rectAll.y + 2;
 
-            if (item->HasImage())
+            if (HasImage())
             {
                 m_gi->m_rectIcon.x = m_gi->m_rectAll.x + 2;
                 m_gi->m_rectIcon.y = m_gi->m_rectAll.y + 2;
@@ -604,89 +729,118 @@ void wxListLineData::SetPosition( int x, int y, int spacing )
     }
 }
 
-void wxListLineData::InitItems( int num )
-{
-    for (int i = 0; i < num; i++)
-        m_items.Append( new wxListItemData(m_owner) );
-}
-
 void wxListLineData::SetItem( int index, const wxListItem &info )
 {
-    wxListItemDataList::compatibility_iterator node = m_items.Item( index );
-    wxCHECK_RET( node, wxT("invalid column index in SetItem") );
+    wxListItemStore& store = GetStore();
+    wxCHECK_RET( index >= 0 && (size_t)index < store.GetColumnCount(),
+                 wxT("invalid column index in SetItem") );
+
+    if ( info.m_mask & wxLIST_MASK_TEXT )
+        store.SetText(m_slot, index, info.m_text);
+    if ( info.m_mask & wxLIST_MASK_IMAGE )
+        store.SetImage(m_slot, index, info.m_image);
+    if ( info.m_mask & wxLIST_MASK_DATA )
+        store.SetData(m_slot, index, info.m_data);
 
-    wxListItemData *item = node->GetData();
-    item->SetItem( info );
+    if ( info.HasAttributes() )
+    {
+        wxItemAttr * const attr = store.GetAttr(m_slot, index);
+        if ( attr )
+            attr->AssignFrom(*info.GetAttributes());
+        else
+            store.SetAttr(m_slot, index, new wxItemAttr(*info.GetAttributes()));
+    }
 }
 
 void wxListLineData::GetItem( int index, wxListItem &info ) const
 {
-    wxListItemDataList::compatibility_iterator node = m_items.Item( index );
-    if (node)
+    const wxListItemStore& store = GetStore();
+    if ( index < 0 || (size_t)index >= store.GetColumnCount() )
+        return;
+
+    long mask = info.m_mask;
+    if ( !mask )
+        // by default, get everything for backwards compatibility
+        mask = -1;
+
+    if ( mask & wxLIST_MASK_TEXT )
+        info.m_text = store.GetText(m_slot, index);
+    if ( mask & wxLIST_MASK_IMAGE )
+        info.m_image = store.GetImage(m_slot, index);
+    if ( mask & wxLIST_MASK_DATA )
+        info.m_data = store.GetData(m_slot, index);
+
+    const wxItemAttr * const attr = store.GetAttr(m_slot, index);
+    if ( attr )
     {
-        wxListItemData *item = node->GetData();
-        item->GetItem( info );
+        if ( attr->HasTextColour() )
+            info.SetTextColour(attr->GetTextColour());
+        if ( attr->HasBackgroundColour() )
+            info.SetBackgroundColour(attr->GetBackgroundColour());
+        if ( attr->HasFont() )
+            info.SetFont(attr->GetFont());
     }
 }
 
 wxString wxListLineData::GetText(int index) const
 {
-    wxString s;
+    const wxListItemStore& store = GetStore();
+    if ( index < 0 || (size_t)index >= store.GetColumnCount() )
+        return wxString();
 
-    wxListItemDataList::compatibility_iterator node = m_items.Item( index );
-    if (node)
-    {
-        wxListItemData *item = node->GetData();
-        s = item->GetText();
-    }
+    return store.GetText(m_slot, index);
+}
+
+bool wxListLineData::HasText(int index) const
+{
+    const wxListItemStore& store = GetStore();
+    if ( index < 0 || (size_t)index >= store.GetColumnCount() )
+        return false;
 
-    return s;
+    return store.HasText(m_slot, index);
 }
 
 void wxListLineData::SetText( int index, const wxString& s )
 {
-    wxListItemDataList::compatibility_iterator node = m_items.Item( index );
-    if (node)
-    {
-        wxListItemData *item = node->GetData();
-        item->SetText( s );
-    }
+    wxListItemStore& store = GetStore();
+    if ( index >= 0 && (size_t)index < store.GetColumnCount() )
+        store.SetText(m_slot, index, s);
 }
 
 void wxListLineData::SetImage( int index, int image )
 {
-    wxListItemDataList::compatibility_iterator node = m_items.Item( index );
-    wxCHECK_RET( node, wxT("invalid column index in SetImage()") );
+    wxListItemStore& store = GetStore();
+    wxCHECK_RET( index >= 0 && (size_t)index < store.GetColumnCount(),
+                 wxT("invalid column index in SetImage()") );
 
-    wxListItemData *item = node->GetData();
-    item->SetImage(image);
+    store.SetImage(m_slot, index, image);
 }
 
 int wxListLineData::GetImage( int index ) const
 {
-    wxListItemDataList::compatibility_iterator node = m_items.Item( index );
-    wxCHECK_MSG( node, -1, wxT("invalid column index in GetImage()") );
+    const wxListItemStore& store = GetStore();
+    wxCHECK_MSG( index >= 0 && (size_t)index < store.GetColumnCount(), -1,
+                 wxT("invalid column index in GetImage()") );
 
-    wxListItemData *item = node->GetData();
-    return item->GetImage();
+    return store.GetImage(m_slot, index);
 }
 
 wxItemAttr *wxListLineData::GetAttr() const
 {
-    wxListItemDataList::compatibility_iterator node = m_items.GetFirst();
-    wxCHECK_MSG( node, NULL, wxT("invalid column index in GetAttr()") );
+    const wxListItemStore& store = GetStore();
+    wxCHECK_MSG( store.GetColumnCount(), NULL,
+                 wxT("invalid column index in GetAttr()") );
 
-    wxListItemData *item = node->GetData();
-    return item->GetAttr();
+    return store.GetAttr(m_slot, 0);
 }
 
 void wxListLineData::SetAttr(wxItemAttr *attr)
 {
-    wxListItemDataList::compatibility_iterator node = m_items.GetFirst();
-    wxCHECK_RET( node, wxT("invalid column index in SetAttr()") );
+    wxListItemStore& store = GetStore();
+    wxCHECK_RET( store.GetColumnCount(),
+                 wxT("invalid column index in SetAttr()") );
 
-    wxListItemData *item = node->GetData();
-    item->SetAttr(attr);
+    store.SetAttr(m_slot, 0, attr);
 }
 
 void wxListLineData::ApplyAttributes(wxDC *dc,
@@ -769,27 +923,26 @@ void wxListLineData::ApplyAttributes(wxDC *dc,
 
 void wxListLineData::Draw(wxDC *dc, bool current)
 {
-    wxListItemDataList::compatibility_iterator node = m_items.GetFirst();
-    wxCHECK_RET( node, wxT("no subitems at all??") );
+    wxCHECK_RET( GetStore().GetColumnCount(), wxT("no subitems at all??") );
 
     ApplyAttributes(dc, m_gi->m_rectHighlight, IsHighlighted(), current);
 
-    wxListItemData *item = node->GetData();
-    if (item->HasImage())
+    const int image = GetImage();
+    if (image != -1)
     {
         // centre the image inside our rectangle, this looks nicer when items
         // ae aligned in a row
         const wxRect& rectIcon = m_gi->m_rectIcon;
 
-        m_owner->DrawImage(item->GetImage(), dc, rectIcon.x, rectIcon.y);
+        m_owner->DrawImage(image, dc, rectIcon.x, rectIcon.y);
     }
 
-    if (item->HasText())
+    if (HasText())
     {
         const wxRect& rectLabel = m_gi->m_rectLabel;
 
         wxDCClipper clipper(*dc, rectLabel);
-        dc->DrawText(item->GetText(), rectLabel.x, rectLabel.y);
+        dc->DrawText(GetText(0), rectLabel.x, rectLabel.y);
     }
 }
 
@@ -797,7 +950,8 @@ void wxListLineData::DrawInReportMode( wxDC *dc,
                                        const wxRect& rect,
                                        const wxRect& rectHL,
                                        bool highlighted,
-                                       bool current )
+                                       bool current,
+                                       wxString& textBuf )
 {
     // TODO: later we should support setting different attributes for
     //       different columns - to do it, just add "col" argument to
@@ -825,13 +979,11 @@ void wxListLineData::DrawInReportMode( wxDC *dc,
         x += cbSize.GetWidth() + (2 * MARGIN_AROUND_CHECKBOX);
     }
 
-    size_t col = 0;
-    for ( wxListItemDataList::compatibility_iterator node = m_items.GetFirst();
-          node;
-          node = node->GetNext(), col++ )
+    const wxListItemStore& store = GetStore();
+    const size_t count = wxMin(store.GetColumnCount(),
+                               (size_t)m_owner->GetColumnCount());
+    for ( size_t col = 0; col < count; col++ )
     {
-        wxListItemData *item = node->GetData();
-
         int width = m_owner->GetColumnWidth(col);
         if (col == 0 && m_owner->HasCheckBoxes())
             width -= x;
@@ -842,11 +994,12 @@ void wxListLineData::DrawInReportMode( wxDC *dc,
         const int wText = width;
         wxDCClipper clipper(*dc, xOld, rect.y, wText, rect.height);
 
-        if ( item->HasImage() )
+        const int image = store.GetImage(m_slot, col);
+        if ( image != -1 )
         {
             int ix, iy;
-            m_owner->GetImageSize( item->GetImage(), ix, iy );
-            m_owner->DrawImage( item->GetImage(), dc, xOld, yMid - iy/2 );
+            m_owner->GetImageSize( image, ix, iy );
+            m_owner->DrawImage( image, dc, xOld, yMid - iy/2 );
 
             ix += IMAGE_MARGIN_IN_REPORT_MODE;
 
@@ -854,13 +1007,16 @@ void wxListLineData::DrawInReportMode( wxDC *dc,
             width -= ix;
         }
 
-        if ( item->HasText() )
-            DrawTextFormatted(dc, item->GetText(), col, xOld, yMid, width);
+        if ( store.HasText(m_slot, col) )
+        {
+            store.GetText(m_slot, col, textBuf);
+            DrawTextFormatted(dc, textBuf, col, xOld, yMid, width);
+        }
     }
 }
 
 void wxListLineData::DrawTextFormatted(wxDC *dc,
-                                       const wxString& textOrig,
+                                       wxString& text,
                                        int col,
                                        int x,
                                        int yMid,
@@ -868,7 +1024,6 @@ void wxListLineData::DrawTextFormatted(wxDC *dc,
 {
     // we don't support displaying multiple lines currently (and neither does
     // wxMSW FWIW) so just merge all the lines
-    wxString text(textOrig);
     text.Replace(wxT("\n"), wxT(" "));
 
     wxCoord w, h;
@@ -1698,14 +1853,9 @@ wxListLineData *wxListMainWindow::GetDummyLine() const
 
     wxListMainWindow *self = wxConstCast(this, wxListMainWindow);
 
-    // we need to recreate the dummy line if the number of columns in the
-    // control changed as it would have the incorrect number of fields
-    // otherwise
-    if ( !m_lines.empty() &&
-            m_lines[0]->m_items.GetCount() != (size_t)GetColumnCount() )
-    {
-        self->m_lines.Clear();
-    }
+    // the number of columns in the control could have changed since the
+    // dummy line creation and it must have enough fields for all of them
+    self->m_itemStore.EnsureColumnCount(GetColumnCount());
 
     if ( m_lines.empty() )
     {
@@ -1779,16 +1929,11 @@ wxRect wxListMainWindow::GetLineLabelRect(size_t line) const
 
     int image_x = 0;
     wxListLineData *data = GetLine(line);
-    wxListItemDataList::compatibility_iterator node = data->m_items.GetFirst();
-    if (node)
+    if ( data->HasImage() )
     {
-        wxListItemData *item = node->GetData();
-        if ( item->HasImage() )
-        {
-            int ix, iy;
-            GetImageSize( item->GetImage(), ix, iy );
-            image_x = 3 + ix + IMAGE_MARGIN_IN_REPORT_MODE;
-        }
+        int ix, iy;
+        GetImageSize( data->GetImage(), ix, iy );
+        image_x = 3 + ix + IMAGE_MARGIN_IN_REPORT_MODE;
     }
 
     wxRect rect;
@@ -2106,6 +2251,9 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
             GetParent()->GetEventHandler()->ProcessEvent( evCache );
         }
 
+        // reuse the same string for the texts of all items
+        wxString textBuf;
+
         for ( size_t line = visibleFrom; line <= visibleEnd; line++ )
         {
             rectLine = GetLineRect(line);
@@ -2137,7 +2285,8 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
                                              rectLine,
                                              GetLineHighlightRect(line),
                                              IsHighlighted(line),
-                                             line == m_current );
+                                             line == m_current,
+                                             textBuf );
         }
 
         if ( HasFlag(wxLC_HRULES) )
@@ -3426,14 +3575,9 @@ public:
     virtual void UpdateWithRow(int row) wxOVERRIDE
     {
         wxListLineData *line = m_listmain->GetLine( row );
-        wxListItemDataList::compatibility_iterator n = line->m_items.Item( GetColumn() );
-
-        wxCHECK_RET( n, wxS("no subitem?") );
-
-        wxListItemData* const itemData = n->GetData();
 
         wxListItem item;
-        itemData->GetItem(item);
+        line->GetItem(GetColumn(), item);
 
         UpdateWithWidth(m_listmain->GetItemWidthWithImage(&item));
     }
@@ -4300,15 +4444,11 @@ void wxListMainWindow::DeleteItem( long lindex )
         //  mark the Column Max Width cache as dirty if the items in the line
         //  we're deleting contain the Max Column Width
         wxListLineData * const line = GetLine(index);
-        wxListItemDataList::compatibility_iterator n;
         wxListItem      item;
 
         for (size_t i = 0; i < m_columns.GetCount(); i++)
         {
-            n = line->m_items.Item( i );
-            wxListItemData* itemData;
-            itemData = n->GetData();
-            itemData->GetItem(item);
+            line->GetItem(i, item);
 
             int itemWidth;
             itemWidth = GetItemWidthWithImage(&item);
@@ -4357,31 +4497,13 @@ void wxListMainWindow::DeleteColumn( int col )
     delete node->GetData();
     m_columns.Erase( node );
 
-    if ( !IsVirtual() )
+    // The items may not have any values for this column if it had been
+    // added before any items were inserted into the control, as the columns
+    // are only created in the item store when they're really needed.
+    if ( !IsVirtual() && static_cast<size_t>(col) < m_itemStore.GetColumnCount() )
     {
-        // update all the items
-        for ( size_t i = 0; i < m_lines.size(); i++ )
-        {
-            wxListLineData * const line = GetLine(i);
-
-            // In the following atypical but possible scenario it can be
-            // legal to call DeleteColumn() but the items may not have any
-            // values for it:
-            //  1. In report view, insert a second column.
-            //  2. Still in report view, add an item with 2 values.
-            //  3. Switch to an icon (or list) view.
-            //  4. Add an item -- necessarily with 1 value only.
-            //  5. Switch back to report view.
-            //  6. Call DeleteColumn().
-            // So we need to check for this as otherwise we would simply crash
-            // if this happens.
-            if ( line->m_items.GetCount() <= static_cast<unsigned>(col) )
-                continue;
-
-            wxListItemDataList::compatibility_iterator n = line->m_items.Item( col );
-            delete n->GetData();
-            line->m_items.Erase(n);
-        }
+        // update all the items at once
+        m_itemStore.DeleteColumn(col, true /* delete attributes */);
     }
 
     if ( InReportView() )   //  we only cache max widths when in Report View
@@ -4660,18 +4782,14 @@ long wxListMainWindow::InsertColumn( long col, const wxListItem &item )
             m_aColWidths.Add( colWidthInfo );
         }
 
-        if ( !IsVirtual() )
+        if ( !IsVirtual() && !m_lines.empty() )
         {
-            // update all the items
-            for ( size_t i = 0; i < m_lines.size(); i++ )
-            {
-                wxListLineData * const line = GetLine(i);
-                wxListItemData * const data = new wxListItemData(this);
-                if ( insert )
-                    line->m_items.Insert(col, data);
-                else
-                    line->m_items.Append(data);
-            }
+            // update all the items: if there are no items yet, the column
+            // will be created in the store when the first one is added
+            if ( insert && static_cast<size_t>(col) < m_itemStore.GetColumnCount() )
+                m_itemStore.InsertColumn(col);
+            else
+                m_itemStore.InsertColumn(m_itemStore.GetColumnCount());
         }
 
         // invalidate it as it has to be recalculated
@@ -4708,6 +4826,17 @@ int wxListMainWindow::GetItemWidthWithImage(wxListItem * item)
 // sorting
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+// the line together with its client data, which is retrieved only once for
+// each line before sorting
+struct wxListLineSortEntry
+{
+    wxUIntPtr data;
+    wxListLineData* line;
+};
+
 struct wxListLineComparator
 {
     wxListLineComparator(wxListCtrlCompare& f, wxIntPtr data)
@@ -4716,21 +4845,18 @@ struct wxListLineComparator
     {
     }
 
-    bool operator()(wxListLineData* const& line1,
-                    wxListLineData* const& line2) const
+    bool operator()(const wxListLineSortEntry& entry1,
+                    const wxListLineSortEntry& entry2) const
     {
-        wxListItem item;
-        line1->GetItem( 0, item );
-        wxUIntPtr data1 = item.m_data;
-        line2->GetItem( 0, item );
-        wxUIntPtr data2 = item.m_data;
-        return m_f(data1, data2, m_data) < 0;
+        return m_f(entry1.data, entry2.data, m_data) < 0;
     }
 
     const wxListCtrlCompare m_f;
     const wxIntPtr          m_data;
 };
 
+} // anonymous namespace
+
 void wxListMainWindow::SortItems( wxListCtrlCompare fn, wxIntPtr data )
 {
     // selections won't make sense any more after sorting the items so reset
@@ -4738,7 +4864,23 @@ void wxListMainWindow::SortItems( wxListCtrlCompare fn, wxIntPtr data )
     HighlightAll(false);
     ResetCurrent();
 
-    std::sort(m_lines.begin(), m_lines.end(), wxListLineComparator(fn, data));
+    const size_t count = m_lines.size();
+    if ( count && !IsVirtual() )
+    {
+        wxVector<wxListLineSortEntry> entries(count);
+        for ( size_t n = 0; n < count; n++ )
+        {
+            wxListLineData* const line = m_lines[n];
+            entries[n].data = m_itemStore.GetData(line->m_slot, 0);
+            entries[n].line = line;
+        }
+
+        std::sort(entries.begin(), entries.end(),
+                  wxListLineComparator(fn, data));
+
+        for ( size_t n = 0; n < count; n++ )
+            m_lines[n] = entries[n].line;
+    }
 
     m_dirty = true;
 }
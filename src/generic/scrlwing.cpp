@@ -759,6 +759,9 @@ void wxScrollHelperBase::DoCalcUnscrolledPosition(int x, int y,
 
 bool wxScrollHelperBase::ScrollLayout()
 {
+    if ( m_win->WXDeferLayout() )
+        return true;
+
     if ( m_win->GetSizer() && m_targetWindow == m_win )
     {
         // If we're the scroll target, take into account the
@@ -132,6 +132,72 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxTreeFindTimer);
 };
 
+// the layout of the children of a tree item: this is a segment tree over the
+// children storing the total heights of their subtrees and their maximal right
+// edges, which allows to find the offset of any child, or the child at the
+// given offset, and to update them when a single child changes in logarithmic
+// time
+class wxGenericTreeChildrenLayout
+{
+public:
+    wxGenericTreeChildrenLayout()
+    {
+        m_count =
+        m_size = 0;
+        m_layoutGen = 0;
+    }
+
+    // the layout is only valid if it has the current generation of the control
+    bool IsValid(unsigned gen) const { return m_layoutGen == gen; }
+
+    // forget the layout when the children themselves change
+    void Invalidate()
+    {
+        m_layoutGen = 0;
+        m_dirty.clear();
+    }
+
+    // compute the layout of all the children, which must be laid out already
+    void Build(const wxArrayGenericTreeItems& children, unsigned gen);
+
+    // update the layout after the subtree of the child with the given index
+    // changed
+    void Update(size_t n, int height, int maxRight);
+
+    int GetTotalHeight() const { return m_size ? m_heights[1] : 0; }
+    int GetMaxRight() const { return m_size ? m_rights[1] : 0; }
+
+    // return the offset of the child with the given index from the top of
+    // the first child
+    int GetOffset(size_t n) const;
+
+    // return the index of the first child whose subtree ends after the given
+    // offset, i.e. the one containing this offset if any, or the number of
+    // children if there is none
+    size_t FindIndexAt(int offset) const;
+
+    // the children whose subtree changed since the layout was last updated
+    wxVector<wxGenericTreeItem *>& GetDirty() { return m_dirty; }
+
+private:
+    // the number of children and of the leaves of the tree, which is the
+    // smallest power of 2 greater or equal to it
+    size_t m_count,
+           m_size;
+
+    // the nodes of the tree: the root is at index 1, the children of the
+    // node k are at 2k and 2k + 1 and the leaf corresponding to the child n
+    // is at m_size + n
+    wxVector<int> m_heights,
+                  m_rights;
+
+    wxVector<wxGenericTreeItem *> m_dirty;
+
+    unsigned m_layoutGen;
+
+    wxDECLARE_NO_COPY_CLASS(wxGenericTreeChildrenLayout);
+};
+
 // a tree item
 class WXDLLEXPORT wxGenericTreeItem
 {
@@ -251,8 +317,6 @@ public:
         { DoCalculateSize(control, dc, true /* dc uses normal font */); }
     void CalculateSize(wxGenericTreeCtrl *control);
 
-    void GetSize( int &x, int &y, const wxGenericTreeCtrl* );
-
     void ResetSize() { m_width = 0; }
     void ResetTextSize() { m_width = 0; m_widthText = -1; }
     void RecursiveResetSize();
@@ -269,6 +333,56 @@ public:
     void Expand() { m_isCollapsed = false; }
     void Collapse() { m_isCollapsed = true; }
 
+    // the cached layout of the subtree of this item: it's only valid if the
+    // layout generation is the same as the current one of the control
+    bool IsLayoutValid(unsigned gen) const { return m_layoutGen == gen; }
+    void InvalidateLayout() { m_layoutGen = 0; }
+    void SetLayout(int totalHeight, int maxRight, unsigned gen)
+    {
+        m_totalHeight = totalHeight;
+        m_maxRight = maxRight;
+        m_layoutGen = gen;
+    }
+
+    // total height of this item and all its visible children
+    int GetTotalHeight() const { return m_totalHeight; }
+
+    // maximal right edge of this item and all its visible children
+    int GetMaxRight() const { return m_maxRight; }
+
+    // the layout of the children of this item, created on demand
+    wxGenericTreeChildrenLayout& GetChildrenLayout()
+    {
+        if ( !m_childrenLayout )
+            m_childrenLayout = new wxGenericTreeChildrenLayout;
+
+        return *m_childrenLayout;
+    }
+
+    void InvalidateChildrenLayout()
+    {
+        if ( m_childrenLayout )
+            m_childrenLayout->Invalidate();
+    }
+
+    // index of this item among the children of its parent, only valid if the
+    // layout of the parent children is
+    size_t GetIndexInParent() const { return m_indexInParent; }
+    void SetIndexInParent(size_t n) { m_indexInParent = n; }
+
+    // true if this item is in the list of the dirty children of its parent
+    bool IsLayoutQueued() const { return m_isLayoutQueued != 0; }
+    void SetLayoutQueued(bool queued) { m_isLayoutQueued = queued; }
+
+    // offset of this item from the top of its parent, only valid if the
+    // layout of the parent is
+    int GetOffsetY() const;
+
+    // return the index of the first child whose subtree ends after the given
+    // offset from the top of this item, i.e. the one containing this offset
+    // if any, or the number of children if there is none
+    size_t FindChildIndexAt(int offsetY) const;
+
     void SetHilight( bool set = true ) { m_hasHilight = set; }
 
     // status inquiries
@@ -344,6 +458,13 @@ private:
     int                 m_width;        // width of this item
     int                 m_height;       // height of this item
 
+    // cached layout, see IsLayoutValid()
+    wxGenericTreeChildrenLayout *m_childrenLayout;
+    size_t              m_indexInParent;
+    int                 m_totalHeight;  // height of the visible subtree
+    int                 m_maxRight;     // right edge of the visible subtree
+    unsigned            m_layoutGen;    // generation of the values above
+
     // use bitfields to save size
     unsigned int        m_isCollapsed :1;
     unsigned int        m_hasHilight  :1; // same as focused
@@ -351,6 +472,7 @@ private:
                                           // children but has a [+] button
     unsigned int        m_isBold      :1; // render the label in bold font
     unsigned int        m_ownsAttr    :1; // delete attribute when done
+    unsigned int        m_isLayoutQueued :1; // see IsLayoutQueued()
 
     wxDECLARE_NO_COPY_CLASS(wxGenericTreeItem);
 };
@@ -570,6 +692,93 @@ void wxTreeTextCtrl::OnKillFocus( wxFocusEvent &event )
     event.Skip();
 }
 
+// -----------------------------------------------------------------------------
+// wxGenericTreeChildrenLayout
+// -----------------------------------------------------------------------------
+
+void
+wxGenericTreeChildrenLayout::Build(const wxArrayGenericTreeItems& children,
+                                   unsigned gen)
+{
+    m_count = children.GetCount();
+    for ( m_size = 1; m_size < m_count; m_size *= 2 )
+        ;
+
+    m_heights.assign(2*m_size, 0);
+    m_rights.assign(2*m_size, 0);
+
+    for ( size_t n = 0; n < m_count; ++n )
+    {
+        wxGenericTreeItem * const child = children[n];
+        child->SetIndexInParent(n);
+        child->SetLayoutQueued(false);
+
+        m_heights[m_size + n] = child->GetTotalHeight();
+        m_rights[m_size + n] = child->GetMaxRight();
+    }
+
+    for ( size_t k = m_size - 1; k > 0; --k )
+    {
+        m_heights[k] = m_heights[2*k] + m_heights[2*k + 1];
+        m_rights[k] = wxMax(m_rights[2*k], m_rights[2*k + 1]);
+    }
+
+    m_dirty.clear();
+    m_layoutGen = gen;
+}
+
+void wxGenericTreeChildrenLayout::Update(size_t n, int height, int maxRight)
+{
+    wxCHECK_RET( n < m_count, "invalid child index" );
+
+    size_t k = m_size + n;
+    m_heights[k] = height;
+    m_rights[k] = maxRight;
+
+    for ( k /= 2; k > 0; k /= 2 )
+    {
+        m_heights[k] = m_heights[2*k] + m_heights[2*k + 1];
+        m_rights[k] = wxMax(m_rights[2*k], m_rights[2*k + 1]);
+    }
+}
+
+int wxGenericTreeChildrenLayout::GetOffset(size_t n) const
+{
+    if ( n >= m_count )
+        return GetTotalHeight();
+
+    // sum the heights of all the leaves before the given one
+    int offset = 0;
+    for ( size_t lo = m_size, hi = m_size + n; lo < hi; lo /= 2, hi /= 2 )
+    {
+        if ( lo & 1 )
+            offset += m_heights[lo++];
+        if ( hi & 1 )
+            offset += m_heights[--hi];
+    }
+
+    return offset;
+}
+
+size_t wxGenericTreeChildrenLayout::FindIndexAt(int offset) const
+{
+    if ( !m_size || offset >= m_heights[1] )
+        return m_count;
+
+    size_t k = 1;
+    while ( k < m_size )
+    {
+        k *= 2;
+        if ( offset >= m_heights[k] )
+        {
+            offset -= m_heights[k];
+            k++;
+        }
+    }
+
+    return k - m_size;
+}
+
 // -----------------------------------------------------------------------------
 // wxGenericTreeItem
 // -----------------------------------------------------------------------------
@@ -589,10 +798,17 @@ wxGenericTreeItem::wxGenericTreeItem(wxGenericTreeItem *parent,
     m_state = wxTREE_ITEMSTATE_NONE;
     m_x = m_y = 0;
 
+    m_childrenLayout = NULL;
+    m_indexInParent = 0;
+    m_totalHeight = 0;
+    m_maxRight = 0;
+    m_layoutGen = 0;
+
     m_isCollapsed = true;
     m_hasHilight = false;
     m_hasPlus = false;
     m_isBold = false;
+    m_isLayoutQueued = false;
 
     m_parent = parent;
 
@@ -613,6 +829,8 @@ wxGenericTreeItem::~wxGenericTreeItem()
 
     if (m_ownsAttr) delete m_attr;
 
+    delete m_childrenLayout;
+
     wxASSERT_MSG( m_children.IsEmpty(),
                   "must call DeleteChildren() before deleting the item" );
 }
@@ -649,22 +867,20 @@ size_t wxGenericTreeItem::GetChildrenCount(bool recursively) const
     return total;
 }
 
-void wxGenericTreeItem::GetSize( int &x, int &y,
-                                 const wxGenericTreeCtrl *theButton )
+int wxGenericTreeItem::GetOffsetY() const
 {
-    int bottomY=m_y+theButton->GetLineHeight(this);
-    if ( y < bottomY ) y = bottomY;
-    int width = m_x +  m_width;
-    if ( x < width ) x = width;
+    if ( !m_parent || !m_parent->m_childrenLayout )
+        return 0;
 
-    if (IsExpanded())
-    {
-        size_t count = m_children.GetCount();
-        for ( size_t n = 0; n < count; ++n )
-        {
-            m_children[n]->GetSize( x, y, theButton );
-        }
-    }
+    return m_parent->m_childrenLayout->GetOffset(m_indexInParent);
+}
+
+size_t wxGenericTreeItem::FindChildIndexAt(int offsetY) const
+{
+    if ( !m_childrenLayout )
+        return m_children.GetCount();
+
+    return m_childrenLayout->FindIndexAt(offsetY);
 }
 
 wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
@@ -672,6 +888,9 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
                                               int &flags,
                                               int level)
 {
+    // this also updates our position if we're the root item
+    theCtrl->UpdateLayout(this);
+
     // for a hidden root node, don't evaluate it, but do evaluate children
     if ( !(level == 0 && theCtrl->HasFlag(wxTR_HIDE_ROOT)) )
     {
@@ -679,6 +898,9 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
         int h = theCtrl->GetLineHeight(this);
         if ((point.y > m_y) && (point.y < m_y + h))
         {
+            // the item may have not been measured yet if it wasn't shown
+            CalculateSize(wxConstCast(theCtrl, wxGenericTreeCtrl));
+
             int y_mid = m_y + h/2;
             if (point.y < y_mid )
                 flags |= wxTREE_HITTEST_ONITEMUPPERPART;
@@ -755,19 +977,15 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
         if (m_isCollapsed) return NULL;
     }
 
-    // evaluate children
-    size_t count = m_children.GetCount();
-    for ( size_t n = 0; n < count; n++ )
-    {
-        wxGenericTreeItem *res = m_children[n]->HitTest( point,
-                                                         theCtrl,
-                                                         flags,
-                                                         level + 1 );
-        if ( res != NULL )
-            return res;
-    }
+    // evaluate the only child which can contain this point
+    const size_t n = FindChildIndexAt(point.y - m_y);
+    if ( n == m_children.GetCount() )
+        return NULL;
 
-    return NULL;
+    wxGenericTreeItem * const child = m_children[n];
+    child->SetY(m_y + child->GetOffsetY());
+
+    return child->HitTest( point, theCtrl, flags, level + 1 );
 }
 
 int wxGenericTreeItem::GetCurrentImage() const
@@ -875,9 +1093,40 @@ wxGenericTreeItem::DoCalculateSize(wxGenericTreeCtrl* control,
         m_height += m_height / 10;   // otherwise 10% extra spacing
 
     if (m_height > control->m_lineHeight)
+    {
         control->m_lineHeight = m_height;
 
+        // if all items use the same height, all their positions change
+        if ( !control->HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+        {
+            control->InvalidateAllLayouts();
+            control->m_dirty = true;
+        }
+    }
+
     m_width = state_w + image_w + m_widthText + 2;
+
+    // as items are measured lazily, when they're shown for the first time,
+    // the cached extent of this item and its parents may need to be updated
+    const int right = m_x + m_width;
+    for ( wxGenericTreeItem *item = this; right > item->m_maxRight; )
+    {
+        item->m_maxRight = right;
+
+        wxGenericTreeItem * const parent = item->m_parent;
+        if ( !parent || !parent->IsExpanded() )
+            break;
+
+        wxGenericTreeChildrenLayout * const layout = parent->m_childrenLayout;
+        if ( layout && layout->IsValid(control->m_layoutGen) &&
+                item->m_indexInParent < parent->m_children.GetCount() &&
+                    parent->m_children[item->m_indexInParent] == item )
+        {
+            layout->Update(item->m_indexInParent, item->m_totalHeight, right);
+        }
+
+        item = parent;
+    }
 }
 
 void wxGenericTreeItem::RecursiveResetSize()
@@ -929,6 +1178,8 @@ void wxGenericTreeCtrl::Init()
     m_select_me = NULL;
     m_hasFocus = false;
     m_dirty = false;
+    m_layoutGen = 1;
+    m_scrolledMaxRight = 0;
 
     m_lineHeight = 10;
     m_indent = 10;
@@ -1073,6 +1324,7 @@ void wxGenericTreeCtrl::SetIndent(unsigned int indent)
 {
     m_indent = (unsigned short) indent;
     m_dirty = true;
+    InvalidateAllLayouts();
 }
 
 size_t
@@ -1100,6 +1352,7 @@ void wxGenericTreeCtrl::SetWindowStyleFlag(long styles)
     // none of the parents has updatable styles
     m_windowStyle = styles;
     m_dirty = true;
+    InvalidateAllLayouts();
 }
 
 // -----------------------------------------------------------------------------
@@ -1169,6 +1422,7 @@ wxGenericTreeCtrl::SetItemText(const wxTreeItemId& item, const wxString& text)
     wxGenericTreeItem *pItem = (wxGenericTreeItem*) item.m_pItem;
     pItem->SetText(text);
     pItem->CalculateSize(this);
+    InvalidateLayout(pItem);
     RefreshLine(pItem);
 }
 
@@ -1181,6 +1435,7 @@ void wxGenericTreeCtrl::SetItemImage(const wxTreeItemId& item,
     wxGenericTreeItem *pItem = (wxGenericTreeItem*) item.m_pItem;
     pItem->SetImage(image, which);
     pItem->CalculateSize(this);
+    InvalidateLayout(pItem);
     RefreshLine(pItem);
 }
 
@@ -1202,6 +1457,7 @@ void wxGenericTreeCtrl::DoSetItemState(const wxTreeItemId& item, int state)
     wxGenericTreeItem *pItem = (wxGenericTreeItem*) item.m_pItem;
     pItem->SetState(state);
     pItem->CalculateSize(this);
+    InvalidateLayout(pItem);
     RefreshLine(pItem);
 }
 
@@ -1227,6 +1483,7 @@ void wxGenericTreeCtrl::SetItemBold(const wxTreeItemId& item, bool bold)
         // recalculate the item size as bold and non bold fonts have different
         // widths
         pItem->CalculateSize(this);
+        InvalidateLayout(pItem);
         RefreshLine(pItem);
     }
 }
@@ -1279,6 +1536,7 @@ wxGenericTreeCtrl::SetItemFont(const wxTreeItemId& item, const wxFont& font)
     pItem->Attr().SetFont(font);
     pItem->ResetTextSize();
     pItem->CalculateSize(this);
+    InvalidateLayout(pItem);
     RefreshLine(pItem);
 }
 
@@ -1295,6 +1553,8 @@ bool wxGenericTreeCtrl::SetFont( const wxFont &font )
     if (m_anchor)
         m_anchor->RecursiveResetTextSize();
 
+    InvalidateAllLayouts();
+
     return true;
 }
 
@@ -1491,37 +1751,50 @@ wxTreeItemId wxGenericTreeCtrl::GetNext(const wxTreeItemId& item) const
     }
 }
 
-wxTreeItemId wxGenericTreeCtrl::GetFirstVisibleItem() const
+wxTreeItemId wxGenericTreeCtrl::FindVisibleItemFrom(int y) const
 {
-    wxTreeItemId itemid = GetRootItem();
-    if (!itemid.IsOk())
-        return itemid;
+    // visible items can only be found in the rows shown in the window, so
+    // walk over them instead of iterating over all the items of the tree
+    int yEnd;
+    CalcUnscrolledPosition(0, GetClientSize().y, NULL, &yEnd);
 
-    do
+    while ( y <= yEnd )
     {
-        if (IsVisible(itemid))
-              return itemid;
-        itemid = GetNext(itemid);
-    } while (itemid.IsOk());
+        wxGenericTreeItem * const item = FindItemAtY(y);
+        if ( !item )
+            break;
+
+        if ( IsVisible(item) )
+            return item;
+
+        y = item->GetY() + GetLineHeight(item);
+    }
 
     return wxTreeItemId();
 }
 
+wxTreeItemId wxGenericTreeCtrl::GetFirstVisibleItem() const
+{
+    if ( !m_anchor )
+        return wxTreeItemId();
+
+    UpdateLayout(m_anchor);
+
+    int y;
+    CalcUnscrolledPosition(0, 0, NULL, &y);
+
+    return FindVisibleItemFrom(wxMax(y, m_anchor->GetY()));
+}
+
 wxTreeItemId wxGenericTreeCtrl::GetNextVisible(const wxTreeItemId& item) const
 {
     wxCHECK_MSG( item.IsOk(), wxTreeItemId(), wxT("invalid tree item") );
     wxASSERT_MSG( IsVisible(item), wxT("this item itself should be visible") );
 
-    wxTreeItemId id = item;
-    if (id.IsOk())
-    {
-        while (id = GetNext(id), id.IsOk())
-        {
-            if (IsVisible(id))
-                return id;
-        }
-    }
-    return wxTreeItemId();
+    wxGenericTreeItem * const pItem = (wxGenericTreeItem*) item.m_pItem;
+    CalculateItemGeometry(pItem);
+
+    return FindVisibleItemFrom(pItem->GetY() + GetLineHeight(pItem));
 }
 
 wxTreeItemId wxGenericTreeCtrl::GetPrevVisible(const wxTreeItemId& item) const
@@ -1529,35 +1802,26 @@ wxTreeItemId wxGenericTreeCtrl::GetPrevVisible(const wxTreeItemId& item) const
     wxCHECK_MSG( item.IsOk(), wxTreeItemId(), wxT("invalid tree item") );
     wxASSERT_MSG( IsVisible(item), wxT("this item itself should be visible") );
 
-    // find out the starting point
-    wxTreeItemId prevItem = GetPrevSibling(item);
-    if ( !prevItem.IsOk() )
-    {
-        prevItem = GetItemParent(item);
-    }
+    wxGenericTreeItem * const pItem = (wxGenericTreeItem*) item.m_pItem;
+    CalculateItemGeometry(pItem);
 
-    // find the first visible item after it
-    while ( prevItem.IsOk() && !IsVisible(prevItem) )
-    {
-        prevItem = GetNext(prevItem);
-        if ( !prevItem.IsOk() || prevItem == item )
-        {
-            // there are no visible items before item
-            return wxTreeItemId();
-        }
-    }
+    int yStart;
+    CalcUnscrolledPosition(0, 0, NULL, &yStart);
 
-    // from there we must be able to navigate until this item
-    while ( prevItem.IsOk() )
+    // walk the rows above this item until we leave the window
+    for ( int y = pItem->GetY() - 1; y >= yStart; )
     {
-        const wxTreeItemId nextItem = GetNextVisible(prevItem);
-        if ( !nextItem.IsOk() || nextItem == item )
+        wxGenericTreeItem * const prev = FindItemAtY(y);
+        if ( !prev )
             break;
 
-        prevItem = nextItem;
+        if ( IsVisible(prev) )
+            return prev;
+
+        y = prev->GetY() - 1;
     }
 
-    return prevItem;
+    return wxTreeItemId();
 }
 
 // called by wxTextTreeCtrl when it marks itself for deletion
@@ -1656,6 +1920,14 @@ wxTreeItemId wxGenericTreeCtrl::DoInsertItem(const wxTreeItemId& parentId,
 
     parent->Insert( item, previous == (size_t)-1 ? parent->GetChildren().size()
                                                  : previous );
+    InvalidateChildrenLayout(parent);
+
+    // measure the item immediately if all items have the same height, as
+    // this height may need to be increased to accommodate it, which changes
+    // the positions of all items and so had better be done before they're
+    // shown
+    if ( !HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+        item->CalculateSize(this);
 
     InvalidateBestSize();
     return item;
@@ -1766,6 +2038,7 @@ void wxGenericTreeCtrl::DeleteChildren(const wxTreeItemId& itemId)
     wxGenericTreeItem *item = (wxGenericTreeItem*) itemId.m_pItem;
     ChildrenClosing(item);
     item->DeleteChildren(this);
+    InvalidateChildrenLayout(item);
     InvalidateBestSize();
 }
 
@@ -1826,6 +2099,7 @@ void wxGenericTreeCtrl::Delete(const wxTreeItemId& itemId)
     if ( parent )
     {
         parent->GetChildren().Remove( item );  // remove by value
+        InvalidateChildrenLayout(parent);
     }
     else // deleting the root
     {
@@ -1876,6 +2150,7 @@ void wxGenericTreeCtrl::Expand(const wxTreeItemId& itemId)
     }
 
     item->Expand();
+    InvalidateLayout(item);
     if ( !IsFrozen() )
     {
         CalculatePositions();
@@ -1918,6 +2193,7 @@ void wxGenericTreeCtrl::Collapse(const wxTreeItemId& itemId)
 
     ChildrenClosing(item);
     item->Collapse();
+    InvalidateLayout(item);
 
 #if 0  // TODO why should items be collapsed recursively?
     wxArrayGenericTreeItems& children = item->GetChildren();
@@ -2108,6 +2384,9 @@ wxGenericTreeCtrl::SelectItemRange(wxGenericTreeItem *item1,
 {
     m_select_me = NULL;
 
+    CalculateItemGeometry(item1);
+    CalculateItemGeometry(item2);
+
     // item2 is not necessary after item1
     // choice first' and 'last' between item1 and item2
     wxGenericTreeItem *first= (item1->GetY()<item2->GetY()) ? item1 : item2;
@@ -2314,6 +2593,7 @@ void wxGenericTreeCtrl::ScrollTo(const wxTreeItemId &item)
 
     wxGenericTreeItem *gitem = (wxGenericTreeItem*) item.m_pItem;
 
+    CalculateItemGeometry(gitem);
     int itemY = gitem->GetY();
 
     int start_x = 0;
@@ -2373,6 +2653,8 @@ void wxGenericTreeCtrl::SortChildren(const wxTreeItemId& itemId)
         s_treeBeingSorted = this;
         children.Sort(tree_ctrl_compare_func);
         s_treeBeingSorted = NULL;
+
+        InvalidateChildrenLayout(item);
     }
     //else: don't make the tree dirty as nothing changed
 }
@@ -2428,6 +2710,8 @@ void wxGenericTreeCtrl::CalculateLineHeight()
         m_lineHeight += 2;                 // at least 2 pixels
     else
         m_lineHeight += m_lineHeight/10;   // otherwise 10% extra spacing
+
+    InvalidateAllLayouts();
 }
 
 void wxGenericTreeCtrl::SetImageList(wxImageList *imageList)
@@ -2439,6 +2723,7 @@ void wxGenericTreeCtrl::SetImageList(wxImageList *imageList)
 
     if (m_anchor)
         m_anchor->RecursiveResetSize();
+    InvalidateAllLayouts();
 
     // Don't do any drawing if we're setting the list to NULL,
     // since we may be in the process of deleting the tree control.
@@ -2455,6 +2740,7 @@ void wxGenericTreeCtrl::SetStateImageList(wxImageList *imageList)
 
     if (m_anchor)
         m_anchor->RecursiveResetSize();
+    InvalidateAllLayouts();
 
     // Don't do any drawing if we're setting the list to NULL,
     // since we may be in the process of deleting the tree control.
@@ -2471,6 +2757,7 @@ void wxGenericTreeCtrl::SetButtonsImageList(wxImageList *imageList)
 
     if (m_anchor)
         m_anchor->RecursiveResetSize();
+    InvalidateAllLayouts();
 
     CalculateLineHeight();
 }
@@ -2487,10 +2774,15 @@ void wxGenericTreeCtrl::AssignButtonsImageList(wxImageList *imageList)
 
 void wxGenericTreeCtrl::AdjustMyScrollbars()
 {
+    if (m_anchor)
+        UpdateLayout(m_anchor);
+
+    m_scrolledMaxRight = m_anchor ? m_anchor->GetMaxRight() : 0;
+
     if (m_anchor)
     {
-        int x = 0, y = 0;
-        m_anchor->GetSize( x, y, this );
+        int x = m_anchor->GetMaxRight(),
+            y = m_anchor->GetY() + m_anchor->GetTotalHeight();
         y += PIXELS_PER_UNIT+2; // one more scrollbar unit + 2 pixels
         x += PIXELS_PER_UNIT+2; // one more scrollbar unit + 2 pixels
         int x_pos = GetScrollPos( wxHORIZONTAL );
@@ -2728,6 +3020,44 @@ void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
     }
 }
 
+void
+wxGenericTreeCtrl::PaintChildren(wxGenericTreeItem *item,
+                                 wxDC& dc,
+                                 int level,
+                                 int &y,
+                                 int &yLast)
+{
+    UpdateLayout(item);
+
+    const wxArrayGenericTreeItems& children = item->GetChildren();
+    const size_t count = children.GetCount();
+
+    // only paint the children intersecting the update region, there may be
+    // a huge number of them and all the others are invisible anyhow
+    const wxRect rectUpdate = GetUpdateRegion().GetBox();
+    const int top = dc.DeviceToLogicalY(rectUpdate.GetTop()),
+              bottom = dc.DeviceToLogicalY(rectUpdate.GetBottom());
+
+    const int itemTop = item->GetY();
+    size_t n = item->FindChildIndexAt(top - itemTop);
+    if ( n < count )
+    {
+        for ( int yNext = itemTop + children[n]->GetOffsetY(); n < count; ++n )
+        {
+            int yChild = yNext;
+            if ( yChild > bottom )
+                break;
+
+            yNext += children[n]->GetTotalHeight();
+
+            PaintLevel(children[n], dc, level, yChild);
+        }
+    }
+
+    y = itemTop + item->GetTotalHeight();
+    yLast = y - children[count - 1]->GetTotalHeight();
+}
+
 void
 wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
                               wxDC &dc,
@@ -2747,18 +3077,15 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
         int count = children.GetCount();
         if (count > 0)
         {
-            int n = 0, oldY;
-            do {
-                oldY = y;
-                PaintLevel(children[n], dc, 1, y);
-            } while (++n < count);
+            int oldY;
+            PaintChildren(item, dc, 1, y, oldY);
 
             if ( !HasFlag(wxTR_NO_LINES) && HasFlag(wxTR_LINES_AT_ROOT)
                     && count > 0 )
             {
                 // draw line down to last child
                 origY += GetLineHeight(children[0])>>1;
-                oldY += GetLineHeight(children[n-1])>>1;
+                oldY += GetLineHeight(children[count-1])>>1;
                 dc.DrawLine(3, origY, 3, oldY);
             }
         }
@@ -2891,17 +3218,13 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
         int count = children.GetCount();
         if (count > 0)
         {
-            int n = 0, oldY;
-            ++level;
-            do {
-                oldY = y;
-                PaintLevel(children[n], dc, level, y);
-            } while (++n < count);
+            int oldY;
+            PaintChildren(item, dc, level + 1, y, oldY);
 
             if (!HasFlag(wxTR_NO_LINES) && count > 0)
             {
                 // draw line down to last child
-                oldY += GetLineHeight(children[n-1])>>1;
+                oldY += GetLineHeight(children[count-1])>>1;
                 if (HasButtons()) y_mid += 5;
 
                 // Only draw the portion of the line that is visible, in case
@@ -2968,6 +3291,7 @@ void wxGenericTreeCtrl::DrawBorder(const wxTreeItemId &item)
         m_dndEffectItem = NULL;
     }
 
+    CalculateItemGeometry(i);
     wxRect rect( i->GetX()-1, i->GetY()-1, i->GetWidth()+2, GetLineHeight(i)+2 );
     CalcScrolledPosition( rect.x, rect.y, &rect.x, &rect.y );
     RefreshRect( rect );
@@ -2993,6 +3317,7 @@ void wxGenericTreeCtrl::DrawLine(const wxTreeItemId &item, bool below)
         m_dndEffectItem = NULL;
     }
 
+    CalculateItemGeometry(i);
     wxRect rect( i->GetX()-1, i->GetY()-1, i->GetWidth()+2, GetLineHeight(i)+2 );
     CalcScrolledPosition( rect.x, rect.y, &rect.x, &rect.y );
     RefreshRect( rect );
@@ -3456,6 +3781,8 @@ bool wxGenericTreeCtrl::GetBoundingRect(const wxTreeItemId& item,
 
     wxGenericTreeItem *i = (wxGenericTreeItem*) item.m_pItem;
 
+    CalculateItemGeometry(i);
+
     if ( textOnly )
     {
         int image_w = 0;
@@ -3962,62 +4289,222 @@ void wxGenericTreeCtrl::OnInternalIdle()
     // actually redraw the tree when everything is over
     if (m_dirty)
         DoDirtyProcessing();
+    else if ( m_anchor && m_anchor->GetMaxRight() > m_scrolledMaxRight &&
+                !IsFrozen() )
+    {
+        // some items became wider when they were measured while being shown
+        AdjustMyScrollbars();
+    }
+}
+
+void wxGenericTreeCtrl::InvalidateLayout(wxGenericTreeItem *item)
+{
+    // the size of the subtree of this item changed, which affects the
+    // positions of its siblings and all the siblings of its parents, but
+    // nothing else, so just remember that the layout of the parents must be
+    // updated for this item
+    item->InvalidateLayout();
+
+    for ( wxGenericTreeItem *parent = item->GetParent();
+          parent;
+          item = parent, parent = parent->GetParent() )
+    {
+        // if the item is already queued, its parents had been invalidated
+        // too, unless they're collapsed and then it doesn't matter anyhow
+        if ( item->IsLayoutQueued() )
+            break;
+
+        item->SetLayoutQueued(true);
+        parent->GetChildrenLayout().GetDirty().push_back(item);
+        parent->InvalidateLayout();
+    }
+}
+
+void wxGenericTreeCtrl::InvalidateChildrenLayout(wxGenericTreeItem *item)
+{
+    // the children of this item were added, removed or reordered, so all of
+    // them need to be laid out again
+    item->InvalidateChildrenLayout();
+    InvalidateLayout(item);
+}
+
+void wxGenericTreeCtrl::InvalidateAllLayouts()
+{
+    // skip 0 which is used for the items which were never laid out
+    if ( !++m_layoutGen )
+        m_layoutGen = 1;
+}
+
+void wxGenericTreeCtrl::UpdateLayout(wxGenericTreeItem *item) const
+{
+    if ( item->IsLayoutValid(m_layoutGen) )
+        return;
+
+    // we only need to measure the items if their height is not fixed,
+    // otherwise they're only measured when they're shown
+    if ( HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+    {
+        wxClientDC dc(wxConstCast(this, wxGenericTreeCtrl));
+        dc.SetFont( m_normalFont );
+
+        DoUpdateLayout(item, &dc);
+    }
+    else
+    {
+        DoUpdateLayout(item, NULL);
+    }
 }
 
 void
-wxGenericTreeCtrl::CalculateLevel(wxGenericTreeItem *item,
-                                  wxDC &dc,
-                                  int level,
-                                  int &y )
+wxGenericTreeCtrl::DoUpdateLayout(wxGenericTreeItem *item, wxDC *dc) const
 {
-    int x = level*m_indent;
-    if (!HasFlag(wxTR_HIDE_ROOT))
+    if ( item->IsLayoutValid(m_layoutGen) )
+        return;
+
+    if ( item == m_anchor )
     {
-        x += m_indent;
+        // the root item is always at the top, see OnPaint()
+        item->SetX( (HasFlag(wxTR_HIDE_ROOT) ? 0 : m_indent) + m_spacing );
+        item->SetY( 2 );
     }
-    else if (level == 0)
+
+    // a hidden root is not shown, but its children are always shown
+    const bool isShown = item != m_anchor || !HasFlag(wxTR_HIDE_ROOT);
+
+    int height = 0,
+        maxRight = 0;
+    if ( isShown )
     {
-        // a hidden root is not evaluated, but its
-        // children are always calculated
-        goto Recurse;
+        if ( dc )
+            item->CalculateSize(wxConstCast(this, wxGenericTreeCtrl), *dc);
+
+        height = GetLineHeight(item);
+        maxRight = item->GetX() + item->GetWidth();
     }
 
-    item->CalculateSize(this, dc);
+    if ( item->HasChildren() && (item->IsExpanded() || !isShown) )
+    {
+        wxGenericTreeChildrenLayout& layout = item->GetChildrenLayout();
+        if ( !layout.IsValid(m_layoutGen) )
+        {
+            // lay out all the children from scratch
+            const int xChildren = item->GetX() + m_indent;
 
-    // set its position
-    item->SetX( x+m_spacing );
-    item->SetY( y );
-    y += GetLineHeight(item);
+            const wxArrayGenericTreeItems& children = item->GetChildren();
+            const size_t count = children.GetCount();
+            for ( size_t n = 0; n < count; ++n )
+            {
+                wxGenericTreeItem * const child = children[n];
 
-    if ( !item->IsExpanded() )
+                child->SetX( xChildren );
+                DoUpdateLayout( child, dc );
+            }
+
+            layout.Build(children, m_layoutGen);
+        }
+        else
+        {
+            // only update the children whose subtrees changed
+            wxVector<wxGenericTreeItem *>& dirty = layout.GetDirty();
+            for ( size_t n = 0; n < dirty.size(); ++n )
+            {
+                wxGenericTreeItem * const child = dirty[n];
+                child->SetLayoutQueued(false);
+
+                DoUpdateLayout( child, dc );
+
+                layout.Update(child->GetIndexInParent(),
+                              child->GetTotalHeight(),
+                              child->GetMaxRight());
+            }
+
+            dirty.clear();
+        }
+
+        height += layout.GetTotalHeight();
+        if ( layout.GetMaxRight() > maxRight )
+            maxRight = layout.GetMaxRight();
+    }
+
+    item->SetLayout(height, maxRight, m_layoutGen);
+}
+
+void wxGenericTreeCtrl::CalculateItemGeometry(wxGenericTreeItem *item) const
+{
+    wxGenericTreeItem * const parent = item->GetParent();
+    if ( parent )
     {
-        // we don't need to calculate collapsed branches
-        return;
+        CalculateItemGeometry(parent);
+        UpdateLayout(parent);
+
+        item->SetY( parent->GetY() + item->GetOffsetY() );
+    }
+    else // root item, its position is fixed
+    {
+        UpdateLayout(item);
     }
 
-  Recurse:
-    wxArrayGenericTreeItems& children = item->GetChildren();
-    size_t n, count = children.GetCount();
-    ++level;
-    for (n = 0; n < count; ++n )
-        CalculateLevel( children[n], dc, level, y );  // recurse
+    item->CalculateSize(wxConstCast(this, wxGenericTreeCtrl));
 }
 
-void wxGenericTreeCtrl::CalculatePositions()
+wxGenericTreeItem *wxGenericTreeCtrl::FindItemAtY(int y) const
 {
-    if ( !m_anchor ) return;
+    if ( !m_anchor )
+        return NULL;
 
-    wxClientDC dc(this);
-    PrepareDC( dc );
+    UpdateLayout(m_anchor);
 
-    dc.SetFont( m_normalFont );
+    wxGenericTreeItem *item = m_anchor;
+    for ( ;; )
+    {
+        if ( item != m_anchor || !HasFlag(wxTR_HIDE_ROOT) )
+        {
+            if ( y < item->GetY() )
+                return NULL;
 
-    dc.SetPen( m_dottedPen );
-    //if(GetImageList() == NULL)
-    // m_lineHeight = (int)(dc.GetCharHeight() + 4);
+            if ( y < item->GetY() + GetLineHeight(item) )
+                return item;
 
-    int y = 2;
-    CalculateLevel( m_anchor, dc, 0, y ); // start recursion
+            if ( !item->IsExpanded() )
+                return NULL;
+        }
+
+        UpdateLayout(item);
+
+        const size_t n = item->FindChildIndexAt(y - item->GetY());
+        if ( n == item->GetChildren().GetCount() )
+            return NULL;
+
+        wxGenericTreeItem * const child = item->GetChildren()[n];
+        child->SetY( item->GetY() + child->GetOffsetY() );
+
+        item = child;
+    }
+}
+
+#if WXWIN_COMPATIBILITY_3_0
+
+void wxGenericTreeCtrl::CalculateLevel(wxGenericTreeItem *item,
+                                       wxDC& WXUNUSED(dc),
+                                       int WXUNUSED(level),
+                                       int &y)
+{
+    // the positions of the items only depend on the layout of their parents
+    // now, so just make sure it is up to date
+    CalculateItemGeometry(item);
+
+    y += item->GetTotalHeight();
+}
+
+#endif // WXWIN_COMPATIBILITY_3_0
+
+void wxGenericTreeCtrl::CalculatePositions()
+{
+    if ( !m_anchor ) return;
+
+    // this only recalculates the layout of the items which changed since the
+    // last call, the positions of the individual items are computed on demand
+    UpdateLayout(m_anchor);
 }
 
 void wxGenericTreeCtrl::Refresh(bool eraseBackground, const wxRect *rect)
@@ -4033,6 +4520,8 @@ void wxGenericTreeCtrl::RefreshSubtree(wxGenericTreeItem *item)
 
     wxSize client = GetClientSize();
 
+    CalculateItemGeometry(item);
+
     wxRect rect;
     CalcScrolledPosition(0, item->GetY(), NULL, &rect.y);
     rect.width = client.x;
@@ -4048,6 +4537,8 @@ void wxGenericTreeCtrl::RefreshLine( wxGenericTreeItem *item )
     if (m_dirty || IsFrozen() )
         return;
 
+    CalculateItemGeometry(item);
+
     wxRect rect;
     CalcScrolledPosition(0, item->GetY(), NULL, &rect.y);
     rect.width = GetClientSize().x;
@@ -4125,7 +4616,9 @@ void wxGenericTreeCtrl::OnGetToolTip( wxTreeEvent &event )
 {
 #if wxUSE_TOOLTIPS
     wxTreeItemId itemId = event.GetItem();
-    const wxGenericTreeItem* const pItem = (wxGenericTreeItem*)itemId.m_pItem;
+    wxGenericTreeItem* const pItem = (wxGenericTreeItem*)itemId.m_pItem;
+
+    CalculateItemGeometry(pItem);
 
     // Check if the item fits into the client area:
     if ( pItem->GetX() + pItem->GetWidth() > GetClientSize().x )
@@ -609,14 +609,13 @@ wxBitmap::wxBitmap(const wxImage& image, int depth, double scale)
 
     guchar* dst = gdk_pixbuf_get_pixels(pixbuf_dst);
     const int dstStride = gdk_pixbuf_get_rowstride(pixbuf_dst);
-    CopyImageData(dst, gdk_pixbuf_get_n_channels(pixbuf_dst), dstStride, src, 3, 3 * w, w, h);
-
-    if (depth == 32 && alpha)
+    if (depth == 32)
     {
-        for (int j = 0; j < h; j++, dst += dstStride)
-            for (int i = 0; i < w; i++)
-                dst[i * 4 + 3] = *alpha++;
+        // pixbuf uses interleaved RGBA, fill it in a single pass
+        image.GetPackedPixels(dst, dstStride, wxIMAGE_PACKED_RGBA);
     }
+    else
+        CopyImageData(dst, gdk_pixbuf_get_n_channels(pixbuf_dst), dstStride, src, 3, 3 * w, w, h);
     if (image.HasMask())
     {
         const guchar r = image.GetMaskRed();
@@ -805,19 +804,13 @@ wxImage wxBitmap::ConvertToImage() const
         const guchar* src = gdk_pixbuf_get_pixels(pixbuf_src);
         const int srcStride = gdk_pixbuf_get_rowstride(pixbuf_src);
         const int srcChannels = gdk_pixbuf_get_n_channels(pixbuf_src);
-        CopyImageData(dst, 3, 3 * w, src, srcChannels, srcStride, w, h);
-
         if (srcChannels == 4)
         {
             image.SetAlpha();
-            guchar* alpha = image.GetAlpha();
-            for (int j = 0; j < h; j++, src += srcStride)
-            {
-                const guchar* s = src;
-                for (int i = 0; i < w; i++, s += 4)
-                    *alpha++ = s[3];
-            }
+            image.SetPackedPixels(src, srcStride, wxIMAGE_PACKED_RGBA);
         }
+        else
+            CopyImageData(dst, 3, 3 * w, src, srcChannels, srcStride, w, h);
     }
     cairo_surface_t* maskSurf = NULL;
     if (bmpData->m_mask)
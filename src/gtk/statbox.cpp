@@ -158,6 +158,8 @@ void wxStaticBox::SetLabel( const wxString& label )
     wxCHECK_RET( !m_labelWin, wxS("Doesn't make sense when using label window") );
 
     GTKSetLabelForFrame(GTK_FRAME(m_widget), label);
+
+    InvalidateBestSize();
 }
 
 void wxStaticBox::DoApplyWidgetStyle(GtkRcStyle *style)
@@ -80,6 +80,8 @@ void wxStaticBox::SetLabel( const wxString& label )
     wxCHECK_RET( m_widget != NULL, wxT("invalid staticbox") );
 
     GTKSetLabelForFrame(GTK_FRAME(m_widget), label);
+
+    InvalidateBestSize();
 }
 
 void wxStaticBox::DoApplyWidgetStyle(GtkRcStyle *style)
@@ -59,6 +59,8 @@ QWidget *wxStaticBox::GetHandle() const
 void wxStaticBox::SetLabel(const wxString& label)
 {
     m_qtGroupBox->setTitle(wxQtConvertString(label));
+
+    InvalidateBestSize();
 }
 
 wxString wxStaticBox::GetLabel() const
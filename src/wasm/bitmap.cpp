@@ -487,21 +487,8 @@ bool wxBitmap::Create(const wxImage& image, int depth, double scale)
         return false;
     }
 
-    unsigned char *rowPtr = data;
-
-    for (int y = 0; y < height; y++)
-    {
-        unsigned char *dstPtr = rowPtr;
-
-        for (int x = 0; x < width; x++)
-        {
-            *dstPtr++ = image.GetRed(x, y);
-            *dstPtr++ = image.GetGreen(x, y);
-            *dstPtr++ = image.GetBlue(x, y);
-            *dstPtr++ = hasAlpha ? image.GetAlpha(x, y) : 0xff;
-        }
-        rowPtr += bytesPerRow;
-    }
+    image.GetPackedPixels(data, bytesPerRow, wxIMAGE_PACKED_RGBA,
+                          wxRect(0, 0, width, height));
 
     EndRawAccess();
 
@@ -539,8 +526,6 @@ wxImage wxBitmap::ConvertToImage() const
         return wxNullImage;
     }
 
-    unsigned char *rowPtr = data;
-
     wxImage image(width, height, false);
 
     if (hasAlpha)
@@ -548,26 +533,8 @@ wxImage wxBitmap::ConvertToImage() const
         image.InitAlpha();
     }
 
-    for (int y = 0; y < height; y++)
-    {
-        unsigned char *srcPtr = rowPtr;
-
-        for (int x = 0; x < width; x++)
-        {
-            const unsigned char r = *srcPtr++;
-            const unsigned char g = *srcPtr++;
-            const unsigned char b = *srcPtr++;
-            const unsigned char a = *srcPtr++;
-
-            image.SetRGB(x, y, r, g, b);
-
-            if (hasAlpha)
-            {
-                image.SetAlpha(x, y, a);
-            }
-        }
-        rowPtr += bytesPerRow;
-    }
+    // alpha values are only copied if the image has alpha channel
+    image.SetPackedPixels(data, bytesPerRow, wxIMAGE_PACKED_RGBA);
 
     EndRawAccess();
 
@@ -89,6 +89,8 @@ void wxWindowWasm::Init()
 
     m_childNeedsPaint = true;
     m_selfNeedsPaint = true;
+
+    m_repositioningChildren = false;
 }
 
 bool wxWindowWasm::Create(wxWindow *parent,
@@ -248,6 +250,34 @@ bool wxWindowWasm::HasTransparentBackground()
            GetBackgroundColour().Alpha() == 0;
 }
 
+bool wxWindowWasm::BeginRepositioningChildren()
+{
+    // Nested calls are possible when laying out nested sizers, just let the
+    // outermost one refresh everything.
+    if (m_repositioningChildren)
+        return false;
+
+    m_repositioningChildren = true;
+    m_repositionedRect = wxRect();
+
+    return true;
+}
+
+void wxWindowWasm::EndRepositioningChildren()
+{
+    wxASSERT_MSG(m_repositioningChildren, "Shouldn't be called");
+
+    m_repositioningChildren = false;
+
+    // Refresh the area affected by all the children moves at once instead of
+    // doing it twice for each of them.
+    if (!m_repositionedRect.IsEmpty())
+    {
+        RefreshRect(m_repositionedRect);
+        m_repositionedRect = wxRect();
+    }
+}
+
 void wxWindowWasm::Invalidate(bool needsPaint)
 {
     if (!m_childNeedsPaint || m_selfNeedsPaint != needsPaint)
@@ -619,8 +649,17 @@ void wxWindowWasm::DoMoveWindow(int x, int y, int width, int height)
 
         if (parent != NULL)
         {
-            parent->RefreshRect(oldPos);
-            parent->RefreshRect(newPos);
+            wxWindowWasm * const parentWasm = static_cast<wxWindowWasm*>(parent);
+            if (parentWasm->m_repositioningChildren)
+            {
+                parentWasm->m_repositionedRect.Union(oldPos);
+                parentWasm->m_repositionedRect.Union(newPos);
+            }
+            else
+            {
+                parent->RefreshRect(oldPos);
+                parent->RefreshRect(newPos);
+            }
         }
     }
 }
@@ -129,6 +129,7 @@
 #include <wx/event.h>
 #include <wx/evtloop.h>
 #include <wx/evtloopsrc.h>
+#include <wx/evtprofiler.h>
 #include <wx/except.h>
 #include <wx/fdrepdlg.h>
 #include <wx/features.h>
@@ -15,6 +15,7 @@
 #if wxUSE_STREAMS && wxUSE_ZIPSTREAM
 
 #include "archivetest.h"
+#include "wx/mstream.h"
 #include "wx/zipstrm.h"
 
 using std::string;
@@ -248,4 +249,60 @@ CppUnit::Test *ziptest::makeTest(
 CPPUNIT_TEST_SUITE_REGISTRATION(ziptest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ziptest, "archive/zip");
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Index of the central directory
+
+TEST_CASE("wxZipInputStream::Index", "[archive][zip]")
+{
+    wxMemoryOutputStream mem;
+    {
+        wxZipOutputStream zip(mem);
+        for ( int n = 0; n < 100; n++ )
+        {
+            zip.PutNextEntry(wxString::Format("dir/file%d.txt", n));
+            zip.Write(wxString::Format("data %d", n).utf8_str(),
+                      wxString::Format("data %d", n).length());
+        }
+        zip.PutNextDirEntry("empty");
+    }
+
+    const wxStreamBuffer& buf = *mem.GetOutputStreamBuffer();
+    wxMemoryInputStream in(buf.GetBufferStart(), buf.GetBufferSize());
+    wxZipInputStream zip(in);
+
+    REQUIRE( zip.LoadIndex() );
+    CHECK( zip.HasIndex() );
+    CHECK( zip.GetTotalEntries() == 101 );
+
+    CHECK( zip.FindEntry("dir/missing.txt", wxPATH_UNIX) == NULL );
+    CHECK( zip.FindEntry("empty/", wxPATH_UNIX)->IsDir() );
+
+    wxZipEntry *entry = zip.FindEntry("dir/file57.txt", wxPATH_UNIX);
+    REQUIRE( entry );
+    REQUIRE( zip.OpenEntry(*entry) );
+
+    char data[16];
+    size_t len = zip.Read(data, sizeof(data)).LastRead();
+    CHECK( wxString(data, len) == "data 57" );
+
+    // a second stream over the same archive reuses the index
+    wxMemoryInputStream in2(buf.GetBufferStart(), buf.GetBufferSize());
+    wxZipInputStream zip2(in2);
+
+    REQUIRE( zip2.ShareIndex(zip) );
+    CHECK( zip2.GetTotalEntries() == 101 );
+
+    entry = zip2.FindEntry("dir/file3.txt", wxPATH_UNIX);
+    REQUIRE( entry );
+    REQUIRE( zip2.OpenEntry(*entry) );
+    len = zip2.Read(data, sizeof(data)).LastRead();
+    CHECK( wxString(data, len) == "data 3" );
+
+    // and iterating over it still works after that
+    wxScopedPtr<wxZipEntry> first(zip2.GetNextEntry());
+    REQUIRE( first );
+    CHECK( first->GetName(wxPATH_UNIX) == "dir/file0.txt" );
+}
+
 #endif // wxUSE_STREAMS && wxUSE_ZIPSTREAM
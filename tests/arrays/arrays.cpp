@@ -844,3 +844,97 @@ TEST_CASE("wxNaturalStringComparisonGeneric()", "[wxString][compare]")
     CHECK(wxCmpNaturalGeneric("a5th 5", "a 10th 10") > 0);
 }
 
+
+namespace
+{
+
+int Sign(int n)
+{
+    return n < 0 ? -1 : n > 0 ? 1 : 0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxGetStringSortKey()", "[wxString][compare]")
+{
+    static const char* const strings[] =
+    {
+        "", " ", ",", "0", "00", "01", "1", "05", "5", "10",
+        "9999999999999999999", "a", "A", "Aa", "AB", "ab", "abc", "z",
+        "1st", " 1st", ",1st", "01st", "5th", "10th",
+        "a1st", "a01st", "a5th", "a10th", "a 10th",
+        "a1st1", "a01st01", "a5th5", "a10th10", "a 10th 10", "a5th 5",
+    };
+
+    const size_t count = WXSIZEOF(strings);
+    for ( size_t i = 0; i < count; i++ )
+    {
+        const wxString s1 = strings[i];
+
+        for ( size_t j = 0; j < count; j++ )
+        {
+            const wxString s2 = strings[j];
+            INFO("Comparing \"" << s1 << "\" and \"" << s2 << "\"");
+
+            CHECK( Sign(wxCmpStringSortKeys(wxGetStringSortKey(s1),
+                                            wxGetStringSortKey(s2))) ==
+                    Sign(s1.Cmp(s2)) );
+
+            CHECK( Sign(wxCmpStringSortKeys(wxGetStringSortKey(s1, wxSORTKEY_NOCASE),
+                                            wxGetStringSortKey(s2, wxSORTKEY_NOCASE))) ==
+                    Sign(s1.CmpNoCase(s2)) );
+
+            CHECK( Sign(wxCmpStringSortKeys(wxGetStringSortKey(s1, wxSORTKEY_LOCALE),
+                                            wxGetStringSortKey(s2, wxSORTKEY_LOCALE))) ==
+                    Sign(wxStrcoll(s1, s2)) );
+
+            CHECK( Sign(wxCmpStringSortKeys(wxGetStringSortKey(s1, wxSORTKEY_NATURAL),
+                                            wxGetStringSortKey(s2, wxSORTKEY_NATURAL))) ==
+                    Sign(wxCmpNaturalGeneric(s1, s2)) );
+        }
+    }
+}
+
+TEST_CASE("wxArrayString::SortByKey", "[dynarray]")
+{
+    wxArrayString a;
+    a.push_back("file10");
+    a.push_back("File2");
+    a.push_back("file1");
+
+    a.SortByKey(wxSORTKEY_NATURAL);
+    CHECK( a[0] == "file1" );
+    CHECK( a[1] == "File2" );
+    CHECK( a[2] == "file10" );
+
+    a.SortByKey(wxSORTKEY_NATURAL, true);
+    CHECK( a[0] == "file10" );
+    CHECK( a[1] == "File2" );
+    CHECK( a[2] == "file1" );
+
+    a.SortByKey(wxSORTKEY_DEFAULT);
+    CHECK( a[0] == "File2" );
+    CHECK( a[1] == "file1" );
+    CHECK( a[2] == "file10" );
+
+    // use enough strings to sort them in several threads
+    wxArrayString big;
+    for ( int n = 0; n < 12000; n++ )
+        big.push_back(wxString::Format("%c%d-%d", 'a' + n % 7, (n * 7919) % 12000, n));
+
+    wxArrayString expected(big);
+    expected.Sort(wxCmpNaturalGeneric);
+
+    big.SortByKey(wxSORTKEY_NATURAL);
+    CHECK( big == expected );
+
+    expected.Sort();
+    const wxSortedArrayString sorted(big);
+    REQUIRE( sorted.size() == expected.size() );
+
+    size_t firstDifferent = 0;
+    while ( firstDifferent < sorted.size() &&
+                sorted[firstDifferent] == expected[firstDifferent] )
+        firstDifferent++;
+    CHECK( firstDifferent == sorted.size() );
+}
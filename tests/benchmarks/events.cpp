@@ -0,0 +1,262 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Event-related benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+// ----------------------------------------------------------------------------
+// ProcessEvent() with many bound handlers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// number of events processed during each benchmark run
+const int EVENTS_PER_RUN = 100;
+
+class DispatchHandler : public wxEvtHandler
+{
+public:
+    DispatchHandler() : m_processed(0) { }
+
+    void OnEvent(wxThreadEvent& WXUNUSED(event))
+    {
+        m_processed++;
+    }
+
+    int m_processed;
+};
+
+DispatchHandler* gs_dispatchHandler = NULL;
+
+// the event type handled by gs_dispatchHandler and the one which is not
+wxEventType gs_typeBound = wxEVT_NULL;
+wxEventType gs_typeUnbound = wxEVT_NULL;
+
+bool InitDispatch()
+{
+    gs_dispatchHandler = new DispatchHandler;
+
+    // bind the handler for the event we process first, so that it's found
+    // last, as the handlers are searched in the reverse order of binding
+    gs_typeBound = wxNewEventType();
+    gs_dispatchHandler->Bind(wxEventTypeTag<wxThreadEvent>(gs_typeBound),
+                             &DispatchHandler::OnEvent, gs_dispatchHandler);
+
+    // use the numeric parameter as the number of the other bound handlers
+    long numHandlers = Bench::GetNumericParameter();
+    if ( numHandlers <= 0 )
+        numHandlers = 50;
+
+    for ( long n = 0; n < numHandlers; n++ )
+    {
+        gs_dispatchHandler->Bind(wxEventTypeTag<wxThreadEvent>(wxNewEventType()),
+                                 &DispatchHandler::OnEvent, gs_dispatchHandler);
+    }
+
+    gs_typeUnbound = wxNewEventType();
+
+    return true;
+}
+
+void DoneDispatch()
+{
+    delete gs_dispatchHandler;
+    gs_dispatchHandler = NULL;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(ProcessEventBound, InitDispatch, DoneDispatch)
+{
+    gs_dispatchHandler->m_processed = 0;
+
+    wxThreadEvent event(gs_typeBound);
+    for ( int n = 0; n < EVENTS_PER_RUN; n++ )
+        gs_dispatchHandler->ProcessEvent(event);
+
+    return gs_dispatchHandler->m_processed == EVENTS_PER_RUN;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ProcessEventUnbound, InitDispatch, DoneDispatch)
+{
+    wxThreadEvent event(gs_typeUnbound);
+    for ( int n = 0; n < EVENTS_PER_RUN; n++ )
+        gs_dispatchHandler->ProcessEvent(event);
+
+    return gs_dispatchHandler->m_processed == 0;
+}
+
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// QueueEvent() from multiple threads
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// number of events queued by each thread during each benchmark run
+const int EVENTS_PER_THREAD = 100;
+
+// number of the events processed by all handlers, only used by the main thread
+int gs_eventsProcessed = 0;
+
+class CountingHandler : public wxEvtHandler
+{
+public:
+    CountingHandler()
+    {
+        Bind(wxEVT_THREAD, &CountingHandler::OnThreadEvent, this);
+    }
+
+private:
+    void OnThreadEvent(wxThreadEvent& WXUNUSED(event))
+    {
+        gs_eventsProcessed++;
+    }
+};
+
+wxVector<CountingHandler*> gs_handlers;
+
+class ProducerThread : public wxThread
+{
+public:
+    ProducerThread()
+        : wxThread(wxTHREAD_JOINABLE),
+          m_stop(false)
+    {
+    }
+
+    // queue another batch of events
+    void Produce() { m_semStart.Post(); }
+
+    // exit the thread, it must be waited for after calling this
+    void Stop()
+    {
+        m_stop = true;
+        m_semStart.Post();
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        const size_t numHandlers = gs_handlers.size();
+        size_t handler = 0;
+
+        for ( ;; )
+        {
+            m_semStart.Wait();
+            if ( m_stop )
+                break;
+
+            for ( int n = 0; n < EVENTS_PER_THREAD; n++ )
+            {
+                gs_handlers[handler]->QueueEvent(new wxThreadEvent);
+
+                if ( ++handler == numHandlers )
+                    handler = 0;
+            }
+        }
+
+        return 0;
+    }
+
+private:
+    wxSemaphore m_semStart;
+    bool m_stop;
+};
+
+wxVector<ProducerThread*> gs_producers;
+
+bool InitProducers(int numHandlers)
+{
+    for ( int n = 0; n < numHandlers; n++ )
+        gs_handlers.push_back(new CountingHandler);
+
+    // use the numeric parameter as the number of the producer threads
+    long numThreads = Bench::GetNumericParameter();
+    if ( numThreads <= 0 )
+        numThreads = 4;
+
+    for ( long n = 0; n < numThreads; n++ )
+    {
+        ProducerThread * const thread = new ProducerThread;
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            return false;
+        }
+
+        gs_producers.push_back(thread);
+    }
+
+    return true;
+}
+
+bool InitOneHandler()
+{
+    return InitProducers(1);
+}
+
+bool InitManyHandlers()
+{
+    return InitProducers(100);
+}
+
+void DoneProducers()
+{
+    for ( size_t n = 0; n < gs_producers.size(); n++ )
+    {
+        gs_producers[n]->Stop();
+        gs_producers[n]->Wait();
+        delete gs_producers[n];
+    }
+
+    gs_producers.clear();
+
+    for ( size_t n = 0; n < gs_handlers.size(); n++ )
+        delete gs_handlers[n];
+
+    gs_handlers.clear();
+}
+
+// queue a batch of events from all the threads simultaneously and wait until
+// all of them are processed in this one
+bool QueueAndProcessEvents()
+{
+    gs_eventsProcessed = 0;
+
+    for ( size_t n = 0; n < gs_producers.size(); n++ )
+        gs_producers[n]->Produce();
+
+    const int eventsTotal = gs_producers.size()*EVENTS_PER_THREAD;
+    while ( gs_eventsProcessed < eventsTotal )
+        wxTheApp->ProcessPendingEvents();
+
+    return gs_eventsProcessed == eventsTotal;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(QueueEventThreads, InitOneHandler, DoneProducers)
+{
+    return QueueAndProcessEvents();
+}
+
+BENCHMARK_FUNC_WITH_INIT(QueueEventManyHandlers, InitManyHandlers, DoneProducers)
+{
+    return QueueAndProcessEvents();
+}
+
+#endif // wxUSE_THREADS
@@ -42,6 +42,35 @@ bool ConvertToMB(const wxMBConv& conv)
     return conv.FromWChar(buf.data(), outlen, TEST_STRING) == outlen;
 }
 
+// the same text with some non-ASCII characters, encoded in UTF-8
+const char *TEST_STRING_UTF8 =
+    "Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do eiusmod"
+    "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim"
+    "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea"
+    "commodo consequat. Duis aute irure dolor in reprehenderit in voluptate"
+    "velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint"
+    "occaecat cupidatat non proident, sunt in culpa qui officia deserunt"
+    "mollit anim id est laborum. \xc3\x89t\xc3\xa9, \xce\xb1\xce\xb2\xce\xb3, "
+    "\xe2\x82\xac 42, \xf0\x9f\x98\x80."
+    ;
+
+// convert the test string from UTF-8 and back using the given converter
+bool ConvertUTF8(const wxMBConv& conv, const char *utf8)
+{
+    const size_t len = strlen(utf8);
+
+    const size_t wlen = conv.ToWChar(NULL, 0, utf8, len);
+    if ( wlen == wxCONV_FAILED )
+        return false;
+
+    wxWCharBuffer wbuf(wlen);
+    if ( conv.ToWChar(wbuf.data(), wlen, utf8, len) != wlen )
+        return false;
+
+    wxCharBuffer buf(len);
+    return conv.FromWChar(buf.data(), len, wbuf, wlen) == len;
+}
+
 } // anonymous namespace
 
 BENCHMARK_FUNC(UTF16InitWX)
@@ -76,3 +105,30 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+BENCHMARK_FUNC(UTF8ASCII)
+{
+    return ConvertToMB(wxConvUTF8);
+}
+
+BENCHMARK_FUNC(UTF8Strict)
+{
+    return ConvertUTF8(wxConvUTF8, TEST_STRING_UTF8);
+}
+
+BENCHMARK_FUNC(UTF8ToPUA)
+{
+    return ConvertUTF8(wxMBConvUTF8(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA),
+                       TEST_STRING_UTF8);
+}
+
+BENCHMARK_FUNC(UTF8ToOctal)
+{
+    return ConvertUTF8(wxMBConvUTF8(wxMBConvUTF8::MAP_INVALID_UTF8_TO_OCTAL),
+                       TEST_STRING_UTF8);
+}
+
+BENCHMARK_FUNC(UTF8FromString)
+{
+    return !wxString::FromUTF8(TEST_STRING_UTF8).empty();
+}
@@ -137,3 +137,19 @@ BENCHMARK_FUNC(SystemSnprintf)
     return true;
 }
 
+
+// wxString::Format() is typically used with literal format strings and a few
+// numeric arguments, e.g. when logging or formatting tables
+BENCHMARK_FUNC(StringFormatNumbers)
+{
+    const wxString s = wxString::Format("Item %d of %u: %ld bytes at %x",
+                                        17, 42u, 123456789L, 0xbeef);
+    return s == "Item 17 of 42: 123456789 bytes at beef";
+}
+
+BENCHMARK_FUNC(StringFormatManyArgs)
+{
+    const wxString s = wxString::Format("%s|%5d|%-8s|%d|%d|%d|%.2f|%s",
+                                        "name", 1, "left", 2, 3, 4, 5.5, "end");
+    return s == "name|    1|left    |2|3|4|5.50|end";
+}
@@ -8,6 +8,7 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "wx/string.h"
+#include "wx/arrstr.h"
 #include "wx/ffile.h"
 
 #include "bench.h"
@@ -58,6 +59,22 @@ const wxString& GetTestAsciiString()
     return testString;
 }
 
+const wxString& GetTestUTF8String()
+{
+    static wxString testString;
+    if ( testString.empty() )
+    {
+        long num = Bench::GetNumericParameter();
+        if ( !num )
+            num = 1;
+
+        for ( long n = 0; n < num; n++ )
+            testString += wxString::FromUTF8(utf8str);
+    }
+
+    return testString;
+}
+
 } // anonymous namespace
 
 // this is just a baseline
@@ -244,6 +261,76 @@ BENCHMARK_FUNC(ForStringRIter)
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// non-sequential string access
+// ----------------------------------------------------------------------------
+
+// all these benchmarks are only really interesting in UTF-8 build and with a
+// big numeric parameter making the string long
+
+BENCHMARK_FUNC(ForStringIndexReverse)
+{
+    const wxString& s = GetTestUTF8String();
+    for ( size_t n = s.length(); n > 0; n-- )
+    {
+        if ( s[n - 1] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(RandomStringIndex)
+{
+    const wxString& s = GetTestUTF8String();
+    const size_t len = s.length();
+    for ( size_t n = 0; n < len; n++ )
+    {
+        if ( s[(n * 7919) % len] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(RandomIndexManyStrings)
+{
+    // use more strings than the number of entries in the per-thread cache of
+    // the string positions, to check that accessing them alternately doesn't
+    // make the index useless
+    static wxString strings[16];
+    if ( strings[0].empty() )
+    {
+        for ( size_t n = 0; n < WXSIZEOF(strings); n++ )
+            strings[n] = GetTestUTF8String() + wxString('x', n);
+    }
+
+    const size_t len = GetTestUTF8String().length();
+    for ( size_t n = 0; n < len; n++ )
+    {
+        const wxString& s = strings[n % WXSIZEOF(strings)];
+        if ( s[(n * 7919) % len] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(FindAndMid)
+{
+    const wxString& s = GetTestUTF8String();
+    size_t count = 0;
+    for ( size_t pos = s.find(' ');
+          pos != wxString::npos;
+          pos = s.find(' ', pos + 1) )
+    {
+        if ( s.Mid(pos, 2).length() == 2 )
+            count++;
+    }
+
+    return count != 0;
+}
+
 // ----------------------------------------------------------------------------
 // wxString::Replace()
 // ----------------------------------------------------------------------------
@@ -401,6 +488,106 @@ BENCHMARK_FUNC(MSWCompareStringIgnoreCase)
 
 #endif // __WINDOWS__
 
+// ----------------------------------------------------------------------------
+// sorting arrays of strings
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// the strings sorted by the benchmarks below, their number can be given by
+// the numeric parameter
+wxArrayString gs_stringsToSort;
+
+bool InitStringsToSort()
+{
+    long count = Bench::GetNumericParameter();
+    if ( count <= 0 )
+        count = 10000;
+
+    for ( long n = 0; n < count; n++ )
+    {
+        gs_stringsToSort.push_back(wxString::Format("%s %ld (copy %ld).txt",
+                                                    n % 3 ? "File" : "file",
+                                                    (n * 7919) % count,
+                                                    n % 10));
+    }
+
+    return true;
+}
+
+void DoneStringsToSort()
+{
+    gs_stringsToSort.clear();
+}
+
+int wxCMPFUNC_CONV CmpNoCase(const wxString& s1, const wxString& s2)
+{
+    return s1.CmpNoCase(s2);
+}
+
+int wxCMPFUNC_CONV CmpCollate(const wxString& s1, const wxString& s2)
+{
+    return wxStrcoll(s1, s2);
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(SortNatural, InitStringsToSort, DoneStringsToSort)
+{
+    wxArrayString a(gs_stringsToSort);
+    a.Sort(wxCmpNaturalGeneric);
+
+    return a.size() == gs_stringsToSort.size();
+}
+
+BENCHMARK_FUNC_WITH_INIT(SortNaturalByKey, InitStringsToSort, DoneStringsToSort)
+{
+    wxArrayString a(gs_stringsToSort);
+    a.SortByKey(wxSORTKEY_NATURAL);
+
+    return a.size() == gs_stringsToSort.size();
+}
+
+BENCHMARK_FUNC_WITH_INIT(SortNoCase, InitStringsToSort, DoneStringsToSort)
+{
+    wxArrayString a(gs_stringsToSort);
+    a.Sort(CmpNoCase);
+
+    return a.size() == gs_stringsToSort.size();
+}
+
+BENCHMARK_FUNC_WITH_INIT(SortNoCaseByKey, InitStringsToSort, DoneStringsToSort)
+{
+    wxArrayString a(gs_stringsToSort);
+    a.SortByKey(wxSORTKEY_NOCASE);
+
+    return a.size() == gs_stringsToSort.size();
+}
+
+BENCHMARK_FUNC_WITH_INIT(SortCollate, InitStringsToSort, DoneStringsToSort)
+{
+    wxArrayString a(gs_stringsToSort);
+    a.Sort(CmpCollate);
+
+    return a.size() == gs_stringsToSort.size();
+}
+
+BENCHMARK_FUNC_WITH_INIT(SortCollateByKey, InitStringsToSort, DoneStringsToSort)
+{
+    wxArrayString a(gs_stringsToSort);
+    a.SortByKey(wxSORTKEY_LOCALE);
+
+    return a.size() == gs_stringsToSort.size();
+}
+
+BENCHMARK_FUNC_WITH_INIT(SortedArrayFromArray, InitStringsToSort, DoneStringsToSort)
+{
+    const wxSortedArrayString a(gs_stringsToSort);
+
+    return a.size() == gs_stringsToSort.size();
+}
+
 // ----------------------------------------------------------------------------
 // string buffers: wx[W]CharBuffer
 // ----------------------------------------------------------------------------
@@ -367,6 +367,43 @@ TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
     CHECK( rectRoot == wxRect() );
 }
 
+TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
+                 "wxDVC::RowMapping",
+                 "[wxDataViewCtrl][item]")
+{
+    // The selection is stored as row indices in the generic version, so
+    // retrieving it checks that the rows are correctly mapped to items after
+    // the tree changes, both for consecutive and random rows.
+    m_dvc->Expand(m_child1);
+
+    const wxDataViewItem child3 = m_dvc->AppendContainer(m_root, "child3");
+    const wxDataViewItem grandchild3 = m_dvc->AppendItem(child3, "grandchild3");
+    m_dvc->Expand(child3);
+
+    const wxDataViewItem items[] =
+    {
+        m_root, m_child1, m_grandchild, m_child2, child3, grandchild3
+    };
+
+    for ( size_t n = 0; n < WXSIZEOF(items); n++ )
+    {
+        m_dvc->Select(items[n]);
+        CHECK( m_dvc->GetSelection() == items[n] );
+    }
+
+    m_dvc->Select(m_child2);
+    m_dvc->Collapse(m_child1);
+    CHECK( m_dvc->GetSelection() == m_child2 );
+
+    // Selecting an item expands its parent again.
+    m_dvc->Select(m_grandchild);
+    CHECK( m_dvc->GetSelection() == m_grandchild );
+
+    m_dvc->Select(grandchild3);
+    m_dvc->DeleteItem(m_child1);
+    CHECK( m_dvc->GetSelection() == grandchild3 );
+}
+
 TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
                  "wxDVC::DeleteAllItems",
                  "[wxDataViewCtrl][delete]")
@@ -412,4 +449,59 @@ TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
     CHECK( m_lastColumn->GetWidth() >= lastColumnMinWidth );
 }
 
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+TEST_CASE("wxDVC::SortUsingKeys", "[wxDataViewCtrl][sort]")
+{
+    wxDataViewCtrl* const
+        dvc = new wxDataViewCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                                 wxDefaultPosition, wxSize(400, 200));
+
+    wxObjectDataPtr<wxDataViewListStore> store(new wxDataViewListStore);
+    REQUIRE( store->CanCacheSortKeys() );
+
+    store->AppendColumn("string");
+    dvc->AssociateModel(store.get());
+    dvc->AppendTextColumn("Text", 0);
+
+    const char* const strings[] = { "c", "a", "d", "b", "a" };
+    for ( size_t n = 0; n < WXSIZEOF(strings); n++ )
+    {
+        wxVector<wxVariant> values;
+        values.push_back(wxString(strings[n]));
+        store->AppendItem(values);
+    }
+
+    dvc->GetColumn(0)->SetSortOrder(false);
+    dvc->GetModel()->Resort();
+    dvc->Update();
+
+    // The items must be ordered by their values and, for the equal ones, in
+    // the reverse order of their IDs as we sort in descending order.
+    const int order[] = { 2, 0, 3, 4, 1 };
+    for ( size_t n = 1; n < WXSIZEOF(order); n++ )
+    {
+        INFO("Item " << n);
+        CHECK( dvc->GetItemRect(store->GetItem(order[n - 1])).y <
+                dvc->GetItemRect(store->GetItem(order[n])).y );
+    }
+
+    // Changing the value of an item must move it to its new place, even if
+    // it's still in order with respect to its previous sibling.
+    store->ChangeValue(wxString("aa"), store->GetItem(0), 0);
+    dvc->Update();
+
+    const int orderAfterChange[] = { 2, 3, 0, 4, 1 };
+    for ( size_t n = 1; n < WXSIZEOF(orderAfterChange); n++ )
+    {
+        INFO("Item " << n << " after change");
+        CHECK( dvc->GetItemRect(store->GetItem(orderAfterChange[n - 1])).y <
+                dvc->GetItemRect(store->GetItem(orderAfterChange[n])).y );
+    }
+
+    delete dvc;
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
 #endif //wxUSE_DATAVIEWCTRL
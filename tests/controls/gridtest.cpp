@@ -22,9 +22,7 @@
 #include "asserthelper.h"
 #include "wx/uiaction.h"
 
-#ifdef __WXGTK__
-    #include "wx/stopwatch.h"
-#endif // __WXGTK__
+#include "wx/stopwatch.h"
 
 #include "waitforpaint.h"
 
@@ -101,6 +99,9 @@ public:
         return GetCellAttr(row, col);
     }
 
+    int CallGetRowTop(int row) const { return GetRowTop(row); }
+    int CallGetRowBottom(int row) const { return GetRowBottom(row); }
+
     bool HasAttr(int row, int col,
                  wxGridCellAttr::wxAttrKind kind = wxGridCellAttr::Cell) const
     {
@@ -835,6 +836,48 @@ TEST_CASE_METHOD(GridTestCase, "Grid::SelectionRange", "[grid]")
 #endif
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::SelectionLines", "[grid]")
+{
+    CHECK( m_grid->GetSelectedRowLines().empty() );
+
+    m_grid->SelectRow(5);
+    m_grid->SelectRow(1, true);
+    m_grid->SelectBlock(2, 0, 3, 1, true);
+    m_grid->SelectBlock(7, 0, 8, 0, true);
+
+    const wxGridLines lines = m_grid->GetSelectedRowLines();
+    REQUIRE( lines.GetRangesCount() == 2 );
+    CHECK( lines.GetRangeFirst(0) == 1 );
+    CHECK( lines.GetRangeLast(0) == 3 );
+    CHECK( lines.GetRangeFirst(1) == 5 );
+    CHECK( lines.GetRangeLast(1) == 5 );
+    CHECK( lines.size() == 4 );
+
+    wxArrayInt rows;
+    for ( wxGridLines::iterator it = lines.begin(); it != lines.end(); ++it )
+        rows.push_back(*it);
+    CHECK( rows == m_grid->GetSelectedRows() );
+
+    // Check that the selection index is kept up to date when the selection
+    // changes in different ways.
+    CHECK( m_grid->IsInSelection(8, 0) );
+    CHECK( !m_grid->IsInSelection(8, 1) );
+
+    m_grid->DeselectCell(2, 1);
+    CHECK( m_grid->IsInSelection(2, 0) );
+    CHECK( !m_grid->IsInSelection(2, 1) );
+    CHECK( m_grid->IsInSelection(3, 1) );
+
+    m_grid->DeleteRows(0, 2);
+    CHECK( m_grid->IsInSelection(0, 0) );
+    CHECK( !m_grid->IsInSelection(0, 1) );
+    CHECK( m_grid->IsInSelection(3, 1) );
+    CHECK( !m_grid->IsInSelection(4, 0) );
+
+    m_grid->ClearSelection();
+    CHECK( !m_grid->IsInSelection(3, 1) );
+}
+
 TEST_CASE_METHOD(GridTestCase, "Grid::SelectEmptyGrid", "[grid]")
 {
     for ( int i = 0; i < 2; ++i )
@@ -1027,6 +1070,58 @@ TEST_CASE_METHOD(GridTestCase, "Grid::DeleteAndAddRowCol", "[grid]")
     m_grid->AppendRows(5);
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::RowSizes", "[grid]")
+{
+    m_grid->SetDefaultRowSize(20, true);
+
+    m_grid->SetRowSize(2, 30);
+    m_grid->SetRowSize(5, 40);
+    m_grid->HideRow(7);
+
+    CHECK( m_grid->GetRowSize(2) == 30 );
+    CHECK( m_grid->GetRowSize(7) == 0 );
+    CHECK( m_grid->CallGetRowTop(3) == 2*20 + 30 );
+    CHECK( m_grid->CallGetRowBottom(5) == 4*20 + 30 + 40 );
+    CHECK( m_grid->CallGetRowTop(8) == m_grid->CallGetRowBottom(6) );
+
+    CHECK( m_grid->YToRow(2*20 + 29) == 2 );
+    CHECK( m_grid->YToRow(2*20 + 30) == 3 );
+    CHECK( m_grid->YToRow(m_grid->CallGetRowTop(8)) == 8 );
+    CHECK( m_grid->YToRow(m_grid->CallGetRowBottom(9)) == wxNOT_FOUND );
+    CHECK( m_grid->YToRow(m_grid->CallGetRowBottom(9), true) == 9 );
+
+    // Inserted rows get the default size and shift the custom ones.
+    m_grid->InsertRows(1, 2);
+    CHECK( m_grid->GetRowSize(1) == 20 );
+    CHECK( m_grid->GetRowSize(4) == 30 );
+    CHECK( m_grid->GetRowSize(9) == 0 );
+
+    m_grid->DeleteRows(0, 5);
+    CHECK( m_grid->GetRowSize(2) == 40 );
+    CHECK( m_grid->CallGetRowTop(2) == 2*20 );
+
+    m_grid->ShowRow(4);
+    CHECK( m_grid->GetRowSize(4) == 20 );
+
+    // Resetting the size to the default one doesn't change anything.
+    m_grid->SetRowSize(2, 20);
+    const wxGridSizesInfo sizes = m_grid->GetRowSizes();
+    CHECK( sizes.m_sizeDefault == 20 );
+    CHECK( sizes.m_customSizes.empty() );
+
+    m_grid->SetRowSize(1, 50);
+    m_grid->SetDefaultRowSize(25, true);
+    CHECK( m_grid->GetRowSize(1) == 25 );
+
+    wxGridSizesInfo sizesNew;
+    sizesNew.m_sizeDefault = 30;
+    sizesNew.m_customSizes[3] = 60;
+    m_grid->SetRowSizes(sizesNew);
+    CHECK( m_grid->GetRowSize(0) == 30 );
+    CHECK( m_grid->GetRowSize(3) == 60 );
+    CHECK( m_grid->CallGetRowBottom(4) == 4*30 + 60 );
+}
+
 TEST_CASE_METHOD(GridTestCase, "Grid::ColumnOrder", "[grid]")
 {
     SECTION("Default") {}
@@ -1634,6 +1729,26 @@ TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeColumn", "[grid]")
         CheckFirstColAutoSize( wxMax(labelWidth, cellWidth) );
     }
 
+    SECTION("Column measured using sampling")
+    {
+        m_grid->SetAutoSizeSampleSize(1);
+        m_grid->SetColLabelValue(0, wxString());
+        m_grid->SetCellValue(1, 0, shortStr);
+        m_grid->SetCellValue(5, 0, longStr);
+
+        // The cell with the longest value is always measured.
+        const int longWidth =
+            renderer->GetBestWidth(*m_grid, *attr, dcCell, 5, 0,
+                                   m_grid->GetRowHeight(5)) + margin;
+        CheckFirstColAutoSize( longWidth );
+
+        // And the cached size is not used after the value changes.
+        m_grid->SetCellValue(5, 0, mediumStr);
+        CheckFirstColAutoSize(
+            renderer->GetBestWidth(*m_grid, *attr, dcCell, 5, 0,
+                                   m_grid->GetRowHeight(5)) + margin );
+    }
+
     SECTION("Column with auto wrapping contents taller than row")
     {
         // Verify row height remains unchanged with an auto-wrapping multi-line
@@ -1755,6 +1870,230 @@ TEST_CASE_METHOD(GridTestCase, "Grid::CellAttribute", "[attr][cell][grid]")
     }
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::BlockAttribute", "[attr][grid]")
+{
+    wxGridCellAttr *attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxRED);
+    m_grid->SetBlockAttr(2, 0, 5, 0, attr);
+
+    CHECK( m_grid->GetCellBackgroundColour(2, 0) == *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(5, 0) == *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(6, 0) != *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(2, 1) != *wxRED );
+
+    // Cell attributes take precedence over the block ones.
+    m_grid->SetCellBackgroundColour(3, 0, *wxGREEN);
+    CHECK( m_grid->GetCellBackgroundColour(3, 0) == *wxGREEN );
+
+    // And the most recently set block wins if they overlap.
+    attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxBLUE);
+    m_grid->SetBlockAttr(4, 0, 7, 1, attr);
+
+    CHECK( m_grid->GetCellBackgroundColour(2, 0) == *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(5, 0) == *wxBLUE );
+    CHECK( m_grid->GetCellBackgroundColour(7, 1) == *wxBLUE );
+
+    // Blocks are shifted when rows are inserted before them.
+    m_grid->InsertRows(0);
+    CHECK( m_grid->GetCellBackgroundColour(2, 0) != *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(3, 0) == *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(4, 0) == *wxGREEN );
+    CHECK( m_grid->GetCellBackgroundColour(8, 1) == *wxBLUE );
+
+    // And clipped when some of their rows are deleted.
+    m_grid->DeleteRows(0, 5);
+    CHECK( m_grid->GetCellBackgroundColour(0, 0) == *wxBLUE );
+    CHECK( m_grid->GetCellBackgroundColour(3, 1) == *wxBLUE );
+    CHECK( m_grid->GetCellBackgroundColour(4, 1) != *wxBLUE );
+
+    m_grid->SetBlockAttr(0, 0, 3, 1, NULL);
+    CHECK( m_grid->GetCellBackgroundColour(1, 0) == *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(2, 0) != *wxRED );
+
+    // Setting the attribute for the same block again replaces it, so that
+    // resetting it afterwards doesn't restore the previous one.
+    attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxRED);
+    m_grid->SetBlockAttr(4, 1, 5, 1, attr);
+
+    attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxGREEN);
+    m_grid->SetBlockAttr(4, 1, 5, 1, attr);
+    CHECK( m_grid->GetCellBackgroundColour(4, 1) == *wxGREEN );
+
+    m_grid->SetBlockAttr(4, 1, 5, 1, NULL);
+    CHECK( m_grid->GetCellBackgroundColour(4, 1) != *wxGREEN );
+    CHECK( m_grid->GetCellBackgroundColour(5, 1) != *wxRED );
+
+    // Using the same attribute for a cell and a block containing it doesn't
+    // require merging it with itself.
+    attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxRED);
+    attr->IncRef();
+    m_grid->SetBlockAttr(4, 0, 5, 0, attr);
+    m_grid->SetAttr(4, 0, attr);
+
+    wxGridCellAttrPtr
+        cellAttr(m_grid->GetTable()->GetAttr(4, 0, wxGridCellAttr::Any));
+    CHECK( cellAttr.get() == attr );
+}
+
+namespace
+{
+
+// Table returning the values of all cells at once and counting the calls to
+// its GetValue() and GetValues().
+class BulkTable : public wxGridStringTable
+{
+public:
+    BulkTable(int rows, int cols)
+        : wxGridStringTable(rows, cols),
+          m_valueCalls(0),
+          m_valuesCalls(0)
+    {
+    }
+
+    virtual bool IsEmptyCell(int WXUNUSED(row), int WXUNUSED(col)) wxOVERRIDE
+    {
+        // Don't call GetValue() from here, as the base class does.
+        return false;
+    }
+
+    virtual wxString GetValue(int row, int col) wxOVERRIDE
+    {
+        m_valueCalls++;
+
+        return CellCoordsToString(row, col);
+    }
+
+    virtual bool GetValues(const wxGridBlockCoords& block,
+                           wxArrayString& values) wxOVERRIDE
+    {
+        m_valuesCalls++;
+
+        values.clear();
+        for ( int row = block.GetTopRow(); row <= block.GetBottomRow(); row++ )
+        {
+            for ( int col = block.GetLeftCol(); col <= block.GetRightCol(); col++ )
+                values.push_back(CellCoordsToString(row, col));
+        }
+
+        return true;
+    }
+
+    int m_valueCalls,
+        m_valuesCalls;
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(GridTestCase, "Grid::GetValues", "[grid]")
+{
+    SECTION("Default")
+    {
+        wxGridStringTable table(2, 2);
+        table.SetValue(0, 0, "foo");
+
+        wxArrayString values;
+        CHECK( !table.GetValues(wxGridBlockCoords(0, 0, 1, 1), values) );
+        CHECK( values.empty() );
+    }
+
+    SECTION("Overridden")
+    {
+        BulkTable* const table = new BulkTable(10, 2);
+        m_grid->SetTable(table, true);
+
+        WaitForPaint waitForPaint(m_grid->GetGridWindow());
+
+        m_grid->Refresh();
+        m_grid->Update();
+
+        waitForPaint.YieldUntilPainted();
+
+        if ( !table->m_valuesCalls && !table->m_valueCalls )
+        {
+            WARN("Grid cells weren't drawn, skipping test.");
+            return;
+        }
+
+        // All the visible cells form a single block, so their values must
+        // have been retrieved at once.
+        CHECK( table->m_valuesCalls > 0 );
+        CHECK( table->m_valueCalls == 0 );
+
+        // And the values retrieved when drawing are not used after it.
+        CHECK( m_grid->GetCellValue(1, 0) == "R1C2" );
+        CHECK( table->m_valueCalls == 1 );
+    }
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+class AsyncTable : public wxGridAsyncTableBase
+{
+public:
+    AsyncTable() { }
+
+    virtual int GetNumberRows() wxOVERRIDE { return 1000; }
+    virtual int GetNumberCols() wxOVERRIDE { return 2; }
+    virtual void SetValue(int, int, const wxString&) wxOVERRIDE { }
+
+    virtual bool LoadRows(int firstRow, int numRows, int numCols,
+                          wxArrayString& values) wxOVERRIDE
+    {
+        for ( int row = firstRow; row < firstRow + numRows; row++ )
+        {
+            for ( int col = 0; col < numCols; col++ )
+                values.push_back(CellCoordsToString(row, col));
+        }
+
+        return true;
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(GridTestCase, "Grid::AsyncTable", "[grid]")
+{
+    AsyncTable table;
+    table.SetChunkSize(10);
+    table.SetPlaceholderValue("...");
+
+    // Nothing is loaded while the table is not used by any grid.
+    CHECK( table.GetValue(25, 1) == "..." );
+    table.WaitUntilLoaded();
+    CHECK( !table.IsRowAvailable(25) );
+
+    m_grid->SetTable(&table);
+
+    CHECK( !table.IsRowAvailable(25) );
+    CHECK( table.GetValue(25, 1) == "..." );
+
+    table.WaitUntilLoaded();
+
+    REQUIRE( table.IsRowAvailable(25) );
+    CHECK( table.IsRowAvailable(20) );
+    CHECK( table.GetValue(25, 1) == CellCoordsToString(25, 1) );
+
+    table.InvalidateCache();
+    CHECK( !table.IsRowAvailable(25) );
+    CHECK( table.GetValue(29, 0) == "..." );
+
+    // The loaded data belongs to the grid and is destroyed, after stopping
+    // the worker thread, when the grid stops using the table, so that the
+    // table can be safely destroyed afterwards.
+    m_grid->SetTable(NULL);
+    CHECK( !table.IsRowAvailable(29) );
+    CHECK( table.GetValue(29, 0) == "..." );
+}
+
+#endif // wxUSE_THREADS
+
 #define CHECK_MULTICELL() CHECK_THAT( *m_grid, HasMulticellOnly(multi) )
 
 #define CHECK_NO_MULTICELL() CHECK_THAT( *m_grid, HasEmptyGrid() )
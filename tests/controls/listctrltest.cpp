@@ -48,10 +48,12 @@ private:
         WXUISIM_TEST( ColumnClick );
         WXUISIM_TEST( ColumnDrag );
         CPPUNIT_TEST( SubitemRect );
+        CPPUNIT_TEST( SubitemColumns );
     CPPUNIT_TEST_SUITE_END();
 
     void EditLabel();
     void SubitemRect();
+    void SubitemColumns();
 #if wxUSE_UIACTIONSIMULATOR
     // Column events are only supported in wxListCtrl currently so we test them
     // here rather than in ListBaseTest
@@ -139,6 +141,51 @@ void ListCtrlTestCase::SubitemRect()
     CHECK(rectLabel.GetRight() == rectItem.GetRight());
 }
 
+void ListCtrlTestCase::SubitemColumns()
+{
+    m_list->InsertColumn(0, "Column 0");
+    m_list->InsertColumn(1, "Column 1");
+    for ( int i = 0; i < 3; i++ )
+    {
+        long index = m_list->InsertItem(i, wxString::Format("Item %d", i));
+        m_list->SetItem(index, 1, wxString::Format("Subitem %d", i));
+    }
+
+    // Changing the text to a longer or a shorter one shouldn't affect the
+    // other items.
+    m_list->SetItem(1, 1, "Much longer subitem 1");
+    m_list->SetItem(0, 1, "S0");
+    CHECK( m_list->GetItemText(0, 1) == "S0" );
+    CHECK( m_list->GetItemText(1, 1) == "Much longer subitem 1" );
+    CHECK( m_list->GetItemText(2, 1) == "Subitem 2" );
+
+    // Inserting a column must shift the existing subitems.
+    m_list->InsertColumn(1, "Inserted");
+    CHECK( m_list->GetItemText(2, 0) == "Item 2" );
+    CHECK( m_list->GetItemText(2, 1) == "" );
+    CHECK( m_list->GetItemText(2, 2) == "Subitem 2" );
+
+    m_list->SetItem(2, 1, "New 2");
+    m_list->DeleteColumn(0);
+    CHECK( m_list->GetItemText(2, 0) == "New 2" );
+    CHECK( m_list->GetItemText(2, 1) == "Subitem 2" );
+
+    for ( int i = 0; i < 3; i++ )
+        m_list->SetItemData(i, 10 + i);
+
+    // Deleting an item must not affect the data of the other ones.
+    m_list->DeleteItem(0);
+    CHECK( m_list->GetItemCount() == 2 );
+    CHECK( m_list->GetItemText(0, 1) == "Much longer subitem 1" );
+    CHECK( m_list->GetItemData(0) == 11 );
+    CHECK( m_list->GetItemData(1) == 12 );
+
+    // And a new item must not reuse the values of the deleted one.
+    m_list->InsertItem(2, "Item 3");
+    CHECK( m_list->GetItemText(2, 1) == "" );
+    CHECK( m_list->GetItemData(2) == 0 );
+}
+
 #if wxUSE_UIACTIONSIMULATOR
 void ListCtrlTestCase::ColumnDrag()
 {
@@ -57,6 +57,7 @@ private:
         CPPUNIT_TEST( Focus );
         CPPUNIT_TEST( Bold );
         CPPUNIT_TEST( Visible );
+        CPPUNIT_TEST( ItemRect );
         CPPUNIT_TEST( Sort );
         WXUISIM_TEST( KeyNavigation );
         CPPUNIT_TEST( HasChildren );
@@ -85,6 +86,7 @@ private:
     void Focus();
     void Bold();
     void Visible();
+    void ItemRect();
     void Sort();
     void KeyNavigation();
     void HasChildren();
@@ -596,6 +598,43 @@ void TreeCtrlTestCase::Visible()
     CPPUNIT_ASSERT(!m_tree->GetPrevVisible(m_root));
 }
 
+void TreeCtrlTestCase::ItemRect()
+{
+    wxRect rect1, rectGrand, rect2;
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_child1, rect1, true) );
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_grandchild, rectGrand, true) );
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_child2, rect2, true) );
+
+    CPPUNIT_ASSERT( rect1.y < rectGrand.y );
+    CPPUNIT_ASSERT( rectGrand.y < rect2.y );
+    CPPUNIT_ASSERT( rect1.x < rectGrand.x );
+    CPPUNIT_ASSERT_EQUAL( rect1.x, rect2.x );
+
+    int flags;
+    CPPUNIT_ASSERT_EQUAL( m_child2,
+                          m_tree->HitTest(wxPoint(rect2.x + rect2.width/2,
+                                                  rect2.y + rect2.height/2),
+                                          flags) );
+
+    // collapsing an item must move all the items below it up
+    m_tree->Collapse(m_child1);
+
+    wxRect rect;
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_child2, rect, true) );
+    CPPUNIT_ASSERT_EQUAL( rectGrand.y, rect.y );
+    CPPUNIT_ASSERT_EQUAL( m_child2,
+                          m_tree->HitTest(wxPoint(rect.x + rect.width/2,
+                                                  rect.y + rect.height/2),
+                                          flags) );
+
+    // and inserting one must move them down
+    m_tree->Expand(m_child1);
+    m_tree->AppendItem(m_child1, "grandchild2");
+
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_child2, rect, true) );
+    CPPUNIT_ASSERT_EQUAL( rect2.y + rect2.y - rectGrand.y, rect.y );
+}
+
 void TreeCtrlTestCase::Sort()
 {
     wxTreeItemId zitem = m_tree->AppendItem(m_root, "zzzz");
@@ -13,7 +13,12 @@
 #include "testprec.h"
 
 
+#include "wx/app.h"
 #include "wx/event.h"
+#include "wx/evtprofiler.h"
+#include "wx/thread.h"
+#include "wx/timer.h"
+#include "wx/vector.h"
 
 // ----------------------------------------------------------------------------
 // test events and their handlers
@@ -507,6 +512,371 @@ TEST_CASE("Event::UnbindFromHandler", "[event][bind][unbind]")
     handler.ProcessEvent(e);
 }
 
+// Helper for BindManyTypes() test.
+struct EventTypesRecorder
+{
+    void OnEvent(wxThreadEvent& e)
+    {
+        types.push_back(e.GetEventType());
+        e.Skip();
+    }
+
+    wxVector<wxEventType> types;
+};
+
+TEST_CASE("Event::BindManyTypes", "[event][bind][unbind]")
+{
+    wxEvtHandler handler;
+    EventTypesRecorder recorder;
+
+    wxVector<wxEventType> types;
+    for ( int n = 0; n < 100; n++ )
+    {
+        types.push_back(wxNewEventType());
+        handler.Bind(wxEventTypeTag<wxThreadEvent>(types[n]),
+                     &EventTypesRecorder::OnEvent, &recorder);
+    }
+
+    for ( int n = 0; n < 100; n += 2 )
+    {
+        CHECK( handler.Unbind(wxEventTypeTag<wxThreadEvent>(types[n]),
+                              &EventTypesRecorder::OnEvent, &recorder) );
+    }
+
+    for ( int n = 0; n < 100; n++ )
+    {
+        wxThreadEvent e(types[n]);
+        handler.ProcessEvent(e);
+    }
+
+    REQUIRE( recorder.types.size() == 50 );
+    for ( int n = 0; n < 50; n++ )
+        CHECK( recorder.types[n] == types[2*n + 1] );
+
+    // unbound handlers must remain unbound after pruning them
+    wxThreadEvent e(types[0]);
+    handler.ProcessEvent(e);
+    CHECK( recorder.types.size() == 50 );
+}
+
+#if wxUSE_STOPWATCH && wxUSE_LONGLONG
+
+TEST_CASE("Event::Profiler", "[event][profiler]")
+{
+    wxEventProfiler profiler;
+    REQUIRE( profiler.Start() );
+
+    wxEventProfiler other;
+    CHECK( !other.Start() );
+
+    MyClassWithEventTable handler;
+    MySink sink;
+    handler.Bind(wxEVT_IDLE, &MySink::OnIdle, &sink);
+    handler.Bind(wxEVT_THREAD, &MySink::OnEvent, &sink);
+
+    // this is handled by the dynamic handler which doesn't skip the event,
+    // so the static one is not called at all
+    wxIdleEvent eIdle;
+    handler.ProcessEvent(eIdle);
+
+    handler.Unbind(wxEVT_IDLE, &MySink::OnIdle, &sink);
+    handler.ProcessEvent(eIdle);
+
+    for ( int n = 0; n < 3; n++ )
+    {
+        wxThreadEvent eThread;
+        handler.ProcessEvent(eThread);
+    }
+
+    profiler.Stop();
+
+    wxThreadEvent eThread;
+    handler.ProcessEvent(eThread);
+
+    const wxVector<wxEventHandlerStats> stats = profiler.GetStats();
+    REQUIRE( stats.size() == 3 );
+
+    int numDynamic = 0;
+    for ( size_t n = 0; n < stats.size(); n++ )
+    {
+        const wxEventHandlerStats& s = stats[n];
+        INFO( s.GetDescription() );
+
+        CHECK( s.GetHandlerClassName() == "wxEvtHandler" );
+        CHECK( s.GetPercentile(50) <= s.GetMaxTime() );
+        CHECK( s.GetMaxTime() <= s.GetTotalTime() );
+
+        if ( n )
+            CHECK( stats[n - 1].GetTotalTime() >= s.GetTotalTime() );
+
+        if ( s.GetEventType() == wxEVT_THREAD )
+        {
+            CHECK( s.IsDynamic() );
+            CHECK( s.GetEventClassName() == "wxThreadEvent" );
+            CHECK( s.GetCount() == 3 );
+        }
+        else
+        {
+            CHECK( s.GetEventType() == wxEVT_IDLE );
+            CHECK( s.GetEventClassName() == "wxIdleEvent" );
+            CHECK( s.GetCount() == 1 );
+        }
+
+        if ( s.IsDynamic() )
+            numDynamic++;
+    }
+
+    CHECK( numDynamic == 2 );
+
+    const wxString trace = profiler.GetChromeTrace();
+    CHECK( trace.StartsWith("{\"traceEvents\":[") );
+    CHECK( trace.Freq('{') == 6 );
+
+    profiler.Reset();
+    CHECK( profiler.GetStats().empty() );
+
+    CHECK( other.Start() );
+}
+
+#endif // wxUSE_STOPWATCH && wxUSE_LONGLONG
+
+namespace
+{
+
+// Remember the values of the thread events processed by the handler.
+struct CoalescedEventsRecorder
+{
+    void OnThreadEvent(wxThreadEvent& event)
+    {
+        values.push_back(event.GetInt());
+
+        wxEventLoopBase* const loop = wxEventLoopBase::GetActive();
+        if ( loop && event.GetInt() == exitOn )
+            loop->ScheduleExit();
+    }
+
+    // Return the position of the given value or -1 if it wasn't received.
+    int Find(int value) const
+    {
+        for ( size_t n = 0; n < values.size(); n++ )
+        {
+            if ( values[n] == value )
+                return n;
+        }
+
+        return -1;
+    }
+
+    wxVector<int> values;
+    int exitOn;
+};
+
+wxThreadEvent* NewThreadEvent(int value)
+{
+    wxThreadEvent* const event = new wxThreadEvent;
+    event->SetInt(value);
+    return event;
+}
+
+class ExitLoopTimer : public wxTimer
+{
+public:
+    explicit ExitLoopTimer(wxEventLoopBase& loop) : m_loop(loop) { }
+
+    virtual void Notify() wxOVERRIDE { m_loop.ScheduleExit(); }
+
+private:
+    wxEventLoopBase& m_loop;
+};
+
+} // anonymous namespace
+
+TEST_CASE("Event::QueueCoalesced", "[event][queue]")
+{
+    wxEvtHandler handler;
+    CoalescedEventsRecorder recorder;
+    recorder.exitOn = 0;
+    handler.Bind(wxEVT_THREAD, &CoalescedEventsRecorder::OnThreadEvent, &recorder);
+
+    SECTION("Replace")
+    {
+        handler.QueueCoalescedEvent(NewThreadEvent(1), 1);
+        handler.QueueEvent(NewThreadEvent(10));
+        handler.QueueCoalescedEvent(NewThreadEvent(2), 1);
+        handler.QueueCoalescedEvent(NewThreadEvent(20), 2);
+        handler.QueueCoalescedEvent(NewThreadEvent(3), 1);
+
+        wxTheApp->ProcessPendingEvents();
+
+        REQUIRE( recorder.values.size() == 3 );
+        CHECK( recorder.values[0] == 3 );
+        CHECK( recorder.values[1] == 10 );
+        CHECK( recorder.values[2] == 20 );
+
+        // once the event was processed, the next one is queued again
+        handler.QueueCoalescedEvent(NewThreadEvent(4), 1);
+        wxTheApp->ProcessPendingEvents();
+
+        REQUIRE( recorder.values.size() == 4 );
+        CHECK( recorder.values[3] == 4 );
+    }
+
+#if wxUSE_TIMER && wxUSE_STOPWATCH
+    SECTION("Interval")
+    {
+        wxStopWatch sw;
+
+        handler.QueueCoalescedEvent(NewThreadEvent(1), 1, 100);
+        wxTheApp->ProcessPendingEvents();
+        REQUIRE( recorder.values.size() == 1 );
+
+        handler.QueueCoalescedEvent(NewThreadEvent(2), 1, 100);
+        wxTheApp->ProcessPendingEvents();
+
+        handler.QueueCoalescedEvent(NewThreadEvent(3), 1, 100);
+        wxTheApp->ProcessPendingEvents();
+
+        // the next events are postponed until the interval expires, but we
+        // can only check it if it really didn't expire yet, as the test may
+        // be arbitrarily delayed
+        if ( sw.Time() < 100 )
+            CHECK( recorder.values.size() == 1 );
+
+        // the other events are not affected in any case
+        handler.QueueCoalescedEvent(NewThreadEvent(10), 2);
+        wxTheApp->ProcessPendingEvents();
+        CHECK( recorder.values.back() == 10 );
+
+        // run the event loop until the last event is processed, but not for
+        // too long in case it isn't
+        if ( recorder.Find(3) == -1 )
+        {
+            wxEventLoop loop;
+            ExitLoopTimer timerExit(loop);
+            timerExit.StartOnce(5000);
+
+            recorder.exitOn = 3;
+            loop.Run();
+        }
+
+        // whatever the timing, the events with the same key must have been
+        // processed in order and the last one of them must not be lost
+        CHECK( recorder.values[0] == 1 );
+        CHECK( recorder.Find(3) != -1 );
+        CHECK( recorder.Find(2) < recorder.Find(3) );
+        CHECK( recorder.Find(10) != -1 );
+    }
+#endif // wxUSE_TIMER && wxUSE_STOPWATCH
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Thread queuing the given number of events numbered from 0 to the handler.
+class QueuingThread : public wxThread
+{
+public:
+    QueuingThread(wxEvtHandler& handler, int id, int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_handler(handler),
+          m_id(id),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        for ( int n = 0; n < m_count; n++ )
+        {
+            wxThreadEvent* const event = new wxThreadEvent(wxEVT_THREAD, m_id);
+            event->SetInt(n);
+            m_handler.QueueEvent(event);
+        }
+
+        return 0;
+    }
+
+private:
+    wxEvtHandler& m_handler;
+    const int m_id;
+    const int m_count;
+};
+
+// Check that the events from each thread are received in order.
+struct QueuedEventsChecker
+{
+    explicit QueuedEventsChecker(int numThreads)
+        : next(numThreads, 0), total(0), outOfOrder(0)
+    {
+    }
+
+    void OnThreadEvent(wxThreadEvent& event)
+    {
+        int& expected = next[event.GetId()];
+        if ( event.GetInt() != expected )
+            outOfOrder++;
+
+        expected = event.GetInt() + 1;
+        total++;
+    }
+
+    wxVector<int> next;
+    int total;
+    int outOfOrder;
+};
+
+} // anonymous namespace
+
+TEST_CASE("Event::QueueFromThreads", "[event][queue][thread]")
+{
+    const int NUM_THREADS = 4;
+    const int NUM_EVENTS = 1000;
+
+    wxEvtHandler handler;
+    QueuedEventsChecker checker(NUM_THREADS);
+    handler.Bind(wxEVT_THREAD, &QueuedEventsChecker::OnThreadEvent, &checker);
+
+    wxVector<QueuingThread*> threads;
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        threads.push_back(new QueuingThread(handler, n, NUM_EVENTS));
+        REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    // process the events while they're being queued
+    for ( ;; )
+    {
+        wxTheApp->ProcessPendingEvents();
+
+        bool anyAlive = false;
+        for ( int n = 0; n < NUM_THREADS; n++ )
+        {
+            if ( threads[n]->IsAlive() )
+                anyAlive = true;
+        }
+
+        if ( !anyAlive && !wxTheApp->HasPendingEvents() )
+            break;
+    }
+
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    CHECK( checker.total == NUM_THREADS*NUM_EVENTS );
+    CHECK( checker.outOfOrder == 0 );
+
+    // the handler must not remain in the list of pending handlers
+    CHECK( !wxTheApp->HasPendingEvents() );
+}
+
+#endif // wxUSE_THREADS
+
 // This is a compilation-time-only test: just check that a class inheriting
 // from wxEvtHandler non-publicly can use Bind() with its method, this used to
 // result in compilation errors.
@@ -20,6 +20,7 @@
 #endif // WX_PRECOMP
 
 #include "wx/anidecod.h" // wxImageArray
+#include "wx/gifdecod.h"
 #include "wx/bitmap.h"
 #include "wx/palette.h"
 #include "wx/url.h"
@@ -1953,6 +1954,83 @@ TEST_CASE("wxImage::Paste", "[image][paste]")
 
 }
 
+#if wxUSE_GIF && wxUSE_PALETTE
+
+TEST_CASE("wxImage::GIFFrameCache", "[image][gif]")
+{
+    wxImage image("horse.gif");
+    REQUIRE( image.IsOk() );
+
+    wxImageArray images;
+    images.Add(image);
+    for ( int i = 1; i < 8; ++i )
+    {
+        images.Add( i % 2 ? images[i-1].Rotate90() : images[i-1].Mirror() );
+
+        images[i].SetPalette(images[0].GetPalette());
+    }
+
+    wxMemoryOutputStream memOut;
+    REQUIRE( wxGIFHandler().SaveAnimation(images, &memOut) );
+
+    // decode all frames using the default cache, which is big enough to keep
+    // all of them, to have something to compare with
+    wxMemoryInputStream memInRef(memOut);
+    wxGIFDecoder decoderRef;
+    REQUIRE( decoderRef.Load(memInRef) );
+
+    const unsigned int count = decoderRef.GetFrameCount();
+    REQUIRE( count == images.size() );
+
+    wxImageArray frames;
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        REQUIRE( decoderRef.ConvertToImage(i, &image) );
+        frames.Add(image);
+    }
+
+    // access the frames in reverse and then in random order, twice each
+    wxVector<unsigned int> orderReverse,
+                           orderRandom;
+    for ( unsigned int i = 0; i < count; ++i )
+        orderReverse.push_back(count - 1 - i);
+
+    srand(1234);
+    orderRandom = orderReverse;
+    for ( unsigned int i = count - 1; i > 0; --i )
+        wxSwap(orderRandom[i], orderRandom[rand() % (i + 1)]);
+
+    // with these cache sizes only the last used frame is kept, so all the
+    // other ones must be decoded again every time
+    const size_t cacheSizes[] = { 0, 1 };
+    for ( size_t n = 0; n < WXSIZEOF(cacheSizes); ++n )
+    {
+        wxMemoryInputStream memIn(memOut);
+        wxGIFDecoder decoder;
+        decoder.SetCacheSize(cacheSizes[n]);
+        REQUIRE( decoder.Load(memIn) );
+        REQUIRE( decoder.GetFrameCount() == count );
+
+        for ( int pass = 0; pass < 4; ++pass )
+        {
+            const wxVector<unsigned int>&
+                order = pass < 2 ? orderReverse : orderRandom;
+
+            for ( unsigned int k = 0; k < count; ++k )
+            {
+                const unsigned int i = order[k];
+
+                INFO("Cache size " << cacheSizes[n] << ", pass " << pass
+                        << ", frame " << i);
+                REQUIRE( decoder.ConvertToImage(i, &image) );
+                CHECK_THAT( image, RGBSameAs(frames[i]) );
+            }
+        }
+    }
+}
+
+#endif // wxUSE_GIF && wxUSE_PALETTE
+
 TEST_CASE("wxImage::RGBtoHSV", "[image][rgb][hsv]")
 {
     SECTION("RGB(0,0,0) (Black) to HSV")
@@ -2164,6 +2242,102 @@ TEST_CASE("wxImage::InitAlpha", "[image][initalpha]")
     }
 }
 
+TEST_CASE("wxImage::Histogram", "[image][histogram]")
+{
+    // an image with runs of the same colour and a few colours appearing in
+    // several runs
+    wxImage img(10, 10);
+    img.SetRGB(wxRect(0, 0, 10, 10), 1, 0, 0);
+    img.SetRGB(wxRect(0, 2, 10, 3), 2, 0, 0);
+    img.SetRGB(wxRect(3, 0, 1, 10), 3, 0, 0);
+    img.SetRGB(9, 9, 255, 255, 255);
+
+    wxImageHistogram h;
+    REQUIRE( img.ComputeHistogram(h) == 4 );
+    CHECK( h.size() == 4 );
+
+    CHECK( h[wxImageHistogram::MakeKey(1, 0, 0)].value == 62 );
+    CHECK( h[wxImageHistogram::MakeKey(1, 0, 0)].index == 0 );
+    CHECK( h[wxImageHistogram::MakeKey(3, 0, 0)].value == 10 );
+    CHECK( h[wxImageHistogram::MakeKey(3, 0, 0)].index == 1 );
+    CHECK( h[wxImageHistogram::MakeKey(2, 0, 0)].value == 27 );
+    CHECK( h[wxImageHistogram::MakeKey(2, 0, 0)].index == 2 );
+    CHECK( h[wxImageHistogram::MakeKey(255, 255, 255)].value == 1 );
+    CHECK( h[wxImageHistogram::MakeKey(255, 255, 255)].index == 3 );
+
+    CHECK( img.CountColours() == 4 );
+    CHECK( img.CountColours(2) == 3 );
+
+    unsigned char r, g, b;
+    REQUIRE( img.FindFirstUnusedColour(&r, &g, &b) );
+    CHECK( r == 4 );
+    CHECK( g == 0 );
+    CHECK( b == 0 );
+
+    REQUIRE( img.FindFirstUnusedColour(&r, &g, &b, 0, 0, 0) );
+    CHECK( r == 0 );
+
+    // big images use a different algorithm, check that it gives the same
+    // results
+    img.Rescale(300, 300);
+    CHECK( img.CountColours() == 4 );
+    CHECK( img.CountColours(2) == 3 );
+
+    REQUIRE( img.FindFirstUnusedColour(&r, &g, &b) );
+    CHECK( r == 4 );
+    CHECK( g == 0 );
+    CHECK( b == 0 );
+}
+
+TEST_CASE("wxImage::PackedPixels", "[image][packed]")
+{
+    wxImage img(3, 2);
+    img.SetRGB(0, 0, 10, 20, 30);
+    img.SetRGB(2, 1, 200, 100, 50);
+
+    // without alpha all pixels are opaque
+    unsigned char buf[6*4];
+    REQUIRE( img.GetPackedPixels(buf) );
+    CHECK( buf[0] == 10 );
+    CHECK( buf[1] == 20 );
+    CHECK( buf[2] == 30 );
+    CHECK( buf[3] == wxIMAGE_ALPHA_OPAQUE );
+    CHECK( buf[5*4 + 0] == 200 );
+    CHECK( buf[5*4 + 3] == wxIMAGE_ALPHA_OPAQUE );
+
+    img.InitAlpha();
+    img.SetAlpha(2, 1, 128);
+
+    // use padded rows to extract just the last column
+    unsigned char col[2*8];
+    REQUIRE( img.GetPackedPixels(col, 8, wxIMAGE_PACKED_RGBA,
+                                 wxRect(2, 0, 1, 2)) );
+    CHECK( col[8 + 0] == 200 );
+    CHECK( col[8 + 3] == 128 );
+
+    wxUint32 argb[6];
+    REQUIRE( img.GetPackedPixels(reinterpret_cast<unsigned char*>(argb), 0,
+                                 wxIMAGE_PACKED_ARGB32_PREMULTIPLIED) );
+    CHECK( argb[0] == 0xff0a141eu );
+    CHECK( argb[5] == 0x80643219u );
+
+    // setting the pixels back preserves them, up to the rounding errors due
+    // to premultiplication
+    wxImage img2(3, 2);
+    img2.InitAlpha();
+    REQUIRE( img2.SetPackedPixels(buf) );
+    CHECK( img2.GetRed(2, 1) == 200 );
+    CHECK( img2.GetAlpha(2, 1) == wxIMAGE_ALPHA_OPAQUE );
+
+    REQUIRE( img2.SetPackedPixels(reinterpret_cast<unsigned char*>(argb), 0,
+                                  wxIMAGE_PACKED_ARGB32_PREMULTIPLIED) );
+    CHECK( img2.GetRed(0, 0) == 10 );
+    CHECK( img2.GetAlpha(2, 1) == 128 );
+    CHECK( img2.GetRed(2, 1) == 199 );
+    CHECK( img2.GetGreen(2, 1) == 99 );
+    CHECK( img2.GetBlue(2, 1) == 49 );
+}
+
 /*
     TODO: add lots of more tests to wxImage functions
 */
@@ -1506,3 +1506,58 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     CHECK( wxConvUTF7.cMB2WC(wxCharBuffer()).length() == 0 );
     CHECK( wxConvUTF7.cMB2WC("+AKM-").length() == 1 );
 }
+
+TEST_CASE("wxMBConvUTF8::ASCIIRuns", "[mbconv][utf8]")
+{
+    static const int options[] =
+    {
+        wxMBConvUTF8::MAP_INVALID_UTF8_NOT,
+        wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA,
+        wxMBConvUTF8::MAP_INVALID_UTF8_TO_OCTAL,
+    };
+
+    // Put a non-ASCII character at all positions in a string long enough to
+    // contain several machine words to check that the runs of ASCII characters
+    // before and after it are converted correctly.
+    const wxString ascii("The quick brown fox jumps over the lazy dog");
+    for ( size_t pos = 0; pos <= ascii.length(); pos++ )
+    {
+        wxString s(ascii);
+        s.insert(pos, wxString::FromUTF8("\xc3\xa9"));
+
+        const wxScopedCharBuffer utf8 = s.utf8_str();
+        REQUIRE( utf8.length() == ascii.length() + 2 );
+
+        for ( size_t n = 0; n < WXSIZEOF(options); n++ )
+        {
+            wxMBConvUTF8 conv(options[n]);
+            INFO("Option " << options[n] << ", position " << pos);
+
+            CHECK( wxString(utf8, conv) == s );
+            CHECK( strcmp(s.mb_str(conv), utf8) == 0 );
+
+            // Check that the lengths are computed correctly too.
+            CHECK( conv.ToWChar(NULL, 0, utf8) == s.length() + 1 );
+            CHECK( conv.ToWChar(NULL, 0, utf8, utf8.length()) == s.length() );
+            CHECK( conv.FromWChar(NULL, 0, s.wc_str()) == utf8.length() + 1 );
+        }
+
+        // Also check that the strict conversion fails if the output buffer is
+        // too small, wherever it ends (notice that 0 size is special, as it
+        // means that only the length is computed).
+        if ( pos )
+        {
+            wchar_t wbuf[64];
+            CHECK( wxConvUTF8.ToWChar(wbuf, pos, utf8, utf8.length()) == wxCONV_FAILED );
+
+            char buf[64];
+            CHECK( wxConvUTF8.FromWChar(buf, pos, s.wc_str(), s.length()) == wxCONV_FAILED );
+        }
+    }
+
+    // Invalid sequences after a run of ASCII characters must still be detected.
+    const char* const invalid = "Lorem ipsum dolor sit amet\xc2, consectetur";
+    CHECK( wxConvUTF8.ToWChar(NULL, 0, invalid) == wxCONV_FAILED );
+    CHECK( wxString(invalid, wxMBConvUTF8(wxMBConvUTF8::MAP_INVALID_UTF8_TO_OCTAL))
+            == "Lorem ipsum dolor sit amet\\302, consectetur" );
+}
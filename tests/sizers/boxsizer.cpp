@@ -17,11 +17,13 @@
     #include "wx/app.h"
     #include "wx/sizer.h"
     #include "wx/listbox.h"
+    #include "wx/statbox.h"
 #endif // WX_PRECOMP
 
 #include "asserthelper.h"
 
 #include "wx/scopedptr.h"
+#include "wx/wupdlock.h"
 
 // ----------------------------------------------------------------------------
 // test fixture
@@ -286,6 +288,124 @@ TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::SetMinSize", "[sizer]")
     CHECK(m_sizer->GetMinSize().x == 100);
 }
 
+TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::CachedMinSize", "[sizer]")
+{
+    // Use a nested sizer filling the entire window, so that its size doesn't
+    // change when the items inside it do.
+    wxSizer* const sizer = new wxBoxSizer(wxVERTICAL);
+    m_sizer->Add(sizer, wxSizerFlags(1).Expand());
+
+    wxWindow* const child1 = new wxWindow(m_win, wxID_ANY);
+    child1->SetInitialSize(wxSize(30, 10));
+    sizer->Add(child1);
+
+    wxWindow* const child2 = new wxWindow(m_win, wxID_ANY);
+    child2->SetInitialSize(wxSize(50, 10));
+    sizer->Add(child2);
+
+    CHECK( m_sizer->GetMinSize() == wxSize(50, 20) );
+
+    m_win->Layout();
+    CHECK( child2->GetPosition().y == 10 );
+
+    // Changing the minimal size of a window must be taken into account by all
+    // the sizers containing it and the nested sizer must be laid out again.
+    child1->SetMinSize(wxSize(30, 15));
+    CHECK( m_sizer->GetMinSize() == wxSize(50, 25) );
+
+    m_win->Layout();
+    CHECK( child2->GetPosition().y == 15 );
+
+    // Same for hiding a window.
+    child1->Hide();
+    CHECK( m_sizer->GetMinSize() == wxSize(50, 10) );
+
+    m_win->Layout();
+    CHECK( child2->GetPosition().y == 0 );
+
+    child1->Show();
+    CHECK( m_sizer->GetMinSize() == wxSize(50, 25) );
+
+    // And for changing the item properties.
+    sizer->GetItem(child1)->SetFlag(wxTOP);
+    sizer->GetItem(child1)->SetBorder(5);
+    CHECK( m_sizer->GetMinSize() == wxSize(50, 30) );
+
+    m_win->Layout();
+    CHECK( child2->GetPosition().y == 20 );
+
+    // And for removing an item from the nested sizer.
+    sizer->Detach(child1);
+    CHECK( m_sizer->GetMinSize() == wxSize(50, 10) );
+
+    m_win->Layout();
+    CHECK( child2->GetPosition().y == 0 );
+
+    CHECK( sizer->GetContainingItem() == m_sizer->GetItem(sizer) );
+    CHECK( sizer->GetItem(child2)->GetContainingSizer() == sizer );
+}
+
+TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::CustomCalcMin", "[sizer]")
+{
+    // A custom sizer whose minimal size depends on its own parameter and
+    // which doesn't call InvalidateMinSize() when it changes.
+    class FixedSizer : public wxBoxSizer
+    {
+    public:
+        FixedSizer() : wxBoxSizer(wxVERTICAL), m_width(20) { }
+
+        virtual wxSize CalcMin() wxOVERRIDE { return wxSize(m_width, 10); }
+
+        int m_width;
+    };
+
+    FixedSizer* const sizer = new FixedSizer();
+    m_sizer->Add(sizer);
+
+    wxWindow* const child = new wxWindow(m_win, wxID_ANY);
+    child->SetInitialSize(wxSize(30, 10));
+    m_sizer->Add(child);
+
+    m_win->Layout();
+    CHECK( child->GetPosition().x == 20 );
+
+    // The change must be taken into account during the next layout.
+    sizer->m_width = 40;
+    CHECK( m_sizer->GetMinSize() == wxSize(70, 10) );
+
+    m_win->Layout();
+    CHECK( child->GetPosition().x == 40 );
+}
+
+#if wxUSE_STATBOX
+TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::NestedStaticBox", "[sizer]")
+{
+    wxStaticBoxSizer* const sizer =
+        new wxStaticBoxSizer(wxVERTICAL, m_win, "Box");
+    m_sizer->Add(sizer);
+
+    wxWindow* const child = new wxWindow(m_win, wxID_ANY);
+    child->SetInitialSize(wxSize(10, 10));
+    m_sizer->Add(child);
+
+    m_win->Layout();
+
+    wxStaticBox* const box = sizer->GetStaticBox();
+    const int widthOld = box->GetBestSize().x;
+
+    // Changing the label must update the best size of the box and so the
+    // minimal size of the sizer containing it.
+    box->SetLabel("A much longer label than the original one");
+
+    const int widthNew = box->GetBestSize().x;
+    CHECK( widthNew > widthOld );
+    CHECK( m_sizer->GetMinSize().x >= widthNew + 10 );
+
+    m_win->Layout();
+    CHECK( child->GetPosition().x >= widthNew );
+}
+#endif // wxUSE_STATBOX
+
 #if wxUSE_LISTBOX
 TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::BestSizeRespectsMaxSize", "[sizer]")
 {
@@ -447,3 +567,47 @@ TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::Replace", "[sizer]")
     m_sizer->AddSpacer(1);
     m_sizer->Replace(0, new wxSizerItem(new wxWindow(m_win, wxID_ANY)));
 }
+
+TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::LayoutTransaction", "[sizer]")
+{
+    wxWindow * const child = new wxWindow(m_win, wxID_ANY);
+    m_sizer->Add(child, wxSizerFlags(1).Expand());
+
+    {
+        wxLayoutTransaction deferLayout(m_win);
+        CHECK( m_win->IsInLayoutTransaction() );
+        CHECK( child->IsInLayoutTransaction() );
+
+        // The layout is only done at the end of the transaction.
+        m_win->Layout();
+        m_win->Layout();
+        CHECK( child->GetSize() != m_win->GetClientSize() );
+
+        // Nested transactions are allowed too.
+        m_win->BeginLayoutTransaction();
+        m_win->Layout();
+        m_win->CommitLayoutTransaction();
+        CHECK( m_win->IsInLayoutTransaction() );
+        CHECK( child->GetSize() != m_win->GetClientSize() );
+    }
+
+    CHECK( !m_win->IsInLayoutTransaction() );
+    CHECK( child->GetSize() == m_win->GetClientSize() );
+
+    // Explicit layout is still done immediately when the window is frozen.
+    child->SetSize(1, 1);
+    {
+        wxWindowUpdateLocker noUpdates(m_win);
+        m_win->Layout();
+        CHECK( child->GetSize() == m_win->GetClientSize() );
+    }
+
+    // And destroying a window whose layout is deferred is safe.
+    wxWindow * const other = new wxWindow(m_win, wxID_ANY);
+    other->SetSizer(new wxBoxSizer(wxVERTICAL));
+    {
+        wxLayoutTransaction deferLayout(m_win);
+        other->Layout();
+        delete other;
+    }
+}
@@ -141,6 +141,51 @@ wxString fileStream::GetInFileName() const
     return FILENAME_FILEINSTREAM;
 }
 
+TEST_CASE("wxMappedFileInputStream", "[stream][file]")
+{
+    const wxString filename = wxT("mappedinstream.test");
+
+    char buf[DATABUFFER_SIZE];
+    for ( size_t i = 0; i < DATABUFFER_SIZE; i++ )
+        buf[i] = (i % 0xFF);
+
+    {
+        wxFileOutputStream out(filename);
+        out.Write(buf, DATABUFFER_SIZE);
+    }
+
+    {
+        wxMappedFileInputStream in(filename);
+        REQUIRE( in.IsOk() );
+        CHECK( in.GetLength() == DATABUFFER_SIZE );
+
+        char data[100];
+        CHECK( in.Read(data, sizeof(data)).LastRead() == sizeof(data) );
+        CHECK( memcmp(data, buf, sizeof(data)) == 0 );
+        CHECK( in.TellI() == 100 );
+
+        size_t size;
+        const char *p = static_cast<const char *>(in.PeekContiguous(&size));
+#ifdef __UNIX__
+        CHECK( in.IsMapped() );
+        REQUIRE( p );
+        CHECK( size == DATABUFFER_SIZE - 100 );
+        CHECK( memcmp(p, buf + 100, size) == 0 );
+#else
+        CHECK( !p );
+#endif
+
+        CHECK( in.SeekI(-10, wxFromEnd) == DATABUFFER_SIZE - 10 );
+        CHECK( in.Read(data, sizeof(data)).LastRead() == 10 );
+        CHECK( memcmp(data, buf + DATABUFFER_SIZE - 10, 10) == 0 );
+
+        CHECK( in.Read(data, sizeof(data)).LastRead() == 0 );
+        CHECK( in.Eof() );
+    }
+
+    wxRemoveFile(filename);
+}
+
 // Register the stream sub suite, by using some stream helper macro.
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(fileStream)
@@ -153,6 +153,31 @@ void memStream::Ctor_InFromOut()
     delete pMemOutStream;
 }
 
+TEST_CASE("wxMemoryInputStream::PeekContiguous", "[stream][memory]")
+{
+    const char data[] = "0123456789";
+    wxMemoryInputStream in(data, 10);
+
+    size_t size;
+    CHECK( in.PeekContiguous(&size) == data );
+    CHECK( size == 10 );
+
+    CHECK( in.SeekI(4, wxFromCurrent) == 4 );
+    CHECK( in.PeekContiguous(&size) == data + 4 );
+    CHECK( size == 6 );
+
+    // data written back isn't contiguous with the stream data
+    in.Ungetch('x');
+    CHECK( !in.PeekContiguous(&size) );
+    CHECK( in.GetC() == 'x' );
+    CHECK( in.PeekContiguous(&size) == data + 4 );
+
+    wxMemoryOutputStream out;
+    in.Read(out);
+    CHECK( out.GetLength() == 6 );
+    CHECK( in.Eof() );
+}
+
 // Register the stream sub suite, by using some stream helper macro.
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(memStream)
@@ -17,6 +17,8 @@
     #include "wx/wx.h"
 #endif // WX_PRECOMP
 
+#include "wx/vector.h"
+
 // ----------------------------------------------------------------------------
 // test class
 // ----------------------------------------------------------------------------
@@ -1315,3 +1317,138 @@ void StringTestCase::SupplementaryUniChar()
     */
 #endif
 }
+
+namespace
+{
+
+// check that all the characters of the string can be accessed by index in
+// non-sequential order and found where they are expected to be
+void CheckIndexedAccess(const wxString& s, const wxVector<wxUniChar>& chars)
+{
+    const size_t len = chars.size();
+    REQUIRE( s.length() == len );
+
+    for ( size_t n = len; n > 0; n-- )
+        CHECK( s[n - 1] == chars[n - 1] );
+
+    for ( size_t n = 0; n < len; n++ )
+    {
+        const size_t pos = (n * 7919) % len;
+        CHECK( s[pos] == chars[pos] );
+        CHECK( s.Mid(pos, 1) == wxString(chars[pos]) );
+    }
+
+    for ( size_t n = 0; n < len; n++ )
+    {
+        if ( chars[n] == '#' )
+            CHECK( s.find('#', n) == n );
+    }
+}
+
+// wxVector doesn't have insert() overload taking a range of elements
+void InsertChars(wxVector<wxUniChar>& chars,
+                 size_t pos,
+                 const wxVector<wxUniChar>& what)
+{
+    for ( size_t n = 0; n < what.size(); n++ )
+        chars.insert(chars.begin() + pos + n, what[n]);
+}
+
+} // anonymous namespace
+
+TEST_CASE("StringIndexedAccessLong", "[wxString]")
+{
+    // this is mostly useful for UTF-8 build in which the positions of the
+    // characters in long strings are indexed
+    const wxUniChar samples[] = { 'x', L'\xe9', L'\x20ac', '#' };
+
+    wxVector<wxUniChar> chars;
+    wxString s;
+    for ( size_t n = 0; n < 1000; n++ )
+    {
+        const wxUniChar ch = samples[(n + n / 3) % WXSIZEOF(samples)];
+        chars.push_back(ch);
+        s += ch;
+    }
+
+    CheckIndexedAccess(s, chars);
+
+    SECTION("erase")
+    {
+        s.erase(100, 50);
+        chars.erase(chars.begin() + 100, chars.begin() + 150);
+        CheckIndexedAccess(s, chars);
+    }
+
+    SECTION("insert")
+    {
+        s.insert(300, wxString(L'\x20ac', 70));
+        chars.insert(chars.begin() + 300, 70, L'\x20ac');
+        CheckIndexedAccess(s, chars);
+    }
+
+    SECTION("insert self")
+    {
+        s.insert(200, s, 500, 100);
+        InsertChars(chars, 200, wxVector<wxUniChar>(chars.begin() + 500,
+                                                    chars.begin() + 600));
+        CheckIndexedAccess(s, chars);
+    }
+
+    SECTION("append self")
+    {
+        s.append(s, 900, 100);
+        InsertChars(chars, chars.size(),
+                    wxVector<wxUniChar>(chars.begin() + 900, chars.end()));
+        CheckIndexedAccess(s, chars);
+    }
+
+    SECTION("copy")
+    {
+        // the copy must not share the index of the original string
+        wxString copy(s);
+        s.erase(0, 10);
+        CheckIndexedAccess(copy, chars);
+
+        chars.erase(chars.begin(), chars.begin() + 10);
+        CheckIndexedAccess(s, chars);
+    }
+
+    SECTION("replace self")
+    {
+        s.replace(100, 200, s, 700, 10);
+        const wxVector<wxUniChar> repl(chars.begin() + 700,
+                                       chars.begin() + 710);
+        chars.erase(chars.begin() + 100, chars.begin() + 300);
+        InsertChars(chars, 100, repl);
+        CheckIndexedAccess(s, chars);
+    }
+
+    SECTION("assign character")
+    {
+        // the replacement character is encoded differently from the original
+        // one in UTF-8, so the positions of all the following ones change
+        REQUIRE( chars[402] == 'x' );
+        s[402] = L'\x20ac';
+        chars[402] = L'\x20ac';
+        CheckIndexedAccess(s, chars);
+    }
+
+    SECTION("swap")
+    {
+        wxString other("#");
+        s.swap(other);
+        CheckIndexedAccess(other, chars);
+
+        wxVector<wxUniChar> otherChars;
+        otherChars.push_back('#');
+        CheckIndexedAccess(s, otherChars);
+    }
+
+    SECTION("truncate")
+    {
+        s.Truncate(500);
+        chars.resize(500);
+        CheckIndexedAccess(s, chars);
+    }
+}
@@ -187,6 +187,22 @@ TEST_CASE("RepeatedPrintf", "[wxString][Printf][vararg]")
     CHECK( s == "buffer hi, len 2" );
 }
 
+TEST_CASE("ReusedFormatBuffer", "[wxString][Printf][vararg]")
+{
+    // the parsed format strings are cached, check that changing the contents
+    // of the same buffer is still taken into account
+    char format[16];
+
+    strcpy(format, "%d-%x");
+    CHECK( wxString::Format(format, 255, 255) == "255-ff" );
+
+    strcpy(format, "%x-%d");
+    CHECK( wxString::Format(format, 255, 255) == "ff-255" );
+
+    strcpy(format, "%s=%ld");
+    CHECK( wxString::Format(format, "x", -17L) == "x=-17" );
+}
+
 TEST_CASE("ArgsValidation", "[wxString][vararg][error]")
 {
     int written;